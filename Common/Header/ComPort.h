@@ -17,6 +17,7 @@
 #include "Util/tstring.hpp"
 #include "Poco/Event.h"
 #include "Thread/Thread.hpp"
+#include "Comm/NMEALineBuffer.h"
 
 class ComPort : public Thread {
 public:
@@ -90,23 +91,18 @@ protected:
 
     virtual unsigned RxThread() = 0;
 
-    void ProcessChar(char c);
-
     void ProcessData(const char* data, size_t size);
 
     Poco::Event StopEvt;
 
 private:
 
-    using _NmeaString_t = char[MAX_NMEA_LEN];
-
     void Run() override;
 
     const unsigned devIdx;
     const tstring sPortName;
 
-    _NmeaString_t _NmeaString;
-    char* pLastNmea;
+    NMEALineBuffer _NmeaLine;
 
     virtual bool Write_Impl(const void *data, size_t size) = 0;
 };
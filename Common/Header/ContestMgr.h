@@ -15,6 +15,8 @@
 #include "NavFunctions.h"
 #include <map>
 #include <memory>
+#include <vector>
+#include <atomic>
 
 
 #ifdef TEST_CONTEST
@@ -33,6 +35,10 @@ class CTestContest;
  *
  * Contest Manager remembers the best results obtained for each contest during
  * a flight.
+ *
+ * Add() only queues the GPS fix, traces are updated and contests are solved
+ * by a low priority worker thread, one step at a time. New fixes restart the
+ * steps sequence, Reset() abort the running step.
  */
 
 
@@ -161,9 +167,36 @@ public:
 private:
 #ifdef TEST_CONTEST
   friend class CTestContest;
+#endif
+#ifndef DOCTEST_CONFIG_DISABLE
+  friend class CContestMgrTest;
 #endif
   typedef std::unique_ptr<CTrace> CTracePtr;
-  typedef std::multimap<unsigned, const CTrace::CPoint *> CDistanceMap;
+
+  /**
+   * @brief Pairwise distances between the points of a triangle trace
+   *
+   * Buffers are kept from one solve to the next, so triangle solvers don't
+   * allocate memory once the trace size is stable.
+   */
+  class CDistanceMatrix {
+    std::vector<const CTrace::CPoint *> _points;
+    std::vector<unsigned> _distance;         /**< @brief DistanceXYZ() of each pair of points, row major */
+    std::vector<unsigned> _maxDistance;      /**< @brief Longest distance from each point to any later point */
+    std::vector<bool> _analysed;             /**< @brief Point inside the loop reviewed by previous iteration */
+
+  public:
+    void Update(const CTrace &trace, const CPointGPS *prevFront, const CPointGPS *prevBack);
+
+    unsigned Size() const                                { return _points.size(); }
+    const CTrace::CPoint *Point(unsigned i) const        { return _points[i]; }
+    unsigned Distance(unsigned i, unsigned j) const      { return _distance[i * _points.size() + j]; }
+    unsigned MaxDistance(unsigned i) const               { return _maxDistance[i]; }
+    bool Analysed(unsigned i) const                      { return _analysed[i]; }
+  };
+
+  typedef std::pair<unsigned, unsigned> CEdge;          /**< @brief Edge length and index of the edge end point */
+  typedef std::vector<CEdge> CEdgeArray;
 
   // Performance knobs
   static constexpr unsigned TRACE_FIX_LIMIT = 100;              /**< @brief The number of GPS fixes to store in the main trace */
@@ -182,6 +215,7 @@ private:
 
   // Other
   static constexpr unsigned DEFAULT_HANDICAP = 100;
+  static constexpr unsigned STEPS_NUM = 9;                      /**< @brief The number of solver steps to analyse a new trace */
 
   unsigned _handicap = DEFAULT_HANDICAP;              /**< @brief Glider handicap */
   CTracePtr _trace = std::make_unique<CTrace>(TRACE_FIX_LIMIT, 0, COMPRESSION_ALGORITHM); /**< @brief Main trace */
@@ -191,6 +225,10 @@ private:
       TRACE_TRIANGLE_FIX_LIMIT, 0, COMPRESSION_ALGORITHM); /**< @brief Trace for XContest Free Triangle */
   CTracePtr _traceLoop =
       std::make_unique<CTrace>(TRACE_TRIANGLE_FIX_LIMIT, 0, COMPRESSION_ALGORITHM); /**< @brief Trace for OLC-League */
+  CTracePtr _traceResult =
+      std::make_unique<CTrace>(7, 0, CTrace::ALGORITHM_DISTANCE); /**< @brief Work trace for OLC-Classic and FAI 3TPs result */
+  CTracePtr _traceSprintResult = std::make_unique<CTrace>(5, TRACE_SPRINT_TIME_LIMIT,
+                                                          CTrace::ALGORITHM_DISTANCE); /**< @brief Work trace for OLC-League result */
 
   std::unique_ptr<CPointGPS> _prevFAIFront;           /**< @brief Last reviewed OLC-FAI loop end points */
   std::unique_ptr<CPointGPS> _prevFAIBack;            /**< @brief Last reviewed OLC-FAI loop end points */
@@ -223,7 +261,7 @@ private:
   bool _bLooksLikeAFAITriangle = false;                 /**< @brief does the  FREE Triangle looks like a FAI attempt ?*/
   int _dFAITriangleClockwise = 0;                       /**< @brief 1 clockwise. 1 counter clockwise*/
 
-  mutable Mutex _mainCS;                                /**< @brief Main critical section that prevents Reset() and Add() at the same time */
+  mutable Mutex _mainCS;                                /**< @brief Main critical section that prevents Reset() and solver steps at the same time */
   mutable Mutex _traceCS;                               /**< @brief Main trace critical section for returning _trace points */
   mutable Mutex _resultsCS;                             /**< @brief Contests results critical section for returning results */
 
@@ -231,6 +269,10 @@ private:
   std::array<TriangleLeg, 3> _faiAssistantTriangleLegs; /** To store data and speedup rendering of the FAI Assistant */
   CResult _resultFREETriangle = {};                     /**< @brief private results for  XContest Free Triangle */
 
+  CDistanceMatrix _triangleMatrix;                      /**< @brief Distances of the trace used by triangle solvers */
+  CEdgeArray _triangleEdges1st;                         /**< @brief Triangle solvers 1st edge candidates */
+  CEdgeArray _triangleEdges2nd;                         /**< @brief Triangle solvers 2nd edge candidates */
+
   // member functions
   bool BiggestLoopFind(const CTrace &trace, const CTrace::CPoint *&start, const CTrace::CPoint *&end) const;
   bool BiggestLoopFind(const CTrace &traceIn, CTrace &traceOut, bool predicted) const;
@@ -241,7 +283,8 @@ private:
   void SolveFAITriangle(const CTrace &trace,const CPointGPS *prevFront,const CPointGPS *prevBack,bool predicted);
   void SolveFREETriangle(const CTrace &trace,const CPointGPS *prevFront,const CPointGPS *prevBack);
   void SolveOLCPlus(bool predicted);
-  void SolveXC();
+  void SolveXC(double lat, double lon);
+  void UpdateXCWaypoint();
   double ScoreXC(double current_distance,double total_distance ,XCFlightType type, bool update_status);
   double ScoreXContest2018(double current_distance, double total_distance_, XCFlightType type, bool update_status);
   double ScoreXContest2019(double current_distance, double total_distance_, XCFlightType type, bool update_status);
@@ -251,12 +294,21 @@ private:
   double ScoreFAI(double current_distance,double total_distance ,XCFlightType type, bool update_status);
   bool FREETriangleEdgeCheck(unsigned length1, unsigned length2, unsigned length3)  const;
   void UpdateFAIAssistantData() ;
-  void FindFAITriangleClosingPoint();
-  void FindFREETriangleClosingPoint();
+  void FindFAITriangleClosingPoint(double lat, double lon);
+  void FindFREETriangleClosingPoint(double lat, double lon);
+
+  class CWorker;
+  std::unique_ptr<CWorker> _worker;                     /**< @brief Solver thread */
+  std::atomic<bool> _cancel = {false};                  /**< @brief @c true to abort running solver */
+  unsigned _step = 0;                                   /**< @brief Next solver step */
+
+  void PushFixes(const std::vector<CPointGPSSmart> &fixes);
+  void SolveStep(double lat, double lon);
 
  public:
 
-  CContestMgr() = default;
+  CContestMgr();
+  ~CContestMgr();
 
   TriangleLeg* GetFAIAssistantMaxLeg() {return _maxFAILeg;};
   TriangleLeg* GetFAIAssistantLeg(int i) {return &_faiAssistantTriangleLegs[i];};
@@ -289,6 +341,8 @@ private:
 
   void Reset(unsigned handicap);
   void Add(unsigned time, double lat, double lon, int alt);
+  void WaitSolver();
+  void Stop();
 
   CResult Result(TType type, bool fillArray) const;
   void Trace(CPointGPSArray &array) const;
@@ -172,11 +172,13 @@
 #define LKS_TERRAINDEM	".dem"
 #define LKS_TERRAINJP2	".jp2"
 #define LKS_TOPOLOGY	".tpl"
+#define LKS_TOPOLOGY_STORE	".xtp"
 #define LKS_AIRFIELDS	".txt"
 #define LKS_LANGUAGE	".LNG"
 #define LKS_INPUT	".xci"
 #define LKS_IGC		".igc"
 #define LKS_OPENAIP ".aip"
+#define LKS_AIRSPACE_CACHE ".xac"
 
 /*
  * LK8000 files (keep original suffixes)
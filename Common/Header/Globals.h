@@ -180,6 +180,7 @@ GEXTERN bool EnableAutoSoundVolume;
 GEXTERN unsigned EnableFLARMMap;
 GEXTERN short AircraftCategory;
 GEXTERN bool CheckSum;
+GEXTERN bool EnableNMEAQueue; // parse nmea sentences in ingestion thread instead of port Rx thread
 GEXTERN bool HideUnits;
 GEXTERN short OutlinedTp;
 GEXTERN short OutlinedTp_Config;
@@ -393,6 +394,7 @@ GEXTERN double SimNettoVario;
 GEXTERN bool AutoContrast; // automatic contrast of terrain
 GEXTERN short SnailScale;  // user choice for rescaling the snail trail
 GEXTERN double TerrainWhiteness; // HSV luminance
+GEXTERN unsigned TerrainCacheSize; // tiled terrain cache size in MB
 
 // General index of all pages
 // current mapspacemode: the internal identifier of a page type
@@ -808,6 +810,7 @@ GEXTERN TCHAR CompetitionID_Config[50];
 
 GEXTERN bool LockSettingsInFlight;
 GEXTERN bool LoggerShortName;
+GEXTERN unsigned LoggerGRecordInterval; // igc records written at once, with updated G record
 
 GEXTERN bool UseHiresBitmap;
 GEXTERN bool UseUngestures;
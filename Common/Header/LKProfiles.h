@@ -74,6 +74,7 @@ extern const char szRegistryBestWarning[];
 extern const char szRegistryBgMapColor[];
 extern const char szRegistryBugs[];
 extern const char szRegistryCheckSum[];
+extern const char szRegistryEnableNMEAQueue[];
 extern const char szRegistryCircleZoom[];
 extern const char szRegistryClipAlt[];
 extern const char szRegistryCompetitionClass[];
@@ -167,6 +168,7 @@ extern const char szRegistryLKVarioVal[];
 extern const char szRegistryLanguageCode[];
 extern const char szRegistryLockSettingsInFlight[];
 extern const char szRegistryLoggerShort[];
+extern const char szRegistryLoggerGRecordInterval[];
 extern const char szRegistryMapBox[];
 extern const char szRegistryMapFile[];
 extern const char szRegistryMenuTimeout[];
@@ -222,6 +224,7 @@ extern const char szRegistryStartRadius[];
 extern const char szRegistryStatusFile[];
 extern const char szRegistryTeamcodeRefWaypoint[];
 extern const char szRegistryTerrainBrightness[];
+extern const char szRegistryTerrainCacheSize[];
 extern const char szRegistryTerrainContrast[];
 extern const char szRegistryTerrainFile[];
 extern const char szRegistryTerrainRamp[];
@@ -137,5 +137,6 @@ int FLARM_FindSlot(NMEA_INFO *GPS_INFO, uint32_t RadioId);
 
 extern bool EnableLogNMEA;
 void LogNMEA(const char* text, int);
+void CloseNMEALogger();
 
 #endif
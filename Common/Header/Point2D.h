@@ -12,6 +12,7 @@
 #include <cmath>
 #include <vector>
 #include <memory>
+#include <cassert>
 
 #ifdef _WGS84
 
@@ -69,6 +70,10 @@ public:
     _z = static_cast<int>(EARTH_RADIUS * sin(lat));
   }
 
+  // already known geocentric coordinates, <x, y, z> must be computed with current earth model.
+  CPoint2D(double lat, double lon, int x, int y, int z):
+    _lat(lat), _lon(lon), _x(x), _y(y), _z(z) { }
+
   CPoint2D(unsigned x, unsigned y, unsigned z):
     _x(x), _y(y), _z(z)
   {
@@ -91,6 +96,11 @@ public:
   
   double Latitude() const    { return _lat; }
   double Longitude() const   { return _lon; }
+
+  // geocentric coordinates
+  int X() const { return _x; }
+  int Y() const { return _y; }
+  int Z() const { return _z; }
   
   unsigned Distance(double lat, double lon) const;
   unsigned Distance(const CPoint2D &ref) const;
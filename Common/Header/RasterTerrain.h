@@ -11,6 +11,8 @@
 
 #include <memory>
 #include "Library/cpp-mmf/memory_mapped_file.hpp"
+#include "Terrain/TerrainTiles.h"
+#include "utils/profiler.h"
 
 struct TERRAIN_INFO {
   double Left;
@@ -26,17 +28,16 @@ struct TERRAIN_INFO {
 class RasterMap final {
  public:
   RasterMap() {
-    Interpolate = false;
-
     TerrainMem = nullptr;
   }
   ~RasterMap() { Close(); }
 
   inline bool isMapLoaded() const {
-    return (TerrainMem);
+    return (TerrainMem || Tiles);
   }
 
   bool GetMapCenter(double *lat, double *lon) const;
+  bool GetMapInfo(TERRAIN_INFO *info) const;
   bool IsInside(double lat, double lon) const;
 
   float GetFieldStepSize() const;
@@ -48,30 +49,11 @@ class RasterMap final {
   int GetEffectivePixelSize(double *pixel_D,
                             double latitude, double longitude) const;
 
-  void SetFieldRounding(double xr, double yr);
-
-  inline short GetField(const double &Latitude, const double &Longitude) const;
-
   bool Open(const TCHAR* filename);
   void Close();
 
-protected:
-  friend class TerrainRenderer;
-
-  inline bool interpolate() const { return Interpolate; }
-  inline short GetFieldInterpolate(const double &Latitude, const double &Longitude) const;
-  inline short GetFieldFine(const double &Latitude, const double &Longitude) const;
-
  private:
-
-  int xlleft;
-  int xlltop;
-
-  bool Interpolate;
-
-  double fXrounding, fYrounding;
-  double fXroundingFine, fYroundingFine;
-  int Xrounding, Yrounding;
+  friend class TerrainSampler;
 
   TERRAIN_INFO TerrainInfo;
   const short* TerrainMem;
@@ -80,19 +62,98 @@ protected:
 #ifndef UNDER_CE
   memory_mapped_file::read_only_mmf TerrainFile;
 #endif
+
+  // tiled terrain file, used instead of TerrainMem
+  std::unique_ptr<TerrainTiles> Tiles;
 };
+
 /**
- * JMW rounding further reduces data as required to speed up terrain display on low zoom levels
+ * Read only elevation query over a RasterMap.
+ *
+ * Sampler carry it's own rounding parameters and keep a reference to the map,
+ * so it can be used without RasterTerrain::Lock() and from many threads at the
+ * same time, even if terrain is closed or reloaded meanwhile.
  *
- * Attention ! allways check if Terrain IsValid before call this.
+ * JMW rounding further reduces data as required to speed up terrain display on low zoom levels
  */
+class TerrainSampler final {
+public:
+  // invalid sampler, GetField() allways return TERRAIN_INVALID
+  TerrainSampler() = default;
+
+  // xr, yr : rounding in degrees, 0 for most accurate elevation (interpolated)
+  TerrainSampler(std::shared_ptr<const RasterMap> map, double xr, double yr);
+
+  bool IsValid() const {
+    return (TerrainMem || Tiles);
+  }
+
+  const RasterMap* GetMap() const {
+    return Map.get();
+  }
+
+  inline bool interpolate() const { return Interpolate; }
+
+  inline short GetField(const double &Latitude, const double &Longitude) const;
+
+  /**
+   * Attention ! allways check if Sampler IsValid before call this.
+   */
+  inline short GetFieldInterpolate(const double &Latitude, const double &Longitude) const;
+  inline short GetFieldFine(const double &Latitude, const double &Longitude) const;
+
+  /**
+   * batch query, same result as GetField() for each point.
+   * interpolation is vectorized with SSE2 or NEON when available.
+   */
+  void GetFields(const double* Latitude, const double* Longitude, short* Height, size_t count) const;
+
+  /**
+   * batch query of <count> points along a straight line,
+   * point <i> is start + i * step (accumulated, like Latitude += dLatitude)
+   */
+  void GetProfile(double Latitude, double Longitude,
+                  double dLatitude, double dLongitude,
+                  short* Height, size_t count) const;
+
+  /**
+   * keep returned scope alive during a batch of GetField() call (e.g. one row of pixels),
+   * so tiled map reader is registered once for all points instead of once by point.
+   */
+  TerrainTiles::ReadScope Batch() const {
+    return TerrainTiles::ReadScope(Tiles);
+  }
+
+private:
+  bool GetFieldInterpolate4(const double* Latitude, const double* Longitude, short* Height) const;
+  short GetFieldInterpolateTiled(unsigned lx, unsigned ly, unsigned ix, unsigned iy) const;
+
+  std::shared_ptr<const RasterMap> Map;
+
+  int xlleft = 0;
+  int xlltop = 0;
+
+  bool Interpolate = false;
+
+  double fXrounding = 0., fYrounding = 0.;
+  double fXroundingFine = 0., fYroundingFine = 0.;
+  int Xrounding = 1, Yrounding = 1;
+
+  // copy of map data, avoid indirection in GetField.
+  TERRAIN_INFO TerrainInfo = {};
+  const short* TerrainMem = nullptr;
+
+  // tiled map only, <Level> is the overview used for current rounding
+  const TerrainTiles* Tiles = nullptr;
+  unsigned Level = 0;
+};
 
 /**
  * @brief return terrain elevation with piecewise linear interpolation
  * @optimization : return invalid terrain for right&bottom line.
  */
 inline
-short RasterMap::GetFieldInterpolate(const double &Latitude, const double &Longitude) const {
+short TerrainSampler::GetFieldInterpolate(const double &Latitude, const double &Longitude) const {
     assert(Interpolate);
 
     unsigned int lx = (int)(Longitude * fXroundingFine) - xlleft;
@@ -104,6 +165,9 @@ short RasterMap::GetFieldInterpolate(const double &Latitude, const double &Longi
     if (gcc_unlikely((lx + 1) >= TerrainInfo.Columns || (ly + 1) >= TerrainInfo.Rows)) {
         return TERRAIN_INVALID;
     }
+    if (gcc_unlikely(!TerrainMem)) {
+        return GetFieldInterpolateTiled(lx, ly, ix, iy);
+    }
     assert(((ly+1) * TerrainInfo.Columns + (lx+1)) < (TerrainInfo.Columns*TerrainInfo.Rows));
     const short *tm = TerrainMem + ly * TerrainInfo.Columns + lx;
 
@@ -146,7 +210,7 @@ short RasterMap::GetFieldInterpolate(const double &Latitude, const double &Longi
  * @optimization : return invalid terrain for right&bottom line.
  */
 inline
-short RasterMap::GetFieldFine(const double &Latitude, const double &Longitude) const {
+short TerrainSampler::GetFieldFine(const double &Latitude, const double &Longitude) const {
     if(gcc_unlikely(Longitude < TerrainInfo.Left || Latitude > TerrainInfo.Top)) {
         return TERRAIN_INVALID;
     }
@@ -157,6 +221,9 @@ short RasterMap::GetFieldFine(const double &Latitude, const double &Longitude) c
     if (gcc_unlikely(lx >= (TerrainInfo.Columns) || ly >= (TerrainInfo.Rows))) {
         return TERRAIN_INVALID;
     }
+    if (gcc_unlikely(!TerrainMem)) {
+        return Tiles->GetHeight(Level, lx >> Level, ly >> Level);
+    }
 
     assert(((ly) * TerrainInfo.Columns + (lx)) < (TerrainInfo.Columns*TerrainInfo.Rows));
 
@@ -164,7 +231,10 @@ short RasterMap::GetFieldFine(const double &Latitude, const double &Longitude) c
 }
 
 inline
-short RasterMap::GetField(const double &Latitude, const double &Longitude) const {
+short TerrainSampler::GetField(const double &Latitude, const double &Longitude) const {
+    if (gcc_unlikely(!IsValid())) {
+        return TERRAIN_INVALID;
+    }
     if (interpolate()) {
         return GetFieldInterpolate(Latitude, Longitude);
     } else {
@@ -182,8 +252,14 @@ public:
     return static_cast<bool>(TerrainMap);
   }
 
-  static std::unique_ptr<RasterMap> TerrainMap;
-  static Mutex mutex;
+  static std::shared_ptr<RasterMap> TerrainMap;
+  static profiler::timed_mutex<profiler::LockTerrain> mutex;
+
+  /**
+   * Lock is only held to copy the map reference, returned sampler can be used
+   * without lock, for all query that need their own rounding.
+   */
+  static TerrainSampler GetSampler(double xr, double yr);
 
 public:
   static void Lock(void);
@@ -197,10 +273,14 @@ public:
 
   static bool WaypointIsInTerrainRange(double latitude, double longitude);
   static bool GetTerrainCenter(double *latitude, double *longitude);
+  static bool GetTerrainInfo(TERRAIN_INFO *info);
 
 protected:
   static bool CreateTerrainMap(const TCHAR *zfilename);
 
+  // used by GetTerrainHeight() and SetTerrainRounding()
+  static TerrainSampler Sampler;
+
 };
 
 
@@ -4,7 +4,8 @@
 #include "Topology.h"
 
 
-void SetTopologyBounds(const RECT& rcin, const ScreenProjection& _Proj,  const bool force=false);
+// @track : if not null, displacement to predicted position, used to prefetch topology ahead.
+void SetTopologyBounds(const RECT& rcin, const ScreenProjection& _Proj,  const bool force=false, const vectorObj* track=nullptr);
 
 void OpenTopology();
 void CloseTopology();
@@ -10,9 +10,14 @@
 #define TOPOLOGY_H
 
 #include "Thread/Thread.hpp"
+#include "Thread/Mutex.hpp"
 #include "Topology/shapelib/mapserver.h"
+#include <vector>
+#include <memory>
+#include <unordered_map>
 
 class ShapeSpecialRenderer;
+class TopologyStore;
 
 class XShape {
  public:
@@ -64,6 +69,10 @@ class XShapeLabel: public XShape {
 
   void setLabel(const char* src);
 
+  const TCHAR* getLabel() const {
+    return label;
+  }
+
   bool renderSpecial(ShapeSpecialRenderer& renderer, LKSurface& Surface, int x, int y, const RECT& ClipRect) const override;
   bool nearestItem(int category, double lon, double lat) const override;
 
@@ -72,6 +81,31 @@ protected:
 };
 
 
+/**
+ * Shape decoded from TopologyStore.
+ *
+ * line, point and label storage is reused by each Load(), so no memory is allocated
+ * once buffers are big enough.
+ */
+class XShapeView final : public XShapeLabel {
+ public:
+  XShapeView() = default;
+  ~XShapeView();
+
+  void Load(const TopologyStore& store, unsigned i);
+
+  // release storage reference without free
+  void clear() override;
+
+ private:
+  std::vector<lineObj> lines;
+  std::vector<pointObj> points;
+#ifdef UNICODE
+  std::vector<TCHAR> label_buffer;
+#endif
+};
+
+
 class Topology final {
   Topology() = delete;
 
@@ -82,7 +116,16 @@ class Topology final {
   void Open();
   void Close();
 
-  void updateCache(rectObj thebounds, bool purgeonly=false);
+  /**
+   * @prefetch : if not null, area ahead that TopologyLoader can load in advance.
+   */
+  void updateCache(rectObj thebounds, bool purgeonly=false, const rectObj* prefetch=nullptr);
+
+  /**
+   * install shapes loaded by TopologyLoader, must be called with TerrainDataGraphics lock.
+   */
+  void ApplyPendingCache();
+
   void Paint(ShapeSpecialRenderer& renderer, LKSurface& Surface, const RECT& rc, const ScreenProjection& _Proj) const;
 
   void SearchNearest(const rectObj& bounds);
@@ -107,10 +150,42 @@ class Topology final {
   void removeShape(const int i);
   XShape* addShape(const int i);
 
+  struct cache_request {
+    rectObj bounds;
+    rectObj prefetch;
+    bool has_prefetch;
+    unsigned generation;
+    std::vector<bool> present; // shpCache[i] != nullptr when request was posted
+  };
+
+  // called by TopologyLoader thread
+  void LoadCache(const cache_request& request);
+
  protected:
+#ifndef DOCTEST_CONFIG_DISABLE
+  friend class TopologyLoaderTest;
+#endif
+
+  struct cache_update {
+    cache_update() = default;
+    ~cache_update();
+
+    cache_update(const cache_update&) = delete;
+    cache_update& operator=(const cache_update&) = delete;
+
+    unsigned generation = 0;
+    std::vector<bool> wanted;
+    std::vector<std::pair<int, XShape*>> shapes; // shapes not in cache when request was posted
+  };
+
+  // shapes overlapping <bounds>
+  std::vector<bool> whichShapes(const rectObj& bounds);
 
   void flushCache();
 
+  // use <name>.xtp store instead of shapefile if available
+  bool OpenStore();
+
   bool in_scale;
   LKPen hPen;
   LKBrush hbBrush;
@@ -131,11 +206,54 @@ class Topology final {
   rectObj lastBounds;
   bool in_scale_last;
 
+  // incremented by flushCache(), pending update of previous generation are discarded.
+  unsigned cache_generation;
+
+  Mutex file_mutex; // shpfile is read by draw, loader and oracle thread
+
+  Mutex pending_mutex;
+  std::unique_ptr<cache_update> pending_update;
+
+  // shapes loaded ahead of track, only used by TopologyLoader thread
+  std::unordered_map<int, std::unique_ptr<XShape>> prefetched;
+
+  // memory mapped store, shpfile, shpCache and TopologyLoader are not used if defined.
+  std::unique_ptr<TopologyStore> store;
+  std::vector<unsigned> store_visible; // index of shapes overlapping last cache bounds
+
   char filename[MAX_PATH];
   int field;
 };
 
 
+/**
+ * Load topology shapes out of draw thread.
+ *
+ * Topology::updateCache() post a request, loader read missing shapes from shapefile then
+ * publish them, draw thread install them on next DrawTopology() and keep drawing
+ * previous cache meanwhile.
+ */
+namespace TopologyLoader {
+
+  struct Stats {
+    unsigned requests; // cache update processed
+    unsigned loads; // shapes read from file for visible area
+    unsigned prefetch_hits; // shapes already loaded by prefetch
+    unsigned prefetch_loads; // shapes read from file for area ahead
+  };
+
+  void Start();
+  void Stop();
+
+  /**
+   * @return false if loader is not running, caller must update cache synchronously.
+   */
+  bool Post(Topology* topology, Topology::cache_request&& request);
+
+  Stats GetStats();
+}
+
+
 /**
  * Thread class used by "Oracle" for find Topology Item nearest to current position.
  */
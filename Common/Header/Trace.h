@@ -10,18 +10,11 @@
 #define __TRACE_H__
 
 #include "PointGPS.h"
-#include <set>
+#include <memory>
+#include <vector>
 
 class CContestMgr; 
 
-/** 
- * @brief Pointers compare object
- */
-template<class T>
-struct CPtrCmp {
-  bool operator()(const T &left, const T &right) const { return *left < *right; }
-};
-
 
 /** 
  * @brief GPS path trace
@@ -30,6 +23,11 @@ struct CPtrCmp {
  * as possible. The trace have a defined maximum size. If more points are added
  * they may be compressed to the required size. During compression the least
  * important points are removed.
+ *
+ * Points are allocated from a pool owned by the trace, sized for maximum size
+ * of the trace and grown only if more points are pushed before compression.
+ * Compression candidates are stored in a binary heap indexed by the points,
+ * so the cost of a point can be updated in place when its neighbors change.
  */
 class CTrace {
 public:
@@ -51,10 +49,10 @@ private:
   friend class CContestMgr; 
 
   /**
-   * @brief A map of GPS points sorted from the most importand to the least important ones.
-   * 
+   * @brief A heap of GPS points, the least important one on top.
    */
-  typedef std::set<CPoint *, CPtrCmp<CPoint *> > CPointCostSet;
+  typedef std::vector<CPoint *> CPointCostHeap;
+  typedef std::vector<std::unique_ptr<CPoint[]>> CPointPool;
   
   unsigned _maxSize;                              /**< @brief Maximum number of GPS fixes to store inside a trace */
   const unsigned _timeLimit;                      /**< @brief Maximum time period of a trace */
@@ -62,14 +60,27 @@ private:
   bool _valid;                                    /**< @brief Informs that a trace is invalid */
   unsigned _size;                                 /**< @brief Current number of fixes stored in a trace */
   unsigned _analyzedPointCount;                   /**< @brief The number of analysed GPS fixes */
-  CPointCostSet _compressionCostSet;              /**< @brief The sorted set of GPS fixes */
+  CPointCostHeap _compressionCostHeap;            /**< @brief The heap of GPS fixes candidates for compression */
+  CPointPool _pool;                               /**< @brief Storage of trace points */
+  CPoint *_free;                                  /**< @brief Unused points of the pool */
   CPoint *_front;                                 /**< @brief The first GPS fix in a trace */
   CPoint *_back;                                  /**< @brief The last GPS fix in a trace */
   
   CTrace(const CTrace &);                         /**< @brief Disallowed */
   CTrace &operator=(const CTrace &);              /**< @brief Disallowed */
 
+  void Grow(unsigned size);
+  CPoint *Alloc();
+  void Release(CPoint *point);
+
   void Push(CPoint *point);
+  void Push(const CPoint &ref);
+
+  void HeapPush(CPoint *point);
+  void HeapRemove(CPoint *point);
+  void HeapUpdate(CPoint *point);
+  bool HeapUp(unsigned index);
+  void HeapDown(unsigned index);
   
 public:
   CTrace(unsigned maxSize, unsigned timeLimit, unsigned algorithm);
@@ -97,8 +108,10 @@ public:
 class CTrace::CPoint {
   friend class CTrace;
   friend class CTestContest;
+
+  static constexpr unsigned NOT_IN_HEAP = static_cast<unsigned>(-1);
   
-  const CTrace &_trace;                           /**< @brief Parent trace */
+  const CTrace *_trace;                           /**< @brief Parent trace */
   CPointGPSSmart _gps;                            /**< @brief Contained GPS fix */
   
   // trace compression values
@@ -106,22 +119,25 @@ class CTrace::CPoint {
   //  float _inheritedCost;                           /**< @brief The cost inherited from compressed (removed) GPS fixes */
   unsigned _distanceCost;                         /**< @brief The distance related compression cost */
   unsigned _timeCost;                             /**< @brief Time related compression cost */
+  unsigned _heapIndex;                            /**< @brief Position in the compression heap */
   
   // list iterators
   CPoint *_prev;                                  /**< @brief Previous point in time domain */
   CPoint *_next;                                  /**< @brief Next point in time domain */
   
+  CPoint() : _trace(0), _heapIndex(NOT_IN_HEAP), _prev(0), _next(0) {} /**< @brief Pool only */
   CPoint(const CPoint &);                         /**< @brief Disallowed */
   CPoint &operator=(const CPoint &);              /**< @brief Disallowed */
+
+  void Init(const CTrace &trace, const CPointGPSSmart &gps, CPoint *prev);
+  void Init(const CTrace &trace, const CPoint &ref, CPoint *prev);
+  void Link(CPoint *prev);
+  void Unlink();
   
   void Reduce();
   void AssesCost();
   
 public:
-  CPoint(const CTrace &trace, const CPointGPSSmart &gps, CPoint *prev);
-  CPoint(const CTrace &trace, const CPoint &ref, CPoint *prev);
-  ~CPoint();
-
   const CPointGPS &GPS() const { return *_gps; }
   
   CPoint *Next() const         { return _next; }
@@ -140,49 +156,73 @@ public:
 inline void CTrace::Push(const CPointGPSSmart &gps)
 {
   // add new point
-  Push(new CPoint(*this, gps, _back));
+  CPoint *point = Alloc();
+  point->Init(*this, gps, _back);
+  Push(point);
 }
 
 
+/** 
+ * @brief Adds a copy of a point from other trace
+ * 
+ * @param ref Point to copy data from
+ */
+inline void CTrace::Push(const CPoint &ref)
+{
+  CPoint *point = Alloc();
+  point->Init(*this, ref, _back);
+  Push(point);
+}
+
 
 /** 
- * @brief Constructor
+ * @brief Initialize a point taken from the pool
  * 
  * @param trace Parent trace
  * @param gps GPS fix to contain
  * @param prev Previous trace point
  */
-inline CTrace::CPoint::CPoint(const CTrace &trace, const CPointGPSSmart &gps, CPoint *prev):
-  _trace(trace), 
-  _gps(gps),
-  _prevDistance(prev ? prev->_gps->DistanceXYZ(*this->_gps) : 0),
-  //  _inheritedCost(0),
-  _distanceCost(0), _timeCost(0),
-  _prev(prev), _next(0)
+inline void CTrace::CPoint::Init(const CTrace &trace, const CPointGPSSmart &gps, CPoint *prev)
 {
-  if(_prev) {
-    _prev->_next = this;
-    if(_prev->_prev)
-      _prev->AssesCost();
-  }
+  _trace = &trace;
+  _gps = gps;
+  _prevDistance = prev ? prev->_gps->DistanceXYZ(*_gps) : 0;
+  //  _inheritedCost = 0;
+  _distanceCost = 0;
+  _timeCost = 0;
+  Link(prev);
 }
 
 
 /** 
- * @brief "Copy" constructor
+ * @brief Initialize a point taken from the pool with data of other point
  * 
  * @param trace Parent trace
  * @param ref Point to copy data from
  * @param prev Previous trace point
  */
-inline CTrace::CPoint::CPoint(const CTrace &trace, const CPoint &ref, CPoint *prev):
-  _trace(trace), 
-  _gps(ref._gps),
-  _prevDistance(ref._prevDistance),
-  // _inheritedCost(ref._inheritedCost),
-  _distanceCost(ref._distanceCost), _timeCost(ref._timeCost),
-  _prev(prev), _next(0)
+inline void CTrace::CPoint::Init(const CTrace &trace, const CPoint &ref, CPoint *prev)
+{
+  _trace = &trace;
+  _gps = ref._gps;
+  _prevDistance = ref._prevDistance;
+  // _inheritedCost = ref._inheritedCost;
+  _distanceCost = ref._distanceCost;
+  _timeCost = ref._timeCost;
+  Link(prev);
+}
+
+
+/** 
+ * @brief Appends the point after the previous one
+ * 
+ * @param prev Previous trace point
+ */
+inline void CTrace::CPoint::Link(CPoint *prev)
 {
+  _heapIndex = NOT_IN_HEAP;
+  _prev = prev;
+  _next = nullptr;
   if(_prev) {
     _prev->_next = this;
     if(_prev->_prev)
@@ -192,14 +232,15 @@ inline CTrace::CPoint::CPoint(const CTrace &trace, const CPoint &ref, CPoint *pr
 
 
 /** 
- * @brief Destructor
+ * @brief Removes the point from the list
  */
-inline CTrace::CPoint::~CPoint()
+inline void CTrace::CPoint::Unlink()
 {
   if(_prev)
     _prev->_next = _next;
   if(_next)
     _next->_prev = _prev;
+  _gps = nullptr;
 }
 
 
@@ -212,7 +253,7 @@ inline void CTrace::CPoint::Reduce()
 {
   // asses new costs & set new prevDistance for next point
   // float distanceCost;
-  // if(_trace._algorithm & ALGORITHM_TRIANGLES) {
+  // if(_trace->_algorithm & ALGORITHM_TRIANGLES) {
   //   unsigned newDistance = _next->_gps->Distance(*_prev->_gps);
   //   distanceCost = _prevDistance + _next->_prevDistance - newDistance;
   //   _next->_prevDistance = newDistance;
@@ -222,7 +263,7 @@ inline void CTrace::CPoint::Reduce()
     //    distanceCost = _distanceCost; 
   // }
   
-  // if(_trace._algorithm & ALGORITHM_INHERITED) {
+  // if(_trace->_algorithm & ALGORITHM_INHERITED) {
   //   float cost = (distanceCost + _inheritedCost) / 2.0;
   //   _prev->_inheritedCost += cost;
   //   _next->_inheritedCost += cost;
@@ -235,7 +276,7 @@ inline void CTrace::CPoint::Reduce()
  */
 inline void CTrace::CPoint::AssesCost()
 {
-  // if(_trace._algorithm & ALGORITHM_TRIANGLES) {
+  // if(_trace->_algorithm & ALGORITHM_TRIANGLES) {
   //   double ax = _gps->Longitude();           double ay = _gps->Latitude();
   //   double bx = _prev->_gps->Longitude();    double by = _prev->_gps->Latitude();
   //   double cx = _next->_gps->Longitude();    double cy = _next->_gps->Latitude();
@@ -244,7 +285,7 @@ inline void CTrace::CPoint::AssesCost()
   // else {
   _distanceCost = std::max(0, (int)(_prevDistance + _next->_prevDistance - _next->_gps->DistanceXYZ(*_prev->_gps)));
   // }
-  if(_trace._algorithm & ALGORITHM_TIME_DELTA)
+  if(_trace->_algorithm & ALGORITHM_TIME_DELTA)
     _timeCost = _gps->TimeDelta(*_prev->_gps);
 }
 
@@ -267,11 +308,11 @@ inline bool CTrace::CPoint::operator<(const CPoint &ref) const
   leftCost += _distanceCost;
   rightCost += ref._distanceCost;
       
-  // if(_trace._algorithm & ALGORITHM_INHERITED) {
+  // if(_trace->_algorithm & ALGORITHM_INHERITED) {
   //   leftCost += _inheritedCost;
   //   rightCost += ref._inheritedCost;
   // }
-  if(_trace._algorithm & ALGORITHM_TIME_DELTA) {
+  if(_trace->_algorithm & ALGORITHM_TIME_DELTA) {
     leftCost *= _timeCost;
     rightCost *= ref._timeCost;
   }
@@ -12,13 +12,14 @@
 #include "Sizes.h"
 #include <stdint.h>
 #include "Thread/Mutex.hpp"
+#include "utils/profiler.h"
 #include "Modeltype.h"
 
-extern Mutex  CritSec_FlightData;
+extern profiler::timed_mutex<profiler::LockFlightData>  CritSec_FlightData;
 extern void UnlockFlightData();
 extern void LockFlightData();
 
-extern Mutex  CritSec_TaskData;
+extern profiler::timed_mutex<profiler::LockTaskData>  CritSec_TaskData;
 extern void UnlockTaskData();
 extern void LockTaskData();
 
@@ -0,0 +1,549 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   AirspaceCache.cpp
+ */
+
+#include "externs.h"
+#include "AirspaceCache.h"
+#include "RasterTerrain.h"
+#include "md5.h"
+#include "utils/openzip.h"
+#include <cstring>
+#include <type_traits>
+
+namespace {
+
+// to increase each time parser or cache format change
+constexpr uint32_t cache_version = 1;
+
+constexpr uint8_t cache_magic[8] = { 'L', 'K', 'A', 'S', 'P', 'C', 0, 1 };
+constexpr uint32_t byte_order_mark = 0x01020304;
+
+struct AIRSPACE_CACHE_HEADER {
+  uint8_t Magic[8];
+  uint32_t ByteOrder;
+  uint32_t Count; // cached airspaces
+  uint32_t Skipped; // airspaces excluded by terrain filter
+  uint32_t DataSize;
+  char Key[32]; // md5 hex digest, see CAirspaceCache::Key()
+};
+
+static_assert(sizeof(AIRSPACE_CACHE_HEADER) == 56, "unexpected padding");
+
+enum : uint8_t {
+  shape_area,
+  shape_circle
+};
+
+enum : uint8_t {
+  flag_flyzone = 1 << 0,
+  flag_enabled = 1 << 1,
+  flag_except_saturday = 1 << 2,
+  flag_except_sunday = 1 << 3
+};
+
+template<typename T>
+void Put(std::vector<uint8_t>& out, const T& value) {
+  static_assert(std::is_arithmetic_v<T>, "only arithmetic type can be stored");
+  const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+  out.insert(out.end(), p, p + sizeof(T));
+}
+
+// null terminated utf-8 string, preceded by size including terminator
+void PutString(std::vector<uint8_t>& out, const std::string& value) {
+  Put<uint32_t>(out, value.size() + 1);
+  out.insert(out.end(), value.begin(), value.end());
+  out.push_back('\0');
+}
+
+void PutAltitude(std::vector<uint8_t>& out, const AIRSPACE_ALT& alt) {
+  Put(out, alt.Altitude);
+  Put(out, alt.FL);
+  Put(out, alt.AGL);
+  Put<int32_t>(out, alt.Base);
+}
+
+template<typename T>
+bool Get(const uint8_t*& p, const uint8_t* end, T& value) {
+  static_assert(std::is_arithmetic_v<T>, "only arithmetic type can be stored");
+  if (static_cast<size_t>(end - p) < sizeof(T)) {
+    return false;
+  }
+  memcpy(&value, p, sizeof(T));
+  p += sizeof(T);
+  return true;
+}
+
+// @return nullptr if invalid
+const char* GetString(const uint8_t*& p, const uint8_t* end) {
+  uint32_t size;
+  if (!Get(p, end, size) || size == 0 || static_cast<size_t>(end - p) < size || p[size - 1] != '\0') {
+    return nullptr;
+  }
+  const char* value = reinterpret_cast<const char*>(p);
+  p += size;
+  return value;
+}
+
+bool GetAltitude(const uint8_t*& p, const uint8_t* end, AIRSPACE_ALT& alt) {
+  int32_t base;
+  if (!Get(p, end, alt.Altitude) || !Get(p, end, alt.FL) || !Get(p, end, alt.AGL) || !Get(p, end, base)) {
+    return false;
+  }
+  if (base < abUndef || base > abFL) {
+    return false;
+  }
+  alt.Base = static_cast<AirspaceAltBase_t>(base);
+  return true;
+}
+
+tstring CachePath(const TCHAR* szFile) {
+  return tstring(szFile) + _T(LKS_AIRSPACE_CACHE);
+}
+
+} // namespace
+
+std::string CAirspaceCache::Key(const TCHAR* szFile) {
+  zzip_file_ptr file(openzip(szFile, "rb"));
+  if (!file) {
+    return {};
+  }
+
+  MD5 md5;
+  md5.Update(cache_version);
+
+  char buffer[16 * 1024];
+  zzip_ssize_t size;
+  while ((size = zzip_read(file.get(), buffer, sizeof(buffer))) > 0) {
+    md5.Update(buffer, size);
+  }
+  if (size < 0) {
+    return {};
+  }
+
+  // settings used by parser
+#ifdef _WGS84
+  md5.Update(earth_model_wgs84);
+#endif
+  const bool terrain_filter = (WaypointsOutOfRange > 1);
+  md5.Update(terrain_filter);
+  if (terrain_filter) {
+    TERRAIN_INFO info;
+    const bool terrain = RasterTerrain::GetTerrainInfo(&info);
+    md5.Update(terrain);
+    if (terrain) {
+      md5.Update(info.Left);
+      md5.Update(info.Right);
+      md5.Update(info.Top);
+      md5.Update(info.Bottom);
+    }
+  }
+  return md5.Final();
+}
+
+void CAirspaceCache::Write(std::vector<uint8_t>& out, const CAirspace& airspace) {
+  const CAirspace_Circle* circle = dynamic_cast<const CAirspace_Circle*>(&airspace);
+
+  uint8_t flags = 0;
+  flags |= airspace.Flyzone() ? flag_flyzone : 0;
+  flags |= airspace.Enabled() ? flag_enabled : 0;
+  flags |= airspace.ExceptSaturday() ? flag_except_saturday : 0;
+  flags |= airspace.ExceptSunday() ? flag_except_sunday : 0;
+
+  Put<uint8_t>(out, circle ? shape_circle : shape_area);
+  Put<uint8_t>(out, flags);
+  Put<int32_t>(out, airspace.Type());
+  PutAltitude(out, *airspace.Base());
+  PutAltitude(out, *airspace.Top());
+  PutString(out, to_utf8(airspace.Name()));
+  PutString(out, to_utf8(airspace.Comment()));
+
+  if (circle) {
+    Put(out, circle->Center().latitude);
+    Put(out, circle->Center().longitude);
+    Put(out, circle->Radius());
+  }
+
+  // geocentric coordinates are also stored, to avoid trigonometry when loading
+  const CPoint2DArray& points = airspace.GeoPoints();
+  Put<uint32_t>(out, points.size());
+  for (const CPoint2D& point : points) {
+    Put(out, point.Latitude());
+    Put(out, point.Longitude());
+    Put<int32_t>(out, point.X());
+    Put<int32_t>(out, point.Y());
+    Put<int32_t>(out, point.Z());
+  }
+}
+
+std::unique_ptr<CAirspace> CAirspaceCache::Read(const uint8_t*& p, const uint8_t* end) {
+  uint8_t shape, flags;
+  int32_t type;
+  AIRSPACE_ALT base, top;
+  if (!Get(p, end, shape) || !Get(p, end, flags) || !Get(p, end, type)
+          || !GetAltitude(p, end, base) || !GetAltitude(p, end, top)) {
+    return nullptr;
+  }
+  if (shape > shape_circle || type < 0 || type >= AIRSPACECLASSCOUNT) {
+    return nullptr;
+  }
+
+  const char* name = GetString(p, end);
+  const char* comment = GetString(p, end);
+  if (!name || !comment) {
+    return nullptr;
+  }
+
+  GeoPoint center;
+  double radius = 0;
+  if (shape == shape_circle) {
+    if (!Get(p, end, center.latitude) || !Get(p, end, center.longitude) || !Get(p, end, radius)) {
+      return nullptr;
+    }
+  }
+
+  uint32_t count;
+  constexpr size_t point_size = 2 * sizeof(double) + 3 * sizeof(int32_t);
+  if (!Get(p, end, count) || count == 0 || static_cast<size_t>(end - p) / point_size < count) {
+    return nullptr;
+  }
+  CPoint2DArray points;
+  points.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    double lat = 0, lon = 0;
+    int32_t x = 0, y = 0, z = 0;
+    Get(p, end, lat);
+    Get(p, end, lon);
+    Get(p, end, x);
+    Get(p, end, y);
+    Get(p, end, z);
+    points.emplace_back(lat, lon, x, y, z);
+  }
+
+  std::unique_ptr<CAirspace> airspace;
+  if (shape == shape_circle) {
+    airspace = std::make_unique<CAirspace_Circle>(center, radius, std::move(points));
+  } else {
+    airspace = std::make_unique<CAirspace_Area>(std::move(points));
+  }
+
+  airspace->Init(utf8_to_tstring(name).c_str(), type, base, top, flags & flag_flyzone, utf8_to_tstring(comment).c_str());
+  airspace->Enabled(flags & flag_enabled);
+  airspace->ExceptSaturday(flags & flag_except_saturday);
+  airspace->ExceptSunday(flags & flag_except_sunday);
+  return airspace;
+}
+
+bool CAirspaceCache::Load(const TCHAR* szFile, const std::string& key, CAirspaceList& airspaces, unsigned& skipped) {
+  if (key.size() != sizeof(AIRSPACE_CACHE_HEADER::Key)) {
+    return false;
+  }
+
+  const tstring path = CachePath(szFile);
+  FILE* fp = _tfopen(path.c_str(), _T("rb"));
+  if (!fp) {
+    return false;
+  }
+  std::vector<uint8_t> data;
+  if (fseek(fp, 0, SEEK_END) == 0) {
+    const long file_size = ftell(fp);
+    if (file_size > 0 && fseek(fp, 0, SEEK_SET) == 0) {
+      data.resize(file_size);
+      if (fread(data.data(), 1, data.size(), fp) != data.size()) {
+        data.clear();
+      }
+    }
+  }
+  fclose(fp);
+
+  if (data.size() < sizeof(AIRSPACE_CACHE_HEADER)) {
+    return false;
+  }
+  AIRSPACE_CACHE_HEADER header;
+  memcpy(&header, data.data(), sizeof(header));
+  if (memcmp(header.Magic, cache_magic, sizeof(cache_magic)) != 0
+          || header.ByteOrder != byte_order_mark
+          || header.DataSize != data.size() - sizeof(header)
+          || key.compare(0, key.size(), header.Key, sizeof(header.Key)) != 0) {
+    return false;
+  }
+
+  std::vector<std::unique_ptr<CAirspace>> loaded;
+  loaded.reserve(header.Count);
+  const uint8_t* p = data.data() + sizeof(header);
+  const uint8_t* end = data.data() + data.size();
+  for (uint32_t i = 0; i < header.Count; ++i) {
+    std::unique_ptr<CAirspace> airspace = Read(p, end);
+    if (!airspace) {
+      return false;
+    }
+    loaded.push_back(std::move(airspace));
+  }
+  if (p != end) {
+    return false;
+  }
+
+  for (auto& airspace : loaded) {
+    airspaces.push_back(airspace.release());
+  }
+  skipped = header.Skipped;
+  return true;
+}
+
+bool CAirspaceCache::Save(const TCHAR* szFile, const std::string& key,
+                          CAirspaceList::const_iterator first, CAirspaceList::const_iterator last, unsigned skipped) {
+  if (key.size() != sizeof(AIRSPACE_CACHE_HEADER::Key)) {
+    return false;
+  }
+
+  std::vector<uint8_t> data;
+  for (auto it = first; it != last; ++it) {
+    Write(data, **it);
+  }
+
+  AIRSPACE_CACHE_HEADER header = {};
+  std::copy(std::begin(cache_magic), std::end(cache_magic), header.Magic);
+  header.ByteOrder = byte_order_mark;
+  header.Count = std::distance(first, last);
+  header.Skipped = skipped;
+  header.DataSize = data.size();
+  std::copy(key.begin(), key.end(), header.Key);
+
+  const tstring path = CachePath(szFile);
+  FILE* fp = _tfopen(path.c_str(), _T("wb"));
+  if (!fp) {
+    return false;
+  }
+  // incomplete file is rejected by Load() : DataSize don't match file size.
+  const bool success = (fwrite(&header, sizeof(header), 1, fp) == 1)
+                    && (fwrite(data.data(), 1, data.size(), fp) == data.size());
+  return (fclose(fp) == 0) && success;
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+#include "utils/filesystem.h"
+#include "Time/PeriodClock.hpp"
+
+namespace {
+
+  std::unique_ptr<CAirspace> TestArea() {
+    CPoint2DArray points = {
+      { 45.0, 6.0 }, { 45.2, 6.1 }, { 45.1, 6.4 }, { 44.9, 6.3 }, { 45.0, 6.0 }
+    };
+    auto airspace = std::make_unique<CAirspace_Area>(std::move(points));
+    AIRSPACE_ALT base = { 0, 0, -1, abAGL };
+    AIRSPACE_ALT top = { 2895.6, 95, 0, abFL };
+    airspace->Init(_T("TEST AREA"), DANGER, base, top, false, _T("comment\n\nsecond line"));
+    airspace->Enabled(false);
+    airspace->ExceptSunday(true);
+    return airspace;
+  }
+
+  std::unique_ptr<CAirspace> TestCircle() {
+    auto airspace = std::make_unique<CAirspace_Circle>(GeoPoint(45.5, 6.5), 5000.);
+    AIRSPACE_ALT base = { 500, 0, 0, abMSL };
+    AIRSPACE_ALT top = { 1500, 0, 0, abMSL };
+    airspace->Init(_T("TEST CIRCLE"), CTR, base, top, true);
+    airspace->ExceptSaturday(true);
+    return airspace;
+  }
+
+  void CheckSame(const CAirspace& a, const CAirspace& b) {
+    CHECK_EQ(a.Hash(), b.Hash());
+    CHECK_EQ(tstring(a.Name()), tstring(b.Name()));
+    CHECK_EQ(tstring(a.Comment()), tstring(b.Comment()));
+    CHECK_EQ(a.Type(), b.Type());
+    CHECK_EQ(a.Flyzone(), b.Flyzone());
+    CHECK_EQ(a.Enabled(), b.Enabled());
+    CHECK_EQ(a.ExceptSaturday(), b.ExceptSaturday());
+    CHECK_EQ(a.ExceptSunday(), b.ExceptSunday());
+    CHECK_EQ(a.Base()->Base, b.Base()->Base);
+    CHECK_EQ(a.Base()->AGL, b.Base()->AGL);
+    CHECK_EQ(a.Top()->FL, b.Top()->FL);
+    CHECK_EQ(a.Bounds().minx, b.Bounds().minx);
+    CHECK_EQ(a.Bounds().miny, b.Bounds().miny);
+    CHECK_EQ(a.Bounds().maxx, b.Bounds().maxx);
+    CHECK_EQ(a.Bounds().maxy, b.Bounds().maxy);
+    REQUIRE_EQ(a.GeoPoints().size(), b.GeoPoints().size());
+    for (size_t i = 0; i < a.GeoPoints().size(); ++i) {
+      const CPoint2D& pa = a.GeoPoints()[i];
+      const CPoint2D& pb = b.GeoPoints()[i];
+      CHECK(pa == pb);
+      CHECK_EQ(pa.X(), pb.X());
+      CHECK_EQ(pa.Y(), pb.Y());
+      CHECK_EQ(pa.Z(), pb.Z());
+    }
+    double bearing_a, bearing_b;
+    CHECK_EQ(a.Range(6.2, 45.05, bearing_a), b.Range(6.2, 45.05, bearing_b));
+    CHECK_EQ(a.IsHorizontalInside(6.2, 45.05), b.IsHorizontalInside(6.2, 45.05));
+  }
+
+  // OpenAir "DD:MM:SS N DDD:MM:SS E"
+  std::string Coords(double lat, double lon) {
+    auto dms = [](double value, int width) {
+      const unsigned sec = std::lround(value * 3600);
+      char buffer[16];
+      snprintf(buffer, std::size(buffer), "%0*u:%02u:%02u", width, sec / 3600, (sec / 60) % 60, sec % 60);
+      return std::string(buffer);
+    };
+    return dms(lat, 2) + " N " + dms(lon, 3) + " E";
+  }
+
+} // namespace
+
+TEST_CASE("airspace cache") {
+
+  SUBCASE("serialization") {
+    std::vector<std::unique_ptr<CAirspace>> airspaces;
+    airspaces.push_back(TestArea());
+    airspaces.push_back(TestCircle());
+    for (const auto& airspace : airspaces) {
+      std::vector<uint8_t> data;
+      CAirspaceCache::Write(data, *airspace);
+
+      const uint8_t* p = data.data();
+      std::unique_ptr<CAirspace> copy = CAirspaceCache::Read(p, data.data() + data.size());
+      REQUIRE(copy);
+      CHECK_EQ(p, data.data() + data.size());
+      CHECK_EQ(dynamic_cast<CAirspace_Circle*>(copy.get()) != nullptr,
+               dynamic_cast<CAirspace_Circle*>(airspace.get()) != nullptr);
+      CheckSame(*airspace, *copy);
+
+      // truncated data
+      for (size_t size = 0; size < data.size(); size += 7) {
+        p = data.data();
+        CHECK_FALSE(CAirspaceCache::Read(p, data.data() + size));
+      }
+    }
+  }
+
+  SUBCASE("file") {
+    const TCHAR* source = _T("airspace_cache_test.txt");
+    const tstring path = CachePath(source);
+
+    FILE* fp = _tfopen(source, _T("wb"));
+    REQUIRE(fp);
+    fputs("AC D\nAN TEST\n", fp);
+    fclose(fp);
+
+    const std::string key = CAirspaceCache::Key(source);
+    CHECK_EQ(key.size(), 32);
+    CHECK(CAirspaceCache::Key(_T("airspace_cache_missing.txt")).empty());
+
+    CAirspaceList airspaces = { TestArea().release(), TestCircle().release() };
+    REQUIRE(CAirspaceCache::Save(source, key, airspaces.begin(), airspaces.end(), 3));
+
+    CAirspaceList loaded;
+    unsigned skipped = 0;
+    REQUIRE(CAirspaceCache::Load(source, key, loaded, skipped));
+    CHECK_EQ(skipped, 3);
+    REQUIRE_EQ(loaded.size(), airspaces.size());
+    for (size_t i = 0; i < loaded.size(); ++i) {
+      CheckSame(*airspaces[i], *loaded[i]);
+    }
+
+    // source changed
+    fp = _tfopen(source, _T("ab"));
+    REQUIRE(fp);
+    fputs("AL GND\n", fp);
+    fclose(fp);
+    const std::string new_key = CAirspaceCache::Key(source);
+    CHECK_NE(new_key, key);
+    CHECK_FALSE(CAirspaceCache::Load(source, new_key, loaded, skipped));
+    CHECK_EQ(loaded.size(), airspaces.size());
+
+    // truncated cache
+    std::vector<char> content(lk::filesystem::getFileSize(path.c_str()));
+    fp = _tfopen(path.c_str(), _T("rb"));
+    REQUIRE(fp);
+    REQUIRE_EQ(fread(content.data(), 1, content.size(), fp), content.size());
+    fclose(fp);
+    fp = _tfopen(path.c_str(), _T("wb"));
+    REQUIRE(fp);
+    fwrite(content.data(), 1, content.size() - 10, fp);
+    fclose(fp);
+    CHECK_FALSE(CAirspaceCache::Load(source, key, loaded, skipped));
+
+    std::for_each(airspaces.begin(), airspaces.end(), std::default_delete<CAirspace>());
+    std::for_each(loaded.begin(), loaded.end(), std::default_delete<CAirspace>());
+    lk::filesystem::deleteFile(path.c_str());
+    lk::filesystem::deleteFile(source);
+  }
+}
+
+// not run by default, use '--test-case="airspace cache benchmark" --no-skip'
+TEST_CASE("airspace cache benchmark" * doctest::skip()) {
+  /*
+   * environment :
+   *   LK_AIRSPACE_FILE  file in _Airspaces directory (default : synthetic OpenAir file)
+   */
+  const char* file_env = getenv("LK_AIRSPACE_FILE");
+  const tstring name = file_env ? utf8_to_tstring(file_env) : _T("airspace_cache_benchmark.txt");
+
+  TCHAR szFile[MAX_PATH];
+  LocalPath(szFile, _T(LKD_AIRSPACES), name.c_str());
+
+  if (!file_env) {
+    // polygons with arcs and circles, similar to country wide file
+    FILE* fp = _tfopen(szFile, _T("wb"));
+    REQUIRE(fp);
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> lat(43., 49.);
+    std::uniform_real_distribution<double> lon(0., 7.);
+    for (unsigned i = 0; i < 3000; ++i) {
+      fprintf(fp, "AC %s\nAN AREA %u\nAL %u FT\nAH FL%u\n", (i % 3) ? "R" : "D", i, (i % 10) * 500, 65 + i % 50);
+      const double y = lat(gen), x = lon(gen);
+      if (i % 4 == 0) {
+        fprintf(fp, "V X=%s\nDC %.1f\n", Coords(y, x).c_str(), 1. + i % 5);
+      } else {
+        fprintf(fp, "DP %s\nDP %s\n", Coords(y, x).c_str(), Coords(y + 0.3, x).c_str());
+        fprintf(fp, "V D=-\nV X=%s\nDB %s, %s\n",
+                Coords(y + 0.3, x + 0.2).c_str(), Coords(y + 0.3, x).c_str(), Coords(y + 0.5, x + 0.2).c_str());
+        fprintf(fp, "DP %s\nDP %s\n", Coords(y + 0.1, x + 0.9).c_str(), Coords(y, x + 0.6).c_str());
+      }
+    }
+    fclose(fp);
+  }
+
+  const tstring cache_path = CachePath(szFile);
+  lk::filesystem::deleteFile(cache_path.c_str());
+
+  TCHAR saved[NO_AS_FILES][MAX_PATH];
+  std::copy(&szAirspaceFile[0][0], &szAirspaceFile[0][0] + NO_AS_FILES * MAX_PATH, &saved[0][0]);
+  std::fill(&szAirspaceFile[0][0], &szAirspaceFile[0][0] + NO_AS_FILES * MAX_PATH, _T('\0'));
+  _tcscpy(szAirspaceFile[0], name.c_str());
+
+  CAirspaceManager& manager = CAirspaceManager::Instance();
+  manager.CloseAirspaces();
+
+  auto load = [&]() {
+    PeriodClock clock;
+    clock.Update();
+    manager.ReadAirspaces();
+    const unsigned ms = clock.Elapsed();
+    const size_t count = manager.GetAllAirspaces().size();
+    manager.CloseAirspaces();
+    return std::make_pair(ms, count);
+  };
+
+  const auto parse = load();
+  CHECK(lk::filesystem::exist(cache_path.c_str()));
+  const auto cache = load();
+  CHECK_EQ(parse.second, cache.second);
+
+  MESSAGE(parse.second << " airspaces : parse " << parse.first << "ms, cache "
+          << cache.first << "ms (" << lk::filesystem::getFileSize(cache_path.c_str()) / 1024 << "kB)");
+
+  std::copy(&saved[0][0], &saved[0][0] + NO_AS_FILES * MAX_PATH, &szAirspaceFile[0][0]);
+  lk::filesystem::deleteFile(cache_path.c_str());
+  if (!file_env) {
+    lk::filesystem::deleteFile(szFile);
+  }
+}
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   AirspaceCache.h
+ */
+
+#ifndef AIRSPACECACHE_H
+#define AIRSPACECACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <tchar.h>
+#include "LKAirspace.h"
+
+/**
+ * Binary cache of airspaces read from one OpenAir or OpenAIP file.
+ *
+ * Parsing a country wide file (arc, sector and geodesic line expansion) take seconds on slow
+ * device : after parsing, expanded polygons and attributes are saved next to the source file
+ * (<file>.xac), and loaded with a single read on next start.
+ *
+ * Cache is used only if its key match : md5 of source file, cache format version, earth model
+ * and terrain bounds if airspaces out of terrain are excluded. Otherwise source file is parsed
+ * and cache is written again.
+ *
+ * Values are stored in native byte order, cache is not meant to be shared between devices.
+ */
+class CAirspaceCache final {
+public:
+  /**
+   * @return empty string if source file can't be read.
+   */
+  static std::string Key(const TCHAR* szFile);
+
+  /**
+   * append airspaces cached for <szFile> to <airspaces>
+   * @skipped : number of airspaces excluded by terrain filter when cache was written.
+   * @return false if cache is missing, outdated or invalid, in this case <airspaces> is unchanged.
+   */
+  static bool Load(const TCHAR* szFile, const std::string& key, CAirspaceList& airspaces, unsigned& skipped);
+
+  /**
+   * write cache of airspaces [first, last) read from <szFile>
+   */
+  static bool Save(const TCHAR* szFile, const std::string& key,
+                   CAirspaceList::const_iterator first, CAirspaceList::const_iterator last, unsigned skipped);
+
+  // serialization of one airspace
+  static void Write(std::vector<uint8_t>& out, const CAirspace& airspace);
+  // @return nullptr if data are invalid
+  static std::unique_ptr<CAirspace> Read(const uint8_t*& p, const uint8_t* end);
+};
+
+#endif /* AIRSPACECACHE_H */
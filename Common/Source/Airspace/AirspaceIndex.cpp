@@ -0,0 +1,256 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   AirspaceIndex.cpp
+ */
+
+#include "options.h"
+#include "AirspaceIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+constexpr unsigned node_capacity = 16;
+
+bool IsWrapped(const rectObj& bounds) {
+  // also reject NaN.
+  return !(bounds.minx <= bounds.maxx && bounds.miny <= bounds.maxy);
+}
+
+// same as msRectOverlap()
+bool IsOverlap(const rectObj& a, const rectObj& b) {
+  return !(a.minx > b.maxx || a.maxx < b.minx || a.miny > b.maxy || a.maxy < b.miny);
+}
+
+void Merge(rectObj& a, const rectObj& b) {
+  a.minx = std::min(a.minx, b.minx);
+  a.miny = std::min(a.miny, b.miny);
+  a.maxx = std::max(a.maxx, b.maxx);
+  a.maxy = std::max(a.maxy, b.maxy);
+}
+
+/**
+ * Sort-Tile-Recursive ordering :
+ *  sort by center longitude, cut in vertical slices of `S * node_capacity` items
+ *  and sort each slice by center latitude.
+ */
+template<typename T>
+void SortTileRecursive(std::vector<T>& items) {
+  const size_t node_count = (items.size() + node_capacity - 1) / node_capacity;
+  const size_t slice_size = std::ceil(std::sqrt(node_count)) * node_capacity;
+
+  std::sort(items.begin(), items.end(), [](const T& a, const T& b) {
+    return (a.bounds.minx + a.bounds.maxx) < (b.bounds.minx + b.bounds.maxx);
+  });
+
+  for (size_t i = 0; i < items.size(); i += slice_size) {
+    auto first = std::next(items.begin(), i);
+    auto last = std::next(items.begin(), std::min(i + slice_size, items.size()));
+    std::sort(first, last, [](const T& a, const T& b) {
+      return (a.bounds.miny + a.bounds.maxy) < (b.bounds.miny + b.bounds.maxy);
+    });
+  }
+}
+
+template<typename T, typename NodeT>
+void MakeNodes(const std::vector<T>& items, std::vector<NodeT>& nodes) {
+  nodes.clear();
+  nodes.reserve((items.size() + node_capacity - 1) / node_capacity);
+  for (size_t i = 0; i < items.size(); i += node_capacity) {
+    const unsigned last = std::min(i + node_capacity, items.size());
+    NodeT node = { items[i].bounds, static_cast<unsigned>(i), last };
+    for (unsigned j = i + 1; j < last; ++j) {
+      Merge(node.bounds, items[j].bounds);
+    }
+    nodes.push_back(node);
+  }
+}
+
+} // namespace
+
+void CAirspaceIndex::Clear() {
+  _size = 0;
+  _entries.clear();
+  _levels.clear();
+  _unindexed.clear();
+}
+
+void CAirspaceIndex::Build(const std::vector<rectObj>& bounds) {
+  Clear();
+
+  _size = bounds.size();
+  _entries.reserve(_size);
+  for (unsigned i = 0; i < _size; ++i) {
+    if (IsWrapped(bounds[i])) {
+      _unindexed.push_back(i);
+    } else {
+      _entries.push_back({ bounds[i], i });
+    }
+  }
+
+  if (_entries.empty()) {
+    return;
+  }
+
+  SortTileRecursive(_entries);
+  _levels.emplace_back();
+  MakeNodes(_entries, _levels.back());
+
+  while (_levels.back().size() > 1) {
+    // reordering nodes of one level don't invalidate their children range.
+    SortTileRecursive(_levels.back());
+    NodeList parent;
+    MakeNodes(_levels.back(), parent);
+    _levels.push_back(std::move(parent));
+  }
+}
+
+void CAirspaceIndex::Query(const rectObj& bounds, std::vector<unsigned>& result) const {
+  result.clear();
+
+  if (IsWrapped(bounds)) {
+    // query across 180° meridian : no filtering
+    result.resize(_size);
+    std::iota(result.begin(), result.end(), 0U);
+    return;
+  }
+
+  result.insert(result.end(), _unindexed.begin(), _unindexed.end());
+  if (!_levels.empty()) {
+    const NodeList& root = _levels.back();
+    Query(bounds, _levels.size() - 1, 0, root.size(), result);
+  }
+  std::sort(result.begin(), result.end());
+}
+
+void CAirspaceIndex::Query(const rectObj& bounds, size_t level, unsigned first, unsigned last, std::vector<unsigned>& result) const {
+  const NodeList& nodes = _levels[level];
+  for (unsigned i = first; i < last; ++i) {
+    const Node& node = nodes[i];
+    if (!IsOverlap(node.bounds, bounds)) {
+      continue;
+    }
+    if (level > 0) {
+      Query(bounds, level - 1, node.first, node.last, result);
+    } else {
+      for (unsigned j = node.first; j < node.last; ++j) {
+        if (IsOverlap(_entries[j].bounds, bounds)) {
+          result.push_back(_entries[j].id);
+        }
+      }
+    }
+  }
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+#include "Time/PeriodClock.hpp"
+
+namespace {
+
+  // random airspace like bounds over europe, size from 1km to 300km
+  std::vector<rectObj> RandomBounds(size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> lon(-10., 30.);
+    std::uniform_real_distribution<double> lat(36., 60.);
+    std::exponential_distribution<double> size(10.);
+
+    std::vector<rectObj> bounds;
+    bounds.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+      const double x = lon(gen);
+      const double y = lat(gen);
+      const double w = std::min(0.01 + size(gen), 3.);
+      const double h = std::min(0.01 + size(gen), 3.);
+      bounds.push_back({x, y, x + w, y + h});
+    }
+    return bounds;
+  }
+
+  std::vector<unsigned> LinearQuery(const std::vector<rectObj>& items, const rectObj& bounds) {
+    std::vector<unsigned> result;
+    for (unsigned i = 0; i < items.size(); ++i) {
+      if (IsOverlap(items[i], bounds)) {
+        result.push_back(i);
+      }
+    }
+    return result;
+  }
+
+} // namespace
+
+TEST_CASE("airspace index") {
+
+  SUBCASE("same result as linear search") {
+    const std::vector<rectObj> items = RandomBounds(5000, 1);
+    CAirspaceIndex index;
+    index.Build(items);
+    CHECK_EQ(index.size(), items.size());
+
+    std::vector<unsigned> result;
+    for (const rectObj& query : RandomBounds(500, 2)) {
+      index.Query(query, result);
+      CHECK_EQ(result, LinearQuery(items, query));
+    }
+    // point query
+    index.Query({ 10., 45., 10., 45. }, result);
+    CHECK_EQ(result, LinearQuery(items, { 10., 45., 10., 45. }));
+  }
+
+  SUBCASE("wrapped bounds") {
+    std::vector<rectObj> items = RandomBounds(100, 3);
+    items.push_back({ 179., 10., -179., 11. }); // across 180° meridian
+    CAirspaceIndex index;
+    index.Build(items);
+
+    std::vector<unsigned> result;
+    index.Query({ 0., 0., 1., 1. }, result);
+    CHECK(std::find(result.begin(), result.end(), 100U) != result.end());
+
+    index.Query({ 170., 0., -170., 1. }, result);
+    CHECK_EQ(result.size(), items.size());
+  }
+
+  SUBCASE("empty") {
+    CAirspaceIndex index;
+    index.Build({});
+    std::vector<unsigned> result = { 1, 2 };
+    index.Query({ 0., 0., 1., 1. }, result);
+    CHECK(result.empty());
+  }
+}
+
+// not run by default, use '--test-case="airspace index benchmark" --no-skip'
+TEST_CASE("airspace index benchmark" * doctest::skip()) {
+  const std::vector<rectObj> items = RandomBounds(20000, 1);
+  const std::vector<rectObj> queries = RandomBounds(2000, 2);
+
+  PeriodClock clock;
+  clock.Update();
+  CAirspaceIndex index;
+  index.Build(items);
+  MESSAGE("build : " << clock.ElapsedUpdate() << "ms");
+
+  size_t count_linear = 0;
+  for (const rectObj& query : queries) {
+    count_linear += LinearQuery(items, query).size();
+  }
+  MESSAGE("linear : " << clock.ElapsedUpdate() << "ms");
+
+  size_t count_index = 0;
+  std::vector<unsigned> result;
+  for (const rectObj& query : queries) {
+    index.Query(query, result);
+    count_index += result.size();
+  }
+  MESSAGE("index : " << clock.ElapsedUpdate() << "ms");
+
+  CHECK_EQ(count_linear, count_index);
+}
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   AirspaceIndex.h
+ */
+
+#ifndef AIRSPACEINDEX_H
+#define AIRSPACEINDEX_H
+
+#include <cstddef>
+#include <vector>
+#include "Topology/shapelib/mapprimitive.h"
+
+/**
+ * Static bulk loaded R-tree (Sort-Tile-Recursive packing) over airspace bounds.
+ *
+ * Items are identified by their position in the list used to build the index,
+ * queries return these positions sorted, so caller can keep original list order
+ * (airspaces are sorted by top altitude for drawing).
+ *
+ * Result of a query is a superset of items for which msRectOverlap() is true :
+ *  - items with bounds wrapped across 180° meridian (minx > maxx) are always returned.
+ *  - an empty index or a wrapped query bounds return all items.
+ * Caller must still apply it's own test on each returned item.
+ *
+ * Index is immutable after Build(), it must be rebuilt each time the airspace list
+ * change (load, sort, close).
+ */
+class CAirspaceIndex final {
+public:
+  void Build(const std::vector<rectObj>& bounds);
+  void Clear();
+
+  /**
+   * @param bounds : area to search
+   * @param result : position of all candidates, sorted ascending.
+   */
+  void Query(const rectObj& bounds, std::vector<unsigned>& result) const;
+
+  size_t size() const { return _size; }
+
+private:
+  struct Entry {
+    rectObj bounds;
+    unsigned id;
+  };
+
+  struct Node {
+    rectObj bounds;
+    unsigned first; // first child in lower level ( or in _entries for leaf )
+    unsigned last; // last child + 1
+  };
+
+  using NodeList = std::vector<Node>;
+
+  void Query(const rectObj& bounds, size_t level, unsigned first, unsigned last, std::vector<unsigned>& result) const;
+
+  size_t _size = 0;
+  std::vector<Entry> _entries; // leaf entries in STR order
+  std::vector<NodeList> _levels; // _levels[0] are leaf nodes, _levels.back() is root level.
+  std::vector<unsigned> _unindexed; // wrapped items, always candidate.
+};
+
+#endif /* AIRSPACEINDEX_H */
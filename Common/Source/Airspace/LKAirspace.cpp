@@ -7,6 +7,7 @@
 
 #include "externs.h"
 #include "LKAirspace.h"
+#include "AirspaceCache.h"
 #include "RasterTerrain.h"
 #include "LKProfiles.h"
 #include "Dialogs.h"
@@ -32,6 +33,8 @@
 #include "utils/printf.h"
 #include "Library/TimeFunctions.h"
 #include "Baro.h"
+#include "Time/PeriodClock.hpp"
+#include "utils/profiler.h"
 
 using xml_document = rapidxml::xml_document<char>;
 using xml_attribute = rapidxml::xml_attribute<char>;
@@ -163,11 +166,8 @@ void CAirspaceBase::AirspaceAGLLookup(double av_lat, double av_lon, double *base
     double top_out = _top.Altitude;
 
     if (((_base.Base == abAGL) || (_top.Base == abAGL))) {
-        RasterTerrain::Lock();
         // want most accurate rounding here
-        RasterTerrain::SetTerrainRounding(0, 0);
-        double th = RasterTerrain::GetTerrainHeight(av_lat, av_lon);
-        RasterTerrain::Unlock();
+        double th = RasterTerrain::GetSampler(0, 0).GetField(av_lat, av_lon);
 
         if (th == TERRAIN_INVALID) th = 0; //@ 101027 FIX
         // 101027 We still use 0 altitude for no terrain, what else can we do..
@@ -801,6 +801,22 @@ CAirspace_Circle::CAirspace_Circle(const GeoPoint &Center, const double Radius)
     AirspaceAGLLookup(Center.latitude, Center.longitude, &_base.Altitude, &_top.Altitude);
 }
 
+CAirspace_Circle::CAirspace_Circle(const GeoPoint &Center, double Radius, CPoint2DArray &&Points)
+    : CAirspace(std::forward<CPoint2DArray>(Points)), _center(Center), _radius(Radius)
+{
+    _bounds.minx = _center.longitude;
+    _bounds.maxx = _center.longitude;
+    _bounds.miny = _center.latitude;
+    _bounds.maxy = _center.latitude;
+
+    for (const CPoint2D& pt : _geopoints) {
+        _bounds.minx = std::min(pt.Longitude(), _bounds.minx);
+        _bounds.maxx = std::max(pt.Longitude(), _bounds.maxx);
+        _bounds.miny = std::min(pt.Latitude(), _bounds.miny);
+        _bounds.maxy = std::max(pt.Latitude(), _bounds.maxy);
+    }
+}
+
 // Dumps object instance to Runtime.log
 
 void CAirspace_Circle::Dump() const {
@@ -869,13 +885,48 @@ static void CalculateScreenPolygon(const ScreenProjection &_Proj, const CPoint2D
     }
 }
 
+// same as above, for simplified polygon : <lod> are indexes of <geopoints>
+template<typename ScreenPointList>
+static void CalculateScreenPolygon(const ScreenProjection &_Proj, const CPoint2DArray& geopoints, const std::vector<unsigned>& lod, ScreenPointList& screenpoints) {
+    using ScreenPoint = typename ScreenPointList::value_type;
+
+    const GeoToScreen<ScreenPoint> ToScreen(_Proj);
+
+    screenpoints.reserve(lod.size());
+    std::transform(
+            std::begin(lod), std::end(lod),
+            std::back_inserter(screenpoints),
+            [&](unsigned idx) {
+                return ToScreen(geopoints[idx]);
+            });
+
+    // close polygon if needed
+    if(screenpoints.front() != screenpoints.back()) {
+        screenpoints.push_back(screenpoints.front());
+    }
+}
+
+template<typename ScreenPointList>
+static void CalculateScreenPolygon(const ScreenProjection &_Proj, const CPoint2DArray& geopoints, const std::vector<unsigned>* lod, ScreenPointList& screenpoints) {
+    if (lod) {
+        CalculateScreenPolygon(_Proj, geopoints, *lod, screenpoints);
+    } else {
+        CalculateScreenPolygon(_Proj, geopoints, screenpoints);
+    }
+}
+
+void CAirspace::BuildLOD() {
+    if (_geopoints.size() >= CPolygonLOD::min_points) {
+        _lod = std::make_unique<CPolygonLOD>(_geopoints);
+    }
+}
+
 
 // Calculate screen coordinates for drawing
-void CAirspace::CalculateScreenPosition(const rectObj &screenbounds_latlon, const int iAirspaceMode[], const int iAirspaceBrush[], const RECT& rcDraw, const ScreenProjection& _Proj) {
+void CAirspace::CalculateScreenPosition(const rectObj &screenbounds_latlon, const int iAirspaceMode[], const int iAirspaceBrush[], const RECT& rcDraw, const ScreenProjection& _Proj, double pixel_size, double alt, double alt_agl) {
 
     /** TODO 
      *   check map projection change
-     *   move CAirspaceManager::Instance().CheckAirspaceAltitude() outside draw function
      */
     
     
@@ -905,8 +956,7 @@ void CAirspace::CalculateScreenPosition(const rectObj &screenbounds_latlon, cons
         is_visible = msRectOverlap(&_bounds, &screenbounds_latlon);
     }
     if(is_visible) { // no need to check Altitude if airspace is not visible
-        // TODO : "CheckAirspaceAltitude() lock Flight data for altitude : to slow, need to change"
-        is_visible = CAirspaceManager::CheckAirspaceAltitude(_base, _top);
+        is_visible = CAirspaceManager::CheckAirspaceAltitude(_base, _top, alt, alt_agl);
     }
     
     if(is_visible) { 
@@ -915,12 +965,15 @@ void CAirspace::CalculateScreenPosition(const rectObj &screenbounds_latlon, cons
         _screenpoints_clipped.clear();
         bool need_clipping = !msRectContained(&_bounds, &screenbounds_latlon);
 
+        // simplified polygon if error is less than one pixel
+        const std::vector<unsigned>* lod = _lod ? _lod->Select(pixel_size) : nullptr;
+
         if(!need_clipping) {
             // clipping is not needed : calculate screen position directly into _screenpoints_clipped
-            CalculateScreenPolygon(_Proj, _geopoints, _screenpoints_clipped);
+            CalculateScreenPolygon(_Proj, _geopoints, lod, _screenpoints_clipped);
         } else {
             // clipping is needed : calculate screen position into temp array
-            CalculateScreenPolygon(_Proj, _geopoints, _screenpoints);
+            CalculateScreenPolygon(_Proj, _geopoints, lod, _screenpoints);
 
             PixelRect MaxRect(rcDraw);
             MaxRect.Grow(300); // add space for inner airspace border, avoid artefact on screen border.
@@ -995,6 +1048,28 @@ CAirspace_Area::CAirspace_Area(CPoint2DArray &&Area_Points)
     AirspaceAGLLookup((_bounds.miny + _bounds.maxy) / 2.0, (_bounds.minx + _bounds.maxx) / 2.0, &_base.Altitude, &_top.Altitude);
 }
 
+CAirspace_Area::~CAirspace_Area() {
+    delete _edge_index.load();
+}
+
+const CPolygonEdgeIndex* CAirspace_Area::EdgeIndex() const {
+    if (_geopoints.size() < CPolygonEdgeIndex::min_points) {
+        return nullptr;
+    }
+    const CPolygonEdgeIndex* index = _edge_index.load(std::memory_order_acquire);
+    if (!index) {
+        // building is rare, one lock shared by all airspaces is enough.
+        static Mutex build_mutex;
+        ScopeLock lock(build_mutex);
+        index = _edge_index.load(std::memory_order_relaxed);
+        if (!index) {
+            index = new CPolygonEdgeIndex(_geopoints);
+            _edge_index.store(index, std::memory_order_release);
+        }
+    }
+    return index;
+}
+
 
 // Dumps object instance to Runtime.log
 void CAirspace_Area::Dump() const {
@@ -1031,18 +1106,7 @@ std::string CAirspace_Area::Hash() const {
 //    a Point is defined by its coordinates {int x, y;}
 //===================================================================
 
-// isLeft(): tests if a point is Left|On|Right of an infinite line.
-//    Input:  three points P0, P1, and P2
-//    Return: >0 for P2 left of the line through P0 and P1
-//            =0 for P2 on the line
-//            <0 for P2 right of the line
-//    See: the January 2001 Algorithm "Area of 2D and 3D Triangles and Polygons"
-
-inline static float
-isLeft(const CPoint2D &P0, const CPoint2D &P1, const double &longitude, const double &latitude) {
-    return ( (P1.Longitude() - P0.Longitude()) * (latitude - P0.Latitude())
-            - (longitude - P0.Longitude()) * (P1.Latitude() - P0.Latitude()));
-}
+// isLeft() : see PolygonEdgeIndex.h
 
 // wn_PnPoly(): winding number test for a point in a polygon
 //      Input:   P = a point,
@@ -1050,6 +1114,12 @@ isLeft(const CPoint2D &P0, const CPoint2D &P1, const double &longitude, const do
 //      Return:  wn = the winding number (=0 only if P is outside V[])
 
 int CAirspace_Area::wn_PnPoly(const double &longitude, const double &latitude) const {
+    const CPolygonEdgeIndex* index = EdgeIndex();
+    if (index) {
+        // only visit edges crossing the latitude of the point
+        return index->WindingNumber(_geopoints, longitude, latitude);
+    }
+
     int wn = 0; // the winding number counter
 
     // loop through all edges of the polygon
@@ -1057,15 +1127,7 @@ int CAirspace_Area::wn_PnPoly(const double &longitude, const double &latitude) c
     CPoint2DArray::const_iterator itnext = it;
     ++itnext;
     for (int i = 0; i < ((int) _geopoints.size() - 1); ++i, ++it, ++itnext) {
-        if (it->Latitude() <= latitude) { // start y <= P.Latitude
-            if (itnext->Latitude() > latitude) // an upward crossing
-                if (isLeft(*it, *itnext, longitude, latitude) > 0) // P left of edge
-                    ++wn; // have a valid up intersect
-        } else { // start y > P.Latitude (no test needed)
-            if (itnext->Latitude() <= latitude) // a downward crossing
-                if (isLeft(*it, *itnext, longitude, latitude) < 0) // P right of edge
-                    --wn; // have a valid down intersect
-        }
+        wn += WindingEdge(*it, *itnext, longitude, latitude);
     }
     return wn;
 }
@@ -1103,31 +1165,31 @@ double CAirspace_Area::Range(const double &longitude, const double &latitude, do
 
     int wn = 0; // the winding number counter
 
-    CPoint2DArray::const_iterator it = _geopoints.begin();
-    CPoint2DArray::const_iterator itnext = it;
-    ++itnext;
+    const CPolygonEdgeIndex* index = EdgeIndex();
+    if (index) {
+        // only visit edges crossing latitude and edges near enough to be the nearest one.
+        wn = index->WindingNumber(_geopoints, longitude, latitude);
+        i = index->NearestEdge(_geopoints, p3, dist_candidate);
+        p3.DistanceXYZ(_geopoints[i], _geopoints[i + 1], &xc, &yc, &zc);
+    } else {
+        CPoint2DArray::const_iterator it = _geopoints.begin();
+        CPoint2DArray::const_iterator itnext = it;
+        ++itnext;
 
-    for (i = 0; i < _geopoints.size() - 1; ++i) {
-        dist = p3.DistanceXYZ(*it, *itnext, &x, &y, &z);
+        for (i = 0; i < _geopoints.size() - 1; ++i) {
+            dist = p3.DistanceXYZ(*it, *itnext, &x, &y, &z);
 
-        if (it->Latitude() <= latitude) { // start y <= P.Latitude
-            if (itnext->Latitude() > latitude) // an upward crossing
-                if (isLeft(*it, *itnext, longitude, latitude) > 0) // P left of edge
-                    ++wn; // have a valid up intersect
-        } else { // start y > P.Latitude (no test needed)
-            if (itnext->Latitude() <= latitude) // a downward crossing
-                if (isLeft(*it, *itnext, longitude, latitude) < 0) // P right of edge
-                    --wn; // have a valid down intersect
-        }
+            wn += WindingEdge(*it, *itnext, longitude, latitude);
 
-        if ((dist < dist_candidate) || (i == 0)) {
-            dist_candidate = dist;
-            xc = x;
-            yc = y;
-            zc = z;
+            if ((dist < dist_candidate) || (i == 0)) {
+                dist_candidate = dist;
+                xc = x;
+                yc = y;
+                zc = z;
+            }
+            ++it;
+            ++itnext;
         }
-        ++it;
-        ++itnext;
     }
 
     CPoint2D p4(xc, yc, zc);
@@ -1195,15 +1257,25 @@ bool CAirspaceManager::CheckAirspaceAltitude(const AIRSPACE_ALT &Base, const AIR
         return false;
     }
 
-    double basealt;
-    double topalt;
-    bool base_is_sfc = false;
-
     LockFlightData();
     double alt = CALCULATED_INFO.NavAltitude;
     double alt_agl = CALCULATED_INFO.TerrainAlt;
     UnlockFlightData();
 
+    return CheckAirspaceAltitude(Base, Top, alt, alt_agl);
+}
+
+bool CAirspaceManager::CheckAirspaceAltitude(const AIRSPACE_ALT &Base, const AIRSPACE_ALT &Top, double alt, double alt_agl) {
+    if (AltitudeMode == ALLON) {
+        return true;
+    } else if (AltitudeMode == ALLOFF) {
+        return false;
+    }
+
+    double basealt;
+    double topalt;
+    bool base_is_sfc = false;
+
     if (Base.Base != abAGL) {
         basealt = Base.Altitude;
     } else {
@@ -2391,6 +2463,117 @@ bool CAirspaceManager::FillAirspacesFromOpenAIP(const TCHAR* szFile) {
     return true;
 }
 
+void CAirspaceManager::RebuildIndex() {
+    ScopeLock guard(_csairspaces);
+
+    PeriodClock clock;
+    clock.Update();
+
+    std::vector<rectObj> bounds;
+    bounds.reserve(_airspaces.size());
+    for (const CAirspace* pAsp : _airspaces) {
+        bounds.push_back(pAsp->Bounds());
+    }
+    _airspaces_index.Build(bounds);
+
+    StartupStore(TEXT(". Airspace index built for %u airspaces (%dms)"), (unsigned)_airspaces.size(), clock.Elapsed());
+}
+
+void CAirspaceManager::BuildLOD() {
+    ScopeLock guard(_csairspaces);
+
+    PeriodClock clock;
+    clock.Update();
+
+    size_t lod_count = 0;
+    for (CAirspace* pAsp : _airspaces) {
+        pAsp->BuildLOD();
+        if (pAsp->HasLOD()) {
+            ++lod_count;
+        }
+    }
+
+    StartupStore(TEXT(". Airspace level of detail built for %u airspaces (%dms)"), (unsigned)lod_count, clock.Elapsed());
+}
+
+template<typename Function>
+void CAirspaceManager::ForEachAirspaceInBounds(const rectObj& bounds, Function&& func) const {
+    LKASSERT(_airspaces_index.size() == _airspaces.size());
+    if (_airspaces_index.size() != _airspaces.size()) {
+        // index not up to date, linear scan.
+        std::for_each(_airspaces.begin(), _airspaces.end(), std::forward<Function>(func));
+        return;
+    }
+
+    std::vector<unsigned> candidates;
+    _airspaces_index.Query(bounds, candidates);
+    for (unsigned i : candidates) {
+        func(_airspaces[i]);
+    }
+}
+
+template<typename Function>
+void CAirspaceManager::ForEachAirspaceInRange(double lon, double lat, double range, Function&& func) const {
+    // 1° of latitude is never shorter than 110.5km, 10% margin cover difference between
+    // distance used by CAirspace::Range() and geodesic distance.
+    const double dlat = range * 1.1 / 110500.;
+    const double maxlat = std::fabs(lat) + dlat;
+    if (maxlat < 89.) {
+        const double dlon = dlat / std::cos(maxlat * DEG_TO_RAD);
+        const rectObj bounds = { lon - dlon, lat - dlat, lon + dlon, lat + dlat };
+        if (bounds.minx >= -180. && bounds.maxx <= 180.) {
+            ForEachAirspaceInBounds(bounds, std::forward<Function>(func));
+            return;
+        }
+    }
+    // near pole or 180° meridian : linear scan.
+    std::for_each(_airspaces.begin(), _airspaces.end(), std::forward<Function>(func));
+}
+
+bool CAirspaceManager::ReadAirspacesFile(const TCHAR* szFile, bool (CAirspaceManager::*Fill)(const TCHAR*)) {
+    PeriodClock clock;
+    clock.Update();
+
+    const std::string cache_key = CAirspaceCache::Key(szFile);
+    if (!cache_key.empty()) {
+        CAirspaceList airspaces;
+        unsigned skipped = 0;
+        if (CAirspaceCache::Load(szFile, cache_key, airspaces, skipped)) {
+            // flight level altitudes depend on current QNH
+            for (CAirspace* pAsp : airspaces) {
+                pAsp->QnhChangeNotify();
+            }
+            { // Begin Lock
+                ScopeLock guard(_csairspaces);
+                _airspaces.insert(_airspaces.end(), airspaces.begin(), airspaces.end());
+            } // End Lock
+            OutsideAirspaceCnt += skipped;
+            StartupStore(TEXT(". %u airspaces loaded from cache (%dms)"), (unsigned)airspaces.size(), clock.Elapsed());
+            return true;
+        }
+    }
+
+    size_t first = 0;
+    { // Begin Lock
+        ScopeLock guard(_csairspaces);
+        first = _airspaces.size();
+    } // End Lock
+    const unsigned outside = OutsideAirspaceCnt;
+
+    if (!(this->*Fill)(szFile)) {
+        return false;
+    }
+    StartupStore(TEXT(". Airspace file parsed (%dms)"), clock.Elapsed());
+
+    if (!cache_key.empty()) {
+        ScopeLock guard(_csairspaces);
+        if (!CAirspaceCache::Save(szFile, cache_key, std::next(_airspaces.cbegin(), first), _airspaces.cend(), OutsideAirspaceCnt - outside)) {
+            StartupStore(TEXT("... Failed to write airspace cache of %s"), szFile);
+        }
+    }
+    return true;
+}
+
 void CAirspaceManager::ReadAirspaces() {
     int fileCounter=0;
   //  for (TCHAR* airSpaceFile : {szAirspaceFile, szAdditionalAirspaceFile}) {
@@ -2406,9 +2589,9 @@ void CAirspaceManager::ReadAirspaces() {
 
             if(wextension != nullptr) { // Check if we have a file extension
                 if(_tcsicmp(wextension,_T(".txt"))==0) { // TXT file: should be an OpenAir
-                    readOk = FillAirspacesFromOpenAir(szFile);
+                    readOk = ReadAirspacesFile(szFile, &CAirspaceManager::FillAirspacesFromOpenAir);
                 } else if(_tcsicmp(wextension,_T(".aip"))==0) { // AIP file: should be an OpenAIP
-                    readOk=FillAirspacesFromOpenAIP(szFile);
+                    readOk = ReadAirspacesFile(szFile, &CAirspaceManager::FillAirspacesFromOpenAIP);
                 }  else {
                     StartupStore(TEXT("... Unknown airspace file %d extension: %s%s"), fileCounter, wextension, NEWLINE);
                 }
@@ -2433,6 +2616,8 @@ void CAirspaceManager::ReadAirspaces() {
         ScopeLock guard(_csairspaces);
         last_day_of_week = ~0;
         airspaces_count = _airspaces.size();
+        BuildLOD();
+        RebuildIndex();
     } //
 
     if((OutsideAirspaceCnt > 0) && ( WaypointsOutOfRange > 1) )
@@ -2477,6 +2662,7 @@ void CAirspaceManager::CloseAirspaces() {
     _airspaces_near.clear();
     _airspaces_of_interest.clear();
     _airspaces_page24.clear();
+    _airspaces_index.Clear();
     std::for_each(_airspaces.begin(), _airspaces.end(), std::default_delete<CAirspace>());
     _airspaces.clear();
     StartupStore(TEXT(". CloseLKAirspace%s"), NEWLINE);
@@ -2499,6 +2685,16 @@ int CAirspaceManager::ScanAirspaceLineList(const double (&lats)[AIRSPACE_SCANSIZ
     unsigned int iSelAS = 0; // current selected airspace for processing
     unsigned int i; // loop variable
     CAirspaceList::const_iterator it;
+
+    // scan line bounds : airspace with bounds outside can't be crossed by scan line.
+    rectObj scan_bounds = { lons[0], lats[0], lons[0], lats[0] };
+    for (i = 1; i < AIRSPACE_SCANSIZE_X; i++) {
+        scan_bounds.minx = std::min(lons[i], scan_bounds.minx);
+        scan_bounds.maxx = std::max(lons[i], scan_bounds.maxx);
+        scan_bounds.miny = std::min(lats[i], scan_bounds.miny);
+        scan_bounds.maxy = std::max(lats[i], scan_bounds.maxy);
+    }
+
     ScopeLock guard(_csairspaces);
 
     airspacetype[0].psAS = NULL;
@@ -2506,6 +2702,12 @@ int CAirspaceManager::ScanAirspaceLineList(const double (&lats)[AIRSPACE_SCANSIZ
         LKASSERT((*it)->Type() < AIRSPACECLASSCOUNT);
         LKASSERT((*it)->Type() >= 0);
 
+        const rectObj& asp_bounds = (*it)->Bounds();
+        if ((asp_bounds.minx <= asp_bounds.maxx) && (msRectOverlap(&scan_bounds, &asp_bounds) != MS_TRUE)) {
+            // not wrapped across 180° meridian and outside of scan line
+            continue;
+        }
+
         if ((CheckAirspaceAltitude(*(*it)->Base(), *(*it)->Top()) == TRUE)&& (iNoFoundAS < iMaxNoAs - 1) &&
                 ((MapWindow::iAirspaceMode[(*it)->Type()] % 2) > 0)) {
             for (i = 0; i < AIRSPACE_SCANSIZE_X; i++) {
@@ -2644,70 +2846,66 @@ CAirspace* CAirspaceManager::FindNearestAirspace(const double &longitude, const
     double nearestd = 100000; // 100km
     double nearestb = 0;
 
-    bool iswarn;
-    bool isdisplay;
-    bool altok;
-    double bearing;
     CAirspace *found = NULL;
-    int type;
-    double dist;
+    bool inside = false;
     double calc_terrainalt;
 
     LockFlightData();
     calc_terrainalt = CALCULATED_INFO.TerrainAlt;
     UnlockFlightData();
 
-    CAirspaceList::const_iterator it;
     ScopeLock guard(_csairspaces);
 
-    for (it = _airspaces.begin(); it != _airspaces.end(); ++it) {
-        if ((*it)->Enabled()) {
-            type = (*it)->Type();
+    ForEachAirspaceInRange(longitude, latitude, nearestd, [&](CAirspace* pAsp) {
+        if (inside) {
+            // no need to continue search, inside
+            return;
+        }
+        if (pAsp->Enabled()) {
+            const int type = pAsp->Type();
             //TODO check index
-            iswarn = (MapWindow::iAirspaceMode[type] >= 2);
-            isdisplay = ((MapWindow::iAirspaceMode[type] % 2) > 0);
+            const bool iswarn = (MapWindow::iAirspaceMode[type] >= 2);
+            const bool isdisplay = ((MapWindow::iAirspaceMode[type] % 2) > 0);
 
             if (!isdisplay || !iswarn) {
                 // don't want warnings for this one
-                continue;
+                return;
             }
 
+            bool altok;
             if (height) {
                 double basealt;
                 double topalt;
                 bool base_is_sfc = false;
 
-                if ((*it)->Base()->Base != abAGL) {
-                    basealt = (*it)->Base()->Altitude;
+                if (pAsp->Base()->Base != abAGL) {
+                    basealt = pAsp->Base()->Altitude;
                 } else {
-                    basealt = (*it)->Base()->AGL + calc_terrainalt;
-                    if ((*it)->Base()->AGL <= 0) base_is_sfc = true;
+                    basealt = pAsp->Base()->AGL + calc_terrainalt;
+                    if (pAsp->Base()->AGL <= 0) base_is_sfc = true;
                 }
-                if ((*it)->Top()->Base != abAGL) {
-                    topalt = (*it)->Top()->Altitude;
+                if (pAsp->Top()->Base != abAGL) {
+                    topalt = pAsp->Top()->Altitude;
                 } else {
-                    topalt = (*it)->Top()->AGL + calc_terrainalt;
+                    topalt = pAsp->Top()->AGL + calc_terrainalt;
                 }
                 altok = (((*height > basealt) || base_is_sfc) && (*height < topalt));
             } else {
-                altok = CheckAirspaceAltitude(*(*it)->Base(), *(*it)->Top()) == TRUE;
+                altok = CheckAirspaceAltitude(*pAsp->Base(), *pAsp->Top()) == TRUE;
             }
             if (altok) {
-
-                dist = (*it)->Range(longitude, latitude, bearing);
+                double bearing;
+                const double dist = pAsp->Range(longitude, latitude, bearing);
 
                 if (dist < nearestd) {
                     nearestd = dist;
                     nearestb = bearing;
-                    found = *it;
-                    if (dist < 0) {
-                        // no need to continue search, inside
-                        break; //for
-                    }
+                    found = pAsp;
+                    inside = (dist < 0);
                 }
             }
         } // enabled
-    } //for
+    });
 
     if (nearestdistance) *nearestdistance = nearestd;
     if (nearestbearing) *nearestbearing = nearestb;
@@ -2732,6 +2930,7 @@ void CAirspaceManager::SortAirspaces(void) {
     // Sort by top altitude for drawing
     ScopeLock guard(_csairspaces);
     std::sort(_airspaces.begin(), _airspaces.end(), airspace_sorter());
+    RebuildIndex();
 }
 
 bool CAirspaceManager::ValidAirspaces(void) const {
@@ -2927,60 +3126,78 @@ void CAirspaceManager::AirspaceWarning(NMEA_INFO *Basic, DERIVED_INFO *Calculate
 
 CAirspaceList CAirspaceManager::GetVisibleAirspacesAtPoint(const double &lon, const double &lat) const {
     CAirspaceList res;
-    CAirspaceList::const_iterator it;
+    const rectObj point = { lon, lat, lon, lat };
     ScopeLock guard(_csairspaces);
-    for (it = _airspaces.begin(); it != _airspaces.end(); ++it) {
-        if ((*it)->DrawStyle()) {
-            if ((*it)->IsHorizontalInside(lon, lat)) res.push_back(*it);
+    ForEachAirspaceInBounds(point, [&](CAirspace* pAsp) {
+        if (pAsp->DrawStyle()) {
+            if (pAsp->IsHorizontalInside(lon, lat)) res.push_back(pAsp);
         }
-    }
+    });
     return res;
 }
 
 CAirspaceList CAirspaceManager::GetNearAirspacesAtPoint(const double &lon, const double &lat, long searchrange) const {
     int HorDist, Bearing, VertDist;
     CAirspaceList res;
-    CAirspaceList::const_iterator it;
     ScopeLock guard(_csairspaces);
-    for (it = _airspaces.begin(); it != _airspaces.end(); ++it) {
-        if ((*it)->DrawStyle() || (((*it)->Top()->Base == abMSL) && ((*it)->Top()->Altitude <= 0))) 
+    ForEachAirspaceInRange(lon, lat, searchrange, [&](CAirspace* pAsp) {
+        if (pAsp->DrawStyle() || ((pAsp->Top()->Base == abMSL) && (pAsp->Top()->Altitude <= 0))) 
         {
-            (*it)->CalculateDistance(&HorDist, &Bearing, &VertDist, lon, lat);
+            pAsp->CalculateDistance(&HorDist, &Bearing, &VertDist, lon, lat);
             if (HorDist < searchrange) {
-                res.push_back(*it);
+                res.push_back(pAsp);
             }
         }
-    }
+    });
     return res;
 }
 
 void CAirspaceManager::SetFarVisible(const rectObj &bounds_active) {
-    CAirspaceList::iterator it;
 #if DEBUG_NEAR_POINTS
     int iCnt = 0;
     StartupStore(_T("... enter SetFarVisible\n"));
 #endif
     ScopeLock guard(_csairspaces);
     _airspaces_near.clear();
-    for (it = _airspaces.begin(); it != _airspaces.end(); ++it) {
+    ForEachAirspaceInBounds(bounds_active, [&](CAirspace* pAsp) {
         // Check if airspace overlaps given bounds
-        if ((msRectOverlap(&bounds_active, &((*it)->Bounds())) == MS_TRUE)
+        if ((msRectOverlap(&bounds_active, &(pAsp->Bounds())) == MS_TRUE)
                 ) {
-            _airspaces_near.push_back(*it);
+            _airspaces_near.push_back(pAsp);
 #if DEBUG_NEAR_POINTS
             iCnt++;
 #endif
         }
-    }
+    });
 #if DEBUG_NEAR_POINTS
     StartupStore(_T("... leaving SetFarVisible %i airspaces\n"), iCnt);
 #endif
 }
 
 void CAirspaceManager::CalculateScreenPositionsAirspace(const rectObj &screenbounds_latlon, const int iAirspaceMode[], const int iAirspaceBrush[], const RECT& rcDraw, const ScreenProjection& _Proj) {
+    profiler::scope timing(profiler::AirspaceScreenPosition);
+
+    const double pixel_size = _Proj.GetPixelSize();
+
+    // altitude is read once for all airspaces, instead of locking flight data for each one.
+    LockFlightData();
+    const double alt = CALCULATED_INFO.NavAltitude;
+    const double alt_agl = CALCULATED_INFO.TerrainAlt;
+    UnlockFlightData();
+
     ScopeLock guard(_csairspaces);
-    for (auto asp : _airspaces_near) {
-        asp->CalculateScreenPosition(screenbounds_latlon, iAirspaceMode, iAirspaceBrush, rcDraw, _Proj);
+
+    /*
+     * each airspace only write it's own screen points and draw style, so airspaces can be
+     * processed in any order by any thread : result are the same than serial loop.
+     * size of polygon is very different from one airspace to another, so use dynamic schedule.
+     */
+    const int count = _airspaces_near.size();
+#if defined(_OPENMP)
+    #pragma omp parallel for schedule(dynamic, 4) if(count > 8)
+#endif
+    for (int i = 0; i < count; ++i) {
+        _airspaces_near[i]->CalculateScreenPosition(screenbounds_latlon, iAirspaceMode, iAirspaceBrush, rcDraw, _Proj, pixel_size, alt, alt_agl);
     }
 }
 
@@ -3439,9 +3656,9 @@ void CAirspaceManager::SelectAirspacesForPage24(const double latitude, const dou
 
     // Select nearest ones (based on bounds)
     _airspaces_page24.clear();
-    for (CAirspaceList::iterator it = _airspaces.begin(); it != _airspaces.end(); ++it) {
-        if (msRectOverlap(&bounds, &(*it)->Bounds()) == MS_TRUE) _airspaces_page24.push_back(*it);
-    }
+    ForEachAirspaceInBounds(bounds, [&](CAirspace* pAsp) {
+        if (msRectOverlap(&bounds, &pAsp->Bounds()) == MS_TRUE) _airspaces_page24.push_back(pAsp);
+    });
 }
 
 void CAirspaceManager::CalculateDistancesForPage24() {
@@ -11,10 +11,15 @@
 #include <deque>
 #include <list>
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <zzip/zzip.h>
 #include "Screen/LKSurface.h"
 #include "Geographic/GeoPoint.h"
 #include "Airspace.h"
+#include "AirspaceIndex.h"
+#include "PolygonEdgeIndex.h"
+#include "PolygonLOD.h"
 
 class ScreenProjection;
 class MD5;
@@ -165,7 +170,7 @@ public:
     _except_saturday = b;
   }
   
-  bool ExceptSaturday() {
+  bool ExceptSaturday() const {
     return _except_saturday;
   }
   
@@ -173,7 +178,7 @@ public:
     _except_sunday = b;
   }
   
-  bool ExceptSunday() {
+  bool ExceptSunday() const {
     return _except_sunday;
   }
 
@@ -278,7 +283,10 @@ public:
     // Dump this airspace to runtime.log
     virtual void Dump() const = 0;
     // Calculate drawing coordinates on screen
-    virtual void CalculateScreenPosition(const rectObj &screenbounds_latlon, const int iAirspaceMode[], const int iAirspaceBrush[], const RECT& rcDraw, const ScreenProjection& _Proj);
+    // pixel_size : screen pixel size in meter, used to select polygon level of detail
+    // alt, alt_agl : aircraft altitude used for altitude filter, read by caller once for all airspaces
+    // thread safe for different airspaces, called in parallel by CAirspaceManager::CalculateScreenPositionsAirspace()
+    virtual void CalculateScreenPosition(const rectObj &screenbounds_latlon, const int iAirspaceMode[], const int iAirspaceBrush[], const RECT& rcDraw, const ScreenProjection& _Proj, double pixel_size, double alt, double alt_agl);
     // Draw airspace on map
     virtual void Draw(LKSurface& Surface, bool fill) const;
     // Calculate nearest horizontal distance and bearing to the airspace from a given point
@@ -288,6 +296,12 @@ public:
       return Range(position.longitude, position.latitude, bearing);
     }
 
+    // Build simplified polygons used for drawing at low zoom level
+    void BuildLOD();
+    bool HasLOD() const { return static_cast<bool>(_lod); }
+
+    const CPoint2DArray& GeoPoints() const { return _geopoints; }
+
     // update hash with airspace common properties
     void Hash(MD5& md5) const;
 
@@ -312,6 +326,9 @@ protected:
     // previous version draw circular airspace using circle, but it's wrong, circle in geographic coordinate are ellipsoid in screen coordinate.
     CPoint2DArray _geopoints;
 
+    // simplified _geopoints, nullptr for small polygon.
+    std::unique_ptr<const CPolygonLOD> _lod;
+
     // this 2 array are modified by DrawThread, never use it in another thread !!
     ScreenPointList _screenpoints; // this is member for reduce memory alloc, but is used only by CalculateScreenPosition();
     RasterPointList _screenpoints_clipped;
@@ -363,7 +380,7 @@ struct AirSpaceSonarLevelStruct {
 class CAirspace_Area: public CAirspace {
 public:
   explicit CAirspace_Area(CPoint2DArray &&Area_Points);
-  ~CAirspace_Area() {};
+  ~CAirspace_Area();
 
   // Check if a point horizontally inside in this airspace
   bool IsHorizontalInside(const double &longitude, const double &latitude) const override ;
@@ -382,6 +399,10 @@ private:
   // Calculate airspace bounds
   void CalcBounds();
 
+  // Edge index of big polygon, built on first use. nullptr if polygon is too small to need it.
+  const CPolygonEdgeIndex* EdgeIndex() const;
+  mutable std::atomic<const CPolygonEdgeIndex*> _edge_index = {};
+
 ////////////////////////////////////////////////////////////////////////////////
 // Draw Picto methods
 //  this methods are NEVER used at same time of airspace loading
@@ -398,8 +419,13 @@ class CAirspace_Circle: public CAirspace
 {
 public:
   CAirspace_Circle(const GeoPoint &Center, double Radius);
+  // polygon already calculated by previous constructor (see CAirspaceCache)
+  CAirspace_Circle(const GeoPoint &Center, double Radius, CPoint2DArray &&Points);
   ~CAirspace_Circle() {}
 
+  const GeoPoint& Center() const { return _center; }
+  double Radius() const { return _radius; }
+
   // Check if a point horizontally inside in this airspace
   bool IsHorizontalInside(const double &longitude, const double &latitude) const override;
   // Dump this airspace to runtime.log
@@ -459,6 +485,8 @@ public:
 
   //HELPER FUNCTIONS
   static bool CheckAirspaceAltitude(const AIRSPACE_ALT &Base, const AIRSPACE_ALT &Top);
+  // same without flight data lock, alt & alt_agl are NavAltitude & TerrainAlt
+  static bool CheckAirspaceAltitude(const AIRSPACE_ALT &Base, const AIRSPACE_ALT &Top, double alt, double alt_agl);
   static const TCHAR* GetAirspaceTypeText(int type);
   static const TCHAR* GetAirspaceTypeShortText(int type);
   static void GetAirspaceAltText(TCHAR *buffer, int bufferlen, const AIRSPACE_ALT *alt);
@@ -543,6 +571,7 @@ private:
   CAirspaceList _airspaces;             // ALL
   CAirspaceList _airspaces_near;        // Near, in reachable range for warnings
   CAirspaceList _airspaces_page24;      // Airspaces for nearest 2.4 page
+  CAirspaceIndex _airspaces_index;      // spatial index over _airspaces bounds
   CAirspace *_selected_airspace = nullptr;         // Selected airspace
   CAirspace *_sideview_nearest = nullptr;         // Neasrest asp instance for sideview
 
@@ -557,6 +586,24 @@ private:
   CAirspace * _detail_current = nullptr;
   CAirspaceList _detail_queue;
 
+  // must be called each time _airspaces content or order change
+  void RebuildIndex();
+
+  // build simplified polygons of all airspaces, called after airspaces loading
+  void BuildLOD();
+
+  // call <func> for each airspace candidate with bounds overlapping <bounds>, in _airspaces order.
+  // candidates are a superset, <func> must still do it's own test.
+  template<typename Function>
+  void ForEachAirspaceInBounds(const rectObj& bounds, Function&& func) const;
+
+  // call <func> for each airspace candidate at less than <range> meters of given point, in _airspaces order.
+  template<typename Function>
+  void ForEachAirspaceInRange(double lon, double lat, double range, Function&& func) const;
+
+  // load airspaces of <szFile> from binary cache if up to date, otherwise parse it using <Fill> and update cache.
+  bool ReadAirspacesFile(const TCHAR* szFile, bool (CAirspaceManager::*Fill)(const TCHAR*));
+
   //Openair parsing functions, internal use
   bool FillAirspacesFromOpenAir(const TCHAR* szFile);
   
@@ -0,0 +1,238 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   PolygonEdgeIndex.cpp
+ */
+
+#include "options.h"
+#include "Defines.h"
+#include "PolygonEdgeIndex.h"
+#include <algorithm>
+#include <limits>
+#include <cassert>
+
+namespace {
+
+constexpr size_t chunk_size = 16; // edges per chunk
+constexpr size_t edges_per_slab = 4;
+
+/*
+ * CPoint2D::DistanceXYZ() truncate nearest point coordinates and result to integer,
+ * so returned distance can be up to sqrt(3) + 1 lower than euclidean distance.
+ */
+constexpr double distance_rounding_margin = 3.;
+
+} // namespace
+
+CPolygonEdgeIndex::CPolygonEdgeIndex(const CPoint2DArray& points)
+    : _edge_count(points.size() > 1 ? points.size() - 1 : 0)
+{
+  _miny = std::numeric_limits<double>::max();
+  _maxy = std::numeric_limits<double>::lowest();
+  for (const auto& pt : points) {
+    _miny = std::min(_miny, pt.Latitude());
+    _maxy = std::max(_maxy, pt.Latitude());
+  }
+
+  // latitude slabs
+  const size_t slab_count = std::max<size_t>(1, _edge_count / edges_per_slab);
+  _slab_scale = (_maxy > _miny) ? slab_count / (_maxy - _miny) : 0.;
+
+  // first pass : count edges per slab, second pass : fill.
+  _slab_offset.assign(slab_count + 1, 0);
+  for (size_t i = 0; i < _edge_count; ++i) {
+    const double lat1 = points[i].Latitude();
+    const double lat2 = points[i + 1].Latitude();
+    for (size_t s = Slab(std::min(lat1, lat2)), last = Slab(std::max(lat1, lat2)); s <= last; ++s) {
+      ++_slab_offset[s + 1];
+    }
+  }
+  for (size_t s = 0; s < slab_count; ++s) {
+    _slab_offset[s + 1] += _slab_offset[s];
+  }
+  _slab_edges.resize(_slab_offset.back());
+  std::vector<unsigned> fill(_slab_offset.begin(), std::prev(_slab_offset.end()));
+  for (size_t i = 0; i < _edge_count; ++i) {
+    const double lat1 = points[i].Latitude();
+    const double lat2 = points[i + 1].Latitude();
+    for (size_t s = Slab(std::min(lat1, lat2)), last = Slab(std::max(lat1, lat2)); s <= last; ++s) {
+      _slab_edges[fill[s]++] = i;
+    }
+  }
+
+  // geocentric bounding box of consecutive edges
+  _chunks.reserve((_edge_count + chunk_size - 1) / chunk_size);
+  for (size_t first = 0; first < _edge_count; first += chunk_size) {
+    const size_t last = std::min(first + chunk_size, _edge_count); // last edge end point
+    const CPoint2D& pt = points[first];
+    Box box = { pt.X(), pt.Y(), pt.Z(), pt.X(), pt.Y(), pt.Z() };
+    for (size_t i = first + 1; i <= last; ++i) {
+      const CPoint2D& next = points[i];
+      box.minx = std::min(box.minx, next.X());
+      box.miny = std::min(box.miny, next.Y());
+      box.minz = std::min(box.minz, next.Z());
+      box.maxx = std::max(box.maxx, next.X());
+      box.maxy = std::max(box.maxy, next.Y());
+      box.maxz = std::max(box.maxz, next.Z());
+    }
+    _chunks.push_back(box);
+  }
+}
+
+size_t CPolygonEdgeIndex::Slab(double latitude) const {
+  // must be monotonic : edge with latitude range [a, b] is stored in all slab from Slab(a) to Slab(b)
+  const double s = (latitude - _miny) * _slab_scale;
+  const size_t last = _slab_offset.size() - 2;
+  if (!(s > 0.)) {
+    return 0;
+  }
+  return std::min(static_cast<size_t>(s), last);
+}
+
+int CPolygonEdgeIndex::WindingNumber(const CPoint2DArray& points, double longitude, double latitude) const {
+  assert(points.size() == _edge_count + 1);
+
+  // an edge can only be crossed if latitude is in [min, max[ of it's end points.
+  if (!(latitude >= _miny && latitude < _maxy)) {
+    return 0;
+  }
+
+  int wn = 0;
+  const size_t s = Slab(latitude);
+  for (unsigned i = _slab_offset[s]; i < _slab_offset[s + 1]; ++i) {
+    const unsigned edge = _slab_edges[i];
+    wn += WindingEdge(points[edge], points[edge + 1], longitude, latitude);
+  }
+  return wn;
+}
+
+double CPolygonEdgeIndex::LowerBound(const Box& box, const CPoint2D& point) const {
+  auto gap = [](double v, double min, double max) {
+    return (v < min) ? (min - v) : ((v > max) ? (v - max) : 0.);
+  };
+  const double dx = gap(point.X(), box.minx, box.maxx);
+  const double dy = gap(point.Y(), box.miny, box.maxy);
+  const double dz = gap(point.Z(), box.minz, box.maxz);
+  return std::sqrt(dx * dx + dy * dy + dz * dz) - distance_rounding_margin;
+}
+
+void CPolygonEdgeIndex::NearestInChunk(const CPoint2DArray& points, size_t chunk, const CPoint2D& point, size_t& edge, unsigned& distance) const {
+  const size_t first = chunk * chunk_size;
+  const size_t last = std::min(first + chunk_size, _edge_count);
+  for (size_t i = first; i < last; ++i) {
+    const unsigned dist = point.DistanceXYZ(points[i], points[i + 1]);
+    // keep first edge in case of equal distance
+    if ((dist < distance) || ((dist == distance) && (i < edge))) {
+      distance = dist;
+      edge = i;
+    }
+  }
+}
+
+size_t CPolygonEdgeIndex::NearestEdge(const CPoint2DArray& points, const CPoint2D& point, unsigned& distance) const {
+  assert(points.size() == _edge_count + 1);
+
+  size_t edge = 0;
+  distance = std::numeric_limits<unsigned>::max();
+  if (_chunks.empty()) {
+    return edge;
+  }
+
+  // start with the most promising chunk to get a good upper bound
+  size_t seed = 0;
+  double seed_bound = std::numeric_limits<double>::max();
+  for (size_t c = 0; c < _chunks.size(); ++c) {
+    const double bound = LowerBound(_chunks[c], point);
+    if (bound < seed_bound) {
+      seed_bound = bound;
+      seed = c;
+    }
+  }
+  NearestInChunk(points, seed, point, edge, distance);
+
+  for (size_t c = 0; c < _chunks.size(); ++c) {
+    // equal bound can still contain an edge with same distance and lower index
+    if (c != seed && LowerBound(_chunks[c], point) <= distance) {
+      NearestInChunk(points, c, point, edge, distance);
+    }
+  }
+  return edge;
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+
+namespace {
+
+  // random star shaped polygon with lot of vertices, closed.
+  CPoint2DArray RandomPolygon(std::mt19937& gen, size_t count, double lat, double lon, double radius) {
+    std::uniform_real_distribution<double> noise(0.5, 1.);
+    CPoint2DArray points;
+    points.reserve(count + 1);
+    for (size_t i = 0; i < count; ++i) {
+      const double angle = 2. * PI * i / count;
+      const double r = radius * noise(gen);
+      points.emplace_back(lat + r * std::sin(angle), lon + r * std::cos(angle) / std::cos(lat * DEG_TO_RAD));
+    }
+    points.push_back(points.front());
+    return points;
+  }
+
+  int BruteForceWindingNumber(const CPoint2DArray& points, double longitude, double latitude) {
+    int wn = 0;
+    for (size_t i = 0; i + 1 < points.size(); ++i) {
+      wn += WindingEdge(points[i], points[i + 1], longitude, latitude);
+    }
+    return wn;
+  }
+
+  size_t BruteForceNearestEdge(const CPoint2DArray& points, const CPoint2D& point, unsigned& distance) {
+    size_t edge = 0;
+    for (size_t i = 0; i + 1 < points.size(); ++i) {
+      const unsigned dist = point.DistanceXYZ(points[i], points[i + 1]);
+      if ((dist < distance) || (i == 0)) {
+        distance = dist;
+        edge = i;
+      }
+    }
+    return edge;
+  }
+
+} // namespace
+
+TEST_CASE("polygon edge index") {
+  std::mt19937 gen(5);
+
+  for (size_t count : { 40, 500, 5000 }) {
+    const CPoint2DArray polygon = RandomPolygon(gen, count, 45., 6., 0.5);
+    const CPolygonEdgeIndex index(polygon);
+
+    std::uniform_real_distribution<double> lat(44., 46.);
+    std::uniform_real_distribution<double> lon(4.5, 7.5);
+
+    for (int i = 0; i < 2000; ++i) {
+      const double y = lat(gen);
+      const double x = lon(gen);
+      CHECK_EQ(index.WindingNumber(polygon, x, y), BruteForceWindingNumber(polygon, x, y));
+
+      const CPoint2D point(y, x);
+      unsigned distance = 0;
+      unsigned expected_distance = 0;
+      const size_t edge = index.NearestEdge(polygon, point, distance);
+      const size_t expected_edge = BruteForceNearestEdge(polygon, point, expected_distance);
+      CHECK_EQ(edge, expected_edge);
+      CHECK_EQ(distance, expected_distance);
+    }
+
+    // vertices and points on slab limits
+    for (const CPoint2D& pt : polygon) {
+      CHECK_EQ(index.WindingNumber(polygon, pt.Longitude(), pt.Latitude()),
+               BruteForceWindingNumber(polygon, pt.Longitude(), pt.Latitude()));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   PolygonEdgeIndex.h
+ */
+
+#ifndef POLYGONEDGEINDEX_H
+#define POLYGONEDGEINDEX_H
+
+#include <vector>
+#include "Point2D.h"
+
+// isLeft(): tests if a point is Left|On|Right of an infinite line.
+//    Input:  three points P0, P1, and P2
+//    Return: >0 for P2 left of the line through P0 and P1
+//            =0 for P2 on the line
+//            <0 for P2 right of the line
+//    See: the January 2001 Algorithm "Area of 2D and 3D Triangles and Polygons"
+
+inline float
+isLeft(const CPoint2D &P0, const CPoint2D &P1, const double &longitude, const double &latitude) {
+    return ( (P1.Longitude() - P0.Longitude()) * (latitude - P0.Latitude())
+            - (longitude - P0.Longitude()) * (P1.Latitude() - P0.Latitude()));
+}
+
+// contribution of edge P0-P1 to the winding number of a point
+inline int
+WindingEdge(const CPoint2D &P0, const CPoint2D &P1, const double &longitude, const double &latitude) {
+    if (P0.Latitude() <= latitude) { // start y <= P.Latitude
+        if (P1.Latitude() > latitude) // an upward crossing
+            if (isLeft(P0, P1, longitude, latitude) > 0) // P left of edge
+                return 1; // have a valid up intersect
+    } else { // start y > P.Latitude (no test needed)
+        if (P1.Latitude() <= latitude) // a downward crossing
+            if (isLeft(P0, P1, longitude, latitude) < 0) // P right of edge
+                return -1; // have a valid down intersect
+    }
+    return 0;
+}
+
+/**
+ * Acceleration structure for polygon with lot of vertices.
+ *
+ *  - edges are bucketed in latitude slabs : winding number only need edges
+ *    crossing the latitude of the point, so only one slab is visited.
+ *  - consecutive edges are grouped in chunks with their geocentric bounding box :
+ *    nearest edge search skip all chunks too far to contain a better candidate.
+ *
+ * Results are exactly the same as looping over all edges.
+ * Index don't keep reference to polygon, the same points must be given to each call.
+ */
+class CPolygonEdgeIndex final {
+public:
+  // don't build index for small polygon, loop over all edges is faster.
+  static constexpr size_t min_points = 32;
+
+  explicit CPolygonEdgeIndex(const CPoint2DArray& points);
+
+  // winding number of point (=0 only if point is outside polygon)
+  int WindingNumber(const CPoint2DArray& points, double longitude, double latitude) const;
+
+  /**
+   * find the first edge with minimal CPoint2D::DistanceXYZ() to <point>
+   * @return index of first vertex of the edge
+   */
+  size_t NearestEdge(const CPoint2DArray& points, const CPoint2D& point, unsigned& distance) const;
+
+private:
+  struct Box {
+    int minx, miny, minz;
+    int maxx, maxy, maxz;
+  };
+
+  size_t Slab(double latitude) const;
+  double LowerBound(const Box& box, const CPoint2D& point) const;
+  void NearestInChunk(const CPoint2DArray& points, size_t chunk, const CPoint2D& point, size_t& edge, unsigned& distance) const;
+
+  double _miny;
+  double _maxy;
+  double _slab_scale;
+
+  std::vector<unsigned> _slab_offset; // edges of slab <i> are _slab_edges[_slab_offset[i] .. _slab_offset[i+1]]
+  std::vector<unsigned> _slab_edges;
+
+  size_t _edge_count;
+  std::vector<Box> _chunks;
+};
+
+#endif /* POLYGONEDGEINDEX_H */
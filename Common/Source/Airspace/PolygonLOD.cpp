@@ -0,0 +1,257 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   PolygonLOD.cpp
+ */
+
+#include "options.h"
+#include "Defines.h"
+#include "PolygonLOD.h"
+#include <numeric>
+#include <utility>
+
+namespace {
+
+constexpr double base_tolerance = 10.; // tolerance of first level in meter
+constexpr double level_factor = 4.;
+constexpr size_t max_levels = 5;
+
+// 3 vertices and closing point
+constexpr size_t min_level_points = 4;
+
+unsigned SegmentDistance(const CPoint2D& point, const CPoint2D& seg1, const CPoint2D& seg2) {
+  if (seg1.X() == seg2.X() && seg1.Y() == seg2.Y() && seg1.Z() == seg2.Z()) {
+    // first and last point of closed polygon
+    return point.DistanceXYZ(seg1);
+  }
+  return point.DistanceXYZ(seg1, seg2);
+}
+
+// Douglas-Peucker simplification of <points>[<in>], without recursion.
+void Simplify(const CPoint2DArray& points, const std::vector<unsigned>& in, double tolerance, std::vector<unsigned>& out) {
+  std::vector<bool> keep(in.size(), false);
+  keep.front() = true;
+  keep.back() = true;
+
+  std::vector<std::pair<size_t, size_t>> stack;
+  stack.emplace_back(0, in.size() - 1);
+  while (!stack.empty()) {
+    const size_t first = stack.back().first;
+    const size_t last = stack.back().second;
+    stack.pop_back();
+
+    const CPoint2D& seg1 = points[in[first]];
+    const CPoint2D& seg2 = points[in[last]];
+
+    size_t farthest = first;
+    unsigned max_distance = 0;
+    for (size_t i = first + 1; i < last; ++i) {
+      const unsigned distance = SegmentDistance(points[in[i]], seg1, seg2);
+      if (distance > max_distance) {
+        max_distance = distance;
+        farthest = i;
+      }
+    }
+    if (max_distance > tolerance) {
+      keep[farthest] = true;
+      stack.emplace_back(first, farthest);
+      stack.emplace_back(farthest, last);
+    }
+  }
+
+  out.clear();
+  for (size_t i = 0; i < in.size(); ++i) {
+    if (keep[i]) {
+      out.push_back(in[i]);
+    }
+  }
+}
+
+} // namespace
+
+CPolygonLOD::CPolygonLOD(const CPoint2DArray& points) {
+  if (points.size() <= min_level_points) {
+    return;
+  }
+
+  std::vector<unsigned> previous(points.size());
+  std::iota(previous.begin(), previous.end(), 0U);
+
+  double tolerance = base_tolerance;
+  double error = 0.;
+  std::vector<unsigned> simplified;
+  for (size_t i = 0; i < max_levels; ++i, tolerance *= level_factor) {
+    Simplify(points, previous, tolerance, simplified);
+    if (simplified.size() < min_level_points) {
+      break; // polygon collapsed
+    }
+    if (simplified.size() * 4 > previous.size() * 3) {
+      continue; // not enough vertices removed to be worth a level
+    }
+    error += tolerance;
+    _levels.push_back({ error, simplified });
+    previous.swap(simplified);
+  }
+}
+
+const std::vector<unsigned>* CPolygonLOD::Select(double pixel_size) const {
+  for (auto it = _levels.rbegin(); it != _levels.rend(); ++it) {
+    if (it->tolerance <= pixel_size) {
+      return &it->points;
+    }
+  }
+  return nullptr;
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+#include "Time/PeriodClock.hpp"
+
+namespace {
+
+  // closed polygon following a random "border" around a circle
+  CPoint2DArray BorderPolygon(std::mt19937& gen, size_t count, double lat, double lon, double radius) {
+    std::normal_distribution<double> noise(0., radius * 0.001);
+    CPoint2DArray points;
+    points.reserve(count + 1);
+    double r = radius;
+    for (size_t i = 0; i < count; ++i) {
+      const double angle = 2. * PI * i / count;
+      r = std::max(radius * 0.5, std::min(radius * 1.5, r + noise(gen)));
+      points.emplace_back(lat + r * std::sin(angle), lon + r * std::cos(angle) / std::cos(lat * DEG_TO_RAD));
+    }
+    points.push_back(points.front());
+    return points;
+  }
+
+  struct Pixel {
+    int x, y;
+  };
+
+  // same math as ScreenProjection::ToScreen() without rotation.
+  template<typename Function>
+  void Project(double lat, double lon, double pixel_size, Function&& for_each_point, std::vector<Pixel>& out) {
+    const double zoom = 111194.9 / pixel_size; // pixel by degree
+    const double coslat = std::cos(lat * DEG_TO_RAD);
+    out.clear();
+    for_each_point([&](const CPoint2D& pt) {
+      out.push_back({ static_cast<int>(std::lround((pt.Longitude() - lon) * coslat * zoom)),
+                      static_cast<int>(std::lround((lat - pt.Latitude()) * zoom)) });
+    });
+  }
+
+} // namespace
+
+TEST_CASE("polygon lod") {
+  std::mt19937 gen(11);
+
+  const CPoint2DArray polygon = BorderPolygon(gen, 5000, 45., 6., 0.3);
+  const CPolygonLOD lod(polygon);
+
+  REQUIRE(lod.LevelCount() > 2);
+
+  SUBCASE("levels are simplified polygon within tolerance") {
+    size_t previous_size = polygon.size();
+    for (size_t level = 0; level < lod.LevelCount(); ++level) {
+      const std::vector<unsigned>& points = lod.Level(level);
+      CHECK(points.size() < previous_size);
+      CHECK(points.size() >= 4);
+      CHECK(points.front() == 0);
+      CHECK(points.back() == polygon.size() - 1);
+      previous_size = points.size();
+
+      unsigned max_error = 0;
+      for (size_t i = 0; i + 1 < points.size(); ++i) {
+        CHECK(points[i] < points[i + 1]);
+        for (unsigned j = points[i]; j <= points[i + 1]; ++j) {
+          max_error = std::max(max_error, SegmentDistance(polygon[j], polygon[points[i]], polygon[points[i + 1]]));
+        }
+      }
+      // +3m : CPoint2D::DistanceXYZ() rounding for each level
+      CHECK(max_error <= lod.Tolerance(level) + 3 * (level + 1));
+    }
+  }
+
+  SUBCASE("select level from pixel size") {
+    CHECK(lod.Select(0.) == nullptr);
+    CHECK(lod.Select(lod.Tolerance(0) - 1.) == nullptr);
+    CHECK(lod.Select(lod.Tolerance(0)) == &lod.Level(0));
+    CHECK(lod.Select(lod.Tolerance(1) + 1.) == &lod.Level(1));
+    CHECK(lod.Select(1e9) == &lod.Level(lod.LevelCount() - 1));
+  }
+
+  SUBCASE("straight edges polygon") {
+    // square with 100 vertices on each side, only corners are needed at first level.
+    CPoint2DArray square;
+    for (const auto& corner : { std::make_pair(0., 0.), std::make_pair(0., 1.), std::make_pair(1., 1.), std::make_pair(1., 0.) }) {
+      for (int i = 0; i < 100; ++i) {
+        square.emplace_back(45. + corner.first, 6. + corner.second);
+      }
+    }
+    square.push_back(square.front());
+    const CPolygonLOD square_lod(square);
+    REQUIRE(square_lod.LevelCount() == 1);
+    CHECK(square_lod.Level(0).size() <= 8);
+  }
+}
+
+// not run by default, use '--test-case="polygon lod benchmark" --no-skip'
+TEST_CASE("polygon lod benchmark" * doctest::skip()) {
+  std::mt19937 gen(3);
+
+  // 200 airspaces following a dense border, like OpenAIP country border airspaces
+  std::vector<CPoint2DArray> polygons;
+  for (int i = 0; i < 200; ++i) {
+    polygons.push_back(BorderPolygon(gen, 5000, 45. + (i % 20) * 0.05, 6. + (i / 20) * 0.05, 0.5));
+  }
+
+  PeriodClock clock;
+  clock.Update();
+  std::vector<CPolygonLOD> lods;
+  for (const auto& polygon : polygons) {
+    lods.emplace_back(polygon);
+  }
+  MESSAGE("build " << polygons.size() << " pyramids : " << clock.Elapsed() << "ms");
+
+  std::vector<Pixel> pixels;
+  for (double pixel_size : { 5., 25., 100., 250. }) {
+    size_t full_count = 0;
+    size_t lod_count = 0;
+
+    clock.Update();
+    for (int repeat = 0; repeat < 10; ++repeat) {
+      for (const auto& polygon : polygons) {
+        Project(45., 6., pixel_size, [&](auto&& func) {
+          std::for_each(polygon.begin(), polygon.end(), func);
+        }, pixels);
+        full_count += pixels.size();
+      }
+    }
+    const int full_ms = clock.ElapsedUpdate();
+
+    for (int repeat = 0; repeat < 10; ++repeat) {
+      for (size_t i = 0; i < polygons.size(); ++i) {
+        const std::vector<unsigned>* level = lods[i].Select(pixel_size);
+        Project(45., 6., pixel_size, [&](auto&& func) {
+          if (level) {
+            for (unsigned idx : *level) {
+              func(polygons[i][idx]);
+            }
+          } else {
+            std::for_each(polygons[i].begin(), polygons[i].end(), func);
+          }
+        }, pixels);
+        lod_count += pixels.size();
+      }
+    }
+    const int lod_ms = clock.ElapsedUpdate();
+
+    MESSAGE("pixel " << pixel_size << "m : full " << full_count / 10 << " vertices " << full_ms << "ms,"
+            << " lod " << lod_count / 10 << " vertices " << lod_ms << "ms");
+  }
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   PolygonLOD.h
+ */
+
+#ifndef POLYGONLOD_H
+#define POLYGONLOD_H
+
+#include <vector>
+#include "Point2D.h"
+
+/**
+ * Level of detail pyramid of polygon with lot of vertices.
+ *
+ * Each level is the polygon simplified by Douglas-Peucker algorithm, with a
+ * tolerance 4 times bigger than previous level. Level <n> is simplified from
+ * level <n-1>, so error accumulate : stored tolerance is the sum of all
+ * previous levels tolerances.
+ *
+ * Levels are stored as indexes of polygon vertices, first and last vertex are
+ * always kept.
+ * Index don't keep reference to polygon, the same points must be given to each call.
+ */
+class CPolygonLOD final {
+public:
+  // don't build pyramid for small polygon
+  static constexpr size_t min_points = 64;
+
+  explicit CPolygonLOD(const CPoint2DArray& points);
+
+  /**
+   * @pixel_size : size of screen pixel in meter.
+   * @return the coarsest level with error smaller than one pixel,
+   *    nullptr if full resolution polygon must be used.
+   */
+  const std::vector<unsigned>* Select(double pixel_size) const;
+
+  size_t LevelCount() const {
+    return _levels.size();
+  }
+
+  // max distance in meter between polygon and simplified polygon of level <i>
+  double Tolerance(size_t i) const {
+    return _levels[i].tolerance;
+  }
+
+  const std::vector<unsigned>& Level(size_t i) const {
+    return _levels[i].points;
+  }
+
+private:
+  struct LevelData {
+    double tolerance;
+    std::vector<unsigned> points;
+  };
+
+  std::vector<LevelData> _levels;
+};
+
+#endif /* POLYGONLOD_H */
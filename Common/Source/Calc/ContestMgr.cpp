@@ -11,9 +11,14 @@
 
 #include "ContestMgr.h"
 #include <memory>
+#include <algorithm>
+#include <functional>
 #include "Waypointparser.h"
 #include "NavFunctions.h"
 #include "RasterTerrain.h"
+#include "Thread/Thread.hpp"
+#include "Thread/Cond.hpp"
+#include "utils/profiler.h"
 
 CContestMgr::ContestRule AdditionalContestRule = CContestMgr::ContestRule::OLC;  	// Enum to Rules to use for the addition contest CContestMgr::ContestRule
 
@@ -80,21 +85,165 @@ const TCHAR *CContestMgr::XCRuleToString(CContestMgr::ContestRule rule) {
   return _T("INVALID TYPE");
 }
 
+/**
+ * @brief Solver thread
+ *
+ * GPS fixes are queued by Add() and pushed into the traces by the worker,
+ * so the trace is never modified while a solver is running.
+ * After each new fix, all the solver steps are run once, one at a time.
+ */
+class CContestMgr::CWorker final : public Thread {
+public:
+  explicit CWorker(CContestMgr &mgr) : Thread("ContestMgr"), _mgr(mgr) {}
+
+  void Add(const CPointGPSSmart &gps) {
+    ScopeLock lock(_mutex);
+    if (_stop) {
+      return;
+    }
+    if (!_started) {
+      _started = Start();
+    }
+    _fixes.push_back(gps);
+    _workCond.Signal();
+  }
+
+  // _mgr._mainCS Requiered
+  void Reset() {
+    ScopeLock lock(_mutex);
+    _fixes.clear();
+    _stepsToGo = 0;
+    _idleCond.Broadcast();
+  }
+
+  void Stop() {
+    WithLock(_mutex, [&]() {
+      _stop = true;
+      _fixes.clear();
+      _workCond.Broadcast();
+      _idleCond.Broadcast();
+    });
+    if (_started) {
+      Join();
+      _started = false;
+    }
+  }
+
+  void WaitIdle() {
+    ScopeLock lock(_mutex);
+    while (!_stop && (!_fixes.empty() || _stepsToGo)) {
+      _idleCond.Wait(_mutex);
+    }
+  }
+
+protected:
+  void Run() override {
+    Poco::Thread::current()->setPriority(Poco::Thread::PRIO_LOW);
+
+    std::vector<CPointGPSSmart> fixes;
+    while (true) {
+      {
+        ScopeLock lock(_mutex);
+        while (!_stop && _fixes.empty() && !_stepsToGo) {
+          _idleCond.Broadcast();
+          _workCond.Wait(_mutex);
+        }
+        if (_stop) {
+          return;
+        }
+      }
+
+      LockFlightData();
+      const double lat = GPS_INFO.Latitude;
+      const double lon = GPS_INFO.Longitude;
+      UnlockFlightData();
+
+      ScopeLock guard(_mgr._mainCS);
+      bool solve = WithLock(_mutex, [&]() {
+        fixes.swap(_fixes);
+        if (!fixes.empty()) {
+          // new trace : restart all steps.
+          _stepsToGo = STEPS_NUM;
+        }
+        return (_stepsToGo > 0);
+      });
+      if (!solve) {
+        // Reset() in the meantime
+        continue;
+      }
+
+      {
+        profiler::scope timing(profiler::ContestSolver);
+        _mgr.PushFixes(fixes);
+        fixes.clear();
+        _mgr.SolveStep(lat, lon);
+      }
+
+      WithLock(_mutex, [&]() {
+        if (_stepsToGo) {
+          --_stepsToGo;
+        }
+      });
+    }
+  }
+
+private:
+  CContestMgr &_mgr;
+
+  Mutex _mutex;  // protect all members below
+  Cond _workCond;
+  Cond _idleCond;
+  std::vector<CPointGPSSmart> _fixes;
+  unsigned _stepsToGo = 0;
+  bool _stop = false;
+  bool _started = false;
+};
+
+
+CContestMgr::CContestMgr() : _worker(std::make_unique<CWorker>(*this)) {
+}
+
+CContestMgr::~CContestMgr() {
+  _worker->Stop();
+}
+
+/**
+ * @brief Stops the solver thread
+ *
+ * Fixes added after that call are ignored.
+ */
+void CContestMgr::Stop() {
+  _worker->Stop();
+}
+
+/**
+ * @brief Waits until all queued GPS fixes are analysed
+ */
+void CContestMgr::WaitSolver() {
+  _worker->WaitIdle();
+}
+
 /** 
  * @brief Resets Contest Manager
  * 
  * @param handicap Glider handicap
  */
 void CContestMgr::Reset(unsigned handicap) {
+  // abort running solver step
+  _cancel = true;
   ScopeLock guard(_mainCS);
+  _cancel = false;
+  _worker->Reset();
+  _step = 0;
   _handicap = handicap;
   {
     ScopeLock TraceGuard(_traceCS);
-    _trace = std::make_unique<CTrace>(TRACE_FIX_LIMIT, 0, COMPRESSION_ALGORITHM);
+    _trace->Clear();
   }
-  _traceSprint = std::make_unique<CTrace>(TRACE_SPRINT_FIX_LIMIT, TRACE_SPRINT_TIME_LIMIT, COMPRESSION_ALGORITHM);
-  _traceFreeTriangle = std::make_unique<CTrace>(TRACE_TRIANGLE_FIX_LIMIT, 0, COMPRESSION_ALGORITHM);
-  _traceLoop = std::make_unique<CTrace>(TRACE_TRIANGLE_FIX_LIMIT, 0, COMPRESSION_ALGORITHM);
+  // traces keep their points pool
+  _traceSprint->Clear();
+  _traceFreeTriangle->Clear();
+  _traceLoop->Clear();
 
   _prevFAIFront = nullptr;
   _prevFAIBack = nullptr;
@@ -197,7 +346,7 @@ bool CContestMgr::BiggestLoopFind(const CTrace &traceIn, CTrace &traceOut, bool
       // new valid loop found - copy the points to output trace
       const CTrace::CPoint *point = start;
       while(point) {
-        traceOut.Push(new CTrace::CPoint(traceOut, *point, traceOut._back));
+        traceOut.Push(*point);
         if(point == end)
           break;
         point = point->Next();
@@ -405,13 +554,15 @@ void CContestMgr::SolvePoints(const CTrace &trace, bool sprint, bool predicted)
     // no points matching heights constrain
     return;
   
-  // create result trace
-  CTrace traceResult(sprint ? 5 : 7, sprint ? TRACE_SPRINT_TIME_LIMIT : 0, CTrace::ALGORITHM_DISTANCE);
+  // reuse result trace
+  CTrace &traceResult = sprint ? *_traceSprintResult : *_traceResult;
+  traceResult.Clear();
+  traceResult._maxSize = sprint ? 5 : 7;
   
   // add points to result trace
   point = first;
   while(point && point != last->Next()) {
-    traceResult.Push(new CTrace::CPoint(traceResult, *point, traceResult._back));
+    traceResult.Push(*point);
     point = point->Next();
   }
   
@@ -464,9 +615,48 @@ else*/
 }
 
 
+/**
+ * @brief Fills distance matrix with the points of a triangle trace
+ *
+ * @param trace The trace to use
+ * @param prevFront Loop front point of previous iteration
+ * @param prevBack Loop back point of previous iteration
+ */
+void CContestMgr::CDistanceMatrix::Update(const CTrace &trace, const CPointGPS *prevFront, const CPointGPS *prevBack)
+{
+  _points.clear();
+  _analysed.clear();
+  for (const CTrace::CPoint *point = trace.Front(); point; point = point->Next()) {
+    _points.push_back(point);
+    _analysed.push_back(prevFront && prevBack && !(point->GPS() < *prevFront || point->GPS() > *prevBack));
+  }
+
+  const unsigned size = _points.size();
+  _distance.resize(size * size);
+  _maxDistance.assign(size, 0);
+  for (unsigned i = 0; i < size; ++i) {
+    _distance[i * size + i] = 0;
+    for (unsigned j = i + 1; j < size; ++j) {
+      // DistanceXYZ() is symmetric
+      const unsigned dist = _points[i]->GPS().DistanceXYZ(_points[j]->GPS());
+      _distance[i * size + j] = dist;
+      _distance[j * size + i] = dist;
+      _maxDistance[i] = std::max(_maxDistance[i], dist);
+    }
+  }
+}
+
+
 /** 
  * @brief Solves FAI triangle based contest
  * 
+ * Points of the trace are reviewed in the same order than the previous
+ * std::multimap based solver (longest edges first, later point first for
+ * equal edges), so the results are the same. Distances are taken from
+ * a precalculated matrix and candidates that can't beat the best result
+ * are pruned using triangle inequality : 3rd edge is never longer than
+ * the sum of the 2 others.
+ *
  * @param trace The trace to use
  * @param prevFront Loop front point of previous iteration
  * @param prevBack Loop back point of previous iteration
@@ -477,66 +667,71 @@ void CContestMgr::SolveFAITriangle(const CTrace &trace, const CPointGPS *prevFro
   TType type = predicted ? TYPE_OLC_FAI_PREDICTED : TYPE_OLC_FAI;
   CResult bestResult = _resultArray[type];
   if (trace.Size() > 2) {
+    CDistanceMatrix &matrix = _triangleMatrix;
+    matrix.Update(trace, prevFront, prevBack);
+    const unsigned size = matrix.Size();
+
     // check for every trace point
-    const CTrace::CPoint *point1st = trace.Front();
-    while (point1st) {
+    for (unsigned index1st = 0; index1st < size && !_cancel; ++index1st) {
       // check if all edges should be analysed
-      bool skip1 = prevFront && prevBack;
-      if (skip1 && (point1st->GPS() < *prevFront || point1st->GPS() > *prevBack))
-        skip1 = false;
-
-      // create a map of points that may form first edge of a better triangle
-      CDistanceMap distanceMap1st;
-      const CTrace::CPoint *next = 0;
-      for (next = point1st->Next(); next; next = next->Next()) {
-        unsigned dist = point1st->GPS().DistanceXYZ(next->GPS());
+      bool skip1 = matrix.Analysed(index1st);
+
+      // find points that may form first edge of a better triangle
+      _triangleEdges1st.clear();
+      for (unsigned next = index1st + 1; next < size; ++next) {
+        unsigned dist = matrix.Distance(index1st, next);
         // check if 1st edge not too short
         if (!FAITriangleEdgeCheck(dist, bestResult.Distance()))
           continue;
-        distanceMap1st.insert(std::make_pair(dist, next));
+        _triangleEdges1st.emplace_back(dist, next);
       }
+      std::sort(_triangleEdges1st.begin(), _triangleEdges1st.end(), std::greater<CEdge>());
 
       // check all possible first edges of the triangle
-      for (CDistanceMap::reverse_iterator it1st = distanceMap1st.rbegin(); it1st != distanceMap1st.rend(); ++it1st) {
-        bool skip2 = skip1;
-        if (skip2 && (it1st->second->GPS() < *prevFront || it1st->second->GPS() > *prevBack))
-          skip2 = false;
-
-        unsigned dist1st = it1st->first;
+      for (const CEdge &edge1st : _triangleEdges1st) {
+        const unsigned dist1st = edge1st.first;
+        const unsigned index2nd = edge1st.second;
         if (!FAITriangleEdgeCheck(dist1st, bestResult.Distance()))
           // better solution found in the meantime
           break;
 
-        // create a map of points that may form second edge of a better triangle
-        CDistanceMap distanceMap2nd;
-        const CTrace::CPoint *point2nd = it1st->second;
-        for (next = point2nd->Next(); next; next = next->Next()) {
-          bool skip3 = skip2;
-          if (skip3 && (next->GPS() < *prevFront || next->GPS() > *prevBack))
-            skip3 = false;
-          if (skip3)
+        // upper bound of the triangles using that edge (2nd edge not longer than 145% of 1st one)
+        const unsigned max2nd = std::min(matrix.MaxDistance(index2nd), dist1st * 20 / 14);
+        if (2 * (dist1st + max2nd) + 1 <= bestResult.Distance())
+          continue;
+
+        bool skip2 = skip1 && matrix.Analysed(index2nd);
+
+        // find points that may form second edge of a better triangle
+        _triangleEdges2nd.clear();
+        for (unsigned next = index2nd + 1; next < size; ++next) {
+          if (skip2 && matrix.Analysed(next))
             // that triangle was analysed already
             continue;
 
-          unsigned dist = point2nd->GPS().DistanceXYZ(next->GPS());
+          unsigned dist = matrix.Distance(index2nd, next);
           // check if 2nd edge not too long
           if (dist * 14 > dist1st * 20) // 45% > 25%
             continue;
           // check if 2nd edge not too short
           if (!FAITriangleEdgeCheck(dist, bestResult.Distance()))
             continue;
-          distanceMap2nd.insert(std::make_pair(dist, next));
+          _triangleEdges2nd.emplace_back(dist, next);
         }
+        std::sort(_triangleEdges2nd.begin(), _triangleEdges2nd.end(), std::greater<CEdge>());
 
         // check all possible second and third edges of the triangle
-        for (CDistanceMap::reverse_iterator it2nd = distanceMap2nd.rbegin(); it2nd != distanceMap2nd.rend(); ++it2nd) {
-          unsigned dist2nd = it2nd->first;
+        for (const CEdge &edge2nd : _triangleEdges2nd) {
+          const unsigned dist2nd = edge2nd.first;
           if (!FAITriangleEdgeCheck(dist2nd, bestResult.Distance()))
             // better solution found in the meantime
             break;
+          if (2 * (dist1st + dist2nd) + 1 <= bestResult.Distance())
+            // no better triangle with shorter 2nd edge (+1 for DistanceXYZ() rounding)
+            break;
 
-          const CTrace::CPoint *point3rd = it2nd->second;
-          unsigned dist3rd = point3rd->GPS().DistanceXYZ(point1st->GPS());
+          const unsigned index3rd = edge2nd.second;
+          unsigned dist3rd = matrix.Distance(index3rd, index1st);
           unsigned distance = dist1st + dist2nd + dist3rd;
           if (distance > bestResult.Distance()) {
             // check if valid FAI triangle
@@ -547,9 +742,9 @@ void CContestMgr::SolveFAITriangle(const CTrace &trace, const CPointGPS *prevFro
               float score = distance / 1000.0 * 0.3 * 100 / _handicap;
               CPointGPSArray pointArray;
               pointArray.push_back(trace.Front()->GPS());
-              pointArray.push_back(point1st->GPS());
-              pointArray.push_back(point2nd->GPS());
-              pointArray.push_back(point3rd->GPS());
+              pointArray.push_back(matrix.Point(index1st)->GPS());
+              pointArray.push_back(matrix.Point(index2nd)->GPS());
+              pointArray.push_back(matrix.Point(index3rd)->GPS());
               pointArray.push_back(trace.Back()->GPS());
 
               bool predictedFAI = false;
@@ -572,8 +767,6 @@ void CContestMgr::SolveFAITriangle(const CTrace &trace, const CPointGPS *prevFro
           }
         }
       }
-
-      point1st = point1st->Next();
     }
   }
 
@@ -608,69 +801,70 @@ void CContestMgr::SolveFAITriangle(const CTrace &trace, const CPointGPS *prevFro
  */
 void CContestMgr::SolveFREETriangle(const CTrace &trace,const CPointGPS *prevFront,const CPointGPS *prevBack) {
   if (trace.Size() > 2) {
+    CDistanceMatrix &matrix = _triangleMatrix;
+    matrix.Update(trace, prevFront, prevBack);
+    const unsigned size = matrix.Size();
+
     // check for every trace point
-    const CTrace::CPoint *point1st = trace.Front();
-    while (point1st) {
+    for (unsigned index1st = 0; index1st < size && !_cancel; ++index1st) {
       // check if all edges should be analysed
-      bool skip1 = prevFront && prevBack;
-      if (skip1 && (point1st->GPS() < *prevFront || point1st->GPS() > *prevBack))
-        skip1 = false;
-
-      // create a map of points that may form first edge of a better triangle
-      CDistanceMap distanceMap1st;
-      const CTrace::CPoint *next = 0;
-      for (next = point1st->Next(); next; next = next->Next()) {
-        unsigned dist = point1st->GPS().DistanceXYZ(next->GPS());
+      bool skip1 = matrix.Analysed(index1st);
 
-        distanceMap1st.insert(std::make_pair(dist, next));
+      // all points may form first edge of a better triangle
+      _triangleEdges1st.clear();
+      for (unsigned next = index1st + 1; next < size; ++next) {
+        _triangleEdges1st.emplace_back(matrix.Distance(index1st, next), next);
       }
+      std::sort(_triangleEdges1st.begin(), _triangleEdges1st.end(), std::greater<CEdge>());
 
       // check all possible first edges of the triangle
-      for (CDistanceMap::reverse_iterator it1st = distanceMap1st.rbegin(); it1st != distanceMap1st.rend(); ++it1st) {
-        bool skip2 = skip1;
-        if (skip2 && (it1st->second->GPS() < *prevFront || it1st->second->GPS() > *prevBack))
-          skip2 = false;
-
-        unsigned dist1st = it1st->first;
-        // create a map of points that may form second edge of a better triangle
-        CDistanceMap distanceMap2nd;
-        const CTrace::CPoint *point2nd = it1st->second;
-        for (next = point2nd->Next(); next; next = next->Next()) {
-          bool skip3 = skip2;
-          if (skip3 && (next->GPS() < *prevFront || next->GPS() > *prevBack))
-            skip3 = false;
-          if (skip3)
+      for (const CEdge &edge1st : _triangleEdges1st) {
+        const unsigned dist1st = edge1st.first;
+        const unsigned index2nd = edge1st.second;
+
+        // upper bound of the triangles using that edge
+        if (2 * (dist1st + matrix.MaxDistance(index2nd)) + 1 <= _resultFREETriangle.PredictedDistance())
+          continue;
+
+        bool skip2 = skip1 && matrix.Analysed(index2nd);
+
+        // find points that may form second edge of a better triangle
+        _triangleEdges2nd.clear();
+        for (unsigned next = index2nd + 1; next < size; ++next) {
+          if (skip2 && matrix.Analysed(next))
             // that triangle was analysed already
             continue;
 
-          unsigned dist = point2nd->GPS().DistanceXYZ(next->GPS());
-          distanceMap2nd.insert(std::make_pair(dist, next));
+          _triangleEdges2nd.emplace_back(matrix.Distance(index2nd, next), next);
         }
+        std::sort(_triangleEdges2nd.begin(), _triangleEdges2nd.end(), std::greater<CEdge>());
 
         // check all possible second and third edges of the triangle
-        for (CDistanceMap::reverse_iterator it2nd = distanceMap2nd.rbegin(); it2nd != distanceMap2nd.rend(); ++it2nd) {
-          unsigned dist2nd = it2nd->first;
-
-          const CTrace::CPoint *point3rd = it2nd->second;
-          unsigned dist3rd = point3rd->GPS().DistanceXYZ(point1st->GPS());
+        for (const CEdge &edge2nd : _triangleEdges2nd) {
+          const unsigned dist2nd = edge2nd.first;
+          const unsigned index3rd = edge2nd.second;
+          unsigned dist3rd = matrix.Distance(index3rd, index1st);
           unsigned total_distance = dist1st + dist2nd + dist3rd;
 
           if ( !FREETriangleEdgeCheck(dist1st, dist2nd, dist3rd) )
             break;
 
+          if (2 * (dist1st + dist2nd) + 1 <= _resultFREETriangle.PredictedDistance())
+            // no better triangle with shorter 2nd edge (+1 for DistanceXYZ() rounding)
+            break;
+
           if ( total_distance > _resultFREETriangle.PredictedDistance() ) {
             CPointGPSArray pointArray = {
               trace.Front()->GPS(),
-              point1st->GPS(),
-              point2nd->GPS(),
-              point3rd->GPS(),
+              matrix.Point(index1st)->GPS(),
+              matrix.Point(index2nd)->GPS(),
+              matrix.Point(index3rd)->GPS(),
               trace.Back()->GPS()
             };
             _resultFREETriangle.UpdateDistancesAndArray(total_distance, total_distance, std::move(pointArray));
           }
         }
       }
-      point1st = point1st->Next();
     }
   }
 
@@ -697,6 +891,8 @@ void CContestMgr::SolveOLCPlus(bool predicted)
 /** 
  * @brief Adds a new GPS fix to analysis
  * 
+ * GPS fix is only queued, analysis is done by the solver thread.
+ *
  * @param gps New GPS fix to use in analysis
  */
 void CContestMgr::Add(unsigned time, double lat, double lon, int alt) {
@@ -706,9 +902,6 @@ void CContestMgr::Add(unsigned time, double lat, double lon, int alt) {
   }
 
   static CPointGPS lastGps(0, 0, 0, 0);
-  static unsigned step = 0;
-  const unsigned STEPS_NUM = 9;
-
 
   const CPointGPSSmart gps = make_CPointGPSSmart(time, lat, lon, alt);
 
@@ -717,13 +910,46 @@ void CContestMgr::Add(unsigned time, double lat, double lon, int alt) {
     return;
   lastGps = *gps;
 
-  ScopeLock guard(_mainCS);
-  {
-    // Update main trace
-    ScopeLock Traceguard(_traceCS);
-    _trace->Push(gps);
-    _trace->Compress();
+  _worker->Add(gps);
+}
+
+
+/**
+ * @brief Updates traces with queued GPS fixes
+ *
+ * Solver thread only, _mainCS Requiered.
+ *
+ * @param fixes New GPS fixes
+ */
+void CContestMgr::PushFixes(const std::vector<CPointGPSSmart> &fixes) {
+  for (const CPointGPSSmart &gps : fixes) {
+    {
+      // Update main trace
+      ScopeLock Traceguard(_traceCS);
+      _trace->Push(gps);
+      _trace->Compress();
+    }
+
+    if (AdditionalContestRule == ContestRule::OLC) {
+      // Update sprint trace
+      _traceSprint->Push(gps);
+      _traceSprint->Compress();
+    }
   }
+}
+
+
+/**
+ * @brief Runs next solver step
+ *
+ * Solver thread only, _mainCS Requiered.
+ *
+ * @param lat Current latitude
+ * @param lon Current longitude
+ */
+void CContestMgr::SolveStep(double lat, double lon) {
+
+  const unsigned step = _step++;
 
   // STEP 0 - Solve OLC-Classic and FAI 3TPs
   if (step % STEPS_NUM == 0 && AdditionalContestRule != ContestRule::FAI_ASSISTANT) {
@@ -774,14 +1000,9 @@ void CContestMgr::Add(unsigned time, double lat, double lon, int alt) {
   }
 
   // STEP 6 - OLC-League
-  if (AdditionalContestRule == ContestRule::OLC) {
-    // Update sprint trace
-    _traceSprint->Push(gps);
-    _traceSprint->Compress();
-    if (step % STEPS_NUM == 6 && AdditionalContestRule == ContestRule::OLC) {
-      // Solve OLC-Sprint
-      SolvePoints(*_traceSprint, true, false);
-    }
+  if (step % STEPS_NUM == 6 && AdditionalContestRule == ContestRule::OLC) {
+    // Solve OLC-Sprint
+    SolvePoints(*_traceSprint, true, false);
   }
 
   // STEP 7 - Update XContest Free Triangle trace. Also needed for FAI_ASSISTANT
@@ -798,10 +1019,9 @@ void CContestMgr::Add(unsigned time, double lat, double lon, int alt) {
       _prevFreeTriangleFront = std::make_unique<CPointGPS>(_traceFreeTriangle->Front()->GPS());
       _prevFreeTriangleBack = std::make_unique<CPointGPS>(_traceFreeTriangle->Back()->GPS());
     }
-    SolveXC();
+    SolveXC(lat, lon);
+    UpdateXCWaypoint();
   }
-
-  step++;
 }
 
 
@@ -827,9 +1047,10 @@ void CContestMgr::Trace(CPointGPSArray &array) const
 /**
  * @brief Find che nearest closing point for FAI triangle Tony 2019
  *
- * @param None will set member variables.
+ * @param lat Current latitude
+ * @param lon Current longitude
  */
-void CContestMgr::FindFAITriangleClosingPoint() {
+void CContestMgr::FindFAITriangleClosingPoint(double lat, double lon) {
 
   CResult &resfai = _resultArray[TYPE_OLC_FAI_PREDICTED];
 
@@ -842,7 +1063,7 @@ void CContestMgr::FindFAITriangleClosingPoint() {
   if (resfai.PointArray().size() > 0) {
     const CTrace::CPoint *p = _trace->Front();
     while (p && p->GPS().Time() <= resfai.PointArray()[1].Time() && p != _trace->Back()) {
-      DistanceBearing(GPS_INFO.Latitude, GPS_INFO.Longitude, p->GPS().Latitude(), p->GPS().Longitude(), &dFAIclosure, &fFAIAngle);
+      DistanceBearing(lat, lon, p->GPS().Latitude(), p->GPS().Longitude(), &dFAIclosure, &fFAIAngle);
       // Find best closure point
       if (dFAIclosure < fFAITriangleBestTogo) {
         //pgpsFAIBestClose = CPointGPS(GPS_INFO.Time, GPS_INFO.Latitude, GPS_INFO.Longitude, GPS_INFO.Altitude);
@@ -853,11 +1074,8 @@ void CContestMgr::FindFAITriangleClosingPoint() {
     }
     _fFAITriangleTogo = fFAITriangleBestTogo;
     if ( pgpsFAIClose.Longitude() != _pgpsFAITriangleClosePoint.Longitude() || pgpsFAIClose.Latitude() != _pgpsFAITriangleClosePoint.Latitude() ) {
-      RasterTerrain::Lock();
-      RasterTerrain::SetTerrainRounding(0,0);
-      const short Alt = RasterTerrain::GetTerrainHeight(pgpsFAIClose.Latitude(),
-                                                        pgpsFAIClose.Longitude());
-      RasterTerrain::Unlock();
+      const short Alt = RasterTerrain::GetSampler(0, 0).GetField(pgpsFAIClose.Latitude(),
+                                                                 pgpsFAIClose.Longitude());
       _pgpsFAITriangleClosePoint = CPointGPS( pgpsFAIClose.Time(),pgpsFAIClose.Latitude(),pgpsFAIClose.Longitude(),Alt);
 
     }
@@ -874,9 +1092,10 @@ void CContestMgr::FindFAITriangleClosingPoint() {
 /**
  * @brief Find che nearest closing point for FREE triangle Tony 2019
  *
- * @param None will set member variables.
+ * @param lat Current latitude
+ * @param lon Current longitude
  */
-void CContestMgr::FindFREETriangleClosingPoint() {
+void CContestMgr::FindFREETriangleClosingPoint(double lat, double lon) {
 
   static double dLastFreeDistance = std::numeric_limits<double>::max();// 100e100;
   double fFreeTriangleBestTogo = std::numeric_limits<double>::max(); // 100e100; // PC does not compile  DBL_MAX;
@@ -887,7 +1106,7 @@ void CContestMgr::FindFREETriangleClosingPoint() {
   if (_resultFREETriangle.PointArray().size() > 0) {
     const CTrace::CPoint *p = _trace->Front();
     while (p && p->GPS().Time() <= _resultFREETriangle.PointArray()[1].Time() && p != _trace->Back()) {
-      DistanceBearing(GPS_INFO.Latitude, GPS_INFO.Longitude, p->GPS().Latitude(), p->GPS().Longitude(), &dFreeclosure, &fFreeAngle);
+      DistanceBearing(lat, lon, p->GPS().Latitude(), p->GPS().Longitude(), &dFreeclosure, &fFreeAngle);
       // Find best closure point
       if (dFreeclosure < fFreeTriangleBestTogo) {
         //pgpsFreeBestClose = CPointGPS(GPS_INFO.Time, GPS_INFO.Latitude, GPS_INFO.Longitude, GPS_INFO.Altitude);
@@ -898,11 +1117,8 @@ void CContestMgr::FindFREETriangleClosingPoint() {
     }
     _fFreeTriangleTogo = fFreeTriangleBestTogo;
     if (pgpsFreeClose.Longitude() != _pgpsFreeTriangleClosePoint.Longitude() || pgpsFreeClose.Latitude() != _pgpsFreeTriangleClosePoint.Latitude()) {
-      RasterTerrain::Lock();
-      RasterTerrain::SetTerrainRounding(0, 0);
-      const short Alt = RasterTerrain::GetTerrainHeight(pgpsFreeClose.Latitude(),
-                                                        pgpsFreeClose.Longitude());
-      RasterTerrain::Unlock();
+      const short Alt = RasterTerrain::GetSampler(0, 0).GetField(pgpsFreeClose.Latitude(),
+                                                                 pgpsFreeClose.Longitude());
       _pgpsFreeTriangleClosePoint = CPointGPS(pgpsFreeClose.Time(), pgpsFreeClose.Latitude(), pgpsFreeClose.Longitude(), Alt);
 
     }
@@ -919,12 +1135,13 @@ void CContestMgr::FindFREETriangleClosingPoint() {
 /**
  * @brief Calculate all Contest results data based on current rule. Tony 2019
  *
- * @param
+ * @param lat Current latitude
+ * @param lon Current longitude
  */
-void CContestMgr::SolveXC() {
+void CContestMgr::SolveXC(double lat, double lon) {
 
-  FindFAITriangleClosingPoint();
-  FindFREETriangleClosingPoint();
+  FindFAITriangleClosingPoint(lat, lon);
+  FindFREETriangleClosingPoint(lat, lon);
 
   ScopeLock guard(_resultsCS);
 
@@ -985,58 +1202,11 @@ void CContestMgr::SolveXC() {
     _XCTriangleClosurePercentage = 100. * ((predicted_distance_fai - current_distance_fai) / predicted_distance_fai);
     _XCTriangleClosureDistance = predicted_distance_fai - current_distance_fai;
     _XCTriangleDistance = predicted_distance_fai;
-
-    WayPointList[RESWP_FAIOPTIMIZED].Latitude = _pgpsFAITriangleClosePoint.Latitude();
-    WayPointList[RESWP_FAIOPTIMIZED].Longitude = _pgpsFAITriangleClosePoint.Longitude();
-    WayPointList[RESWP_FAIOPTIMIZED].Altitude = _pgpsFAITriangleClosePoint.Altitude();
-    if (WayPointList[RESWP_FAIOPTIMIZED].Altitude == 0) WayPointList[RESWP_FAIOPTIMIZED].Altitude = 0.001;
-    WayPointList[RESWP_FAIOPTIMIZED].Reachable = TRUE;
-    WayPointList[RESWP_FAIOPTIMIZED].Visible = TRUE;
-
-    SetWaypointComment(WayPointList[RESWP_FAIOPTIMIZED], MsgToken<1541>());
-    _tcscpy(WayPointList[RESWP_FAIOPTIMIZED].Code, _T("FAI"));
-    switch (_XCFAIStatus) {
-      case XCTriangleStatus::INVALID:
-        _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("FAI*%.0f"),predicted_distance_fai/1000.);
-        break;
-      case XCTriangleStatus::VALID:
-        _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("FAI %.0f"),predicted_distance_fai/1000.);
-        break;
-      case XCTriangleStatus::CLOSED:
-        _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("FAI!%.0f"),predicted_distance_fai/1000.);
-        break;
-    }
   } else if (predicted_score_ft > 0) {
     _bestXCTriangleType = XCFlightType::XC_FREE_TRIANGLE;
     _XCTriangleClosurePercentage = 100. * ((predicted_distance_ft - current_distance_ft) / predicted_distance_ft);
     _XCTriangleClosureDistance = predicted_distance_ft - current_distance_ft;
     _XCTriangleDistance = predicted_distance_ft;
-
-    WayPointList[RESWP_FAIOPTIMIZED].Latitude = _pgpsFreeTriangleClosePoint.Latitude();
-    WayPointList[RESWP_FAIOPTIMIZED].Longitude = _pgpsFreeTriangleClosePoint.Longitude();
-    WayPointList[RESWP_FAIOPTIMIZED].Altitude = _pgpsFreeTriangleClosePoint.Altitude();
-    if (WayPointList[RESWP_FAIOPTIMIZED].Altitude == 0) WayPointList[RESWP_FAIOPTIMIZED].Altitude = 0.001;
-    WayPointList[RESWP_FAIOPTIMIZED].Reachable = TRUE;
-    WayPointList[RESWP_FAIOPTIMIZED].Visible = TRUE;
-    SetWaypointComment(WayPointList[RESWP_FAIOPTIMIZED], MsgToken<1525>());
-    _tcscpy(WayPointList[RESWP_FAIOPTIMIZED].Code, _T("TRI"));
-    switch (_XCFTStatus) {
-      case XCTriangleStatus::INVALID:
-        _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("TRI*%.0f"),predicted_distance_ft/1000.);
-        break;
-      case XCTriangleStatus::VALID:
-        _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("TRI %.0f"),predicted_distance_ft/1000.);
-        break;
-      case XCTriangleStatus::CLOSED:
-        _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("TRI!%.0f"),predicted_distance_ft/1000.);
-        break;
-    }
-  } else {
-    WayPointList[RESWP_FAIOPTIMIZED].Altitude = RESWP_INVALIDNUMBER;
-    WayPointList[RESWP_FAIOPTIMIZED].Reachable = false;
-    WayPointList[RESWP_FAIOPTIMIZED].Visible = false;
-    SetWaypointComment(WayPointList[RESWP_FAIOPTIMIZED], MsgToken<1526>());
-    _tcscpy(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("NO TRIANGLE"));
   }
 
   // Mean Speed. We use current 3TP distance as XCTrack does here.
@@ -1049,6 +1219,70 @@ void CContestMgr::SolveXC() {
 }
 
 
+/**
+ * @brief Updates the reserved waypoint of the best XC triangle closing point
+ */
+void CContestMgr::UpdateXCWaypoint() {
+  ScopeLock lock(CritSec_TaskData);
+  if (WayPointList.size() <= RESWP_FAIOPTIMIZED) {
+    return; // waypoints not loaded
+  }
+
+  switch (_bestXCTriangleType) {
+    case XCFlightType::XC_FAI_TRIANGLE:
+      WayPointList[RESWP_FAIOPTIMIZED].Latitude = _pgpsFAITriangleClosePoint.Latitude();
+      WayPointList[RESWP_FAIOPTIMIZED].Longitude = _pgpsFAITriangleClosePoint.Longitude();
+      WayPointList[RESWP_FAIOPTIMIZED].Altitude = _pgpsFAITriangleClosePoint.Altitude();
+      if (WayPointList[RESWP_FAIOPTIMIZED].Altitude == 0) WayPointList[RESWP_FAIOPTIMIZED].Altitude = 0.001;
+      WayPointList[RESWP_FAIOPTIMIZED].Reachable = TRUE;
+      WayPointList[RESWP_FAIOPTIMIZED].Visible = TRUE;
+
+      SetWaypointComment(WayPointList[RESWP_FAIOPTIMIZED], MsgToken<1541>());
+      _tcscpy(WayPointList[RESWP_FAIOPTIMIZED].Code, _T("FAI"));
+      switch (_XCFAIStatus) {
+        case XCTriangleStatus::INVALID:
+          _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("FAI*%.0f"),_XCTriangleDistance/1000.);
+          break;
+        case XCTriangleStatus::VALID:
+          _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("FAI %.0f"),_XCTriangleDistance/1000.);
+          break;
+        case XCTriangleStatus::CLOSED:
+          _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("FAI!%.0f"),_XCTriangleDistance/1000.);
+          break;
+      }
+      break;
+    case XCFlightType::XC_FREE_TRIANGLE:
+      WayPointList[RESWP_FAIOPTIMIZED].Latitude = _pgpsFreeTriangleClosePoint.Latitude();
+      WayPointList[RESWP_FAIOPTIMIZED].Longitude = _pgpsFreeTriangleClosePoint.Longitude();
+      WayPointList[RESWP_FAIOPTIMIZED].Altitude = _pgpsFreeTriangleClosePoint.Altitude();
+      if (WayPointList[RESWP_FAIOPTIMIZED].Altitude == 0) WayPointList[RESWP_FAIOPTIMIZED].Altitude = 0.001;
+      WayPointList[RESWP_FAIOPTIMIZED].Reachable = TRUE;
+      WayPointList[RESWP_FAIOPTIMIZED].Visible = TRUE;
+      SetWaypointComment(WayPointList[RESWP_FAIOPTIMIZED], MsgToken<1525>());
+      _tcscpy(WayPointList[RESWP_FAIOPTIMIZED].Code, _T("TRI"));
+      switch (_XCFTStatus) {
+        case XCTriangleStatus::INVALID:
+          _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("TRI*%.0f"),_XCTriangleDistance/1000.);
+          break;
+        case XCTriangleStatus::VALID:
+          _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("TRI %.0f"),_XCTriangleDistance/1000.);
+          break;
+        case XCTriangleStatus::CLOSED:
+          _stprintf(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("TRI!%.0f"),_XCTriangleDistance/1000.);
+          break;
+      }
+      break;
+    default:
+      WayPointList[RESWP_FAIOPTIMIZED].Altitude = RESWP_INVALIDNUMBER;
+      WayPointList[RESWP_FAIOPTIMIZED].Reachable = false;
+      WayPointList[RESWP_FAIOPTIMIZED].Visible = false;
+      SetWaypointComment(WayPointList[RESWP_FAIOPTIMIZED], MsgToken<1526>());
+      _tcscpy(WayPointList[RESWP_FAIOPTIMIZED].Name, _T("NO TRIANGLE"));
+      break;
+  }
+}
+
+
 /**
  * @brief Score the Flight
  *
@@ -1516,3 +1750,428 @@ void CContestMgr::UpdateFAIAssistantData() {
 
 
 
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+#include "Time/PeriodClock.hpp"
+
+/**
+ * @brief Test access to CContestMgr triangle solvers
+ */
+class CContestMgrTest {
+public:
+  struct Triangle {
+    unsigned distance = 0;
+    unsigned time[3] = {};
+
+    bool operator==(const Triangle &ref) const {
+      return distance == ref.distance && std::equal(std::begin(time), std::end(time), std::begin(ref.time));
+    }
+  };
+
+private:
+  typedef std::multimap<unsigned, const CTrace::CPoint *> CDistanceMap;
+
+  static void Store(Triangle &result, unsigned distance, const CTrace::CPoint *p1, const CTrace::CPoint *p2, const CTrace::CPoint *p3);
+
+public:
+
+  static Triangle FromResult(const CContestMgr::CResult &result, unsigned distance) {
+    Triangle triangle;
+    if (result.PointArray().size() == 5) {
+      triangle.distance = distance;
+      for (unsigned i = 0; i < 3; ++i) {
+        triangle.time[i] = result.PointArray()[i + 1].Time();
+      }
+    }
+    return triangle;
+  }
+
+  static Triangle FAITriangle(CContestMgr &mgr, const CTrace &trace, const CPointGPS *prevFront, const CPointGPS *prevBack) {
+    mgr._resultArray[CContestMgr::TYPE_OLC_FAI] = CContestMgr::CResult();
+    mgr.SolveFAITriangle(trace, prevFront, prevBack, false);
+    const CContestMgr::CResult &result = mgr._resultArray[CContestMgr::TYPE_OLC_FAI];
+    return FromResult(result, result.Distance());
+  }
+
+  static Triangle FREETriangle(CContestMgr &mgr, const CTrace &trace, const CPointGPS *prevFront, const CPointGPS *prevBack) {
+    mgr._resultFREETriangle = CContestMgr::CResult();
+    mgr.SolveFREETriangle(trace, prevFront, prevBack);
+    return FromResult(mgr._resultFREETriangle, mgr._resultFREETriangle.PredictedDistance());
+  }
+
+  static Triangle LegacyFAITriangle(const CContestMgr &mgr, const CTrace &trace, const CPointGPS *prevFront, const CPointGPS *prevBack);
+  static Triangle LegacyFREETriangle(const CContestMgr &mgr, const CTrace &trace, const CPointGPS *prevFront, const CPointGPS *prevBack);
+
+  static const CTrace &TraceLoop(const CContestMgr &mgr) {
+    return *mgr._traceLoop;
+  }
+  static const CTrace &TraceFreeTriangle(const CContestMgr &mgr) {
+    return *mgr._traceFreeTriangle;
+  }
+};
+
+void CContestMgrTest::Store(Triangle &result, unsigned distance, const CTrace::CPoint *p1, const CTrace::CPoint *p2, const CTrace::CPoint *p3) {
+  result.distance = distance;
+  result.time[0] = p1->GPS().Time();
+  result.time[1] = p2->GPS().Time();
+  result.time[2] = p3->GPS().Time();
+}
+
+namespace {
+
+  bool Inside(const CTrace::CPoint *point, const CPointGPS *prevFront, const CPointGPS *prevBack) {
+    return prevFront && prevBack && !(point->GPS() < *prevFront || point->GPS() > *prevBack);
+  }
+
+} // namespace
+
+// std::multimap based solver used before distance matrix, without prediction
+CContestMgrTest::Triangle CContestMgrTest::LegacyFAITriangle(const CContestMgr &mgr, const CTrace &trace, const CPointGPS *prevFront, const CPointGPS *prevBack) {
+  Triangle best;
+  if (trace.Size() <= 2) {
+    return best;
+  }
+  for (const CTrace::CPoint *point1st = trace.Front(); point1st; point1st = point1st->Next()) {
+    bool skip1 = Inside(point1st, prevFront, prevBack);
+    CDistanceMap distanceMap1st;
+    for (const CTrace::CPoint *next = point1st->Next(); next; next = next->Next()) {
+      unsigned dist = point1st->GPS().DistanceXYZ(next->GPS());
+      if (mgr.FAITriangleEdgeCheck(dist, best.distance))
+        distanceMap1st.insert(std::make_pair(dist, next));
+    }
+    for (auto it1st = distanceMap1st.rbegin(); it1st != distanceMap1st.rend(); ++it1st) {
+      bool skip2 = skip1 && Inside(it1st->second, prevFront, prevBack);
+      unsigned dist1st = it1st->first;
+      if (!mgr.FAITriangleEdgeCheck(dist1st, best.distance))
+        break;
+      CDistanceMap distanceMap2nd;
+      const CTrace::CPoint *point2nd = it1st->second;
+      for (const CTrace::CPoint *next = point2nd->Next(); next; next = next->Next()) {
+        if (skip2 && Inside(next, prevFront, prevBack))
+          continue;
+        unsigned dist = point2nd->GPS().DistanceXYZ(next->GPS());
+        if (dist * 14 > dist1st * 20)
+          continue;
+        if (!mgr.FAITriangleEdgeCheck(dist, best.distance))
+          continue;
+        distanceMap2nd.insert(std::make_pair(dist, next));
+      }
+      for (auto it2nd = distanceMap2nd.rbegin(); it2nd != distanceMap2nd.rend(); ++it2nd) {
+        unsigned dist2nd = it2nd->first;
+        if (!mgr.FAITriangleEdgeCheck(dist2nd, best.distance))
+          break;
+        const CTrace::CPoint *point3rd = it2nd->second;
+        unsigned dist3rd = point3rd->GPS().DistanceXYZ(point1st->GPS());
+        unsigned distance = dist1st + dist2nd + dist3rd;
+        if (distance > best.distance && mgr.FAITriangleEdgeCheck(dist1st, dist2nd, dist3rd)) {
+          Store(best, distance, point1st, point2nd, point3rd);
+        }
+      }
+    }
+  }
+  return best;
+}
+
+CContestMgrTest::Triangle CContestMgrTest::LegacyFREETriangle(const CContestMgr &mgr, const CTrace &trace, const CPointGPS *prevFront, const CPointGPS *prevBack) {
+  Triangle best;
+  if (trace.Size() <= 2) {
+    return best;
+  }
+  for (const CTrace::CPoint *point1st = trace.Front(); point1st; point1st = point1st->Next()) {
+    bool skip1 = Inside(point1st, prevFront, prevBack);
+    CDistanceMap distanceMap1st;
+    for (const CTrace::CPoint *next = point1st->Next(); next; next = next->Next()) {
+      distanceMap1st.insert(std::make_pair(point1st->GPS().DistanceXYZ(next->GPS()), next));
+    }
+    for (auto it1st = distanceMap1st.rbegin(); it1st != distanceMap1st.rend(); ++it1st) {
+      bool skip2 = skip1 && Inside(it1st->second, prevFront, prevBack);
+      unsigned dist1st = it1st->first;
+      CDistanceMap distanceMap2nd;
+      const CTrace::CPoint *point2nd = it1st->second;
+      for (const CTrace::CPoint *next = point2nd->Next(); next; next = next->Next()) {
+        if (skip2 && Inside(next, prevFront, prevBack))
+          continue;
+        distanceMap2nd.insert(std::make_pair(point2nd->GPS().DistanceXYZ(next->GPS()), next));
+      }
+      for (auto it2nd = distanceMap2nd.rbegin(); it2nd != distanceMap2nd.rend(); ++it2nd) {
+        unsigned dist2nd = it2nd->first;
+        const CTrace::CPoint *point3rd = it2nd->second;
+        unsigned dist3rd = point3rd->GPS().DistanceXYZ(point1st->GPS());
+        if (!mgr.FREETriangleEdgeCheck(dist1st, dist2nd, dist3rd))
+          break;
+        unsigned distance = dist1st + dist2nd + dist3rd;
+        if (distance > best.distance) {
+          Store(best, distance, point1st, point2nd, point3rd);
+        }
+      }
+    }
+  }
+  return best;
+}
+
+namespace {
+
+  void Fill(CTrace &trace, const std::vector<CPointGPS> &points) {
+    trace.Clear();
+    for (const auto &point : points) {
+      trace.Push(make_CPointGPSSmart(point.Time(), point.Latitude(), point.Longitude(), point.Altitude()));
+    }
+  }
+
+  // random points in a 1°x1° box, roughly shaped like a glider task
+  std::vector<CPointGPS> RandomTrace(std::mt19937 &gen, unsigned size) {
+    std::uniform_real_distribution<double> pos(-0.5, 0.5);
+    std::vector<CPointGPS> points;
+    for (unsigned i = 0; i < size; ++i) {
+      points.emplace_back(36000 + i * 60, 45. + pos(gen), 10. + pos(gen), 1000);
+    }
+    return points;
+  }
+
+  /**
+   * synthetic flight : 3 laps of a ~120km FAI triangle, 1 fix per second at 30m/s
+   * with a 30s thermal every 3km.
+   */
+  std::vector<CPointGPS> SyntheticFlight() {
+    const double turnpoints[][2] = {{45.0, 10.0}, {45.35, 10.45}, {44.85, 10.6}};
+    std::vector<CPointGPS> fixes;
+    unsigned time = 36000;
+    double lat = turnpoints[0][0];
+    double lon = turnpoints[0][1];
+    for (unsigned leg = 0; leg < 9; ++leg) {
+      const double *target = turnpoints[(leg + 1) % 3];
+      double dist, bearing;
+      DistanceBearing(lat, lon, target[0], target[1], &dist, &bearing);
+      for (double flown = 0; flown < dist; flown += 30) {
+        double next_lat, next_lon;
+        FindLatitudeLongitude(lat, lon, bearing, 30, &next_lat, &next_lon);
+        lat = next_lat;
+        lon = next_lon;
+        fixes.emplace_back(time++, lat, lon, 1500);
+        if (static_cast<unsigned>(flown) % 3000 < 30) {
+          for (unsigned i = 0; i < 30; ++i) {
+            FindLatitudeLongitude(lat, lon, i * 12, 80, &next_lat, &next_lon);
+            fixes.emplace_back(time++, next_lat, next_lon, 1500 + i * 3);
+          }
+        }
+      }
+    }
+    return fixes;
+  }
+
+  // B records of an IGC file
+  std::vector<CPointGPS> ReadIGC(const char *filename) {
+    std::vector<CPointGPS> fixes;
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+      return fixes;
+    }
+    char line[200];
+    while (fgets(line, sizeof(line), file)) {
+      unsigned hour, minute, second, lat_deg, lat_min, lon_deg, lon_min;
+      char lat_hemi, lon_hemi;
+      int baro_alt, gps_alt;
+      if (sscanf(line, "B%02u%02u%02u%02u%05u%c%03u%05u%cA%05d%05d",
+                 &hour, &minute, &second, &lat_deg, &lat_min, &lat_hemi,
+                 &lon_deg, &lon_min, &lon_hemi, &baro_alt, &gps_alt) == 11) {
+        double lat = lat_deg + lat_min / 60000.;
+        double lon = lon_deg + lon_min / 60000.;
+        fixes.emplace_back(hour * 3600 + minute * 60 + second,
+                           (lat_hemi == 'S') ? -lat : lat,
+                           (lon_hemi == 'W') ? -lon : lon,
+                           (gps_alt > 0) ? gps_alt : baro_alt);
+      }
+    }
+    fclose(file);
+    return fixes;
+  }
+
+  std::vector<CPointGPS> Points(const CTrace &trace) {
+    std::vector<CPointGPS> points;
+    for (const CTrace::CPoint *point = trace.Front(); point; point = point->Next()) {
+      points.push_back(point->GPS());
+    }
+    return points;
+  }
+
+  bool SameTrace(const std::vector<CPointGPS> &a, const std::vector<CPointGPS> &b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end());
+  }
+
+} // namespace
+
+TEST_CASE("contest triangle solver") {
+
+  const CContestMgr::ContestRule rule = AdditionalContestRule;
+
+  std::mt19937 gen(42);
+  CContestMgr mgr;
+  CTrace trace(100, 0, CTrace::ALGORITHM_DISTANCE);
+
+  SUBCASE("same result as multimap solver") {
+    unsigned fai_count = 0;
+    for (auto test_rule : { CContestMgr::ContestRule::XContest2019, CContestMgr::ContestRule::UK_NATIONAL_LEAGUE }) {
+      AdditionalContestRule = test_rule;
+      for (unsigned i = 0; i < 300; ++i) {
+        const std::vector<CPointGPS> points = RandomTrace(gen, 3 + i % 23);
+        Fill(trace, points);
+
+        // every 3rd test reuse a random part of the trace as previous loop
+        const CPointGPS *prevFront = nullptr;
+        const CPointGPS *prevBack = nullptr;
+        if (i % 3 == 0) {
+          std::uniform_int_distribution<size_t> index(0, points.size() - 1);
+          prevFront = &points[index(gen)];
+          prevBack = &points[index(gen)];
+          if (*prevBack < *prevFront) {
+            std::swap(prevFront, prevBack);
+          }
+        }
+
+        const auto fai = CContestMgrTest::FAITriangle(mgr, trace, prevFront, prevBack);
+        CHECK(fai == CContestMgrTest::LegacyFAITriangle(mgr, trace, prevFront, prevBack));
+        fai_count += (fai.distance > 0);
+        CHECK(CContestMgrTest::FREETriangle(mgr, trace, prevFront, prevBack) ==
+              CContestMgrTest::LegacyFREETriangle(mgr, trace, prevFront, prevBack));
+      }
+    }
+    // random traces must not be too small to contain FAI triangles
+    CHECK(fai_count > 100);
+  }
+
+  SUBCASE("find FAI triangle") {
+    const std::vector<CPointGPS> points = {
+      {36000, 45.0, 10.0, 1000},
+      {37000, 45.35, 10.45, 1000},
+      {38000, 44.85, 10.6, 1000},
+      {39000, 45.0, 10.0, 1000}
+    };
+    Fill(trace, points);
+    const auto result = CContestMgrTest::FAITriangle(mgr, trace, nullptr, nullptr);
+    CHECK(result.distance > 120000);
+    CHECK(result.time[0] == 36000);
+    CHECK(result.time[1] == 37000);
+    CHECK(result.time[2] == 38000);
+  }
+
+  AdditionalContestRule = rule;
+}
+
+TEST_CASE("contest solver thread") {
+
+  const CContestMgr::ContestRule rule = AdditionalContestRule;
+  AdditionalContestRule = CContestMgr::ContestRule::OLC;
+
+  const std::vector<CPointGPS> fixes = SyntheticFlight();
+
+  CContestMgr mgr;
+  mgr.Reset(100);
+
+  SUBCASE("solve queued fixes") {
+    // first lap of the synthetic triangle, without waiting for the solver
+    for (size_t i = 0; i < fixes.size() / 3; i += 10) {
+      mgr.Add(fixes[i].Time(), fixes[i].Latitude(), fixes[i].Longitude(), fixes[i].Altitude());
+    }
+    mgr.WaitSolver();
+    CHECK(mgr.Result(CContestMgr::TYPE_OLC_CLASSIC, false).Distance() > 100000);
+    CHECK(mgr.Result(CContestMgr::TYPE_OLC_FAI_PREDICTED, false).Distance() > 100000);
+
+    mgr.Reset(100);
+    mgr.WaitSolver();
+    CHECK(mgr.Result(CContestMgr::TYPE_OLC_CLASSIC, false).Distance() == 0);
+  }
+
+  SUBCASE("ignore fixes after stop") {
+    mgr.Stop();
+    for (size_t i = 0; i < 100; ++i) {
+      mgr.Add(fixes[i].Time(), fixes[i].Latitude(), fixes[i].Longitude(), fixes[i].Altitude());
+    }
+    mgr.WaitSolver();
+    CHECK(mgr.Result(CContestMgr::TYPE_OLC_CLASSIC, false).Distance() == 0);
+  }
+
+  AdditionalContestRule = rule;
+}
+
+// not run by default, use '--test-case="contest triangle solver benchmark" --no-skip'
+// set LK_BENCHMARK_IGC to replay an igc file instead of synthetic flight.
+TEST_CASE("contest triangle solver benchmark" * doctest::skip()) {
+
+  const CContestMgr::ContestRule rule = AdditionalContestRule;
+  AdditionalContestRule = CContestMgr::ContestRule::OLC;
+
+  const char *igc = getenv("LK_BENCHMARK_IGC");
+  const std::vector<CPointGPS> fixes = igc ? ReadIGC(igc) : SyntheticFlight();
+  REQUIRE(!fixes.empty());
+
+  // replay the flight, keep each different loop trace for solvers comparison.
+  CContestMgr mgr;
+  mgr.Reset(100);
+  std::vector<std::vector<CPointGPS>> loops;
+  std::vector<CPointGPS> last_loop, last_free_triangle;
+
+  PeriodClock clock;
+  clock.Update();
+  int replay_ms = 0;
+  for (const auto &fix : fixes) {
+    mgr.Add(fix.Time(), fix.Latitude(), fix.Longitude(), fix.Altitude());
+    // run all solver steps for each fix, like the original synchronous solver
+    mgr.WaitSolver();
+
+    replay_ms += clock.ElapsedUpdate();
+    for (auto loop : { std::make_pair(&CContestMgrTest::TraceLoop(mgr), &last_loop),
+                       std::make_pair(&CContestMgrTest::TraceFreeTriangle(mgr), &last_free_triangle) }) {
+      std::vector<CPointGPS> points = Points(*loop.first);
+      if (points.size() > 2 && !SameTrace(*loop.second, points)) {
+        loops.push_back(points);
+        *loop.second = std::move(points);
+      }
+    }
+    clock.Update();
+  }
+  MESSAGE("replay " << fixes.size() << " fixes : " << replay_ms << "ms, "
+          << loops.size() << " loops, FAI-OLC : " << mgr.Result(CContestMgr::TYPE_OLC_FAI_PREDICTED, false).Distance()
+          << "m, Free Triangle : " << mgr.Result(CContestMgr::TYPE_XC_FREE_TRIANGLE, false).PredictedDistance() << "m");
+
+  std::vector<std::unique_ptr<CTrace>> traces;
+  for (const auto &loop : loops) {
+    traces.push_back(std::make_unique<CTrace>(loop.size(), 0, CTrace::ALGORITHM_DISTANCE));
+    Fill(*traces.back(), loop);
+  }
+
+  const unsigned repeat = std::max<size_t>(1, 20000 / traces.size());
+
+  std::vector<CContestMgrTest::Triangle> legacy;
+  clock.Update();
+  for (unsigned i = 0; i < repeat; ++i) {
+    legacy.clear();
+    for (const auto &trace : traces) {
+      legacy.push_back(CContestMgrTest::LegacyFAITriangle(mgr, *trace, nullptr, nullptr));
+      legacy.push_back(CContestMgrTest::LegacyFREETriangle(mgr, *trace, nullptr, nullptr));
+    }
+  }
+  const int legacy_ms = clock.ElapsedUpdate();
+
+  CContestMgr solver;
+  std::vector<CContestMgrTest::Triangle> result;
+  clock.Update();
+  for (unsigned i = 0; i < repeat; ++i) {
+    result.clear();
+    for (const auto &trace : traces) {
+      result.push_back(CContestMgrTest::FAITriangle(solver, *trace, nullptr, nullptr));
+      result.push_back(CContestMgrTest::FREETriangle(solver, *trace, nullptr, nullptr));
+    }
+  }
+  const int matrix_ms = clock.ElapsedUpdate();
+
+  const double solves = 2. * repeat * traces.size();
+  MESSAGE("multimap solver : " << (legacy_ms * 1000. / solves) << "us/solve");
+  MESSAGE("matrix solver : " << (matrix_ms * 1000. / solves) << "us/solve");
+  CHECK(result == legacy);
+
+  AdditionalContestRule = rule;
+}
+
+#endif
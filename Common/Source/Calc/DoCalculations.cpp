@@ -12,6 +12,7 @@
 #include "Sideview.h"
 #include "Multimap.h"
 #include "Comm/ExternalWind.h"
+#include "utils/profiler.h"
 
 
 extern void LD(NMEA_INFO *Basic, DERIVED_INFO *Calculated);
@@ -46,6 +47,7 @@ extern bool TargetDialogOpen;
 
 bool DoCalculations(NMEA_INFO *Basic, DERIVED_INFO *Calculated)
 {
+  profiler::scope timing(profiler::DoCalculations);
 
   // first thing: assign navaltitude!
   EnergyHeightNavAltitude(Basic, Calculated);
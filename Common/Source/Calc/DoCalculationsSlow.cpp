@@ -12,6 +12,7 @@
 #include "DoInits.h"
 #include "MathFunctions.h"
 #include "Radio.h"
+#include "utils/profiler.h"
 
 
 
@@ -26,6 +27,8 @@ void DoCalculationsSlow(NMEA_INFO *Basic, DERIVED_INFO *Calculated) {
   static bool	validHomeWaypoint=false;
   static bool	gotValidFix=false;
 
+  profiler::scope timing(profiler::DoCalculationsSlow);
+
   if (DoInit[MDI_DOCALCULATIONSSLOW]) {
 	LastSearchBestTime = 0; 
 	validHomeWaypoint=false;
@@ -35,10 +38,14 @@ void DoCalculationsSlow(NMEA_INFO *Basic, DERIVED_INFO *Calculated) {
 
   // See also same redundant check inside AirspaceWarning
   // calculate airspace warnings - multicalc approach embedded in CAirspaceManager
-    CAirspaceManager::Instance().AirspaceWarning( Basic, Calculated);
+    {
+      profiler::scope timing(profiler::AirspaceWarning);
+      CAirspaceManager::Instance().AirspaceWarning( Basic, Calculated);
+    }
 
 
     if (FinalGlideTerrain) {
+        profiler::scope timing(profiler::TerrainFootprint);
         TerrainFootprint(Basic, Calculated);
     }
 
@@ -64,6 +71,7 @@ void DoCalculationsSlow(NMEA_INFO *Basic, DERIVED_INFO *Calculated) {
 		// or a real home waypoint position. Which is OK, but only until a real FIX is found!
 		if (HomeWaypoint!=-1) validHomeWaypoint=true;
 
+		profiler::scope timing(profiler::RangeWaypointList);
 		if ( DoRangeWaypointList(Basic,Calculated) )
 			LastDoRangeWaypointListTime=Basic->Time;
 
@@ -77,6 +85,7 @@ void DoCalculationsSlow(NMEA_INFO *Basic, DERIVED_INFO *Calculated) {
 				#if TESTBENCH
 				StartupStore(_T("...... Got first valid FIX, we need to DoRangeWaypoint!\n"));
 				#endif
+				profiler::scope timing(profiler::RangeWaypointList);
 				if ( DoRangeWaypointList(Basic,Calculated) )
 					LastDoRangeWaypointListTime=Basic->Time;
 
@@ -96,6 +105,7 @@ void DoCalculationsSlow(NMEA_INFO *Basic, DERIVED_INFO *Calculated) {
 
 	if (Basic->Time > (LastSearchBestTime + BESTALTERNATEINTERVAL)) {
 		LastSearchBestTime = Basic->Time;
+		profiler::scope timing(profiler::BestAlternate);
 		if (SearchBestAlternate(Basic, Calculated)) {
 			AutomaticRadioStation(GetCurrentPosition(*Basic));
 		}
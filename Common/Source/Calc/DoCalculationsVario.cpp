@@ -7,11 +7,13 @@
 */
 
 #include "Vario.h"
+#include "utils/profiler.h"
 
 extern void NettoVario(NMEA_INFO *Basic, DERIVED_INFO *Calculated);
 extern void SpeedToFly(NMEA_INFO *Basic, DERIVED_INFO *Calculated);
 
 void DoCalculationsVario(NMEA_INFO *Basic, DERIVED_INFO *Calculated) {
+  profiler::scope timing(profiler::DoCalculationsVario);
   if(Basic && Calculated) {
     Vario(*Basic,*Calculated);
     NettoVario(Basic, Calculated);
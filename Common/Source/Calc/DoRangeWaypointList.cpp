@@ -9,6 +9,7 @@
 #include "externs.h"
 #include "DoInits.h"
 #include "NavFunctions.h"
+#include "Waypoints/WaypointIndex.h"
 
 extern int CalculateWaypointApproxDistance(int scx_aircraft, int scy_aircraft, int i);
 
@@ -118,8 +119,14 @@ _retunedst:
   StartupStore(_T(".... dstrangeturnpoint=%d  dstrangelandable=%d\n"),dstrangeturnpoint,dstrangelandable);
   #endif
 
-  for (i=0, kt=0, kl=0, ka=0; i<WayPointList.size(); i++) {
+  // only waypoints near enough are tested, in same order as WayPointList.
+  static std::vector<unsigned> candidates;
+  WaypointIndex::QueryFlat(scx_aircraft, scy_aircraft, std::max(dstrangeturnpoint, dstrangelandable), candidates);
 
+  kt=0, kl=0, ka=0;
+  for (size_t n=0; n<candidates.size(); n++) {
+
+	i = candidates[n];
 	int approx_distance = CalculateWaypointApproxDistance(scx_aircraft, scy_aircraft, i);
 
 	// Size a reasonable distance, wide enough 
@@ -53,7 +53,6 @@ double FarFinalGlideThroughTerrain(const double this_bearing,
   double last_dh=0;
   double altitude;
  
-  RasterTerrain::Lock();
   double retval = 0;
   int i=0;
   bool start_under = false;
@@ -65,23 +64,11 @@ double FarFinalGlideThroughTerrain(const double this_bearing,
 
   double Xrounding = fabs(lon-start_lon)/2;
   double Yrounding = fabs(lat-start_lat)/2;
-  RasterTerrain::SetTerrainRounding(Xrounding, Yrounding);
+  const TerrainSampler Sampler = RasterTerrain::GetSampler(Xrounding, Yrounding);
 
   lat = last_lat = start_lat;
   lon = last_lon = start_lon;
 
-  altitude = myaltitude;
-  h =  max(0, (int)RasterTerrain::GetTerrainHeight(lat, lon)); 
-  if (h==TERRAIN_INVALID) h=0; //@ 101027 FIX
-  dh = altitude - h - SAFETYALTITUDETERRAIN/10;
-  last_dh = dh;
-  if (dh<0) {
-    start_under = true;
-    // already below safety terrain height
-    //    retval = 0;
-    //    goto OnExit;
-  }
-
   // find grid
   double dlat, dlon;
 
@@ -99,6 +86,22 @@ double FarFinalGlideThroughTerrain(const double this_bearing,
   dlat *= f_scale;
   dlon *= f_scale;
 
+  // terrain height of all points of the glide, in one batch
+  short terrain_profile[NUMFINALGLIDETERRAIN + 1];
+  Sampler.GetProfile(lat, lon, dlat, dlon, terrain_profile, NUMFINALGLIDETERRAIN + 1);
+
+  altitude = myaltitude;
+  h =  max(0, (int)terrain_profile[0]); 
+  if (h==TERRAIN_INVALID) h=0; //@ 101027 FIX
+  dh = altitude - h - SAFETYALTITUDETERRAIN/10;
+  last_dh = dh;
+  if (dh<0) {
+    start_under = true;
+    // already below safety terrain height
+    //    retval = 0;
+    //    goto OnExit;
+  }
+
   for (i=1; i<=NUMFINALGLIDETERRAIN; i++) {
     double f;
     bool solution_found = false;
@@ -124,7 +127,7 @@ double FarFinalGlideThroughTerrain(const double this_bearing,
     lon += dlon;
 
     // find height over terrain
-    h =  max(0,(int)RasterTerrain::GetTerrainHeight(lat, lon)); 
+    h =  max(0,(int)terrain_profile[i]); 
     if (h==TERRAIN_INVALID) h=0;
 
     dh = altitude - h - SAFETYALTITUDETERRAIN/10;
@@ -179,7 +182,6 @@ double FarFinalGlideThroughTerrain(const double this_bearing,
   retval = glide_max_range;
 
  OnExit:
-  RasterTerrain::Unlock();
   return retval;
 }
 
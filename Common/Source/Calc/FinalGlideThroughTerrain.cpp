@@ -57,8 +57,6 @@ double FinalGlideThroughTerrain(const double this_bearing,
   double last_dh=0;
   double altitude;
 
-  // Warning: leave this part locked, RasterTerrain need no changes on the map position while working
-  RasterTerrain::Lock();  //@ 101031 WE DO NEED IT!   BUG 101027:  no need, locking individually
   double retval = 0;
   int i=0;
   bool start_under = false;
@@ -70,23 +68,12 @@ double FinalGlideThroughTerrain(const double this_bearing,
 
   double Xrounding = fabs(lon-start_lon)/2;
   double Yrounding = fabs(lat-start_lat)/2;
-  RasterTerrain::SetTerrainRounding(Xrounding, Yrounding);
+  // local sampler : no lock needed, and rounding is not shared with other threads
+  const TerrainSampler Sampler = RasterTerrain::GetSampler(Xrounding, Yrounding);
 
   lat = last_lat = start_lat;
   lon = last_lon = start_lon;
 
-  altitude = start_alt;
-  h =  max((short)0, RasterTerrain::GetTerrainHeight(lat, lon));
-  if (h==TERRAIN_INVALID) h=0; // @ 101027 FIX
-  dh = altitude - h - safetyterrain;
-  last_dh = dh;
-  if (dh<0) {
-    start_under = true;
-    // already below safety terrain height
-    //    retval = 0;
-    //    goto OnExit;
-  }
-
   // find grid
   double dlat, dlon;
 
@@ -104,6 +91,22 @@ double FinalGlideThroughTerrain(const double this_bearing,
   dlat *= f_scale;
   dlon *= f_scale;
 
+  // terrain height of all points of the glide, in one batch
+  short terrain_profile[NUMFINALGLIDETERRAIN + 1];
+  Sampler.GetProfile(lat, lon, dlat, dlon, terrain_profile, NUMFINALGLIDETERRAIN + 1);
+
+  altitude = start_alt;
+  h =  max((short)0, terrain_profile[0]);
+  if (h==TERRAIN_INVALID) h=0; // @ 101027 FIX
+  dh = altitude - h - safetyterrain;
+  last_dh = dh;
+  if (dh<0) {
+    start_under = true;
+    // already below safety terrain height
+    //    retval = 0;
+    //    goto OnExit;
+  }
+
   for (i=1; i<=NUMFINALGLIDETERRAIN; i++) {
     double f;
     bool solution_found = false;
@@ -137,7 +140,7 @@ double FinalGlideThroughTerrain(const double this_bearing,
 
     // find height over terrain
 
-    h =  max((short)0, RasterTerrain::GetTerrainHeight(lat, lon));
+    h =  max((short)0, terrain_profile[i]);
     if (h==TERRAIN_INVALID) h=0; //@ 101027 FIX
 
 
@@ -191,6 +194,5 @@ double FinalGlideThroughTerrain(const double this_bearing,
   retval = glide_max_range;
 
  OnExit:
-  RasterTerrain::Unlock();
   return retval;
 }
@@ -14,12 +14,9 @@ void TerrainHeight(NMEA_INFO *Basic, DERIVED_INFO *Calculated)
 {
   short Alt = 0;
 
-  RasterTerrain::Lock();
   // want most accurate rounding here
-  RasterTerrain::SetTerrainRounding(0,0);
-  Alt = RasterTerrain::GetTerrainHeight(Basic->Latitude, 
-                                        Basic->Longitude);
-  RasterTerrain::Unlock();
+  Alt = RasterTerrain::GetSampler(0, 0).GetField(Basic->Latitude,
+                                                 Basic->Longitude);
 
   if(Alt!=TERRAIN_INVALID) { // terrain invalid is now positive  ex. 32767
 	Calculated->TerrainValid = true;
@@ -275,8 +275,6 @@ void ThermalLocator::EstimateThermalBase(double Thermal_Longitude,
   Tmax = (altitude/wthermal);
   double dt = Tmax/10;
 
-  RasterTerrain::Lock();
-
   double lat, lon;
   FindLatitudeLongitude(Thermal_Latitude, Thermal_Longitude,
                         wind_bearing,
@@ -284,7 +282,7 @@ void ThermalLocator::EstimateThermalBase(double Thermal_Longitude,
                         &lat, &lon);
   double Xrounding = fabs(lon-Thermal_Longitude)/2;
   double Yrounding = fabs(lat-Thermal_Latitude)/2;
-  RasterTerrain::SetTerrainRounding(Xrounding, Yrounding);
+  const TerrainSampler Sampler = RasterTerrain::GetSampler(Xrounding, Yrounding);
 
 //  double latlast = lat;
 //  double lonlast = lon;
@@ -297,7 +295,7 @@ void ThermalLocator::EstimateThermalBase(double Thermal_Longitude,
                           wind_speed*t, &lat, &lon);
 
     double hthermal = altitude-wthermal*t;
-    hground = RasterTerrain::GetTerrainHeight(lat, lon);
+    hground = Sampler.GetField(lat, lon);
     if (hground==TERRAIN_INVALID) hground=0; //@ 101027 FIX
     double dh = hthermal-hground;
     if (dh<0) {
@@ -308,9 +306,8 @@ void ThermalLocator::EstimateThermalBase(double Thermal_Longitude,
       break;
     }
   }
-  hground = RasterTerrain::GetTerrainHeight(lat, lon);
+  hground = Sampler.GetField(lat, lon);
   if (hground==TERRAIN_INVALID) hground=0; //@ 101027 FIX
-  RasterTerrain::Unlock();
 
   *ground_longitude = lon;
   *ground_latitude = lat;
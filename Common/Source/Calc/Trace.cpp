@@ -19,8 +19,11 @@
  */
 CTrace::CTrace(unsigned maxSize, unsigned timeLimit, unsigned algorithm):
   _maxSize(maxSize), _timeLimit(timeLimit), _algorithm(algorithm),
-  _valid(true), _size(0), _analyzedPointCount(0), _front(0), _back(0)
+  _valid(true), _size(0), _analyzedPointCount(0), _free(0), _front(0), _back(0)
 {
+  // one more point than max size, for Push() followed by Compress()
+  Grow(_maxSize + 1);
+  _compressionCostHeap.reserve(_maxSize + 1);
 }
 
 
@@ -41,19 +44,152 @@ void CTrace::Clear()
   CPoint *point = _front;
   while(point) {
     CPoint *next = point->_next;
-    delete point;
+    Release(point);
     point = next;
   }
 
   _valid = true;
   _size = 0;
   _analyzedPointCount = 0;
-  _compressionCostSet.clear();
+  _compressionCostHeap.clear();
   _front = 0;
   _back = 0;
 }
 
 
+/** 
+ * @brief Adds unused points to the pool
+ * 
+ * @param size Number of points to add
+ */
+void CTrace::Grow(unsigned size)
+{
+  _pool.emplace_back(new CPoint[size]);
+  CPoint *points = _pool.back().get();
+  for(unsigned i = 0; i < size; i++) {
+    points[i]._next = _free;
+    _free = &points[i];
+  }
+}
+
+
+/** 
+ * @brief Takes an unused point from the pool
+ * 
+ * The pool size is doubled if all points are in use.
+ */
+CTrace::CPoint *CTrace::Alloc()
+{
+  if(!_free)
+    Grow((_maxSize + 1) << std::min<size_t>(_pool.size() - 1, 16));
+  CPoint *point = _free;
+  _free = point->_next;
+  return point;
+}
+
+
+/** 
+ * @brief Removes a point from the list and gives it back to the pool
+ * 
+ * @param point Point to release
+ */
+void CTrace::Release(CPoint *point)
+{
+  point->Unlink();
+  point->_prev = 0;
+  point->_next = _free;
+  _free = point;
+}
+
+
+/** 
+ * @brief Adds a point to the compression heap
+ */
+void CTrace::HeapPush(CPoint *point)
+{
+  point->_heapIndex = _compressionCostHeap.size();
+  _compressionCostHeap.push_back(point);
+  HeapUp(point->_heapIndex);
+}
+
+
+/** 
+ * @brief Removes a point from the compression heap
+ */
+void CTrace::HeapRemove(CPoint *point)
+{
+  const unsigned index = point->_heapIndex;
+  point->_heapIndex = CPoint::NOT_IN_HEAP;
+
+  CPoint *last = _compressionCostHeap.back();
+  _compressionCostHeap.pop_back();
+  if(last != point) {
+    _compressionCostHeap[index] = last;
+    last->_heapIndex = index;
+    HeapUpdate(last);
+  }
+}
+
+
+/** 
+ * @brief Restores heap order after the cost of a point was changed
+ */
+void CTrace::HeapUpdate(CPoint *point)
+{
+  if(!HeapUp(point->_heapIndex))
+    HeapDown(point->_heapIndex);
+}
+
+
+/** 
+ * @brief Moves a point toward the top of the heap
+ * 
+ * @return @c true if the point was moved
+ */
+bool CTrace::HeapUp(unsigned index)
+{
+  CPoint *point = _compressionCostHeap[index];
+  const unsigned start = index;
+  while(index > 0) {
+    const unsigned parent = (index - 1) / 2;
+    CPoint *parentPoint = _compressionCostHeap[parent];
+    if(!(*point < *parentPoint))
+      break;
+    _compressionCostHeap[index] = parentPoint;
+    parentPoint->_heapIndex = index;
+    index = parent;
+  }
+  _compressionCostHeap[index] = point;
+  point->_heapIndex = index;
+  return index != start;
+}
+
+
+/** 
+ * @brief Moves a point toward the bottom of the heap
+ */
+void CTrace::HeapDown(unsigned index)
+{
+  const unsigned size = _compressionCostHeap.size();
+  CPoint *point = _compressionCostHeap[index];
+  while(true) {
+    unsigned child = 2 * index + 1;
+    if(child >= size)
+      break;
+    if(child + 1 < size && *_compressionCostHeap[child + 1] < *_compressionCostHeap[child])
+      child++;
+    CPoint *childPoint = _compressionCostHeap[child];
+    if(!(*childPoint < *point))
+      break;
+    _compressionCostHeap[index] = childPoint;
+    childPoint->_heapIndex = index;
+    index = child;
+  }
+  _compressionCostHeap[index] = point;
+  point->_heapIndex = index;
+}
+
+
 /** 
  * @brief Adds a new point to a trace
  * 
@@ -65,7 +201,7 @@ void CTrace::Push(CPoint *point)
   _analyzedPointCount++;
   
   if(!_valid) {
-    delete point;
+    Release(point);
     return;
   }
   
@@ -79,13 +215,12 @@ void CTrace::Push(CPoint *point)
     // limit the trace to required time period
     while(_back && _front && (unsigned)_back->_gps->TimeDelta(*_front->_gps) > _timeLimit) {
       CPoint *next = _front->_next;
-      delete _front;
+      Release(_front);
       _size--;
       
       if(next != _back) {
-        // _back and _front are not stored in a _compressionCostSet so skip below actions when next == _back
-        CPointCostSet::iterator nextIt = _compressionCostSet.find(next);
-        if(nextIt == _compressionCostSet.end()) {
+        // _back and _front are not stored in a _compressionCostHeap so skip below actions when next == _back
+        if(next->_heapIndex == CPoint::NOT_IN_HEAP) {
 #ifndef TEST_CONTEST
           if (warnings>=0) {
             StartupStore(_T("%s:%u - ERROR: next not found!!\n"), _T(__FILE__), __LINE__);
@@ -95,7 +230,7 @@ void CTrace::Push(CPoint *point)
           _valid = false;
         }
         else {
-          _compressionCostSet.erase(nextIt);
+          HeapRemove(next);
         }
       }
       
@@ -116,7 +251,7 @@ void CTrace::Push(CPoint *point)
     return;
   
   // add previous point to compression pool
-  _compressionCostSet.insert(_back->_prev);
+  HeapPush(_back->_prev);
 }
 
 
@@ -139,18 +274,17 @@ void CTrace::Compress(unsigned maxSize /* = 0 */)
   
   while(_size > _maxSize) {
     // get the worst point
-    CPointCostSet::iterator worstIt = _compressionCostSet.begin();
-    if(worstIt == _compressionCostSet.end()) {
+    if(_compressionCostHeap.empty()) {
 #ifndef TEST_CONTEST
-      StartupStore(_T("%s:%u - ERROR: _compressionCostSet is empty !!\n"), _T(__FILE__), __LINE__);
+      StartupStore(_T("%s:%u - ERROR: _compressionCostHeap is empty !!\n"), _T(__FILE__), __LINE__);
 #endif
       BUGSTOP_LKASSERT(0);
 		  return;
     }
-    CPoint *worst = *worstIt;
+    CPoint *worst = _compressionCostHeap.front();
     
     // remove the worst point from optimization pool
-    _compressionCostSet.erase(worstIt);
+    HeapRemove(worst);
     
     // find time neighbors
     CPoint *preWorst = worst->_prev;
@@ -158,54 +292,278 @@ void CTrace::Compress(unsigned maxSize /* = 0 */)
     
     // find previous time neighbor
     CPoint *prepreWorst = preWorst->_prev;
-    if(prepreWorst) { 
-      // remove previous neighbor
-      CPointCostSet::iterator preWorstIt = _compressionCostSet.find(preWorst);
-      if(preWorstIt == _compressionCostSet.end()) {
+    if(prepreWorst && preWorst->_heapIndex == CPoint::NOT_IN_HEAP) {
 #ifndef TEST_CONTEST
 	if (warnings>=0) {
           StartupStore(_T("%s:%u - ERROR: preWorst not found!!\n"), _T(__FILE__), __LINE__);
 	  warnings--;
         }
 #endif
-        return;
-      }
-      _compressionCostSet.erase(preWorstIt);
+      return;
     }
     
     // find next time neighbor
     CPoint *postpostWorst = postWorst->_next;
-    if(postpostWorst) { 
-      // remove next neighbor
-      CPointCostSet::iterator postWorstIt = _compressionCostSet.find(postWorst);
-      if(postWorstIt == _compressionCostSet.end()) {
+    if(postpostWorst && postWorst->_heapIndex == CPoint::NOT_IN_HEAP) {
 #ifndef TEST_CONTEST
 	if (warnings>=0) {
           StartupStore(_T("%s:%u - ERROR: postWorst not found!!\n"), _T(__FILE__), __LINE__);
 	  warnings--;
         }
 #endif
-        return;
-      }
-      _compressionCostSet.erase(postWorstIt);
+      return;
     }
     
     // reduce and delete current point
     worst->Reduce();
-    delete worst;
+    Release(worst);
     _size--;
     
     if(prepreWorst) { 
-      // insert next neighbor
+      // update previous neighbor cost
       preWorst->AssesCost();
-      _compressionCostSet.insert(preWorst);
+      HeapUpdate(preWorst);
     }
     if(postpostWorst) { 
-      // insert previous neighbor
+      // update next neighbor cost
       postWorst->AssesCost();
-      _compressionCostSet.insert(postWorst);
+      HeapUpdate(postWorst);
     }
   }
 }
 
 
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+#include <set>
+#include "Time/PeriodClock.hpp"
+
+namespace {
+
+  /**
+   * Reference implementation : points allocated one by one
+   * and compression costs sorted in a std::set.
+   */
+  class LegacyTrace {
+    struct Point {
+      CPointGPSSmart gps;
+      unsigned prevDistance = 0;
+      unsigned distanceCost = 0;
+      unsigned timeCost = 0;
+      Point *prev = nullptr;
+      Point *next = nullptr;
+    };
+
+    struct Cmp {
+      unsigned algorithm;
+      bool operator()(const Point *left, const Point *right) const {
+        unsigned leftCost = left->distanceCost;
+        unsigned rightCost = right->distanceCost;
+        if (algorithm & CTrace::ALGORITHM_TIME_DELTA) {
+          leftCost *= left->timeCost;
+          rightCost *= right->timeCost;
+        }
+        if (leftCost != rightCost)
+          return leftCost < rightCost;
+        if (left->timeCost != right->timeCost)
+          return left->timeCost < right->timeCost;
+        return left->gps->Time() > right->gps->Time();
+      }
+    };
+
+    void AssesCost(Point *point) const {
+      point->distanceCost = std::max(0, (int)(point->prevDistance + point->next->prevDistance
+                                              - point->next->gps->DistanceXYZ(*point->prev->gps)));
+      if (algorithm & CTrace::ALGORITHM_TIME_DELTA)
+        point->timeCost = point->gps->TimeDelta(*point->prev->gps);
+    }
+
+    const unsigned maxSize;
+    const unsigned timeLimit;
+    const unsigned algorithm;
+    unsigned size = 0;
+    std::set<Point *, Cmp> costSet;
+    Point *front = nullptr;
+    Point *back = nullptr;
+
+  public:
+    LegacyTrace(unsigned max_size, unsigned time_limit, unsigned algo)
+        : maxSize(max_size), timeLimit(time_limit), algorithm(algo), costSet(Cmp{algo}) {}
+
+    ~LegacyTrace() {
+      while (front) {
+        Point *next = front->next;
+        delete front;
+        front = next;
+      }
+    }
+
+    void Push(const CPointGPSSmart &gps) {
+      Point *point = new Point();
+      point->gps = gps;
+      point->prev = back;
+      if (back) {
+        point->prevDistance = back->gps->DistanceXYZ(*gps);
+        back->next = point;
+        if (back->prev)
+          AssesCost(back);
+      }
+      back = point;
+      size++;
+      if (!front)
+        front = back;
+
+      if (timeLimit) {
+        while ((unsigned)back->gps->TimeDelta(*front->gps) > timeLimit) {
+          Point *next = front->next;
+          delete front;
+          size--;
+          if (next != back)
+            costSet.erase(next);
+          front = next;
+          front->prevDistance = 0;
+          front->distanceCost = 0;
+          front->timeCost = 0;
+          front->prev = nullptr;
+        }
+      }
+      if (size >= 3)
+        costSet.insert(back->prev);
+    }
+
+    void Compress() {
+      while (size > maxSize) {
+        Point *worst = *costSet.begin();
+        costSet.erase(costSet.begin());
+        Point *pre = worst->prev;
+        Point *post = worst->next;
+        if (pre->prev)
+          costSet.erase(pre);
+        if (post->next)
+          costSet.erase(post);
+        post->prevDistance = std::max(0, (int)(worst->prevDistance + post->prevDistance - worst->distanceCost));
+        pre->next = post;
+        post->prev = pre;
+        delete worst;
+        size--;
+        if (pre->prev) {
+          AssesCost(pre);
+          costSet.insert(pre);
+        }
+        if (post->next) {
+          AssesCost(post);
+          costSet.insert(post);
+        }
+      }
+    }
+
+    std::vector<unsigned> Times() const {
+      std::vector<unsigned> times;
+      for (const Point *point = front; point; point = point->next) {
+        times.push_back(point->gps->Time());
+      }
+      return times;
+    }
+  };
+
+  std::vector<unsigned> Times(const CTrace &trace) {
+    std::vector<unsigned> times;
+    for (const CTrace::CPoint *point = trace.Front(); point; point = point->Next()) {
+      times.push_back(point->GPS().Time());
+    }
+    return times;
+  }
+
+  // random walk at glider speed, 1 fix per second
+  std::vector<CPointGPSSmart> RandomFlight(unsigned seconds) {
+    std::mt19937 gen(seconds);
+    std::normal_distribution<double> turn(0, 0.1);
+    std::vector<CPointGPSSmart> fixes;
+    double lat = 45., lon = 10., heading = 0.;
+    for (unsigned i = 0; i < seconds; ++i) {
+      heading += turn(gen);
+      lat += cos(heading) * 0.0003;
+      lon += sin(heading) * 0.0004;
+      fixes.push_back(make_CPointGPSSmart(28800 + i, lat, lon, 1500 + (i % 600)));
+    }
+    return fixes;
+  }
+
+} // namespace
+
+TEST_CASE("trace compression") {
+
+  const unsigned algorithm = CTrace::ALGORITHM_DISTANCE | CTrace::ALGORITHM_TIME_DELTA;
+  const std::vector<CPointGPSSmart> fixes = RandomFlight(3 * 3600);
+
+  SUBCASE("same points as std::set compression") {
+    for (unsigned time_limit : { 0U, 1800U }) {
+      CTrace trace(100, time_limit, algorithm);
+      LegacyTrace legacy(100, time_limit, algorithm);
+      for (const auto &gps : fixes) {
+        trace.Push(gps);
+        trace.Compress();
+        legacy.Push(gps);
+        legacy.Compress();
+      }
+      CHECK(trace.Size() == 100);
+      CHECK(Times(trace) == legacy.Times());
+    }
+  }
+
+  SUBCASE("push more points than max size") {
+    CTrace trace(7, 0, CTrace::ALGORITHM_DISTANCE);
+    LegacyTrace legacy(7, 0, CTrace::ALGORITHM_DISTANCE);
+    for (unsigned i = 0; i < 500; ++i) {
+      trace.Push(fixes[i * 10]);
+      legacy.Push(fixes[i * 10]);
+    }
+    CHECK(trace.Size() == 500);
+    trace.Compress();
+    legacy.Compress();
+    CHECK(Times(trace) == legacy.Times());
+
+    // pool is reused after clear
+    trace.Clear();
+    CHECK(trace.Size() == 0);
+    CHECK(trace.Front() == nullptr);
+    for (unsigned i = 0; i < 20; ++i) {
+      trace.Push(fixes[i]);
+    }
+    trace.Compress();
+    CHECK(trace.Size() == 7);
+    CHECK(trace.Front()->GPS().Time() == fixes[0]->Time());
+    CHECK(trace.Back()->GPS().Time() == fixes[19]->Time());
+  }
+}
+
+// not run by default, use '--test-case="trace compression benchmark" --no-skip'
+TEST_CASE("trace compression benchmark" * doctest::skip()) {
+
+  const unsigned algorithm = CTrace::ALGORITHM_DISTANCE | CTrace::ALGORITHM_TIME_DELTA;
+  const std::vector<CPointGPSSmart> fixes = RandomFlight(10 * 3600);
+
+  PeriodClock clock;
+  clock.Update();
+  LegacyTrace legacy(100, 0, algorithm);
+  for (const auto &gps : fixes) {
+    legacy.Push(gps);
+    legacy.Compress();
+  }
+  const int legacy_ms = clock.ElapsedUpdate();
+
+  CTrace trace(100, 0, algorithm);
+  for (const auto &gps : fixes) {
+    trace.Push(gps);
+    trace.Compress();
+  }
+  const int heap_ms = clock.ElapsedUpdate();
+
+  MESSAGE("push+compress " << fixes.size() << " fixes");
+  MESSAGE("std::set : " << legacy_ms << "ms");
+  MESSAGE("indexed heap : " << heap_ms << "ms");
+  CHECK(Times(trace) == legacy.Times());
+}
+
+#endif
@@ -23,7 +23,6 @@
 #include <regex>
 
 ComPort::ComPort(unsigned idx, const tstring& sName) : Thread("ComPort"), StopEvt(false), devIdx(idx), sPortName(sName) {
-    pLastNmea = std::begin(_NmeaString);
 }
 
 bool ComPort::Close() {
@@ -133,41 +132,25 @@ void ComPort::Run() {
     StartupStore(_T(". ComPort %u ReadThread : terminated"), GetPortIndex() + 1);
 }
 
-void ComPort::ProcessChar(char c) {
+void ComPort::ProcessData(const char* data, size_t size) {
+    if (size == 0) {
+        return;
+    }
+
     if (ComCheck_ActivePort>=0 && GetPortIndex()==(unsigned)ComCheck_ActivePort) {
-        ComCheck_AddChar(c);
+        for (auto c : std::string_view(data, size)) {
+            ComCheck_AddChar(c);
+        }
     }
 
-    if (devParseStream(devIdx, &c, 1, &GPS_INFO)) {
+    if (devParseStream(devIdx, data, size, &GPS_INFO)) {
         // if this port is used for stream device, leave immediately.
         // don't return mayby more devices on one Port (shared Port)
     }
 
-    // last char need to be reserved for '\0' for avoid buffer overflow
-    // in theory this should never happen because NMEA sentence can't have more than 82 char and _NmeaString size is 160.
-    if (pLastNmea >= std::begin(_NmeaString) && (pLastNmea+1) < std::end(_NmeaString)) {
-
-        if (c == '\n' || c == '\r') {
-            // abcd\n , now closing the line also with \r
-            *(pLastNmea++) = '\n';
-            *(pLastNmea) = '\0'; // terminate string.
-            // process only meaningful sentences, avoid processing a single \n \r etc.
-            if (std::distance(std::begin(_NmeaString), pLastNmea) > 5) {
-                devParseNMEA(devIdx, _NmeaString, &GPS_INFO);
-            }
-        } else {
-            *(pLastNmea++) = c;
-            return;
-        }
-    }
-    // overflow, so reset buffer
-    pLastNmea = std::begin(_NmeaString);
-}
-
-void ComPort::ProcessData(const char* string, size_t size) {
-    for (auto c : std::string_view(string, size)) {
-        ProcessChar(c);
-    }
+    _NmeaLine.Process(data, size, [&](const char* line) {
+        devParseNMEA(devIdx, line, &GPS_INFO);
+    });
 }
 
 void ComPort::AddStatRx(unsigned dwBytes) {
@@ -207,3 +190,169 @@ void ComPort::StatusMessage(const TCHAR *fmt, ...) {
     tmp[126] = _T('\0');
     DoStatusMessage(tmp);
 }
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "Time/PeriodClock.hpp"
+
+namespace {
+
+/**
+ * previous per char line assembly, used as reference.
+ */
+class LegacyLineBuffer {
+public:
+    template<typename Callback>
+    gcc_noinline
+    void ProcessChar(char c, Callback&& on_line) {
+        if (pLastNmea >= std::begin(_NmeaString) && (pLastNmea+1) < std::end(_NmeaString)) {
+            if (c == '\n' || c == '\r') {
+                *(pLastNmea++) = '\n';
+                *(pLastNmea) = '\0';
+                if (std::distance(std::begin(_NmeaString), pLastNmea) > 5) {
+                    on_line(_NmeaString);
+                }
+            } else {
+                *(pLastNmea++) = c;
+                return;
+            }
+        }
+        pLastNmea = std::begin(_NmeaString);
+    }
+
+private:
+    char _NmeaString[MAX_NMEA_LEN];
+    char* pLastNmea = std::begin(_NmeaString);
+};
+
+std::vector<std::string> SplitLines(const std::string& data, size_t chunk) {
+    std::vector<std::string> lines;
+    NMEALineBuffer buffer;
+    for (size_t i = 0; i < data.size(); i += chunk) {
+        const size_t size = std::min(chunk, data.size() - i);
+        buffer.Process(data.data() + i, size, [&](const char* line) {
+            lines.emplace_back(line);
+        });
+    }
+    return lines;
+}
+
+std::vector<std::string> LegacySplitLines(const std::string& data) {
+    std::vector<std::string> lines;
+    LegacyLineBuffer buffer;
+    for (char c : data) {
+        buffer.ProcessChar(c, [&](const char* line) {
+            lines.emplace_back(line);
+        });
+    }
+    return lines;
+}
+
+} // namespace
+
+TEST_CASE("nmea line buffer") {
+
+    const std::string data =
+        "$GPRMC,101530.00,A,4551.2345,N,00612.3456,E,45.3,123.4,150624,,,A*6C\r\n"
+        "\r\n"
+        "$PFLAU,3,1,2,1,1,-45,2,25,452,DD8F12*4A\n"
+        "$ABC\r"
+        "$LXWP0,Y,112.3,1665.5,1.71,,,,,,239,174,10.1*47\r\n"
+        "$PLXVS,23.5,0,12.6";
+
+    SUBCASE("same lines than per char processing") {
+        const auto legacy = LegacySplitLines(data);
+        REQUIRE(legacy.size() == 3);
+        CHECK(legacy[0] == "$GPRMC,101530.00,A,4551.2345,N,00612.3456,E,45.3,123.4,150624,,,A*6C\n");
+        CHECK(legacy[1] == "$PFLAU,3,1,2,1,1,-45,2,25,452,DD8F12*4A\n");
+
+        for (size_t chunk : { 1, 2, 3, 7, 64, 1024 }) {
+            CHECK(SplitLines(data, chunk) == legacy);
+        }
+    }
+
+    SUBCASE("incomplete line is kept for next chunk") {
+        std::vector<std::string> lines;
+        NMEALineBuffer buffer;
+        auto on_line = [&](const char* line) {
+            lines.emplace_back(line);
+        };
+        buffer.Process("$PLXVS,23.5", 11, on_line);
+        CHECK(lines.empty());
+        buffer.Process(",0,12.6\r\n", 9, on_line);
+        REQUIRE(lines.size() == 1);
+        CHECK(lines[0] == "$PLXVS,23.5,0,12.6\n");
+    }
+
+    SUBCASE("too long line is discarded") {
+        const std::string too_long = "$" + std::string(MAX_NMEA_LEN, 'A') + "\r\n";
+        const auto lines = SplitLines(too_long + data, 1024);
+        REQUIRE(lines.size() == 3);
+        CHECK(lines[0].substr(0, 6) == "$GPRMC");
+    }
+}
+
+// not run by default, use '--test-case="nmea line buffer benchmark" --no-skip'
+// set LK_BENCHMARK_STREAM to replay a captured raw stream instead of synthetic data.
+TEST_CASE("nmea line buffer benchmark" * doctest::skip()) {
+
+    std::string data;
+    const char* path = getenv("LK_BENCHMARK_STREAM");
+    if (path) {
+        std::ifstream file(path, std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    } else {
+        const char* sentences[] = {
+            "$GPRMC,101530.00,A,4551.2345,N,00612.3456,E,45.3,123.4,150624,,,A*6C\r\n",
+            "$GPGGA,101530.00,4551.2345,N,00612.3456,E,1,12,0.8,1523.4,M,48.2,M,,*5A\r\n",
+            "$PFLAA,0,-1234,1234,220,2,DD8F12,180,,30,-1.4,1*3B\r\n",
+            "$PFLAU,3,1,2,1,1,-45,2,25,452,DD8F12*4A\r\n",
+            "$LXWP0,Y,112.3,1665.5,1.71,1.52,1.33,1.24,1.15,1.06,239,174,10.1*47\r\n",
+        };
+        while (data.size() < 8 * 1024 * 1024) {
+            for (auto s : sentences) {
+                data += s;
+            }
+        }
+    }
+    REQUIRE(!data.empty());
+
+    // same block size than serial port Rx thread
+    constexpr size_t chunk = 1024;
+    PeriodClock clock;
+
+    size_t legacy_count = 0;
+    clock.Update();
+    LegacyLineBuffer legacy;
+    for (size_t i = 0; i < data.size(); i += chunk) {
+        const size_t size = std::min(chunk, data.size() - i);
+        // previous ProcessData() : one call per char
+        for (char c : std::string_view(data.data() + i, size)) {
+            legacy.ProcessChar(c, [&](const char*) {
+                ++legacy_count;
+            });
+        }
+    }
+    const int legacy_ms = clock.Elapsed();
+
+    size_t count = 0;
+    clock.Update();
+    NMEALineBuffer buffer;
+    for (size_t i = 0; i < data.size(); i += chunk) {
+        const size_t size = std::min(chunk, data.size() - i);
+        buffer.Process(data.data() + i, size, [&](const char*) {
+            ++count;
+        });
+    }
+    const int chunked_ms = clock.Elapsed();
+
+    CHECK(count == legacy_count);
+    MESSAGE(data.size() / 1024 << "kB, " << count << " lines : per char " << legacy_ms
+            << "ms, chunked " << chunked_ms << "ms");
+}
+
+#endif
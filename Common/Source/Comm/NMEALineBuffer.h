@@ -0,0 +1,94 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   NMEALineBuffer.h
+ */
+
+#ifndef _Comm_NMEALineBuffer_h_
+#define _Comm_NMEALineBuffer_h_
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include "Sizes.h"
+
+/**
+ * Assemble lines from received data chunks.
+ *
+ * Data is scanned with memchr() for '\r' or '\n', complete lines are copied once
+ * into the line buffer and given to callback as "xxxx\n" zero terminated string.
+ * Line shorter than 5 char are ignored.
+ *
+ * in theory overflow should never happen because NMEA sentence can't have more than 82 char
+ * and buffer size is 160, but if a line is too long, it's discarded up to next end of line.
+ */
+class NMEALineBuffer final {
+public:
+  NMEALineBuffer() = default;
+
+  NMEALineBuffer(const NMEALineBuffer&) = delete;
+  NMEALineBuffer& operator=(const NMEALineBuffer&) = delete;
+
+  template<typename Callback>
+  void Process(const char* data, size_t size, Callback&& on_line) {
+    const char* const end = std::next(data, size);
+    while (data != end) {
+      const char* eol = FindEndOfLine(data, end);
+      Append(data, eol);
+      if (eol == end) {
+        return; // incomplete line, wait for next chunk
+      }
+      const char* line = Close();
+      if (line) {
+        on_line(line);
+      }
+      data = std::next(eol);
+    }
+  }
+
+  void Reset() {
+    length = 0;
+    overflow = false;
+  }
+
+private:
+  static const char* FindEndOfLine(const char* begin, const char* end) {
+    // sentence usually end with "\r\n", so '\r' is searched only before first '\n'
+    const void* lf = memchr(begin, '\n', std::distance(begin, end));
+    const char* last = lf ? static_cast<const char*>(lf) : end;
+    const void* cr = memchr(begin, '\r', std::distance(begin, last));
+    return cr ? static_cast<const char*>(cr) : last;
+  }
+
+  void Append(const char* begin, const char* end) {
+    const size_t size = std::distance(begin, end);
+    // last 2 char are reserved for '\n' and '\0'
+    if (overflow || (length + size) > (std::size(buffer) - 2)) {
+      overflow = true;
+      return;
+    }
+    std::copy(begin, end, std::next(buffer, length));
+    length += size;
+  }
+
+  // @return nullptr if line must be ignored
+  const char* Close() {
+    // process only meaningful sentences, avoid processing a single \n \r etc.
+    const bool valid = !overflow && length >= 5;
+    if (valid) {
+      buffer[length++] = '\n';
+      buffer[length] = '\0';
+    }
+    Reset();
+    return valid ? buffer : nullptr;
+  }
+
+  char buffer[MAX_NMEA_LEN];
+  size_t length = 0;
+  bool overflow = false;
+};
+
+#endif // _Comm_NMEALineBuffer_h_
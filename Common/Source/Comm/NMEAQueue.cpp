@@ -0,0 +1,285 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   NMEAQueue.cpp
+ */
+
+#include "externs.h"
+#include "NMEAQueue.h"
+#include "Thread/Thread.hpp"
+#include "Poco/Event.h"
+#include <memory>
+
+namespace {
+
+  // ~1s of data at 10Hz with ~3 sentences per fix
+  constexpr size_t queue_capacity = 32;
+  // max sentences per port applied under one lock, keep lock duration short
+  constexpr size_t batch_size = 16;
+
+  struct PortQueue {
+    NMEARing<queue_capacity> ring;
+    std::atomic<size_t> max_depth = {0}; // written by producer
+    std::atomic<unsigned> dropped = {0}; // written by producer
+    std::atomic<unsigned> processed = {0}; // written by consumer
+  };
+
+  PortQueue queues[NUMDEV];
+
+  // static : Rx thread can signal it after ingestion thread is stopped
+  Poco::Event data_event;
+
+  std::atomic<bool> running = {false};
+
+  // consumer side : only ingestion thread can call it, Rx threads can still push.
+  void ClearQueues() {
+    for (auto& queue : queues) {
+      queue.ring.Clear();
+    }
+  }
+
+  class IngestionThread final : public Thread {
+  public:
+    IngestionThread() : Thread("NMEAQueue") {}
+
+    void Stop() {
+      _stop = true;
+      data_event.set();
+      Join();
+    }
+
+  protected:
+    void Run() override {
+      // discard sentences pushed after previous ingestion thread was stopped
+      ClearQueues();
+      running = true;
+
+      while (!_stop) {
+        data_event.tryWait(100);
+        while (!_stop && ProcessBatch()) {
+          // more sentences are pending, don't wait
+        }
+      }
+
+      ClearQueues();
+    }
+
+  private:
+    // @return true if at least one queue was not fully processed
+    static bool ProcessBatch() {
+      size_t count[NUMDEV] = {};
+
+      WithLock(CritSec_FlightData, [&]() {
+        for (unsigned port = 0; port < NUMDEV; ++port) {
+          auto& ring = queues[port].ring;
+          for (const char* String; count[port] < batch_size && (String = ring.Front(count[port])); ++count[port]) {
+            devParseNMEASentence(port, String, &GPS_INFO);
+          }
+        }
+      });
+
+      bool pending = false;
+      for (unsigned port = 0; port < NUMDEV; ++port) {
+        auto& queue = queues[port];
+        for (size_t i = 0; i < count[port]; ++i) {
+          devForwardNMEA(port, queue.ring.Front(i));
+        }
+        queue.ring.Pop(count[port]);
+        queue.processed += count[port];
+        pending |= (count[port] == batch_size);
+      }
+      return pending;
+    }
+
+    std::atomic<bool> _stop = {false};
+  };
+
+  std::unique_ptr<IngestionThread> ingestion_thread;
+
+} // namespace
+
+void NMEAQueue::Start() {
+  Stop();
+
+  // port are closed or not yet pushing : running is false
+  for (auto& queue : queues) {
+    queue.max_depth = 0;
+    queue.dropped = 0;
+    queue.processed = 0;
+  }
+
+  ingestion_thread = std::make_unique<IngestionThread>();
+  if (ingestion_thread->Start()) {
+    StartupStore(_T(". NMEA ingestion queue started"));
+  } else {
+    ingestion_thread = nullptr;
+    StartupStore(_T("... NMEA ingestion queue failed to start"));
+  }
+}
+
+void NMEAQueue::Stop() {
+  if (!ingestion_thread) {
+    return;
+  }
+  running = false;
+  ingestion_thread->Stop();
+  ingestion_thread = nullptr;
+  running = false; // in case ingestion thread was stopped before it set it
+
+  for (unsigned port = 0; port < NUMDEV; ++port) {
+    const Stats stats = GetStats(port);
+    if (stats.processed || stats.dropped) {
+      StartupStore(_T(". NMEA queue %c : %u processed, %u dropped, max depth %u"), _T('A') + port,
+                   stats.processed, stats.dropped, static_cast<unsigned>(stats.max_depth));
+    }
+  }
+}
+
+bool NMEAQueue::Push(unsigned portNum, const char* String) {
+  if (!running || portNum >= NUMDEV) {
+    return false;
+  }
+  if (!NMEAParser::NMEAChecksum(String)) {
+    return false; // corrupted or not NMEA, don't waste a ring slot
+  }
+
+  auto& queue = queues[portNum];
+  if (queue.ring.Push(String)) {
+    const size_t depth = queue.ring.Depth();
+    if (depth > queue.max_depth) {
+      queue.max_depth = depth;
+    }
+  } else {
+    ++queue.dropped;
+  }
+  data_event.set();
+  return true;
+}
+
+NMEAQueue::Stats NMEAQueue::GetStats(unsigned portNum) {
+  if (portNum >= NUMDEV) {
+    return {};
+  }
+  const auto& queue = queues[portNum];
+  return {
+    queue.ring.Depth(),
+    queue.max_depth,
+    queue.processed,
+    queue.dropped
+  };
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <thread>
+#include <string>
+
+TEST_CASE("nmea ring") {
+
+  SUBCASE("fifo") {
+    NMEARing<4> ring;
+    CHECK(ring.Front() == nullptr);
+    CHECK(ring.Push("$A1"));
+    CHECK(ring.Push("$A2"));
+    CHECK(ring.Push("$A3"));
+    CHECK(ring.Push("$A4"));
+    CHECK_FALSE(ring.Push("$A5"));
+    CHECK(ring.Depth() == 4);
+
+    CHECK(std::string_view(ring.Front()) == "$A1");
+    CHECK(std::string_view(ring.Front(3)) == "$A4");
+    CHECK(ring.Front(4) == nullptr);
+
+    ring.Pop(2);
+    CHECK(ring.Depth() == 2);
+    CHECK(std::string_view(ring.Front()) == "$A3");
+    CHECK(ring.Push("$A6"));
+    CHECK(std::string_view(ring.Front(2)) == "$A6");
+
+    ring.Clear();
+    CHECK(ring.Depth() == 0);
+    CHECK(ring.Front() == nullptr);
+  }
+
+  SUBCASE("truncate") {
+    NMEARing<2> ring;
+    const std::string line(MAX_NMEA_LEN * 2, 'x');
+    CHECK(ring.Push(line.c_str()));
+    CHECK(strlen(ring.Front()) == MAX_NMEA_LEN - 1);
+  }
+
+  SUBCASE("threads") {
+    NMEARing<8> ring;
+    constexpr unsigned count = 100000;
+
+    std::thread producer([&]() {
+      char buff[MAX_NMEA_LEN];
+      for (unsigned i = 0; i < count; ) {
+        sprintf(buff, "$%u", i);
+        if (ring.Push(buff)) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    unsigned errors = 0;
+    for (unsigned i = 0; i < count; ) {
+      const char* s = ring.Front();
+      if (s) {
+        errors += (strtoul(s + 1, nullptr, 10) != i);
+        ring.Pop();
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+
+    CHECK(errors == 0);
+    CHECK(ring.Depth() == 0);
+  }
+
+  SUBCASE("clear while pushing") {
+    NMEARing<8> ring;
+    std::atomic<bool> stop = {false};
+
+    std::thread producer([&]() {
+      char buff[MAX_NMEA_LEN];
+      for (unsigned i = 0; !stop; ) {
+        sprintf(buff, "$%u", i);
+        if (ring.Push(buff)) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    // sentences left after Clear() must still be received in order
+    unsigned errors = 0;
+    unsigned last = 0;
+    for (unsigned i = 0; i < 100000; ++i) {
+      if ((i % 16) == 0) {
+        ring.Clear();
+      }
+      const char* s = ring.Front();
+      if (s) {
+        const unsigned value = strtoul(s + 1, nullptr, 10);
+        errors += (value < last);
+        last = value;
+        ring.Pop();
+      }
+    }
+    stop = true;
+    producer.join();
+
+    CHECK(errors == 0);
+    CHECK(ring.Depth() <= 8);
+  }
+}
+
+#endif
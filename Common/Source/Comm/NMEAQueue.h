@@ -0,0 +1,111 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   NMEAQueue.h
+ */
+
+#ifndef _Comm_NMEAQueue_h_
+#define _Comm_NMEAQueue_h_
+
+#include <cstddef>
+#include <cstring>
+#include <atomic>
+#include <algorithm>
+#include <iterator>
+#include "Sizes.h"
+
+/**
+ * Lock-free single producer / single consumer ring of NMEA sentences.
+ *
+ * Producer is the port Rx thread, consumer is the NMEA ingestion thread.
+ * Slot returned by Front() is owned by consumer until Pop(), so sentence
+ * can be parsed in place without copy.
+ */
+template<size_t capacity>
+class NMEARing final {
+  static_assert(capacity && !(capacity & (capacity - 1)), "capacity must be power of 2");
+
+public:
+  NMEARing() = default;
+
+  NMEARing(const NMEARing&) = delete;
+  NMEARing& operator=(const NMEARing&) = delete;
+
+  // producer side, @return false if ring is full
+  bool Push(const char* sentence) {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if ((head - _tail.load(std::memory_order_acquire)) >= capacity) {
+      return false;
+    }
+    char* slot = _slots[head & (capacity - 1)];
+    const size_t size = std::min(strlen(sentence), std::size(_slots[0]) - 1);
+    std::copy_n(sentence, size, slot);
+    slot[size] = '\0';
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // consumer side, @return nullptr if ring is empty
+  const char* Front(size_t i = 0) const {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (i >= (_head.load(std::memory_order_acquire) - tail)) {
+      return nullptr;
+    }
+    return _slots[(tail + i) & (capacity - 1)];
+  }
+
+  // consumer side, release <count> slots
+  void Pop(size_t count = 1) {
+    _tail.store(_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+  }
+
+  size_t Depth() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+  // consumer side, discard all pending sentences
+  void Clear() {
+    _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+
+private:
+  char _slots[capacity][MAX_NMEA_LEN];
+  std::atomic<size_t> _head = {0}; // written by producer
+  std::atomic<size_t> _tail = {0}; // written by consumer
+};
+
+/**
+ * NMEA ingestion thread.
+ *
+ * When enabled, port Rx threads only push received sentences into one ring per port,
+ * and a single thread apply them to GPS_INFO by batch, under only one CritSec_FlightData lock.
+ * Rx threads never wait for calculation or draw thread : if ring is full, sentence is dropped.
+ * Only sentences with valid checksum are queued, others are parsed by Rx thread like before.
+ */
+namespace NMEAQueue {
+
+  struct Stats {
+    size_t depth; // sentences waiting
+    size_t max_depth;
+    unsigned processed;
+    unsigned dropped;
+  };
+
+  // Called from devInit(), after all port are opened.
+  void Start();
+
+  // Called from devCloseAll(), before port are closed, pending sentences are discarded by ingestion thread.
+  void Stop();
+
+  /**
+   * Called from port Rx thread
+   * @return false if queue is not running or if checksum is invalid, sentence must be parsed by caller.
+   */
+  bool Push(unsigned portNum, const char* String);
+
+  Stats GetStats(unsigned portNum);
+}
+
+#endif // _Comm_NMEAQueue_h_
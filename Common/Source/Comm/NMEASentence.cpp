@@ -0,0 +1,290 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   NMEASentence.cpp
+ */
+
+#include "externs.h"
+#include "NMEASentence.h"
+#include <algorithm>
+
+NMEASentence::NMEASentence(const char* str) : string(str ? str : "") {
+
+  const char* field = string;
+  bool is_address = true;
+
+  auto push_field = [&](const char* end) {
+    if (is_address) {
+      address = std::string_view(field, std::distance(field, end));
+      is_address = false;
+    } else if (count < std::size(fields)) {
+      fields[count++] = std::string_view(field, std::distance(field, end));
+    }
+  };
+
+  const char* it = string;
+  if (*it == '$') {
+    ++it; // '$' is not part of checksum
+  }
+
+  for (; *it && *it != '*'; ++it) {
+    checksum ^= static_cast<uint8_t>(*it);
+    if (*it == ',') {
+      push_field(it);
+      field = std::next(it);
+    }
+  }
+
+  const char* end = it;
+  if (*it == '*') {
+    has_checksum = true;
+    while (*it) {
+      uint8_t digit = HexDigit(*(++it));
+      if (0xFF == digit) {
+        break;
+      }
+      read_checksum = (read_checksum << 4) | digit;
+    }
+  } else {
+    // no checksum : remove trailing <CR><LF>
+    while (end > field && (end[-1] == '\r' || end[-1] == '\n')) {
+      --end;
+    }
+  }
+  push_field(end);
+}
+
+bool NMEASentence::ChecksumValid() const {
+  if (!CheckSum) {
+    return true;
+  }
+  return has_checksum && (checksum == read_checksum);
+}
+
+double NMEASentence::ToDouble(size_t i) const {
+  // field is followed by ',', '*' or end of string, so StrToDouble stop at end of field.
+  return StrToDouble((*this)[i].data(), nullptr);
+}
+
+bool NMEASentence::ToDouble(size_t i, double* value) const {
+  const std::string_view field = (*this)[i];
+  if (field.empty()) {
+    *value = 0; // like StrToDouble(), callers may ignore the result
+    return false;
+  }
+  const char* stop = nullptr;
+  *value = StrToDouble(field.data(), &stop);
+  return stop == std::next(field.data(), field.size());
+}
+
+void NMEASentence::Copy(size_t i, char* dst, size_t size) const {
+  if (!dst || size == 0) {
+    return;
+  }
+  const std::string_view field = (*this)[i];
+  const size_t n = std::min(field.size(), size - 1);
+  std::copy_n(field.data(), n, dst);
+  dst[n] = '\0';
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Time/PeriodClock.hpp"
+
+using std::string_view_literals::operator""sv;
+
+TEST_CASE("nmea sentence") {
+
+  const bool check_sum = CheckSum;
+  CheckSum = true;
+
+  SUBCASE("fields") {
+    NMEASentence s("$LXWP0,Y,222.3,1665.5,1.71,,,,,,239,174,10.1*47\r\n");
+    CHECK(s.Address() == "$LXWP0"sv);
+    CHECK(s.size() == 12);
+    CHECK(s[0] == "Y"sv);
+    CHECK(s[1] == "222.3"sv);
+    CHECK(s[4] == ""sv);
+    CHECK(s[11] == "10.1"sv);
+    CHECK(s[12] == ""sv);
+    CHECK(s.ToDouble(2) == 1665.5);
+    CHECK(s.ToDouble(4) == 0.);
+    CHECK(s.ToDouble(12) == 0.);
+
+    // must match old ExtractParameter for all fields
+    char legacy[MAX_NMEA_LEN];
+    char copy[MAX_NMEA_LEN];
+    for (size_t i = 0; i < s.size(); ++i) {
+      NMEAParser::ExtractParameter(s.c_str() + 7, legacy, i);
+      s.Copy(i, copy);
+      CHECK(std::string_view(legacy) == std::string_view(copy));
+    }
+  }
+
+  SUBCASE("checksum") {
+    char valid[MAX_NMEA_LEN] = "$PFLAU,3,1,2,1,1,-45,2,25,452,ABCDEF";
+    NMEAParser::AppendChecksum(valid);
+    CHECK(NMEASentence(valid).ChecksumValid());
+    CHECK(NMEAParser::NMEAChecksum(valid));
+
+    CHECK_FALSE(NMEASentence("$PFLAU,3,1,2,1,1,-45,2,25,452,ABCDEF*00").ChecksumValid());
+    CHECK_FALSE(NMEASentence("$PFLAU,3,1,2,1,1,-45,2,25,452,ABCDEF").ChecksumValid());
+    CHECK_FALSE(NMEASentence("").ChecksumValid());
+    CHECK_FALSE(NMEASentence(nullptr).ChecksumValid());
+
+    CheckSum = false;
+    CHECK(NMEASentence("$PFLAU,3,1,2,1,1,-45,2,25,452,ABCDEF*00").ChecksumValid());
+  }
+
+  SUBCASE("no checksum") {
+    NMEASentence s("!xcv,1.5\r\n");
+    CHECK(s.Address() == "!xcv"sv);
+    CHECK(s.size() == 1);
+    CHECK(s[0] == "1.5"sv);
+  }
+
+  SUBCASE("ToDouble") {
+    NMEASentence s("$PLXVF,,1.5,abc,-2, 3,");
+    double value = 42;
+    CHECK_FALSE(s.ToDouble(0, &value));
+    CHECK(value == 0);
+    CHECK(s.ToDouble(1, &value));
+    CHECK(value == 1.5);
+    CHECK_FALSE(s.ToDouble(2, &value));
+    CHECK(s.ToDouble(3, &value));
+    CHECK(value == -2);
+    CHECK(s.ToDouble(4, &value));
+    CHECK(value == 3);
+    CHECK_FALSE(s.ToDouble(5, &value));
+    CHECK_FALSE(s.ToDouble(6, &value));
+  }
+
+  SUBCASE("Copy") {
+    NMEASentence s("$LXWP1,LX5000IGC-2,15862,11.1 ,2.0*4A");
+    char small[4];
+    s.Copy(0, small);
+    CHECK(std::string_view(small) == "LX5"sv);
+    s.Copy(9, small);
+    CHECK(std::string_view(small) == ""sv);
+  }
+
+  SUBCASE("too many fields") {
+    std::string str = "$PTEST";
+    for (size_t i = 0; i < MAX_NMEA_PARAMS + 10; ++i) {
+      str += "," + std::to_string(i);
+    }
+    NMEASentence s(str.c_str());
+    CHECK(s.size() == MAX_NMEA_PARAMS);
+    CHECK(s.ToDouble(MAX_NMEA_PARAMS - 1) == MAX_NMEA_PARAMS - 1);
+  }
+
+  CheckSum = check_sum;
+}
+
+namespace {
+
+std::vector<std::string> SyntheticNMEA() {
+  const char* sentences[] = {
+    "$GPRMC,101530.00,A,4551.2345,N,00612.3456,E,45.3,123.4,150624,,,A",
+    "$GPGGA,101530.00,4551.2345,N,00612.3456,E,1,12,0.8,1523.4,M,48.2,M,,",
+    "$LXWP0,Y,112.3,1665.5,1.71,1.52,1.33,1.24,1.15,1.06,239,174,10.1",
+    "$PLXVF,10.25,0.12,0.05,9.81,1.52,112.3,1665.5,1,0.5",
+    "$PFLAA,0,-1234,1234,220,2,DD8F12,180,,30,-1.4,1",
+    "$PFLAU,3,1,2,1,1,-45,2,25,452,DD8F12",
+    "$PLXVS,23.5,0,12.6",
+  };
+  std::vector<std::string> out;
+  for (int i = 0; i < 1000; ++i) {
+    for (auto sentence : sentences) {
+      char buff[MAX_NMEA_LEN];
+      strcpy(buff, sentence);
+      NMEAParser::AppendChecksum(buff);
+      out.emplace_back(buff);
+    }
+  }
+  return out;
+}
+
+std::vector<std::string> ReadNMEA(const char* path) {
+  std::vector<std::string> out;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty() && line.size() < MAX_NMEA_LEN) {
+      out.push_back(line);
+    }
+  }
+  return out;
+}
+
+} // namespace
+
+// not run by default, use '--test-case="nmea sentence benchmark" --no-skip'
+// set LK_BENCHMARK_NMEA to parse a recorded nmea log instead of synthetic sentences.
+TEST_CASE("nmea sentence benchmark" * doctest::skip()) {
+
+  const bool check_sum = CheckSum;
+  CheckSum = true;
+
+  const char* log = getenv("LK_BENCHMARK_NMEA");
+  const std::vector<std::string> lines = log ? ReadNMEA(log) : SyntheticNMEA();
+  REQUIRE(!lines.empty());
+
+  constexpr unsigned repeat = 20;
+  PeriodClock clock;
+
+  // old way : checksum then rescan from start for each field
+  double legacy_sum = 0;
+  size_t field_count = 0;
+  clock.Update();
+  for (unsigned r = 0; r < repeat; ++r) {
+    for (const auto& line : lines) {
+      const char* str = line.c_str();
+      if (!NMEAParser::NMEAChecksum(str)) {
+        continue;
+      }
+      const char* data = strchr(str, ',');
+      if (!data) {
+        continue;
+      }
+      ++data;
+      const char* data_end = strchr(data, '*');
+      const size_t n = std::count(data, data_end ? data_end : data + strlen(data), ',') + 1;
+      for (size_t i = 0; i < n; ++i) {
+        char temp[80];
+        NMEAParser::ExtractParameter(data, temp, i);
+        legacy_sum += StrToDouble(temp, nullptr);
+      }
+      field_count += n;
+    }
+  }
+  const int legacy_ms = clock.Elapsed();
+
+  double sum = 0;
+  clock.Update();
+  for (unsigned r = 0; r < repeat; ++r) {
+    for (const auto& line : lines) {
+      NMEASentence sentence(line.c_str());
+      if (!sentence.ChecksumValid()) {
+        continue;
+      }
+      for (size_t i = 0; i < sentence.size(); ++i) {
+        sum += sentence.ToDouble(i);
+      }
+    }
+  }
+  const int tokenized_ms = clock.Elapsed();
+
+  CHECK(sum == legacy_sum);
+  MESSAGE(lines.size() * repeat << " sentences, " << field_count << " fields : ExtractParameter "
+          << legacy_ms << "ms, NMEASentence " << tokenized_ms << "ms");
+
+  CheckSum = check_sum;
+}
+
+#endif
@@ -0,0 +1,85 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   NMEASentence.h
+ */
+
+#ifndef _Comm_NMEASentence_h_
+#define _Comm_NMEASentence_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "Sizes.h"
+
+/**
+ * Tokenized view of one NMEA sentence.
+ *
+ * The sentence is scanned only once : checksum is computed while fields are split.
+ * Fields are string_view into the original string, nothing is copied, so
+ * the string must outlive this object.
+ *
+ *  "$LXWP0,Y,222.3,1665.5*4A" : Address() is "$LXWP0", [0] is "Y", [1] is "222.3" ...
+ *
+ * Field index start after address, like the old ExtractParameter(&String[7], ...).
+ * Checksum and trailing <CR><LF> are not part of last field.
+ * Fields over MAX_NMEA_PARAMS are ignored.
+ */
+class NMEASentence final {
+public:
+  explicit NMEASentence(const char* string);
+
+  NMEASentence(const NMEASentence&) = delete;
+  NMEASentence& operator=(const NMEASentence&) = delete;
+
+  const char* c_str() const {
+    return string;
+  }
+
+  // first field, including leading '$'
+  std::string_view Address() const {
+    return address;
+  }
+
+  // true if sentence has a valid checksum or if checksum check is disabled, same as NMEAParser::NMEAChecksum()
+  bool ChecksumValid() const;
+
+  // number of fields after address
+  size_t size() const {
+    return count;
+  }
+
+  // field after address, empty if <i> is out of range
+  std::string_view operator[](size_t i) const {
+    return (i < count) ? fields[i] : std::string_view();
+  }
+
+  // same as StrToDouble(field, nullptr) : 0 if field is empty
+  double ToDouble(size_t i) const;
+
+  // <value> is always set, 0 if field is empty
+  // @return false if field is empty or is not a number
+  bool ToDouble(size_t i, double* value) const;
+
+  // copy field into zero terminated buffer, truncated if buffer is too small
+  void Copy(size_t i, char* dst, size_t size) const;
+
+  template<size_t size>
+  void Copy(size_t i, char (&dst)[size]) const {
+    Copy(i, dst, size);
+  }
+
+private:
+  const char* string;
+  std::string_view address;
+  std::string_view fields[MAX_NMEA_PARAMS];
+  size_t count = 0;
+
+  bool has_checksum = false;
+  uint8_t checksum = 0; // calculated
+  uint8_t read_checksum = 0; // read after '*'
+};
+
+#endif // _Comm_NMEASentence_h_
@@ -25,6 +25,7 @@
 #include "LKInterface.h"
 #include "Baro.h"
 #include "Comm/wait_ack.h"
+#include "Comm/NMEAQueue.h"
 #include "OS/Sleep.h"
 
 #ifdef __linux__
@@ -731,6 +732,10 @@ BOOL devInit() {
 
     }
 
+    if (EnableNMEAQueue && !SIMMODE) {
+        NMEAQueue::Start();
+    }
+
     return TRUE;
 }
 
@@ -759,6 +764,8 @@ static void devClose(DeviceDescriptor_t& d) {
 }
 
 void devCloseAll() {
+  // stop NMEA ingestion before ports are closed, pending sentences are discarded.
+  NMEAQueue::Stop();
   std::for_each(std::begin(DeviceList), std::end(DeviceList), &devClose);
 }
 
@@ -772,7 +779,7 @@ DeviceDescriptor_t* devGetDeviceOnPort(unsigned Port){
 }
 
 
-BOOL devParseStream(int portNum, char* stream, int length, NMEA_INFO *pGPS) {
+BOOL devParseStream(int portNum, const char* stream, int length, NMEA_INFO *pGPS) {
   DeviceDescriptor_t* din = devGetDeviceOnPort(portNum);
   if (!din) {
     return FALSE;
@@ -812,12 +819,30 @@ void devParseNMEA(int portNum, const char* String, NMEA_INFO *pGPS){
 
   d->HB=LKHearthBeats;
 
+  if (pGPS == &GPS_INFO && NMEAQueue::Push(portNum, String)) {
+    return; // parsed later by NMEA ingestion thread
+  }
+
+  devParseNMEASentence(portNum, String, pGPS);
+  devForwardNMEA(portNum, String);
+}
+
+// Called from devParseNMEA() or from NMEA ingestion thread with CritSec_FlightData locked
+void devParseNMEASentence(int portNum, const char* String, NMEA_INFO *pGPS) {
+  DeviceDescriptor_t* d = devGetDeviceOnPort(portNum);
+  if (!d || !d->Com) {
+    return;
+  }
+
+  // tokenized once for all device specific parser
+  const NMEASentence sentence(String);
+
   // intercept device specific parser routines 
     for(DeviceDescriptor_t& d2 : DeviceList) {
 
       if((d2.iSharedPort == portNum) ||  (d2.PortNumber == portNum)) {
 
-        if ( d2.ParseNMEA && WithLock(CritSec_FlightData, d2.ParseNMEA, d, String, pGPS) ) {
+        if ( d2.ParseNMEA && WithLock(CritSec_FlightData, d2.ParseNMEA, d, sentence, pGPS) ) {
           continue;
         }
         // call ParseNMEAString_Internal only for master port if string are not device specific.
@@ -826,6 +851,14 @@ void devParseNMEA(int portNum, const char* String, NMEA_INFO *pGPS){
         }
       }
     }
+}
+
+// Must be called without CritSec_FlightData locked, write to port can wait for TX buffer.
+void devForwardNMEA(int portNum, const char* String) {
+  DeviceDescriptor_t* d = devGetDeviceOnPort(portNum);
+  if (!d) {
+    return;
+  }
 
     if(d->nmeaParser.activeGPS) {
 
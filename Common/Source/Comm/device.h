@@ -10,6 +10,7 @@
 #include "Util/tstring.hpp"
 #include "utils/stl_utils.h"
 #include "Comm/wait_ack.h"
+#include "Comm/NMEASentence.h"
 
 #define	NUMDEV		 6
 
@@ -77,8 +78,8 @@ struct DeviceDescriptor_t {
   TCHAR	Name[DEVNAMESIZE+1];
 
   BOOL (*DirectLink)(DeviceDescriptor_t* d, BOOL	bLinkEnable);
-  BOOL (*ParseNMEA)(DeviceDescriptor_t* d, const char *String, NMEA_INFO *GPS_INFO);
-  BOOL (*ParseStream)(DeviceDescriptor_t* d, char *String, int len, NMEA_INFO *GPS_INFO);
+  BOOL (*ParseNMEA)(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *GPS_INFO);
+  BOOL (*ParseStream)(DeviceDescriptor_t* d, const char *String, int len, NMEA_INFO *GPS_INFO);
   BOOL (*PutMacCready)(DeviceDescriptor_t	*d,	double McReady);
   BOOL (*PutBugs)(DeviceDescriptor_t* d, double	Bugs);
   BOOL (*PutBallast)(DeviceDescriptor_t	*d,	double Ballast);
@@ -195,7 +196,9 @@ bool devIsDisabled();
 BOOL devOpen(DeviceDescriptor_t* d);
 BOOL devDirectLink(DeviceDescriptor_t* d,	BOOL bLink);
 void devParseNMEA(int portNum, const char *String,	NMEA_INFO	*GPS_INFO);
-BOOL devParseStream(int portNum, char *String,int len,	NMEA_INFO	*GPS_INFO);
+void devParseNMEASentence(int portNum, const char *String, NMEA_INFO *GPS_INFO);
+void devForwardNMEA(int portNum, const char *String);
+BOOL devParseStream(int portNum, const char *String,int len,	NMEA_INFO	*GPS_INFO);
 BOOL devPutMacCready(double MacCready, DeviceDescriptor_t* Sender);
 BOOL devRequestFlarmVersion(DeviceDescriptor_t* d);
 BOOL devPutBugs(double	Bugs, DeviceDescriptor_t* Sender);
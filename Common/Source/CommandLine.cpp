@@ -7,6 +7,10 @@
 */
 
 #include "externs.h"
+#include "Terrain/TerrainTiles.h"
+#include "Topology/TopologyStore.h"
+#include "Logger/ReplayBenchmark.h"
+#include "utils/profiler.h"
 
 #if !defined(UNDER_CE) || defined(__linux__) && !defined(ANDROID)
 
@@ -38,6 +42,12 @@ bool LK8000GetOpts(const TCHAR *MyCommandLine) {
      SysOpMode=true;
   }
 
+  pC = _tcsstr(MyCommandLine, TEXT("-profiler"));
+  if (pC != NULL){
+     profiler::Enable(true);
+     StartupStore(_T(". CommandLine profiler enabled, see %s%sPROFILER.TXT"), _T(LKD_LOGS), _T(DIRSEP));
+  }
+
   pC = _tcsstr(MyCommandLine, TEXT("-help"));
   if (pC != NULL){
 
@@ -60,6 +70,16 @@ bool LK8000GetOpts(const TCHAR *MyCommandLine) {
           force terrain quantization=n\n\
  -sysop\n\
           start with sysop mode active\n\
+ -profiler\n\
+          append calculation, drawing and lock wait timing to _Logger/PROFILER.TXT every minute\n\
+ -tiledem=filename\n\
+          convert terrain filename.dem to tiled terrain filename_tiled.dem and exit\n\
+ -topostore=directory\n\
+          convert shapefiles listed in directory/topology.tpl to compact .xtp files and exit\n\
+ -replay=filename.igc\n\
+          replay igc file through calculations as fast as possible, print timing and exit\n\
+ -replaytask=filename\n\
+          task to load before -replay (.lkt, .cup, .gpx or .xctsk)\n\
 \n");
 
   return false; 
@@ -229,6 +249,97 @@ bool LK8000GetOpts(const TCHAR *MyCommandLine) {
      }
   }
 
+  pC = _tcsstr(MyCommandLine, TEXT("-tiledem="));
+  if (pC != NULL){
+     pC += strlen("-tiledem=");
+     if (*pC == '"'){
+        pC++;
+        pCe = pC;
+        while (*pCe != '"' && *pCe != '\0') pCe++;
+     } else{
+        pCe = pC;
+        while (*pCe != ' ' && *pCe != '\0') pCe++;
+     }
+     if (pCe != NULL && pCe > pC) {
+        TCHAR src[MAX_PATH];
+        TCHAR dst[MAX_PATH];
+        LK_tcsncpy(src, pC, std::min<size_t>(pCe-pC, MAX_PATH-1));
+        _tcscpy(dst, src);
+        TCHAR* ext = _tcsrchr(dst, _T('.'));
+        if (ext) {
+           *ext = _T('\0');
+        }
+        _tcsncat(dst, _T("_tiled.dem"), MAX_PATH - _tcslen(dst) - 1);
+
+        const bool success = TerrainTiles::Convert(src, dst);
+        _ftprintf(stderr, _T("%s : %s -> %s\n"), success ? _T("terrain converted") : _T("terrain conversion failed"), src, dst);
+     }
+     return false;
+  }
+
+  pC = _tcsstr(MyCommandLine, TEXT("-topostore="));
+  if (pC != NULL){
+     pC += strlen("-topostore=");
+     if (*pC == '"'){
+        pC++;
+        pCe = pC;
+        while (*pCe != '"' && *pCe != '\0') pCe++;
+     } else{
+        pCe = pC;
+        while (*pCe != ' ' && *pCe != '\0') pCe++;
+     }
+     if (pCe != NULL && pCe > pC) {
+        TCHAR directory[MAX_PATH];
+        LK_tcsncpy(directory, pC, std::min<size_t>(pCe-pC, MAX_PATH-1));
+
+        const unsigned count = TopologyStore::ConvertMap(directory);
+        _ftprintf(stderr, _T("%u topology files converted in %s\n"), count, directory);
+     }
+     return false;
+  }
+
+  pC = _tcsstr(MyCommandLine, TEXT("-replay="));
+  if (pC != NULL){
+     pC += strlen("-replay=");
+     if (*pC == '"'){
+        pC++;
+        pCe = pC;
+        while (*pCe != '"' && *pCe != '\0') pCe++;
+     } else{
+        pCe = pC;
+        while (*pCe != ' ' && *pCe != '\0') pCe++;
+     }
+     if (pCe != NULL && pCe > pC) {
+        TCHAR igc[MAX_PATH];
+        LK_tcsncpy(igc, pC, std::min<size_t>(pCe-pC, MAX_PATH-1));
+
+        TCHAR task[MAX_PATH] = {};
+        pC = _tcsstr(MyCommandLine, TEXT("-replaytask="));
+        if (pC != NULL){
+           pC += strlen("-replaytask=");
+           if (*pC == '"'){
+              pC++;
+              pCe = pC;
+              while (*pCe != '"' && *pCe != '\0') pCe++;
+           } else{
+              pCe = pC;
+              while (*pCe != ' ' && *pCe != '\0') pCe++;
+           }
+           if (pCe != NULL && pCe > pC) {
+              LK_tcsncpy(task, pC, std::min<size_t>(pCe-pC, MAX_PATH-1));
+           }
+        }
+
+        const std::string report = ReplayBenchmark::Run(igc, startProfileFile, task[0] ? task : nullptr);
+        if (report.empty()) {
+           _ftprintf(stderr, _T("no fix found in %s\n"), igc);
+        } else {
+           fprintf(stderr, "%s\n", report.c_str());
+        }
+     }
+     return false;
+  }
+
   return true;
 }
 
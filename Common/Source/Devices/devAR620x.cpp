@@ -409,7 +409,7 @@ int AR620x_Convert_Answer(DeviceDescriptor_t* d, uint8_t *szCommand, int len, ui
   return processed;  /* return the number of converted characters */
 }
 
-BOOL AR620xParseString(DeviceDescriptor_t* d, char *String, int len, NMEA_INFO *GPS_INFO) {
+BOOL AR620xParseString(DeviceDescriptor_t* d, const char *String, int len, NMEA_INFO *GPS_INFO) {
   int cnt=0;
   uint16_t CalCRC=0;
   static  uint16_t Recbuflen=0;
@@ -229,7 +229,7 @@ BOOL ATR833_KeepAlive(DeviceDescriptor_t* d) {
   return(TRUE);
 }
 
-BOOL ATR833ParseString(DeviceDescriptor_t* d, char *String, int len, NMEA_INFO *GPS_INFO)
+BOOL ATR833ParseString(DeviceDescriptor_t* d, const char *String, int len, NMEA_INFO *GPS_INFO)
 {
 uint16_t cnt=0;
 static int Recbuflen =0;
@@ -127,7 +127,7 @@ BOOL ParseCommand(DeviceDescriptor_t* d, const char* String, NMEA_INFO* GPS_INFO
   return TRUE;
 }
 
-BOOL ParseCOM(DeviceDescriptor_t* d, const char* String, NMEA_INFO* GPS_INFO) {
+BOOL ParseCOM(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* GPS_INFO) {
   /* <CHN1>,<CHN2>,<RXVOL1>,<RXVOL2>,<DWATCH>,<RX1>,<RX2>,<TX1>
 
       Field    Description                      Values
@@ -156,47 +156,43 @@ BOOL ParseCOM(DeviceDescriptor_t* d, const char* String, NMEA_INFO* GPS_INFO) {
                                                 1: transmitting signal
    */
 
+  // sentence[0] is "COM"
   char szTmp[MAX_NMEA_LEN];
 
   d->IsRadio = true;
   RadioPara.Enabled8_33 = true;
   RadioPara.Enabled = true;
 
-  NMEAParser::ExtractParameter(String, szTmp, 0);  // CHN1
+  sentence.Copy(1, szTmp);  // CHN1
   if (compare_set(RadioPara.ActiveKhz, ExtractFrequency(szTmp))) {
     UpdateStationName(RadioPara.ActiveName, RadioPara.ActiveKhz);
     RadioPara.Changed = true;
   }
   RadioPara.Changed |= compare_set<BOOL>(RadioPara.ActiveValid, true);
 
-  NMEAParser::ExtractParameter(String, szTmp, 1);  // CHN2
+  sentence.Copy(2, szTmp);  // CHN2
   if (compare_set(RadioPara.PassiveKhz, ExtractFrequency(szTmp))) {
     UpdateStationName(RadioPara.PassiveName, RadioPara.PassiveKhz);
     RadioPara.Changed = true;
   }
   RadioPara.Changed |= compare_set<BOOL>(RadioPara.PassiveValid, true);
 
-  NMEAParser::ExtractParameter(String, szTmp, 2);  // RXVOL1
-  RadioPara.Changed |= compare_set<int>(RadioPara.Volume, StrToDouble(szTmp, nullptr) / 5.);
+  RadioPara.Changed |= compare_set<int>(RadioPara.Volume, sentence.ToDouble(3) / 5.); // RXVOL1
   RadioPara.Changed |= compare_set<BOOL>(RadioPara.VolValid, true);
 
-  NMEAParser::ExtractParameter(String, szTmp, 4);  // DWATCH
-  RadioPara.Changed |= compare_set<BOOL>(RadioPara.Dual, ("1"sv == szTmp));
+  RadioPara.Changed |= compare_set<BOOL>(RadioPara.Dual, ("1"sv == sentence[5])); // DWATCH
   RadioPara.Changed |= compare_set<BOOL>(RadioPara.DualValid, true);
 
-  NMEAParser::ExtractParameter(String, szTmp, 5);  // RX1
-  RadioPara.Changed |= compare_set<BOOL>(RadioPara.RX_active, ("1"sv == szTmp));
+  RadioPara.Changed |= compare_set<BOOL>(RadioPara.RX_active, ("1"sv == sentence[6])); // RX1
 
-  NMEAParser::ExtractParameter(String, szTmp, 6);  // RX2
-  RadioPara.Changed |= compare_set<BOOL>(RadioPara.RX_standy, ("1"sv == szTmp));
+  RadioPara.Changed |= compare_set<BOOL>(RadioPara.RX_standy, ("1"sv == sentence[7])); // RX2
 
-  NMEAParser::ExtractParameter(String, szTmp, 7);  // TX1
-  RadioPara.Changed |= compare_set<BOOL>(RadioPara.TX, ("1"sv == szTmp));
+  RadioPara.Changed |= compare_set<BOOL>(RadioPara.TX, ("1"sv == sentence[8])); // TX1
 
   return TRUE;
 }
 
-BOOL ParseALT(DeviceDescriptor_t* d, const char* String, NMEA_INFO* GPS_INFO) {
+BOOL ParseALT(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* GPS_INFO) {
   /* $PAAVS,ALT,<ALTQNE>,<ALTQNH>,<QNH>
     Field    Description                       Values
     
@@ -207,16 +203,13 @@ BOOL ParseALT(DeviceDescriptor_t* d, const char* String, NMEA_INFO* GPS_INFO) {
     QNH      Current QNH setting in pascal.    Unsigned integer values (e.g.101325).
   */
 
-  char szTmp[MAX_NMEA_LEN];
-
-  NMEAParser::ExtractParameter(String, szTmp, 2);  // QNH
-  if (szTmp[0]) { // string not empty
-    UpdateQNH(StrToDouble(szTmp, nullptr) / 100.);
+  // sentence[0] is "ALT"
+  if (!sentence[3].empty()) { // QNH
+    UpdateQNH(sentence.ToDouble(3) / 100.);
   }
 
-  NMEAParser::ExtractParameter(String, szTmp, 0);  // ALTQNE
-  if (szTmp[0]) { // string not empty
-    UpdateBaroSource( GPS_INFO, d, StrToDouble(szTmp, nullptr));
+  if (!sentence[1].empty()) { // ALTQNE
+    UpdateBaroSource( GPS_INFO, d, sentence.ToDouble(1));
   }
 
   return TRUE;
@@ -229,7 +222,8 @@ BOOL ParseXPDR(DeviceDescriptor_t* d, const char* String, NMEA_INFO* GPS_INFO) {
   return TRUE;
 }
 
-BOOL ParseNMEA(DeviceDescriptor_t* d, const char* String, NMEA_INFO* GPS_INFO) {
+BOOL ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* GPS_INFO) {
+  const char* String = sentence.c_str();
   auto wait_ack = d->lock_wait_ack();
   if (wait_ack && wait_ack->check(String)) {
     return TRUE;
@@ -245,16 +239,14 @@ BOOL ParseNMEA(DeviceDescriptor_t* d, const char* String, NMEA_INFO* GPS_INFO) {
     return ParseCommand(d, String + command_prefix.size(), GPS_INFO);
   }
 
-  auto com_prefix = "$PAAVS,COM,"sv;
-  if (start_with(String, com_prefix)) {
+  if (sentence.Address() == "$PAAVS"sv && sentence[0] == "COM"sv) {
     // COM radio
-    return ParseCOM(d, String + com_prefix.size(), GPS_INFO);
+    return ParseCOM(d, sentence, GPS_INFO);
   }
 
-  auto alt_prefix = "$PAAVS,ALT,"sv;
-  if (start_with(String, alt_prefix)) {
+  if (sentence.Address() == "$PAAVS"sv && sentence[0] == "ALT"sv) {
     // Altimeter
-    return ParseALT(d, String + alt_prefix.size(), GPS_INFO);
+    return ParseALT(d, sentence, GPS_INFO);
   }
 
   auto xpdr_prefix = "$PAAVS,XPDR,"sv;
@@ -26,35 +26,6 @@
 // #############################################################################
 
 
-//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-/// Converts parameter from NMEA sentence into double.
-///
-/// @param sentence  received NMEA sentence
-/// @param parIdx    index of parameter to be extracted (from 0)
-/// @param value     returned value
-///
-/// @retval true  the conversion has been successful
-/// @retval false either string is empty or cannot be converted
-///
-//static
-bool DevBase::ParToDouble(const char* sentence, unsigned int parIdx, double* value)
-{
-  char temp[80];
-  const char* stop;
-  LKASSERT(value!=NULL);
-
-  NMEAParser::ExtractParameter(sentence, temp, parIdx);
-
-  stop = NULL;
-  *value = StrToDouble(temp, &stop);
-
-  if (stop == NULL || *stop != '\0')
-    return(false);
-
-  return(true);
-} // ParToDouble()
-
-
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 /// Constant handler returning always @c true.
 ///
@@ -54,11 +54,6 @@ class DevBase
     /// Protected only constructor - class should not be instantiated.
     DevBase() {}
 
-    /// Converts parameter from NMEA sentence into double.
-    gcc_nonnull(1, 3)
-    static bool ParToDouble(
-      const char* sentence, unsigned int parIdx, double* value);
-
     /// Constant handler returning always @c true.
     gcc_nonnull(1)
     static BOOL GetTrue(DeviceDescriptor_t* d);
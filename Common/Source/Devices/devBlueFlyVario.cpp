@@ -499,7 +499,8 @@ BOOL PRS(DeviceDescriptor_t* d, const char *String, NMEA_INFO *_INFO){
 	return TRUE;
 }
 
-BOOL BlueFlyVarioParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
+BOOL BlueFlyVarioParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS) {
+    const char* String = sentence.c_str(); // "PRS " sentence is not a nmea sentence
     if( RequestParamTimer == 1 ) {
         if(!RequestConfig(d)) {
             RequestParamTimer = 10;
@@ -512,10 +513,10 @@ BOOL BlueFlyVarioParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO
     if(strncmp("PRS ", String, 4)==0){
         return PRS(d, &String[4], pGPS);
     } 
-    if(LK8EX1ParseNMEA(d, String, pGPS)) {
+    if(LK8EX1ParseNMEA(d, sentence, pGPS)) {
         return TRUE;
     }
-    if(FlyNetParseNMEA(d, String, pGPS)) {
+    if(FlyNetParseNMEA(d, sentence, pGPS)) {
         return TRUE;
     }
 
@@ -10,19 +10,21 @@
 #include "devBorgeltB50.h"
 #include "Calc/Vario.h"
 
-static BOOL PBB50(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+using std::string_view_literals::operator""sv;
 
-extern BOOL vl_PGCS1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+static BOOL PBB50(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
+extern BOOL vl_PGCS1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
-BOOL B50ParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+
+BOOL B50ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
   (void)d;
 
-  if(strncmp("$PBB50", String, 6)==0) {
-    return PBB50(d, &String[7], pGPS);
+  if(sentence.Address() == "$PBB50"sv) {
+    return PBB50(d, sentence, pGPS);
   }
-  else if(strncmp("$PGCS", String, 5)==0) {
-    return vl_PGCS1( d, &String[6], pGPS);
+  else if(sentence.Address() == "$PGCS"sv) {
+    return vl_PGCS1( d, sentence, pGPS);
   }
   return FALSE;
 }
@@ -66,7 +68,7 @@ CHK = standard NMEA checksum
 
 */
 
-BOOL PBB50(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
+BOOL PBB50(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS) {
   // $PBB50,100,0,10,1,10000,0,1,0,20*4A..
   // $PBB50,0,.0,.0,0,0,1.07,0,-228*58
   // $PBB50,14,-.2,.0,196,0,.92,0,-228*71
@@ -74,20 +76,16 @@ BOOL PBB50(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
   double vtas, vias, wnet;
   char ctemp[MAX_NMEA_LEN];
 
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  vtas = Units::From(unKnots, StrToDouble(ctemp,NULL));
+  vtas = Units::From(unKnots, sentence.ToDouble(0));
 
-  NMEAParser::ExtractParameter(String,ctemp,1);
-  wnet = Units::From(unKnots, StrToDouble(ctemp,NULL));
+  wnet = Units::From(unKnots, sentence.ToDouble(1));
 
-  NMEAParser::ExtractParameter(String,ctemp,2);
-  d->RecvMacCready(Units::From(unKnots, StrToDouble(ctemp,NULL)));
+  d->RecvMacCready(Units::From(unKnots, sentence.ToDouble(2)));
 
-  NMEAParser::ExtractParameter(String,ctemp,3);
-  vias = Units::From(unKnots, sqrt(StrToDouble(ctemp,NULL)));
+  vias = Units::From(unKnots, sqrt(sentence.ToDouble(3)));
 
   // inclimb/incruise 1=cruise,0=climb, OAT
-  NMEAParser::ExtractParameter(String,ctemp,6);
+  sentence.Copy(6, ctemp);
 
   #if 0 // UNUSED EnableExternalTriggerCruise
   if (EnableExternalTriggerCruise) {
@@ -103,8 +101,7 @@ BOOL PBB50(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
   }
   #endif
 
-  NMEAParser::ExtractParameter(String,ctemp,7);
-  pGPS->OutsideAirTemperature = StrToDouble(ctemp,NULL);
+  pGPS->OutsideAirTemperature = sentence.ToDouble(7);
   pGPS->TemperatureAvailable = true;
 
   pGPS->AirspeedAvailable = TRUE;
@@ -21,6 +21,8 @@
 #include "devCAI302.h"
 #include "OS/Sleep.h"
 
+using std::string_view_literals::operator""sv;
+
 using std::min;
 using std::max;
 
@@ -103,26 +105,26 @@ static cai302_OdataNoArgs_t cai302_OdataNoArgs;
 static cai302_OdataPilot_t cai302_OdataPilot;
 
 // Additional sentance for CAI302 support
-static BOOL cai_w(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
-static BOOL cai_PCAIB(const char *String, NMEA_INFO *pGPS);
-static BOOL cai_PCAID(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+static BOOL cai_w(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
+static BOOL cai_PCAIB(const NMEASentence& sentence, NMEA_INFO *pGPS);
+static BOOL cai_PCAID(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
-BOOL cai302ParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+BOOL cai302ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
 
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
-  if(strstr(String, "$PCAIB") == String){
-    return cai_PCAIB(&String[7], pGPS);
+  if(sentence.Address() == "$PCAIB"sv){
+    return cai_PCAIB(sentence, pGPS);
   }
 
-  if(strstr(String, "$PCAID") == String){
-    return cai_PCAID(d, &String[7], pGPS);
+  if(sentence.Address() == "$PCAID"sv){
+    return cai_PCAID(d, sentence, pGPS);
   }
 
-  if(strstr(String, "!w") == String){
-    return cai_w(d, &String[3], pGPS);
+  if(sentence.Address() == "!w"sv){
+    return cai_w(d, sentence, pGPS);
   }
 
   return FALSE;
@@ -447,9 +449,9 @@ $PCAIB,<1>,<2>,<CR><LF>
 <2> Destination Navpoint attribute word, format XXXXX (leading zeros will be transmitted)
 */
 
-BOOL cai_PCAIB(const char* String, NMEA_INFO *pGPS){
+BOOL cai_PCAIB(const NMEASentence& sentence, NMEA_INFO *pGPS){
   (void)pGPS;
-  (void)String;
+  (void)sentence;
   return TRUE;
 }
 
@@ -465,9 +467,8 @@ $PCAID,<1>,<2>,<3>,<4>*hh<CR><LF>
 
 static bool have_Qnhaltitude=false;
 
-BOOL cai_PCAID(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+BOOL cai_PCAID(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
 
-  char ctemp[80];
   static short waitinit=3;
 
   if (waitinit>0) {
@@ -476,14 +477,13 @@ BOOL cai_PCAID(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
   }
 
 
-  NMEAParser::ExtractParameter(String,ctemp,1);
   // This is in conflict with !w sentence providing true altitude and the relative QNH.
   // The idea is to use this value, which would require a manual setup of QNH) only if no baro altitude
   // is available  from the !w sentence (and in such case we ignore QNH as well).
   // We use a local flag to make it easier.
   // We must wait for at least the first run to see if the sequencing pcaid-!w is done, no matter the order.
   if (!have_Qnhaltitude) {
-      double ps = StrToDouble(ctemp,NULL);
+      double ps = sentence.ToDouble(1);
       UpdateBaroSource( pGPS , d, QNEAltitudeToQNHAltitude(ps));
   }
 
@@ -508,26 +508,21 @@ BOOL cai_PCAID(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
 *hh  Checksum, XOR of all bytes
 */
 
-BOOL cai_w(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
-
-  char ctemp[80];
+BOOL cai_w(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
 
-  NMEAParser::ExtractParameter(String,ctemp,1);
-  double wind_speed = StrToDouble(ctemp, nullptr) / 10.0;
+  double wind_speed = sentence.ToDouble(1) / 10.0;
 
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  double wind_dir = StrToDouble(ctemp, nullptr) + 180;
+  double wind_dir = sentence.ToDouble(0) + 180;
   
   UpdateExternalWind(*pGPS, *d, wind_speed, wind_dir);
 
 
 
-  NMEAParser::ExtractParameter(String,ctemp,4);
 
   // this is true altitude, already corrected for non-standard temp and pressure.
   // It is the altitude relative to the current (following) QNH
   // So we dont do any qnh conversion!
-  double qnhalt=StrToDouble(ctemp,NULL)-1000;
+  double qnhalt=sentence.ToDouble(4)-1000;
 
   // minimalistic check, to be sure we are not excluding PCAID without a real qnh
   if (qnhalt!=0) {
@@ -536,31 +531,25 @@ BOOL cai_w(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
   }
 
   // We DO need to set the QNH altitude as well, if we use the previous baro altitude!
-  NMEAParser::ExtractParameter(String,ctemp,5);
   if (have_Qnhaltitude) {
-      UpdateQNH(StrToDouble(ctemp, NULL));
+      UpdateQNH(sentence.ToDouble(5));
   }
 
-  NMEAParser::ExtractParameter(String,ctemp,6);
   pGPS->AirspeedAvailable = TRUE;
 
-  pGPS->TrueAirspeed = (StrToDouble(ctemp,NULL) / 100.0);
+  pGPS->TrueAirspeed = (sentence.ToDouble(6) / 100.0);
   // if qnhalt is zero, IAS is the TAS, more or less, so no problems
   pGPS->IndicatedAirspeed = IndicatedAirSpeed(pGPS->TrueAirspeed, QNHAltitudeToQNEAltitude(qnhalt));
 
 
-  NMEAParser::ExtractParameter(String,ctemp,7);
-  double Vario = Units::From(unKnots, (StrToDouble(ctemp,NULL) - 200.0) / 10.0);;
+  double Vario = Units::From(unKnots, (sentence.ToDouble(7) - 200.0) / 10.0);;
   UpdateVarioSource(*pGPS, *d, Vario);
 
-  NMEAParser::ExtractParameter(String,ctemp,10);
-  d->RecvMacCready(Units::From(unKnots, StrToDouble(ctemp, nullptr) / 10.0));
+  d->RecvMacCready(Units::From(unKnots, sentence.ToDouble(10) / 10.0));
 
-  NMEAParser::ExtractParameter(String,ctemp,11);
-  d->RecvBallast(StrToDouble(ctemp, nullptr) / 100.0);
+  d->RecvBallast(sentence.ToDouble(11) / 100.0);
 
-  NMEAParser::ExtractParameter(String,ctemp,12);
-  d->RecvBugs(StrToDouble(ctemp, nullptr) / 100.0);
+  d->RecvBugs(sentence.ToDouble(12) / 100.0);
 
   return TRUE;
 }
@@ -74,8 +74,8 @@ void CDevCProbe::UnlockDeviceData(){
 	}
 }
 
-BOOL CDevCProbe::ParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pINFO ) {
-	nmeastring wiss(String);
+BOOL CDevCProbe::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pINFO) {
+	nmeastring wiss(sentence.c_str());
 	char* strToken = wiss.GetNextString();
 
  	if(strcmp(strToken, "$PCPROBE")==0) {
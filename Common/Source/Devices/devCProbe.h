@@ -50,7 +50,7 @@ private:
 
 // Receive data
 private:
-	static BOOL ParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pINFO);
+	static BOOL ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pINFO);
 
 	static BOOL ParseData(DeviceDescriptor_t* d, nmeastring& wiss, NMEA_INFO *pINFO );
 	static BOOL ParseGyro(nmeastring& wiss, NMEA_INFO *pINFO );
@@ -11,18 +11,20 @@
 #include "Calc/Vario.h"
 #include "devCompeo.h"
 
-static BOOL VMVABD(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+using std::string_view_literals::operator""sv;
 
-static BOOL CompeoParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+static BOOL VMVABD(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
+
+static BOOL CompeoParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
 
   (void)d;
 
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
-  if (strncmp("$VMVABD", String, 7)==0) {
-    return VMVABD(d, &String[8], pGPS);
+  if (sentence.Address() == "$VMVABD"sv) {
+    return VMVABD(d, sentence, pGPS);
   }
 
   return FALSE;
@@ -36,7 +38,7 @@ void CompeoInstall(DeviceDescriptor_t* d) {
   d->ParseNMEA = CompeoParseNMEA;
 }
 
-static BOOL VMVABD(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
+static BOOL VMVABD(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
 /*
 	$VMVABD,
@@ -59,18 +61,15 @@ static BOOL VMVABD(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 
   char ctemp[80];
 
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  pGPS->Altitude = StrToDouble(ctemp,NULL);
+  pGPS->Altitude = sentence.ToDouble(0);
 
-  NMEAParser::ExtractParameter(String,ctemp,2);
-  double QneAltitude = StrToDouble(ctemp,NULL);
+  double QneAltitude = sentence.ToDouble(2);
 
   UpdateBaroSource( pGPS, d, QNEAltitudeToQNHAltitude(QneAltitude));
 
-  NMEAParser::ExtractParameter(String,ctemp,4);
-  UpdateVarioSource(*pGPS, *d, StrToDouble(ctemp,NULL));
+  UpdateVarioSource(*pGPS, *d, sentence.ToDouble(4));
 
-  NMEAParser::ExtractParameter(String,ctemp,8);
+  sentence.Copy(8, ctemp);
   if (ctemp[0] != '\0') { // 100209
     // we store m/s  , so we convert it from kmh
     pGPS->IndicatedAirspeed = Units::From(unKiloMeterPerHour, StrToDouble(ctemp, nullptr));
@@ -13,29 +13,31 @@
 #include "Comm/ExternalWind.h"
 
 
-static BOOL cLXWP0(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS);
-static BOOL cLXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS);
-static BOOL cLXWP2(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS);
+using std::string_view_literals::operator""sv;
+
+static BOOL cLXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
+static BOOL cLXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
+static BOOL cLXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
 static
-BOOL CondorParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+BOOL CondorParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
 
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
 
-  if(strncmp("$LXWP0", String, 6)==0)
+  if(sentence.Address() == "$LXWP0"sv)
     {
-      return cLXWP0(d, &String[7], pGPS);
+      return cLXWP0(d, sentence, pGPS);
     }
-  if(strncmp("$LXWP1", String, 6)==0)
+  if(sentence.Address() == "$LXWP1"sv)
     {
-      return cLXWP1(d, &String[7], pGPS);
+      return cLXWP1(d, sentence, pGPS);
     }
-  if(strncmp("$LXWP2", String, 6)==0)
+  if(sentence.Address() == "$LXWP2"sv)
     {
-      return cLXWP2(d, &String[7], pGPS);
+      return cLXWP2(d, sentence, pGPS);
     }
 
   return FALSE;
@@ -56,7 +58,7 @@ void condorInstall(DeviceDescriptor_t* d) {
 
 
 static
-BOOL cLXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS)
+BOOL cLXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
   //  TCHAR ctemp[80];
   (void)pGPS;
@@ -66,17 +68,14 @@ BOOL cLXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS)
 
 
 static
-BOOL cLXWP2(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS) {
-  char ctemp[80];
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  d->RecvMacCready(StrToDouble(ctemp, nullptr));
+BOOL cLXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS) {
+  d->RecvMacCready(sentence.ToDouble(0));
   return TRUE;
 }
 
 
 static
-BOOL cLXWP0(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS) {
-  char ctemp[80];
+BOOL cLXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS) {
 
   /*
   $LXWP0,Y,222.3,1665.5,1.71,,,,,,239,174,10.1
@@ -94,11 +93,9 @@ BOOL cLXWP0(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS) {
 
   DevIsCondor=true;
 
-  NMEAParser::ExtractParameter(String,ctemp,1);
-  double airspeed = Units::From(unKiloMeterPerHour, StrToDouble(ctemp,NULL));
+  double airspeed = Units::From(unKiloMeterPerHour, sentence.ToDouble(1));
 
-  NMEAParser::ExtractParameter(String,ctemp,2);
-  double QneAltitude = StrToDouble(ctemp,NULL);
+  double QneAltitude = sentence.ToDouble(2);
 
   pGPS->IndicatedAirspeed = IndicatedAirSpeed(airspeed, QneAltitude);
   pGPS->TrueAirspeed = airspeed;
@@ -106,16 +103,13 @@ BOOL cLXWP0(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS) {
 
   UpdateBaroSource( pGPS, d,  QNEAltitudeToQNHAltitude(QneAltitude));
 
-  NMEAParser::ExtractParameter(String,ctemp,3);
-  double Vario = StrToDouble(ctemp,NULL);
+  double Vario = sentence.ToDouble(3);
   UpdateVarioSource(*pGPS, *d, Vario);
 
 
   // we don't use heading for wind calculation since... wind is already calculated in condor!!
-  NMEAParser::ExtractParameter(String,ctemp,11);
-  double wspeed = StrToDouble(ctemp,NULL);
-  NMEAParser::ExtractParameter(String,ctemp,10);
-  double wfrom = StrToDouble(ctemp,NULL) + 180;
+  double wspeed = sentence.ToDouble(11);
+  double wfrom = sentence.ToDouble(10) + 180;
 
   UpdateExternalWind(*pGPS, *d, Units::From(Units_t::unKiloMeterPerHour, wspeed), wfrom);
 
@@ -13,27 +13,29 @@
 #include "MathFunctions.h"
 #include "Comm/UpdateQNH.h"
 
+using std::string_view_literals::operator""sv;
+
 static
-BOOL PDGFTL1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+BOOL PDGFTL1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
 // Leonardo Pro & Catesio
 static
-BOOL D(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+BOOL D(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
 static
-BOOL DigiflyParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+BOOL DigiflyParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
 
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
 
-  if(strncmp("$PDGFTL1", String, 8)==0) {
-    return PDGFTL1(d, &String[9], pGPS);
+  if(sentence.Address() == "$PDGFTL1"sv) {
+    return PDGFTL1(d, sentence, pGPS);
   }
 
-  if(strncmp("$D", String, 2) == 0) {
-    return D(d, &String[3], pGPS);
+  if(sentence.Address() == "$D"sv) {
+    return D(d, sentence, pGPS);
   }
 
   return FALSE;
@@ -48,7 +50,7 @@ void DigiflyInstall(DeviceDescriptor_t* d) {
 }
 
 static
-BOOL PDGFTL1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
+BOOL PDGFTL1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS) {
 /*
 	$PDGFTL1		     field     example
 	QNE 1013.25 altitude		0	2025  meters
@@ -74,10 +76,8 @@ BOOL PDGFTL1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
 
 
 
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  altqne = StrToDouble(ctemp,NULL);
-  NMEAParser::ExtractParameter(String,ctemp,1);
-  altqnh = StrToDouble(ctemp,NULL);
+  altqne = sentence.ToDouble(0);
+  altqnh = sentence.ToDouble(1);
 
   // AutoQNH will take care of setting an average QNH if nobody does it for a while
   if (initqnh) {
@@ -95,10 +95,9 @@ BOOL PDGFTL1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
   UpdateBaroSource( pGPS, d, QNEAltitudeToQNHAltitude(altqne));
 
 
-  NMEAParser::ExtractParameter(String,ctemp,2);
-  UpdateVarioSource(*pGPS, *d, StrToDouble(ctemp,NULL)/100);
+  UpdateVarioSource(*pGPS, *d, sentence.ToDouble(2)/100);
 
-  NMEAParser::ExtractParameter(String,ctemp,3);
+  sentence.Copy(3, ctemp);
   if (ctemp[0] != '\0') {
 	pGPS->NettoVario = StrToDouble(ctemp,NULL)/10; // dm/s
 	pGPS->NettoVarioAvailable = TRUE;
@@ -106,7 +105,7 @@ BOOL PDGFTL1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
 	pGPS->NettoVarioAvailable = FALSE;
 
 
-  NMEAParser::ExtractParameter(String,ctemp,4);
+  sentence.Copy(4, ctemp);
   if (ctemp[0] != '\0') {
 	// we store m/s  , so we convert it from kmh
 	vias = StrToDouble(ctemp,NULL)/3.6;
@@ -122,16 +121,14 @@ BOOL PDGFTL1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
   }
 
 
-  NMEAParser::ExtractParameter(String,ctemp,8);
-  pGPS->ExtBatt1_Voltage = StrToDouble(ctemp,NULL)/100;
-  NMEAParser::ExtractParameter(String,ctemp,9);
-  pGPS->ExtBatt2_Voltage = StrToDouble(ctemp,NULL)/100;
+  pGPS->ExtBatt1_Voltage = sentence.ToDouble(8)/100;
+  pGPS->ExtBatt2_Voltage = sentence.ToDouble(9)/100;
 
   return TRUE;
 }
 
 static
-BOOL D(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
+BOOL D(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS) {
 /*
  * 00 : vario ist           in dm/sec
  * 01 : pressure            in cents of mB
@@ -151,19 +148,19 @@ BOOL D(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
     char ctemp[80];
 
     // Vario
-    NMEAParser::ExtractParameter(String,ctemp,0);
+    sentence.Copy(0, ctemp);
     if (ctemp[0] != '\0') {
         UpdateVarioSource(*pGPS, *d, StrToDouble(ctemp,NULL)/100);
     }
     // Pressure
-    NMEAParser::ExtractParameter(String,ctemp,1);
+    sentence.Copy(1, ctemp);
     if (ctemp[0] != '\0') {
         double abs_press = StrToDouble(ctemp,NULL);
         UpdateBaroSource(pGPS, d, StaticPressureToQNHAltitude(abs_press));
     }
 
     // Netto Vario
-    NMEAParser::ExtractParameter(String,ctemp,2);
+    sentence.Copy(2, ctemp);
     if (ctemp[0] != '\0') {
         pGPS->NettoVario = StrToDouble(ctemp,NULL)/10;
         pGPS->NettoVarioAvailable = TRUE;
@@ -172,7 +169,7 @@ BOOL D(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
     }
 
     // airspeed
-    NMEAParser::ExtractParameter(String,ctemp,3);
+    sentence.Copy(3, ctemp);
     if (ctemp[0] != '\0') {
         pGPS->TrueAirspeed = Units::From(unKiloMeterPerHour, StrToDouble(ctemp, nullptr));
         pGPS->IndicatedAirspeed = IndicatedAirSpeed(pGPS->TrueAirspeed, QNHAltitudeToQNEAltitude(pGPS->Altitude));
@@ -184,7 +181,7 @@ BOOL D(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS) {
     }
 
     // temperature
-    NMEAParser::ExtractParameter(String,ctemp,4);
+    sentence.Copy(4, ctemp);
     if (ctemp[0] != '\0') {
         pGPS->OutsideAirTemperature = StrToDouble(ctemp,NULL);
         pGPS->TemperatureAvailable = TRUE;
@@ -54,11 +54,11 @@ BOOL ExpectStringWait(DeviceDescriptor_t* d, const TCHAR *token) {
 
 
 
-BOOL EWMicroRecorderParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+BOOL EWMicroRecorderParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
   char ctemp[MAX_NMEA_LEN];
   char* params[MAX_NMEA_PARAMS];
 
-  int nparams = NMEAParser::ValidateAndExtract(String, ctemp, params);
+  int nparams = NMEAParser::ValidateAndExtract(sentence.c_str(), ctemp, params);
   if (nparams < 1)
     return FALSE;
 
@@ -573,11 +573,13 @@ constexpr auto function_table = lookup_table<uint8_t, parse_function>({
   { 0x04, &FanetParseType4Msg }
 });
 
-BOOL ParseNMEA(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS){
+BOOL ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
+  // fanet sentence address is separated by space, fields are parsed from raw string.
+  const char* String = sentence.c_str();
   if(pGPS && strncmp("#FNF", String, 4)==0) {
     return FanetParse(function_table, d, &String[5], pGPS);      
   }
-  if(LK8EX1ParseNMEA(d, String, pGPS)) {
+  if(LK8EX1ParseNMEA(d, sentence, pGPS)) {
       return TRUE;
   }
   return FALSE;
@@ -607,7 +609,9 @@ constexpr auto function_table = lookup_table<uint8_t, parse_function>({
   { 0x04, &FanetParseType4Msg }
 });
 
-BOOL ParseNMEA(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS) {
+BOOL ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS) {
+  // fanet sentence address is separated by space, fields are parsed from raw string.
+  const char* String = sentence.c_str();
   if (!pGPS) {
     return FALSE;
   }
@@ -18,6 +18,8 @@
 #include "Thread/Mutex.hpp"
 #include "Thread/Cond.hpp"
 
+using std::string_view_literals::operator""sv;
+
 
 
 
@@ -43,9 +45,9 @@ namespace {
   bool bFLARM_BinMode = false;
 }
 
-BOOL CDevFlarm::FlarmParse(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info) {
+BOOL CDevFlarm::FlarmParse(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info) {
   if (IsInBinaryMode()) {
-    if (strncmp("$PFLAU", sentence, 6) == 0) {
+    if (sentence.Address() == "$PFLAU"sv) {
       StartupStore(TEXT("$PFLAU detected, disable binary mode!" ));
       SetBinaryModeFlag(false);
     }
@@ -54,7 +56,7 @@ BOOL CDevFlarm::FlarmParse(DeviceDescriptor_t* d, const char* sentence, NMEA_INF
   return false;
 }
 
-BOOL CDevFlarm::FlarmParseString(DeviceDescriptor_t* d, char *String, int len, NMEA_INFO *GPS_INFO) {
+BOOL CDevFlarm::FlarmParseString(DeviceDescriptor_t* d, const char *String, int len, NMEA_INFO *GPS_INFO) {
   if ((!d) || (!String) || (!len)) {
     return FALSE;
   }
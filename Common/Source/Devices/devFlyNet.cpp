@@ -23,7 +23,9 @@ BOOL _BAT(DeviceDescriptor_t* d, const char *String, NMEA_INFO *_INFO){
 	return TRUE;
 }
 
-BOOL FlyNetParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *_INFO){
+BOOL FlyNetParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *_INFO){
+  // not a nmea sentence, use raw string.
+  const char* String = sentence.c_str();
   if(strncmp("_PRS ", String, 5)==0){
 	  return _PRS(d, &String[5], _INFO);
   }
@@ -11,20 +11,22 @@
 #include "Calc/Vario.h"
 #include "devFlymasterF1.h"
 
+using std::string_view_literals::operator""sv;
+
 static
-BOOL VARIO(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+BOOL VARIO(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
 static
-BOOL FlymasterF1ParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+BOOL FlymasterF1ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
 
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
 
-  if(strncmp("$VARIO", String, 6)==0)
+  if(sentence.Address() == "$VARIO"sv)
     {
-      return VARIO(d, &String[7], pGPS);
+      return VARIO(d, sentence, pGPS);
     }
 
   return FALSE;
@@ -84,26 +86,20 @@ void flymasterInstall(DeviceDescriptor_t* d) {
 // local stuff
 
 static
-BOOL VARIO(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
+BOOL VARIO(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
   // $VARIO,fPressure,fVario,Bat1Volts,Bat2Volts,BatBank,TempSensor1,TempSensor2*CS
 
-  char ctemp[80];
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  double ps = StrToDouble(ctemp,NULL);
+  double ps = sentence.ToDouble(0);
   UpdateBaroSource(pGPS, d, StaticPressureToQNHAltitude(ps * 100));
 
-  NMEAParser::ExtractParameter(String,ctemp,1);
-  double Vario = StrToDouble(ctemp,NULL)/10.0;
+  double Vario = sentence.ToDouble(1)/10.0;
   UpdateVarioSource(*pGPS, *d, Vario);
   // JMW vario is in dm/s
 
-  NMEAParser::ExtractParameter(String,ctemp,2);
-  pGPS->ExtBatt1_Voltage = StrToDouble(ctemp,NULL);
-  NMEAParser::ExtractParameter(String,ctemp,3);
-  pGPS->ExtBatt2_Voltage = StrToDouble(ctemp,NULL);
-  NMEAParser::ExtractParameter(String,ctemp,4);
-  pGPS->ExtBatt_Bank = (int)StrToDouble(ctemp,NULL);
+  pGPS->ExtBatt1_Voltage = sentence.ToDouble(2);
+  pGPS->ExtBatt2_Voltage = sentence.ToDouble(3);
+  pGPS->ExtBatt_Bank = (int)sentence.ToDouble(4);
 
   return TRUE;
 }
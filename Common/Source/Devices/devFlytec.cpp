@@ -11,21 +11,23 @@
 #include "Calc/Vario.h"
 #include "devFlytec.h"
 
+using std::string_view_literals::operator""sv;
+
 extern double EastOrWest(double in, TCHAR EoW);
 extern double NorthOrSouth(double in, TCHAR NoS);
 extern double MixedFormatToDegrees(double mixed);
 
 static
-BOOL FLYSEN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+BOOL FLYSEN(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
 static
-BOOL FlytecParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+BOOL FlytecParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
-  if(strncmp("$FLYSEN", String, 7)==0) {
-    return FLYSEN(d, &String[8], pGPS);
+  if(sentence.Address() == "$FLYSEN"sv) {
+    return FLYSEN(d, sentence, pGPS);
   }
 
   return FALSE;
@@ -38,7 +40,7 @@ void FlytecInstall(DeviceDescriptor_t* d) {
 }
 
 static
-BOOL FLYSEN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
+BOOL FLYSEN(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
 
   char ctemp[80];
@@ -50,11 +52,11 @@ BOOL FLYSEN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
   // firmware 3.32  1 offset
   // Determine firmware version, assuming it will not change in the session!
   if (offset<0) {
-	NMEAParser::ExtractParameter(String,ctemp,8);
+	sentence.Copy(8, ctemp);
 	if ( (strcmp(ctemp, "A")==0) || (strcmp(ctemp, "V")==0))
 		offset=0;
 	else {
-		NMEAParser::ExtractParameter(String,ctemp,9);
+		sentence.Copy(9, ctemp);
 		if ( (strcmp(ctemp, "A")==0) || (strcmp(ctemp, "V")==0))
 			offset=1;
 		else
@@ -63,7 +65,7 @@ BOOL FLYSEN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
   }
 
   // VOID GPS SIGNAL
-  NMEAParser::ExtractParameter(String,ctemp,8+offset);
+  sentence.Copy(8+offset, ctemp);
   if (strcmp(ctemp, "V")==0) {
 	pGPS->NAVWarning=true;
 	// GPSCONNECT=false; // 121127 NO!!
@@ -74,14 +76,12 @@ BOOL FLYSEN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
   double tmplat;
   double tmplon;
 
-  NMEAParser::ExtractParameter(String,ctemp,1+offset);
-  tmplat = MixedFormatToDegrees(StrToDouble(ctemp, NULL));
-  NMEAParser::ExtractParameter(String,ctemp,2+offset);
+  tmplat = MixedFormatToDegrees(sentence.ToDouble(1+offset));
+  sentence.Copy(2+offset, ctemp);
   tmplat = NorthOrSouth(tmplat, ctemp[0]);
 
-  NMEAParser::ExtractParameter(String,ctemp,3+offset);
-  tmplon = MixedFormatToDegrees(StrToDouble(ctemp, NULL));
-  NMEAParser::ExtractParameter(String,ctemp,4+offset);
+  tmplon = MixedFormatToDegrees(sentence.ToDouble(3+offset));
+  sentence.Copy(4+offset, ctemp);
   tmplon = EastOrWest(tmplon,ctemp[0]);
 
   if (!((tmplat == 0.0) && (tmplon == 0.0))) {
@@ -91,30 +91,26 @@ BOOL FLYSEN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
   }
 
   // GPS SPEED
-  NMEAParser::ExtractParameter(String,ctemp,6+offset);
-  pGPS->Speed = StrToDouble(ctemp,NULL)/10;
+  pGPS->Speed = sentence.ToDouble(6+offset)/10;
 
   // TRACK BEARING
   if (pGPS->Speed>1.0) {
-	NMEAParser::ExtractParameter(String,ctemp,5+offset);
-	pGPS->TrackBearing = AngleLimit360(StrToDouble(ctemp, NULL));
+	pGPS->TrackBearing = AngleLimit360(sentence.ToDouble(5+offset));
   }
 
   // HGPS
-  NMEAParser::ExtractParameter(String,ctemp,7+offset);
-  pGPS->Altitude = StrToDouble(ctemp,NULL);
+  pGPS->Altitude = sentence.ToDouble(7+offset);
 
   // ------------------------
   label_nogps:
 
   // SATS
-  NMEAParser::ExtractParameter(String,ctemp,9+offset);
-  pGPS->SatellitesUsed = (int) StrToDouble(ctemp,NULL);
+  pGPS->SatellitesUsed = (int) sentence.ToDouble(9+offset);
 
   // DATE
   // Firmware 3.32 has got the date
   if (offset>0) {
-	NMEAParser::ExtractParameter(String,ctemp,0);
+	sentence.Copy(0, ctemp);
 
   long gy = strtol(&ctemp[4], nullptr, 10) + 2000;
   ctemp[4] = '\0';
@@ -134,29 +130,25 @@ BOOL FLYSEN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
   // We need to manage UTC time
   static int StartDay=-1;
   if (pGPS->SatellitesUsed>0) {
-      NMEAParser::ExtractParameter(String,ctemp,0+offset);
+      sentence.Copy(0+offset, ctemp);
       pGPS->Time = TimeModify(ctemp, pGPS, StartDay);
   }
   // TODO : check if TimeHasAdvanced check is needed (cf. Parser.cpp)
 
   // HPA from the pressure sensor
-  //   NMEAParser::ExtractParameter(String,ctemp,10+offset);
-  //   double ps = StrToDouble(ctemp,NULL)/100;
+  //   //   double ps = sentence.ToDouble(10+offset)/100;
   //   pGPS->BaroAltitude = (1 - pow(fabs(ps / QNH),  0.190284)) * 44307.69;
 
   // HBAR 1013.25
-  NMEAParser::ExtractParameter(String,ctemp,11+offset);
-  double qne_altitude = StrToDouble(ctemp,NULL);
+  double qne_altitude = sentence.ToDouble(11+offset);
   UpdateBaroSource(pGPS, d, QNEAltitudeToQNHAltitude(qne_altitude));
 
   // VARIO
-  NMEAParser::ExtractParameter(String,ctemp,12+offset);
-  double Vario = StrToDouble(ctemp,NULL)/100;
+  double Vario = sentence.ToDouble(12+offset)/100;
   UpdateVarioSource(*pGPS, *d, Vario);
 
   // TAS
-  NMEAParser::ExtractParameter(String,ctemp,13+offset);
-  double vtas = StrToDouble(ctemp,NULL) / 10;
+  double vtas = sentence.ToDouble(13+offset) / 10;
   pGPS->IndicatedAirspeed = IndicatedAirSpeed(vtas, qne_altitude);
   pGPS->TrueAirspeed = vtas;
   pGPS->AirspeedAvailable = (pGPS->IndicatedAirspeed >0);
@@ -164,17 +156,14 @@ BOOL FLYSEN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
   // ignore n.14 airspeed source
 
   // OAT
-  NMEAParser::ExtractParameter(String,ctemp,15+offset);
-  pGPS->OutsideAirTemperature = StrToDouble(ctemp,NULL);
+  pGPS->OutsideAirTemperature = sentence.ToDouble(15+offset);
   pGPS->TemperatureAvailable=TRUE;
 
   // ignore n.16 baloon temperature
 
   // BATTERY PERCENTAGES
-  NMEAParser::ExtractParameter(String,ctemp,17+offset);
-  pGPS->ExtBatt1_Voltage = StrToDouble(ctemp,NULL)+1000;
-  NMEAParser::ExtractParameter(String,ctemp,18+offset);
-  pGPS->ExtBatt2_Voltage = StrToDouble(ctemp,NULL)+1000;
+  pGPS->ExtBatt1_Voltage = sentence.ToDouble(17+offset)+1000;
+  pGPS->ExtBatt2_Voltage = sentence.ToDouble(18+offset)+1000;
 
   TriggerGPSUpdate();
 
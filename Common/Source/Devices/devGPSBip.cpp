@@ -27,9 +27,9 @@ namespace {
 
   std::array<DeviceDescriptor_t, std::size(DeviceNameList)> DeviceDesciptorList;
 
-  BOOL ParseNMEA(DeviceDescriptor_t *d, const char *String, NMEA_INFO *GPS_INFO) {
+  BOOL ParseNMEA(DeviceDescriptor_t *d, const NMEASentence& sentence, NMEA_INFO *GPS_INFO) {
     for(auto& Dev : DeviceDesciptorList) {
-      if(Dev.ParseNMEA && Dev.ParseNMEA(d, String, GPS_INFO)) {
+      if(Dev.ParseNMEA && Dev.ParseNMEA(d, sentence, GPS_INFO)) {
         // this device send GPS data only when fix is valid.
         d->nmeaParser.connected = true;
         return TRUE;
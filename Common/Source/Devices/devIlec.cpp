@@ -13,18 +13,20 @@
 #include "devIlec.h"
 #include "Comm/ExternalWind.h"
 
+using std::string_view_literals::operator""sv;
+
 
 static
-BOOL PILC(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS);
+BOOL PILC(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
 static
-BOOL IlecParseNMEA(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS){
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+BOOL IlecParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
-  if(strncmp("$PILC", String, 5)==0) {
-      return PILC(d, &String[6], pGPS);
+  if(sentence.Address() == "$PILC"sv) {
+      return PILC(d, sentence, pGPS);
   }
 
   return FALSE;
@@ -37,29 +39,27 @@ void IlecInstall(DeviceDescriptor_t* d) {
 }
 
 static
-BOOL PILC(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS)
+BOOL PILC(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
 
   char ctemp[80];
 
-  NMEAParser::ExtractParameter(String,ctemp,0);
+  sentence.Copy(0, ctemp);
 
   if (strcmp(ctemp, "PDA1")==0) {
 
-	NMEAParser::ExtractParameter(String,ctemp,1);
-	UpdateBaroSource( pGPS, d, QNEAltitudeToQNHAltitude(StrToDouble(ctemp, NULL)));
+	UpdateBaroSource( pGPS, d, QNEAltitudeToQNHAltitude(sentence.ToDouble(1)));
 
-	NMEAParser::ExtractParameter(String,ctemp,2);
-	double Vario = StrToDouble(ctemp,NULL);
+	double Vario = sentence.ToDouble(2);
 	UpdateVarioSource(*pGPS, *d, Vario);
 
-	NMEAParser::ExtractParameter(String,ctemp,4); // wind speed kph integer
+	sentence.Copy(4, ctemp); // wind speed kph integer
 	if (strlen(ctemp)!=0) {
 		double wspeed = StrToDouble(ctemp,NULL);
-		NMEAParser::ExtractParameter(String,ctemp,5); // confidence  0-100 percentage
+		sentence.Copy(5, ctemp); // confidence  0-100 percentage
 		double wconfidence = StrToDouble(ctemp,NULL);
 		if (wconfidence > 0) {
-			NMEAParser::ExtractParameter(String,ctemp,3); // wind direction, integer
+			sentence.Copy(3, ctemp); // wind direction, integer
 			double wfrom = StrToDouble(ctemp,NULL); //@ could also be the NMEA checksum!
 			UpdateExternalWind(*pGPS, *d, Units::From(Units_t::unKiloMeterPerHour, wspeed), wfrom);
 		}
@@ -69,7 +69,7 @@ BOOL PILC(DeviceDescriptor_t* d, const char* String, NMEA_INFO *pGPS)
   }
 
   if (strcmp(ctemp, "SET")==0) {
-	NMEAParser::ExtractParameter(String,ctemp,1);
+	sentence.Copy(1, ctemp);
 	UpdateQNH(StrToDouble(ctemp,NULL));
 	// StartupStore(_T("... SET QNH= %.1f\n"),QNH);
 
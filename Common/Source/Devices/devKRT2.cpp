@@ -465,7 +465,7 @@ int KRT2_Convert_Answer(DeviceDescriptor_t* d, uint8_t *szCommand, int len) {
 }
 
 
-BOOL KRT2ParseString(DeviceDescriptor_t* d, char *String, int len, NMEA_INFO *GPS_INFO) {
+BOOL KRT2ParseString(DeviceDescriptor_t* d, const char *String, int len, NMEA_INFO *GPS_INFO) {
   if(d == NULL) return 0;
   if(String == NULL) return 0;
   if(len == 0) return 0;
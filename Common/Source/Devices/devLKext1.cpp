@@ -11,15 +11,17 @@
 #include "Calc/Vario.h"
 #include "devLK8EX1.h"
 
+using std::string_view_literals::operator""sv;
+
 static
-BOOL LK8EX1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+BOOL LK8EX1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
-BOOL LK8EX1ParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
-  if(strncmp("$LK8EX1", String, 7)==0) {
-    if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+BOOL LK8EX1ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
+  if(sentence.Address() == "$LK8EX1"sv) {
+    if (!sentence.ChecksumValid() || (pGPS == NULL)){
       return FALSE;
     }
-    return LK8EX1(d, &String[8], pGPS);
+    return LK8EX1(d, sentence, pGPS);
   }
   return FALSE;
 }
@@ -73,15 +75,13 @@ void LK8EX1Install(DeviceDescriptor_t* d){
 */
 
 static
-BOOL LK8EX1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
+BOOL LK8EX1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
 
-  char ctemp[80];
   bool havebaro=false;
 
   // HPA from the pressure sensor
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  double ps = StrToDouble(ctemp,NULL);
+  double ps = sentence.ToDouble(0);
   if (ps!=999999) {
     UpdateBaroSource( pGPS, d, StaticPressureToQNHAltitude(ps));
     havebaro = true;
@@ -89,8 +89,7 @@ BOOL LK8EX1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 
   // QNE
   if (!havebaro) {
-    NMEAParser::ExtractParameter(String,ctemp,1);
-    double ba = StrToDouble(ctemp,NULL);
+    double ba = sentence.ToDouble(1);
     if (ba!=99999) {
         UpdateBaroSource( pGPS, d, QNEAltitudeToQNHAltitude(ba));
     }
@@ -98,23 +97,20 @@ BOOL LK8EX1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 
 
   // VARIO
-  NMEAParser::ExtractParameter(String,ctemp,2);
-  double va = StrToDouble(ctemp,NULL);
+  double va = sentence.ToDouble(2);
   if (va != 9999) {
     UpdateVarioSource(*pGPS, *d, va/100);
   }
 
   // OAT
-  NMEAParser::ExtractParameter(String,ctemp,3);
-  double ta = StrToDouble(ctemp,NULL);
+  double ta = sentence.ToDouble(3);
   if (ta != 99) {
     pGPS->OutsideAirTemperature = ta;
     pGPS->TemperatureAvailable=TRUE;
   }
 
   // BATTERY PERCENTAGES
-  NMEAParser::ExtractParameter(String,ctemp,4);
-  double voa = StrToDouble(ctemp,NULL);
+  double voa = sentence.ToDouble(4);
   if (voa!=999) {
     pGPS->ExtBatt1_Voltage = voa;
   }
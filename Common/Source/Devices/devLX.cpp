@@ -16,6 +16,8 @@
 #include "utils/charset_helper.h"
 #include "Comm/ExternalWind.h"
 
+using std::string_view_literals::operator""sv;
+
 //____________________________________________________________class_definitions_
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -44,20 +46,20 @@ void DevLX::Install(DeviceDescriptor_t* d)
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLX::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLX::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
-  if (!NMEAParser::NMEAChecksum(sentence) || (info == NULL)){
+  if (!sentence.ChecksumValid() || (info == NULL)){
     return FALSE;
   }
 
-  if (strncmp("$LXWP0", sentence, 6) == 0)
-      return LXWP0(d, sentence + 7, info);
-  else if (strncmp("$LXWP1", sentence, 6) == 0)
-      return LXWP1(d, sentence + 7, info);
-  else if (strncmp("$LXWP2", sentence, 6) == 0)
-      return LXWP2(d, sentence + 7, info);
-  else if (strncmp("$LXWP3", sentence, 6) == 0)
-      return LXWP3(d, sentence + 7, info);
+  if (sentence.Address() == "$LXWP0"sv)
+      return LXWP0(d, sentence, info);
+  else if (sentence.Address() == "$LXWP1"sv)
+      return LXWP1(d, sentence, info);
+  else if (sentence.Address() == "$LXWP2"sv)
+      return LXWP2(d, sentence, info);
+  else if (sentence.Address() == "$LXWP3"sv)
+      return LXWP3(d, sentence, info);
 
   return(false);
 } // ParseNMEA()
@@ -73,7 +75,7 @@ BOOL DevLX::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* in
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLX::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLX::LXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   // $LXWP0,logger_stored, airspeed, airaltitude,
   //   v1[0],v1[1],v1[2],v1[3],v1[4],v1[5], hdg, windspeed*CS<CR><LF>
@@ -91,14 +93,14 @@ bool DevLX::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
 
   double alt=0, airspeed=0;
 
-  if (ParToDouble(sentence, 1, &airspeed))
+  if (sentence.ToDouble(1, &airspeed))
   {
     airspeed = Units::From(unKiloMeterPerHour, airspeed);
     info->TrueAirspeed = airspeed;
     info->AirspeedAvailable = TRUE;
   }
 
-  if (ParToDouble(sentence, 2, &alt))
+  if (sentence.ToDouble(2, &alt))
   {
     if (airspeed>0) {
       info->IndicatedAirspeed = IndicatedAirSpeed(airspeed, alt);
@@ -111,15 +113,15 @@ bool DevLX::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
   }
 
   double Vario = 0;
-  if (ParToDouble(sentence, 8, &Vario)) { /* take the last value to be more recent */
+  if (sentence.ToDouble(8, &Vario)) { /* take the last value to be more recent */
     UpdateVarioSource(*info, *d, Vario);
   }
 
-  if (ParToDouble(sentence, 9, &info->MagneticHeading))
+  if (sentence.ToDouble(9, &info->MagneticHeading))
       info->MagneticHeadingAvailable=TRUE;
 
   double WindSpeed, WindDirection;
-  if (ParToDouble(sentence, 10, &WindDirection) && ParToDouble(sentence, 11, &WindSpeed)) {
+  if (sentence.ToDouble(10, &WindDirection) && sentence.ToDouble(11, &WindSpeed)) {
     UpdateExternalWind(*info, *d, Units::From(Units_t::unKiloMeterPerHour, WindSpeed), WindDirection);
   }
 
@@ -137,7 +139,7 @@ bool DevLX::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLX::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
+bool DevLX::LXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* pGPS)
 {
   // $LXWP1,serial number,instrument ID, software version, hardware
   //   version,license string,NU*SC<CR><LF>
@@ -153,25 +155,22 @@ bool DevLX::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
 char ctemp[180];
 static int NoMsg=0;
 static int oldSerial=0;
-if(strlen(String) < 180)
+if(strlen(sentence.c_str()) < 180)
   if((( d->SerialNumber == 0)  || ( d->SerialNumber != oldSerial)) && (NoMsg < 5))
   {
     NoMsg++ ;
-    NMEAParser::ExtractParameter(String, ctemp, 0);
+    sentence.Copy(0, ctemp);
     from_unknown_charset(ctemp, d->Name);
     lk::snprintf(d->Name, _T("%s"), ctemp);
     StartupStore(_T(". %s\n"), d->Name);
 
-    NMEAParser::ExtractParameter(String, ctemp, 1);
-    oldSerial = d->SerialNumber = StrToDouble(ctemp, nullptr);
+    oldSerial = d->SerialNumber = sentence.ToDouble(1);
     StartupStore(_T(". %s Serial Number %i"), d->Name, d->SerialNumber);
 
-    NMEAParser::ExtractParameter(String, ctemp, 2);
-  	d->SoftwareVer = StrToDouble(ctemp, nullptr);
+    d->SoftwareVer = sentence.ToDouble(2);
     StartupStore(_T(". %s Software Vers.: %3.2f"), d->Name, d->SoftwareVer);
 
-    NMEAParser::ExtractParameter(String, ctemp, 3);
-    d->HardwareId = StrToDouble(ctemp, nullptr) * 10;
+    d->HardwareId = sentence.ToDouble(3) * 10;
     StartupStore(_T(". %s Hardware Vers.: %3.2f"), d->Name, (d->HardwareId) / 10.0);
 
     TCHAR str[255];
@@ -196,7 +195,7 @@ if(strlen(String) < 180)
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLX::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLX::LXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   // $LXWP2,mccready,ballast,bugs,polar_a,polar_b,polar_c, audio volume
   //   *CS<CR><LF>
@@ -210,7 +209,7 @@ bool DevLX::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
   // audio volume 0 - 100%
 
   double value;
-  ParToDouble(sentence, 0, &value);
+  sentence.ToDouble(0, &value);
   d->RecvMacCready(value);
 
   return(true);
@@ -227,7 +226,7 @@ bool DevLX::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLX::LXWP3(DeviceDescriptor_t*, const char*, NMEA_INFO*)
+bool DevLX::LXWP3(DeviceDescriptor_t*, const NMEASentence&, NMEA_INFO*)
 {
   // $LXWP3,altioffset, scmode, variofil, tefilter, televel, varioavg,
   //   variorange, sctab, sclow, scspeed, SmartDiff,
@@ -259,33 +258,33 @@ bool DevLX::LXWP3(DeviceDescriptor_t*, const char*, NMEA_INFO*)
 
 
 
-bool DevLX::GPRMB(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLX::GPRMB(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 
   char  szTmp[MAX_NMEA_LEN];
   double fTmp;
 
-  ParToDouble(sentence, 5, &fTmp);
+  sentence.ToDouble(5, &fTmp);
   double DegLat = (double)((int) (fTmp/100.0));
   double MinLat =  fTmp- (100.0*DegLat);
   double Latitude = DegLat+MinLat/60.0;
 
-  NMEAParser::ExtractParameter(sentence,szTmp,6);
+  sentence.Copy(6, szTmp);
   if (szTmp[0]==_T('S')) {
     Latitude *= -1;
   }
 
-  ParToDouble(sentence, 7, &fTmp);
+  sentence.ToDouble(7, &fTmp);
   double DegLon =  (double) ((int) (fTmp/100.0));
   double MinLon =  fTmp- (100.0*DegLon);
   double Longitude = DegLon+MinLon/60.0;
 
-  NMEAParser::ExtractParameter(sentence,szTmp,8);
+  sentence.Copy(8, szTmp);
   if (szTmp[0]==_T('W')) {
     Longitude *= -1;
   }
 	
-  NMEAParser::ExtractParameter(sentence,szTmp,4);
+  sentence.Copy(4, szTmp);
   tstring tname = from_unknown_charset(szTmp);
 
   LockTaskData();
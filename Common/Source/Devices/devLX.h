@@ -65,7 +65,7 @@ class DevLX : public DevBase
     static void Install(DeviceDescriptor_t* d);
 
     /// Parses LXWPn sentences.
-    static BOOL ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static BOOL ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Returns device name (max length is @c DEVNAMESIZE).
     static constexpr
@@ -74,18 +74,18 @@ class DevLX : public DevBase
     }
 
     /// Parses LXWP0 sentence.
-    static bool LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool LXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Parses LXWP1 sentence.
-    static bool LXWP1(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool LXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Parses LXWP2 sentence.
-    static bool LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool LXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Parses LXWP3 sentence.
-    static bool LXWP3(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool LXWP3(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
-    static bool GPRMB(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool GPRMB(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Converts TCHAR[] string into US-ASCII string.
     static void Wide2LxAscii(const TCHAR* input, int outSize, char* output);
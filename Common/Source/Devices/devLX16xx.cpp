@@ -18,6 +18,8 @@
 #include "OS/Sleep.h"
 #include "Comm/ExternalWind.h"
 
+using std::string_view_literals::operator""sv;
+
 int  LX166AltitudeUpdateTimeout =0;
 int  LX16xxAlt=0;
 double fPolar_a=0.0, fPolar_b=0.0, fPolar_c=0.0, fVolume=0.0;
@@ -217,32 +219,32 @@ BOOL LX16xxPutBugs(DeviceDescriptor_t* d, double Bugs){
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLX16xx::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLX16xx::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   static int i=40;
 
-  if (!NMEAParser::NMEAChecksum(sentence) || (info == NULL)){
+  if (!sentence.ChecksumValid() || (info == NULL)){
     return FALSE;
   }
 
   /* configure LX after 30 GPS positions */
-  if (strncmp("$GPGGA", sentence, 6) == 0) {
+  if (sentence.Address() == "$GPGGA"sv) {
     if (i++ > 10) {
       SetupLX_Sentence(d);
       i = 0;
     }
   }
 
-  if (strncmp("$LXWP0", sentence, 6) == 0)
-    return LXWP0(d, sentence + 7, info);
-  else if (strncmp("$LXWP1", sentence, 6) == 0)
-    return LXWP1(d, sentence + 7, info);
-  else if (strncmp("$LXWP2", sentence, 6) == 0)
-    return LXWP2(d, sentence + 7, info);
-  else if (strncmp("$LXWP3", sentence, 6) == 0)
-    return LXWP3(d, sentence + 7, info);
-  else if (strncmp("$LXWP4", sentence, 6) == 0)
-    return LXWP4(d, sentence + 7, info);
+  if (sentence.Address() == "$LXWP0"sv)
+    return LXWP0(d, sentence, info);
+  else if (sentence.Address() == "$LXWP1"sv)
+    return LXWP1(d, sentence, info);
+  else if (sentence.Address() == "$LXWP2"sv)
+    return LXWP2(d, sentence, info);
+  else if (sentence.Address() == "$LXWP3"sv)
+    return LXWP3(d, sentence, info);
+  else if (sentence.Address() == "$LXWP4"sv)
+    return LXWP4(d, sentence, info);
 
   return(false);
 } // ParseNMEA()
@@ -258,7 +260,7 @@ BOOL DevLX16xx::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLX16xx::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLX16xx::LXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   // $LXWP0,logger_stored, airspeed, airaltitude,
   //   v1[0],v1[1],v1[2],v1[3],v1[4],v1[5], hdg, windspeed*CS<CR><LF>
@@ -276,7 +278,7 @@ bool DevLX16xx::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* in
 
   double alt=0, airspeed=0;
 
-  if (ParToDouble(sentence, 1, &airspeed))
+  if (sentence.ToDouble(1, &airspeed))
   {
     airspeed = Units::From(unKiloMeterPerHour, airspeed);
     info->TrueAirspeed = airspeed;
@@ -285,7 +287,7 @@ bool DevLX16xx::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* in
   if(LX166AltitudeUpdateTimeout >0)
 	  LX166AltitudeUpdateTimeout--;
   else
-    if (ParToDouble(sentence, 2, &alt))
+    if (sentence.ToDouble(2, &alt))
     {
       LX16xxAlt = (int) alt;
       if (airspeed>0) {
@@ -295,12 +297,12 @@ bool DevLX16xx::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* in
     }
 
   double Vario = 0;
-  if (ParToDouble(sentence, 3, &Vario)) {
+  if (sentence.ToDouble(3, &Vario)) {
     UpdateVarioSource(*info, *d, Vario);
   }
 
   double WindSpeed, WindDirection;
-  if (ParToDouble(sentence, 10, &WindDirection) && ParToDouble(sentence, 11, &WindSpeed)) {
+  if (sentence.ToDouble(10, &WindDirection) && sentence.ToDouble(11, &WindSpeed)) {
     UpdateExternalWind(*info, *d, Units::From(Units_t::unKiloMeterPerHour, WindSpeed), WindDirection);
   }
 
@@ -319,7 +321,7 @@ bool DevLX16xx::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* in
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLX16xx::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
+bool DevLX16xx::LXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* pGPS)
 {
   // $LXWP1,serial number,instrument ID, software version, hardware
   //   version,license string,NU*SC<CR><LF>
@@ -335,26 +337,23 @@ bool DevLX16xx::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS
   char ctemp[180];
   static int NoMsg=0;
   static int oldSerial=0;
-if (strlen(String) < 180)
+if (strlen(sentence.c_str()) < 180)
   if((( d->SerialNumber == 0)  || ( d->SerialNumber != oldSerial)) && (NoMsg < 5))
   {
     NoMsg++ ;
-    NMEAParser::ExtractParameter(String, ctemp, 0);
+    sentence.Copy(0, ctemp);
     from_unknown_charset(ctemp, d->Name);
     lk::snprintf(d->Name, _T("%s"),ctemp);
     StartupStore(_T(". %s\n"),ctemp);
 
-    NMEAParser::ExtractParameter(String, ctemp, 1);
-    d->SerialNumber = StrToDouble(ctemp, nullptr);
+    d->SerialNumber = sentence.ToDouble(1);
     oldSerial = d->SerialNumber;
 	  StartupStore(_T(". %s Serial Number %i"), d->Name, d->SerialNumber);
 
-    NMEAParser::ExtractParameter(String, ctemp, 2);
-    d->SoftwareVer= StrToDouble(ctemp, nullptr);
+    d->SoftwareVer= sentence.ToDouble(2);
     StartupStore(_T(". %s Software Vers.: %3.2f"), d->Name, d->SoftwareVer);
 
-    NMEAParser::ExtractParameter(String, ctemp, 3);
-    d->HardwareId = StrToDouble(ctemp, nullptr) * 10;
+    d->HardwareId = sentence.ToDouble(3) * 10;
   	StartupStore(_T(". %s Hardware Vers.: %3.2f"), d->Name, d->HardwareId / 10.0);
 
     TCHAR str[255];
@@ -381,7 +380,7 @@ if (strlen(String) < 180)
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLX16xx::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*)
+bool DevLX16xx::LXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO*)
 {
   // $LXWP2,mccready,ballast,bugs,polar_a,polar_b,polar_c, audio volume
   //   *CS<CR><LF>
@@ -396,27 +395,27 @@ bool DevLX16xx::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*)
   //float fBallast,fBugs, polar_a, polar_b, polar_c, fVolume;
 
   double fTmp;
-  if (ParToDouble(sentence, 0, &fTmp)) {
+  if (sentence.ToDouble(0, &fTmp)) {
     int iTmp = (fTmp * 100.0 + 0.5f);
     bValid = true;
     d->RecvMacCready((double)(iTmp) / 100.0);
   }
 
-  if (ParToDouble(sentence, 1, &fTmp)) {
+  if (sentence.ToDouble(1, &fTmp)) {
     d->RecvBallast(CalculateBalastFromLX(fTmp));
   }
 
-  if(ParToDouble(sentence, 2, &fTmp)) {
+  if(sentence.ToDouble(2, &fTmp)) {
     d->RecvBugs(CalculateBugsFromLX(fTmp));
   }
 
-  if (ParToDouble(sentence, 3, &fTmp))
+  if (sentence.ToDouble(3, &fTmp))
     fPolar_a = fTmp;
-  if (ParToDouble(sentence, 4, &fTmp))
+  if (sentence.ToDouble(4, &fTmp))
     fPolar_b = fTmp;
-  if (ParToDouble(sentence, 5, &fTmp))
+  if (sentence.ToDouble(5, &fTmp))
     fPolar_c = fTmp;
-  if (ParToDouble(sentence, 6, &fTmp))
+  if (sentence.ToDouble(6, &fTmp))
   {
     fVolume = fTmp;
   }
@@ -434,7 +433,7 @@ bool DevLX16xx::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*)
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLX16xx::LXWP3(DeviceDescriptor_t*, const char*, NMEA_INFO*)
+bool DevLX16xx::LXWP3(DeviceDescriptor_t*, const NMEASentence&, NMEA_INFO*)
 {
   // $LXWP3,altioffset, scmode, variofil, tefilter, televel, varioavg,
   //   variorange, sctab, sclow, scspeed, SmartDiff,
@@ -464,7 +463,7 @@ bool DevLX16xx::LXWP3(DeviceDescriptor_t*, const char*, NMEA_INFO*)
 } // LXWP3()
 
 
-bool DevLX16xx::LXWP4(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLX16xx::LXWP4(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 
 // $LXWP4 Sc, Netto, Relativ, gl.dif, leg speed, leg time, integrator, flight time, battery voltage*CS<CR><LF>
@@ -481,7 +480,7 @@ bool DevLX16xx::LXWP4(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* in
 
   double Batt;
 
-  if (ParToDouble(sentence, 9, &Batt))
+  if (sentence.ToDouble(9, &Batt))
   {
 	 info->ExtBatt1_Voltage = Batt;
   }
@@ -23,6 +23,8 @@
 #include "OS/Sleep.h"
 #include "Comm/ExternalWind.h"
 
+using std::string_view_literals::operator""sv;
+
 //____________________________________________________________class_definitions_
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -201,23 +203,23 @@ BOOL DevLXMiniMap::Open(DeviceDescriptor_t* d){
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLXMiniMap::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLXMiniMap::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 
-  if (!NMEAParser::NMEAChecksum(sentence) || (info == NULL)){
+  if (!sentence.ChecksumValid() || (info == NULL)){
     return FALSE;
   }
 
-  if (strncmp("$GPGGA", sentence, 6) == 0)
+  if (sentence.Address() == "$GPGGA"sv)
 	   LXMiniMapOnSysTicker(d);
-  else if (strncmp("$LXWP0", sentence, 6) == 0)
-      return LXWP0(d, sentence + 7, info);
-  else if (strncmp("$LXWP1", sentence, 6) == 0)
-      return LXWP1(d, sentence + 7, info);
-  else if (strncmp("$LXWP2", sentence, 6) == 0)
-      return LXWP2(d, sentence + 7, info);
-  else if (strncmp("$LXWP3", sentence, 6) == 0)
-      return LXWP3(d, sentence + 7, info);
+  else if (sentence.Address() == "$LXWP0"sv)
+      return LXWP0(d, sentence, info);
+  else if (sentence.Address() == "$LXWP1"sv)
+      return LXWP1(d, sentence, info);
+  else if (sentence.Address() == "$LXWP2"sv)
+      return LXWP2(d, sentence, info);
+  else if (sentence.Address() == "$LXWP3"sv)
+      return LXWP3(d, sentence, info);
 
   return(false);
 } // ParseNMEA()
@@ -233,7 +235,7 @@ BOOL DevLXMiniMap::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_I
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLXMiniMap::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLXMiniMap::LXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   // $LXWP0,logger_stored, airspeed, airaltitude,
   //   v1[0],v1[1],v1[2],v1[3],v1[4],v1[5], hdg, windspeed*CS<CR><LF>
@@ -253,14 +255,14 @@ bool DevLXMiniMap::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 
   double alt=0, airspeed=0;
 
-  if (ParToDouble(sentence, 1, &airspeed))
+  if (sentence.ToDouble(1, &airspeed))
   {
     airspeed = Units::From(unKiloMeterPerHour, airspeed);
     info->TrueAirspeed = airspeed;
     info->AirspeedAvailable = TRUE;
   }
 
-  if (ParToDouble(sentence, 2, &alt))
+  if (sentence.ToDouble(2, &alt))
   {
     if (airspeed>0) {
       info->IndicatedAirspeed = IndicatedAirSpeed(airspeed, alt);
@@ -273,12 +275,12 @@ bool DevLXMiniMap::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   }
 
   double Vario = 0;
-  if (ParToDouble(sentence, 3, &Vario)) {
+  if (sentence.ToDouble(3, &Vario)) {
     UpdateVarioSource(*info, *d, Vario);
   }
 
   double WindSpeed, WindDirection;
-  if (ParToDouble(sentence, 10, &WindDirection) && ParToDouble(sentence, 11, &WindSpeed)) {
+  if (sentence.ToDouble(10, &WindDirection) && sentence.ToDouble(11, &WindSpeed)) {
     UpdateExternalWind(*info, *d, Units::From(Units_t::unKiloMeterPerHour, WindSpeed), WindDirection);
   }
 
@@ -296,7 +298,7 @@ bool DevLXMiniMap::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLXMiniMap::LXWP1(DeviceDescriptor_t*, const char*, NMEA_INFO*)
+bool DevLXMiniMap::LXWP1(DeviceDescriptor_t*, const NMEASentence&, NMEA_INFO*)
 {
   // $LXWP1,serial number,instrument ID, software version, hardware
   //   version,license string,NU*SC<CR><LF>
@@ -345,7 +347,7 @@ double DevLXMiniMap::CalculateBalast(double Factor)
 
 
 
-bool DevLXMiniMap::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLXMiniMap::LXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   // $LXWP2,mccready,ballast,bugs,polar_a,polar_b,polar_c, audio volume
   //   *CS<CR><LF>
@@ -358,16 +360,16 @@ bool DevLXMiniMap::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   // polar_c: float polar_c=c
   // audio volume 0 - 100%
   double value;
-  ParToDouble(sentence, 0, &value);
+  sentence.ToDouble(0, &value);
   d->RecvMacCready(value);
 
   double tempBallastFactor;
-  ParToDouble(sentence, 1, &tempBallastFactor);
+  sentence.ToDouble(1, &tempBallastFactor);
 
   d->RecvBallast(CalculateBalast(tempBallastFactor));
 
   double tempBugs;
-  ParToDouble(sentence, 2, &tempBugs);
+  sentence.ToDouble(2, &tempBugs);
   d->RecvBugs((100.0 - tempBugs)/100);
 
   return(true);
@@ -384,7 +386,7 @@ bool DevLXMiniMap::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLXMiniMap::LXWP3(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLXMiniMap::LXWP3(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 
 
@@ -397,7 +399,7 @@ bool DevLXMiniMap::LXWP3(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 	else
 	{
 		double offsettmp = 0.0;
-		ParToDouble(sentence, 0, &offsettmp);
+		sentence.ToDouble(0, &offsettmp);
 		AltOffset = offsettmp * FT2M;
 	}
 
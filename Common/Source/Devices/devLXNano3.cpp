@@ -37,6 +37,8 @@
 #include "Comm/UpdateQNH.h"
 #include "Comm/ExternalWind.h"
 
+using std::string_view_literals::operator""sv;
+
 #define NANO_PROGRESS_DLG
 #define BLOCK_SIZE 32
 
@@ -286,9 +288,9 @@ TCHAR  szTmp[MAX_NMEA_LEN];
 /// @retval true if the sentence has been parsed
 ///
 // static
-BOOL DevLXNanoIII::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info) {
+BOOL DevLXNanoIII::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info) {
   auto wait_ack = d->lock_wait_ack();
-  if (wait_ack && wait_ack->check(sentence)) {
+  if (wait_ack && wait_ack->check(sentence.c_str())) {
     return TRUE;
   }
 
@@ -296,7 +298,7 @@ BOOL DevLXNanoIII::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_I
   const auto& Port = PortConfig[d->PortNumber];
   const auto& PortIO = Port.PortIO;
 
-  if (strncmp("$LXWP2", sentence, 6) == 0) {
+  if (sentence.Address() == "$LXWP2"sv) {
     Nano3_bValid = true;
     if (iNano3_RxUpdateTime > 0) {
       iNano3_RxUpdateTime--;
@@ -320,7 +322,7 @@ BOOL DevLXNanoIII::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_I
     }
   }
 
-  if (strncmp("$GPGGA", sentence, 6) == 0) {
+  if (sentence.Address() == "$GPGGA"sv) {
     if (iS_SeriesTimeout-- < 0)
       devSetAdvancedMode(d, false);
 
@@ -348,31 +350,31 @@ BOOL DevLXNanoIII::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_I
     SendNmea(d, szTmp);
   }
 #endif
-  if (strncmp("$PLXVC", sentence, 6) == 0) {
+  if (sentence.Address() == "$PLXVC"sv) {
     return PLXVC(d, sentence, info);
   }
 
-  if (!NMEAParser::NMEAChecksum(sentence) || (info == NULL)) {
+  if (!sentence.ChecksumValid() || (info == NULL)) {
     return FALSE;
   }
 
-  if (strncmp("$PLXVF", sentence, 6) == 0)
-    return PLXVF(d, sentence + 7, info);
-  else if (strncmp("$PLXVS", sentence, 6) == 0)
-    return PLXVS(d, sentence + 7, info);
-  else if (strncmp("$PLXV0", sentence, 6) == 0)
-    return PLXV0(d, sentence + 7, info);
-  else if (strncmp("$LXWP2", sentence, 6) == 0)
-    return LXWP2(d, sentence + 7, info);
-  else if (strncmp("$LXWP0", sentence, 6) == 0)
-    return LXWP0(d, sentence + 7, info);
-  else if (strncmp("$PLXVTARG", sentence, 9) == 0)
-    return PLXVTARG(d, sentence + 10, info);
-  else if (strncmp("$GPRMB", sentence, 6) == 0)
-    return GPRMB(d, sentence + 7, info);
-  else if (strncmp("$LXWP1", sentence, 6) == 0) {
+  if (sentence.Address() == "$PLXVF"sv)
+    return PLXVF(d, sentence, info);
+  else if (sentence.Address() == "$PLXVS"sv)
+    return PLXVS(d, sentence, info);
+  else if (sentence.Address() == "$PLXV0"sv)
+    return PLXV0(d, sentence, info);
+  else if (sentence.Address() == "$LXWP2"sv)
+    return LXWP2(d, sentence, info);
+  else if (sentence.Address() == "$LXWP0"sv)
+    return LXWP0(d, sentence, info);
+  else if (sentence.Address() == "$PLXVTARG"sv)
+    return PLXVTARG(d, sentence, info);
+  else if (sentence.Address() == "$GPRMB"sv)
+    return GPRMB(d, sentence, info);
+  else if (sentence.Address() == "$LXWP1"sv) {
     Nano3_bValid = true;
-    return LXWP1(d, sentence + 7, info);
+    return LXWP1(d, sentence, info);
   }
   return false;
 }  // ParseNMEA()
@@ -1121,17 +1123,17 @@ BOOL DevLXNanoIII::AbortLX_IGC_FileRead(void)
 }
 
 
-BOOL DevLXNanoIII::PLXVC(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLXNanoIII::PLXVC(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
  /*
   * $PLXVC,<key>,<type>,<values>*<checksum><cr><lf>
   */
 
-  bool bCRCok = NMEAParser::NMEAChecksum(sentence);
+  bool bCRCok = sentence.ChecksumValid();
 
   char ctemp[MAX_NMEA_LEN];
   char* params[MAX_NMEA_PARAMS];
-  size_t n_params = NMEAParser::ExtractParameters(sentence, ctemp, params);
+  size_t n_params = NMEAParser::ExtractParameters(sentence.c_str(), ctemp, params);
   if(n_params < 4) {
     return FALSE;
   }
@@ -1234,7 +1236,7 @@ BOOL DevLXNanoIII::PLXVC(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLXNanoIII::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLXNanoIII::LXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   // $LXWP0,logger_stored, airspeed, airaltitude,
   //   v1[0],v1[1],v1[2],v1[3],v1[4],v1[5], hdg, windspeed*CS<CR><LF>
@@ -1256,7 +1258,7 @@ BOOL DevLXNanoIII::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   if( !devGetAdvancedMode(d))
   {
     double airspeed;
-    if (ParToDouble(sentence, 1, &airspeed))
+    if (sentence.ToDouble(1, &airspeed))
     {
 
       if(Values(d))
@@ -1273,7 +1275,7 @@ BOOL DevLXNanoIII::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
     }
 
     double altitude;
-    if (ParToDouble(sentence, 2, &altitude))
+    if (sentence.ToDouble(2, &altitude))
     {
       if(Values(d))
       { TCHAR szTmp[MAX_NMEA_LEN];
@@ -1290,7 +1292,7 @@ BOOL DevLXNanoIII::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
     }
 
     double vario;
-    if (ParToDouble(sentence, 3, &vario))
+    if (sentence.ToDouble(3, &vario))
     {
       if(Values(d))
       { TCHAR szTmp[MAX_NMEA_LEN];
@@ -1305,7 +1307,7 @@ BOOL DevLXNanoIII::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   }
 
   double WindSpeed, WindDirection;
-  if (ParToDouble(sentence, 10, &WindDirection) && ParToDouble(sentence, 11, &WindSpeed)) {
+  if (sentence.ToDouble(10, &WindDirection) && sentence.ToDouble(11, &WindSpeed)) {
     if(Values(d)) {
       TCHAR szTmp[MAX_NMEA_LEN];
       _sntprintf(szTmp,MAX_NMEA_LEN, _T("%5.1fkm/h %3.0f° ($LXWP0)"), WindSpeed, WindDirection);
@@ -1331,7 +1333,7 @@ BOOL DevLXNanoIII::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLXNanoIII::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
+BOOL DevLXNanoIII::LXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* pGPS)
 {
   // $LXWP1,serial number,instrument ID, software version, hardware
   //   version,license string,NU*SC<CR><LF>
@@ -1347,24 +1349,21 @@ BOOL DevLXNanoIII::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* p
   char ctemp[MAX_NMEA_LEN];
   static int NoMsg=0;
   static int oldSerial=0;
-  if (strlen(String) < 180)
+  if (strlen(sentence.c_str()) < 180)
     if ((( d->SerialNumber == 0)  || ( d->SerialNumber != oldSerial)) && (NoMsg < 5)) {
       NoMsg++ ;
-      NMEAParser::ExtractParameter(String, ctemp, 0);
+      sentence.Copy(0, ctemp);
       from_unknown_charset(ctemp, d->Name);
       StartupStore(_T(". %s"), d->Name);
 
-      NMEAParser::ExtractParameter(String, ctemp, 1);
-      d->SerialNumber = StrToDouble(ctemp, nullptr);
+      d->SerialNumber = sentence.ToDouble(1);
       oldSerial = d->SerialNumber;
       StartupStore(_T(". %s Serial Number %i"), d->Name, d->SerialNumber);
 
-      NMEAParser::ExtractParameter(String, ctemp, 2);
-      d->SoftwareVer= StrToDouble(ctemp, nullptr);
+      d->SoftwareVer= sentence.ToDouble(2);
       StartupStore(_T(". %s Software Vers.: %3.2f"), d->Name, d->SoftwareVer);
 
-      NMEAParser::ExtractParameter(String, ctemp, 3);
-      d->HardwareId = StrToDouble(ctemp, nullptr) * 10;
+      d->HardwareId = sentence.ToDouble(3) * 10;
       StartupStore(_T(". %s Hardware Vers.: %3.2f"), d->Name, d->HardwareId / 10.0);
 
       TCHAR str[255];
@@ -1390,7 +1389,7 @@ BOOL DevLXNanoIII::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* p
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLXNanoIII::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*)
+BOOL DevLXNanoIII::LXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO*)
 {
   // $LXWP2,mccready,ballast,bugs,polar_a,polar_b,polar_c, audio volume
   //   *CS<CR><LF>
@@ -1410,7 +1409,7 @@ BOOL DevLXNanoIII::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   const auto& Port = PortConfig[d->PortNumber];
   const auto& PortIO = Port.PortIO;
 
-  if (ParToDouble(sentence, 0, &fTmp))
+  if (sentence.ToDouble(0, &fTmp))
   {
     iTmp =(int) (fTmp*100.0+0.5f);
     fTmp = (double)(iTmp)/100.0;
@@ -1426,7 +1425,7 @@ BOOL DevLXNanoIII::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
     }
   }
 
-  if (ParToDouble(sentence, 1, &fTmp))
+  if (sentence.ToDouble(1, &fTmp))
   {
     double fBALPerc = CalculateBalastFromLX(fTmp);
     if(Values(d))
@@ -1440,7 +1439,7 @@ BOOL DevLXNanoIII::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
     }
   }
 
-  if(ParToDouble(sentence, 2, &fTmp))
+  if(sentence.ToDouble(2, &fTmp))
   {
     if(Values(d))
     {
@@ -1455,9 +1454,9 @@ BOOL DevLXNanoIII::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   }
 
  double fa,fb,fc;
-     if(ParToDouble(sentence, 3, &fa))
-       if(ParToDouble(sentence, 4, &fb))
-   if(ParToDouble(sentence, 5, &fc))
+     if(sentence.ToDouble(3, &fa))
+       if(sentence.ToDouble(4, &fb))
+   if(sentence.ToDouble(5, &fc))
    {
       if(Values(d))
       {
@@ -1486,7 +1485,7 @@ BOOL DevLXNanoIII::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 
 
 
-     if(ParToDouble(sentence, 6, &fTmp))
+     if(sentence.ToDouble(6, &fTmp))
      {
 
      }
@@ -1508,7 +1507,7 @@ BOOL DevLXNanoIII::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLXNanoIII::LXWP3(DeviceDescriptor_t*, const char*, NMEA_INFO*)
+BOOL DevLXNanoIII::LXWP3(DeviceDescriptor_t*, const NMEASentence&, NMEA_INFO*)
 {
   // $LXWP3,altioffset, scmode, variofil, tefilter, televel, varioavg,
   //   variorange, sctab, sclow, scspeed, SmartDiff,
@@ -1540,7 +1539,7 @@ BOOL DevLXNanoIII::LXWP3(DeviceDescriptor_t*, const char*, NMEA_INFO*)
 
 
 
-BOOL DevLXNanoIII::LXWP4(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLXNanoIII::LXWP4(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 // $LXWP4 Sc, Netto, Relativ, gl.dif, leg speed, leg time, integrator, flight time, battery voltage*CS<CR><LF>
 // Sc  float (m/s)
@@ -1558,7 +1557,7 @@ BOOL DevLXNanoIII::LXWP4(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 
 
 
-BOOL DevLXNanoIII::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLXNanoIII::PLXVF(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   TCHAR szTmp[MAX_NMEA_LEN];
   double alt=0, airspeed=0;
@@ -1570,9 +1569,9 @@ BOOL DevLXNanoIII::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   if(IsDirInput(PortIO.GFORCEDir))
   {
     double fX,fY,fZ;
-    if(ParToDouble(sentence, 1, &fX) &&
-      ParToDouble(sentence, 2, &fY) &&
-      ParToDouble(sentence, 3, &fZ))
+    if(sentence.ToDouble(1, &fX) &&
+      sentence.ToDouble(2, &fY) &&
+      sentence.ToDouble(3, &fZ))
     {
       if(Values(d))
       {
@@ -1590,7 +1589,7 @@ BOOL DevLXNanoIII::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   }
 
 
-  if (ParToDouble(sentence, 5, &airspeed))
+  if (sentence.ToDouble(5, &airspeed))
   {
     if(Values(d))
     {
@@ -1606,7 +1605,7 @@ BOOL DevLXNanoIII::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   }
 
 
-  if (ParToDouble(sentence, 6, &alt))
+  if (sentence.ToDouble(6, &alt))
   {
     if(Values(d))
     {
@@ -1623,7 +1622,7 @@ BOOL DevLXNanoIII::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   }
 
 
-  if (ParToDouble(sentence, 4, &alt))
+  if (sentence.ToDouble(4, &alt))
   {
     if(Values(d))
     {
@@ -1639,7 +1638,7 @@ BOOL DevLXNanoIII::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 
 // Get STF switch
   double fTmp;
-  if (ParToDouble(sentence, 7, &fTmp))
+  if (sentence.ToDouble(7, &fTmp))
   {
     int  iTmp = (int)(fTmp+0.1);
     if(Values(d))
@@ -1676,7 +1675,7 @@ BOOL DevLXNanoIII::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 } // PLXVF()
 
 
-BOOL DevLXNanoIII::PLXVS(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLXNanoIII::PLXVS(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   double Batt;
   double OAT;
@@ -1687,7 +1686,7 @@ BOOL DevLXNanoIII::PLXVS(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   const auto& Port = PortConfig[d->PortNumber];
   const auto& PortIO = Port.PortIO;
 
-  if (ParToDouble(sentence, 0, &OAT))
+  if (sentence.ToDouble(0, &OAT))
   {
     if(Values(d))
     {
@@ -1702,7 +1701,7 @@ BOOL DevLXNanoIII::PLXVS(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
     }
   }
 
-  if (ParToDouble(sentence, 2, &Batt))
+  if (sentence.ToDouble(2, &Batt))
   {
     if(Values(d))
     {
@@ -1719,37 +1718,34 @@ BOOL DevLXNanoIII::PLXVS(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 } // PLXVS()
 
 
-BOOL DevLXNanoIII::PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLXNanoIII::PLXV0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
-  char  szTmp1[MAX_NMEA_LEN], szTmp2[MAX_NMEA_LEN];
+  char  szTmp1[MAX_NMEA_LEN];
   const auto& Port = PortConfig[d->PortNumber];
   const auto& PortIO = Port.PortIO;
 
-  NMEAParser::ExtractParameter(sentence,szTmp1,1);
+  sentence.Copy(1, szTmp1);
   if  (strcmp(szTmp1, "W")!=0)  // no write flag received
     return false;
 
-  NMEAParser::ExtractParameter(sentence,szTmp1,0);
+  sentence.Copy(0, szTmp1);
   if  (strcmp(szTmp1, "BRGPS") == 0)
   {
-    NMEAParser::ExtractParameter(sentence,szTmp2,2);
-    iNano3_GPSBaudrate = Nano3Baudrate( (int)( (StrToDouble(szTmp2,NULL))+0.1 ) );
+    iNano3_GPSBaudrate = Nano3Baudrate( (int)( (sentence.ToDouble(2))+0.1 ) );
     return true;
   }
 
   if (strcmp(szTmp1, "BRPDA") == 0)
   {
-    NMEAParser::ExtractParameter(sentence,szTmp2,2);
-    iNano3_PDABaudrate = Nano3Baudrate( (int) StrToDouble(szTmp2,NULL));
+    iNano3_PDABaudrate = Nano3Baudrate( (int) sentence.ToDouble(2));
     return true;
   }
 
-  NMEAParser::ExtractParameter(sentence,szTmp1,0);
+  sentence.Copy(0, szTmp1);
   if  (strcmp(szTmp1, "QNH") == 0)
   {
     
-    NMEAParser::ExtractParameter(sentence,szTmp2,2);
-    double newQNH = StrToDouble(szTmp2,NULL)/100.0;
+    double newQNH = sentence.ToDouble(2)/100.0;
     TCHAR szQNH[128];
     _sntprintf(szQNH,std::size(szQNH), TEXT("%6.1f $PLXV"),newQNH);
     SetDataText( d, _QNH,   szQNH);
@@ -1766,7 +1762,7 @@ BOOL DevLXNanoIII::PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
    ****************************************************************/
   if (strcmp(szTmp1, "MC") == 0) {
     double fTmp;
-    if (ParToDouble(sentence, 2, &fTmp)) {
+    if (sentence.ToDouble(2, &fTmp)) {
       if (Values(d)) {
         TCHAR szTmp[MAX_NMEA_LEN];
         _sntprintf(szTmp, MAX_NMEA_LEN, _T("%5.2f PLXV0"), fTmp);
@@ -1787,7 +1783,7 @@ BOOL DevLXNanoIII::PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   if (strcmp(szTmp1, "BAL") == 0)
   {
     double fTmp;
-    if (ParToDouble(sentence, 2, &fTmp)) {
+    if (sentence.ToDouble(2, &fTmp)) {
       double fNewBal = CalculateBalastFromLX(fTmp);
       if (Values(d)) {
         TCHAR szTmp[MAX_NMEA_LEN];
@@ -1807,7 +1803,7 @@ BOOL DevLXNanoIII::PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   if (strcmp(szTmp1, "BUGS") == 0)
   {
     double fTmp;
-    if (ParToDouble(sentence, 2, &fTmp)) {
+    if (sentence.ToDouble(2, &fTmp)) {
       if (Values(d)) {
         TCHAR szTmp[20];
         _sntprintf(szTmp, std::size(szTmp), _T("%3.0f%% ($PLXV0)"), fTmp);
@@ -1824,7 +1820,7 @@ BOOL DevLXNanoIII::PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   if (strcmp(szTmp1, "VOL")==0)
   {
     double fTmp;
-    if(ParToDouble(sentence, 2, &fTmp))
+    if(sentence.ToDouble(2, &fTmp))
       StartupStore(_T("Nano3 VOL: %i"),(int)fTmp);
     return true;
   }
@@ -1835,14 +1831,14 @@ BOOL DevLXNanoIII::PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   if (strcmp(szTmp1, "POLAR") == 0)
   {
     double fLoad,fWeight,fMaxW, fEmptyW,fPilotW, fa,fb,fc;
-    if( (ParToDouble(sentence, 2, &fa)) &&
-        (ParToDouble(sentence, 3, &fb)) &&
-        (ParToDouble(sentence, 4, &fc)) &&
-        (ParToDouble(sentence, 5, &fLoad)) &&
-        (ParToDouble(sentence, 6, &fWeight)) &&
-        (ParToDouble(sentence, 7, &fMaxW)) &&
-        (ParToDouble(sentence, 8, &fEmptyW)) &&
-        (ParToDouble(sentence, 9, &fPilotW))
+    if( (sentence.ToDouble(2, &fa)) &&
+        (sentence.ToDouble(3, &fb)) &&
+        (sentence.ToDouble(4, &fc)) &&
+        (sentence.ToDouble(5, &fLoad)) &&
+        (sentence.ToDouble(6, &fWeight)) &&
+        (sentence.ToDouble(7, &fMaxW)) &&
+        (sentence.ToDouble(8, &fEmptyW)) &&
+        (sentence.ToDouble(9, &fPilotW))
       )
       StartupStore(_T("Nano3 POLAR: a:%5.2f b:%5.2f c:%5.2f L:%3.1f W:%3.1f E:%3.1f P:%3.1f"),fa,fb,fc, fLoad,fWeight,fEmptyW,fPilotW)  ;
     return true;
@@ -1851,7 +1847,7 @@ BOOL DevLXNanoIII::PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   if (strcmp(szTmp1, "CONNECTION") == 0)
   {
     double fTmp;
-    if(ParToDouble(sentence, 2, &fTmp))
+    if(sentence.ToDouble(2, &fTmp))
       StartupStore(_T("Nano3 CONNECTION: %i"),(int)fTmp);
     return true;
   }
@@ -1859,7 +1855,7 @@ BOOL DevLXNanoIII::PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   if (strcmp(szTmp1, "NMEARATE") == 0)
   {
     double fTmp;
-    if(ParToDouble(sentence, 2, &fTmp))
+    if(sentence.ToDouble(2, &fTmp))
       StartupStore(_T("Nano3 NMEARATE: %i"),(int)fTmp);
     return true;
   }
@@ -1986,7 +1982,7 @@ BOOL DevLXNanoIII::PutTarget(DeviceDescriptor_t* d, const WAYPOINT& wpt) {
 
 
 
-BOOL DevLXNanoIII::GPRMB(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLXNanoIII::GPRMB(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   const auto& Port = PortConfig[d->PortNumber];
   const auto& PortIO = Port.PortIO;
@@ -2009,7 +2005,7 @@ BOOL DevLXNanoIII::GPRMB(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 }
 
 
-BOOL DevLXNanoIII::PLXVTARG(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLXNanoIII::PLXVTARG(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   const auto& Port = PortConfig[d->PortNumber];
   const auto& PortIO = Port.PortIO;
@@ -2021,32 +2017,32 @@ BOOL DevLXNanoIII::PLXVTARG(DeviceDescriptor_t* d, const char* sentence, NMEA_IN
 
   double fTmp;
 
-  ParToDouble(sentence, 1, &fTmp);
+  sentence.ToDouble(1, &fTmp);
   double DegLat = (double)((int) (fTmp/100.0));
   double MinLat =  fTmp- (100.0*DegLat);
   double Latitude = DegLat+MinLat/60.0;
 
-  NMEAParser::ExtractParameter(sentence,szTmp,2);
+  sentence.Copy(2, szTmp);
   if (szTmp[0]==_T('S')) {
     Latitude *= -1;
   }
 
-  ParToDouble(sentence, 3, &fTmp);
+  sentence.ToDouble(3, &fTmp);
   double DegLon =  (double) ((int) (fTmp/100.0));
   double MinLon =  fTmp- (100.0*DegLon);
   double Longitude = DegLon+MinLon/60.0;
 
-  NMEAParser::ExtractParameter(sentence,szTmp,4);
+  sentence.Copy(4, szTmp);
   if (szTmp[0]==_T('W')) {
     Longitude *= -1;
   }
 
 	
-  NMEAParser::ExtractParameter(sentence,szTmp,0);
+  sentence.Copy(0, szTmp);
   tstring tname = from_unknown_charset(szTmp);
 
   double Altitude = RESWP_INVALIDNUMBER;
-  if (!ParToDouble(sentence, 5, &Altitude)) {
+  if (!sentence.ToDouble(5, &Altitude)) {
     Altitude = RESWP_INVALIDNUMBER;
   }
 
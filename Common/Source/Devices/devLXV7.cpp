@@ -19,6 +19,8 @@
 #include "Comm/ExternalWind.h"
 #include "OS/Sleep.h"
 
+using std::string_view_literals::operator""sv;
+
 
 int iLXV7_RxUpdateTime=0;
 double LXV7_oldMC = MACCREADY;
@@ -239,15 +241,15 @@ BOOL LXV7PutBugs(DeviceDescriptor_t* d, double Bugs){
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLXV7::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info) {
+BOOL DevLXV7::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info) {
     static int i=40;
     TCHAR  szTmp[256];
 
-    if (!NMEAParser::NMEAChecksum(sentence) || (info == NULL)){
+    if (!sentence.ChecksumValid() || (info == NULL)){
         return FALSE;
     }
 
-    if (strncmp("$LXWP2", sentence, 6) == 0) {
+    if (sentence.Address() == "$LXWP2"sv) {
         if (iLXV7_RxUpdateTime > 0) {
             iLXV7_RxUpdateTime--;
         } else {
@@ -259,7 +261,7 @@ BOOL DevLXV7::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
     }
 
     /* configure LX after 10 GPS positions */
-    if (strncmp("$GPGGA", sentence, 6) == 0) {
+    if (sentence.Address() == "$GPGGA"sv) {
         if(i++ > 30) {
             SetupLX_Sentence(d);
 	    i=0;
@@ -291,26 +293,26 @@ BOOL DevLXV7::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
         d->Com->WriteString(szTmp);
     }
 
-    if (strncmp(("$PLXVF"), sentence, 6) == 0)
-      return PLXVF(d, sentence + 7, info);
-    else if (strncmp(("$PLXVS"), sentence, 6) == 0)
-      return PLXVS(d, sentence + 7, info);
-    else if (strncmp(("$PLXV0"), sentence, 6) == 0)
-      return PLXV0(d, sentence + 7, info);
-    else if (strncmp(("$LXWP1"), sentence, 6) == 0)
-      return LXWP1(d, sentence + 7, info);
-    else if (strncmp(("$LXWP2"), sentence, 6) == 0)
-      return LXWP2(d, sentence + 7, info);
-    else if (strncmp(("$LXWP0"), sentence, 6) == 0)
-      return LXWP0(d, sentence + 7, info);
+    if (sentence.Address() == "$PLXVF"sv)
+      return PLXVF(d, sentence, info);
+    else if (sentence.Address() == "$PLXVS"sv)
+      return PLXVS(d, sentence, info);
+    else if (sentence.Address() == "$PLXV0"sv)
+      return PLXV0(d, sentence, info);
+    else if (sentence.Address() == "$LXWP1"sv)
+      return LXWP1(d, sentence, info);
+    else if (sentence.Address() == "$LXWP2"sv)
+      return LXWP2(d, sentence, info);
+    else if (sentence.Address() == "$LXWP0"sv)
+      return LXWP0(d, sentence, info);
 
     #ifdef OLD_LX_SENTENCES
-    else if (strncmp(("$LXWP1"), sentence, 6) == 0)
-      return LXWP1(d, sentence + 7, info);
-    else if (strncmp(("$LXWP3"), sentence, 6) == 0)
-      return LXWP3(d, sentence + 7, info);
-    else if (strncmp(("$LXWP4"), sentence, 6) == 0)
-      return LXWP4(d, sentence + 7, info);
+    else if (sentence.Address() == "$LXWP1"sv)
+      return LXWP1(d, sentence, info);
+    else if (sentence.Address() == "$LXWP3"sv)
+      return LXWP3(d, sentence, info);
+    else if (sentence.Address() == "$LXWP4"sv)
+      return LXWP4(d, sentence, info);
     #endif
 
     return(false);
@@ -327,7 +329,7 @@ BOOL DevLXV7::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLXV7::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLXV7::LXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   // $LXWP0,logger_stored, airspeed, airaltitude,
   //   v1[0],v1[1],v1[2],v1[3],v1[4],v1[5], hdg, windspeed*CS<CR><LF>
@@ -346,7 +348,7 @@ bool DevLXV7::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info
 
 
   double WindSpeed, WindDirection;
-  if (ParToDouble(sentence, 10, &WindDirection) && ParToDouble(sentence, 11, &WindSpeed)) {
+  if (sentence.ToDouble(10, &WindDirection) && sentence.ToDouble(11, &WindSpeed)) {
     UpdateExternalWind(*info, *d, Units::From(Units_t::unKiloMeterPerHour, WindSpeed), WindDirection);
   }
   return(false);
@@ -364,7 +366,7 @@ bool DevLXV7::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLXV7::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
+bool DevLXV7::LXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* pGPS)
 {
   // $LXWP1,serial number,instrument ID, software version, hardware
   //   version,license string,NU*SC<CR><LF>
@@ -380,24 +382,21 @@ bool DevLXV7::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
   char ctemp[180];
   static int NoMsg=0;
   static int oldSerial=0;
-  if (strlen(String) < 180) {
+  if (strlen(sentence.c_str()) < 180) {
     if((( d->SerialNumber == 0)  || ( d->SerialNumber != oldSerial)) && (NoMsg < 5)) {
       NoMsg++;
-      NMEAParser::ExtractParameter(String, ctemp, 0);
+      sentence.Copy(0, ctemp);
       from_unknown_charset(ctemp, d->Name);
       StartupStore(_T(". %s"), d->Name);
 
-      NMEAParser::ExtractParameter(String, ctemp, 1);
-      d->SerialNumber = StrToDouble(ctemp, nullptr);
+      d->SerialNumber = sentence.ToDouble(1);
       oldSerial = d->SerialNumber;
       StartupStore(_T(". %s Serial Number %i"), d->Name, d->SerialNumber);
 
-      NMEAParser::ExtractParameter(String, ctemp, 2);
-      d->SoftwareVer = StrToDouble(ctemp, nullptr);
+      d->SoftwareVer = sentence.ToDouble(2);
       StartupStore(_T(". %s Software Vers.: %3.2f"), d->Name, d->SoftwareVer);
 
-      NMEAParser::ExtractParameter(String, ctemp, 3);
-      d->HardwareId = StrToDouble(ctemp,NULL) * 10;
+      d->HardwareId = sentence.ToDouble(3) * 10;
       StartupStore(_T(". %s Hardware Vers.: %3.2f"), d->Name, d->HardwareId / 10.0);
 
       TCHAR str[255];
@@ -425,7 +424,7 @@ bool DevLXV7::LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLXV7::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*)
+bool DevLXV7::LXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO*)
 {
   // $LXWP2,mccready,ballast,bugs,polar_a,polar_b,polar_c, audio volume
   //   *CS<CR><LF>
@@ -440,19 +439,19 @@ bool DevLXV7::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*)
 //float fBallast,fBugs, polar_a, polar_b, polar_c, fVolume;
 
   double fTmp;
-  if (ParToDouble(sentence, 0, &fTmp)) {
+  if (sentence.ToDouble(0, &fTmp)) {
     int iTmp = (int)(fTmp * 100.0 + 0.5f);
     fTmp = (double)(iTmp) / 100.0;
     LXV7_bValid = true;
     d->RecvMacCready(fTmp);
   }
 
-  if (ParToDouble(sentence, 1, &fTmp)) {
+  if (sentence.ToDouble(1, &fTmp)) {
     double newBallast = CalculateBalastFromLX(fTmp);
     d->RecvBallast(newBallast);
   }
 
-  if(ParToDouble(sentence, 2, &fTmp)) {
+  if(sentence.ToDouble(2, &fTmp)) {
     d->RecvBugs(CalculateBalastFromLX(fTmp));
   }
 
@@ -470,7 +469,7 @@ bool DevLXV7::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*)
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevLXV7::LXWP3(DeviceDescriptor_t*, const char*, NMEA_INFO*)
+bool DevLXV7::LXWP3(DeviceDescriptor_t*, const NMEASentence&, NMEA_INFO*)
 {
 
 
@@ -505,7 +504,7 @@ bool DevLXV7::LXWP3(DeviceDescriptor_t*, const char*, NMEA_INFO*)
 
 
 
-bool DevLXV7::LXWP4(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLXV7::LXWP4(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 
 
@@ -527,18 +526,18 @@ bool DevLXV7::LXWP4(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info
 
 
 
-bool DevLXV7::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLXV7::PLXVF(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 
   double alt=0, airspeed=0;
 
 
-  if (ParToDouble(sentence, 1, &info->AccelX))
-    if (ParToDouble(sentence, 2, &info->AccelY))
-      if (ParToDouble(sentence, 3, &info->AccelZ))
+  if (sentence.ToDouble(1, &info->AccelX))
+    if (sentence.ToDouble(2, &info->AccelY))
+      if (sentence.ToDouble(3, &info->AccelZ))
         info->AccelerationAvailable = true;
 
-  if (ParToDouble(sentence, 5, &airspeed))
+  if (sentence.ToDouble(5, &airspeed))
   {
 //	airspeed = 135.0/TOKPH;
 	info->IndicatedAirspeed = airspeed;
@@ -546,7 +545,7 @@ bool DevLXV7::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info
 
   }
 
-  if (ParToDouble(sentence, 6, &alt))
+  if (sentence.ToDouble(6, &alt))
   {
     UpdateBaroSource(info, d, QNEAltitudeToQNHAltitude(alt));
     if (airspeed>0) {
@@ -554,14 +553,14 @@ bool DevLXV7::PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info
     }
   }
   double Vario = 0;
-  if (ParToDouble(sentence, 4, &Vario)) {
+  if (sentence.ToDouble(4, &Vario)) {
     UpdateVarioSource(*info, *d, Vario);
   }
 
 
   // Get STF switch
 double fTmp;
-if (ParToDouble(sentence, 7, &fTmp))
+if (sentence.ToDouble(7, &fTmp))
 {
 int  iTmp = (int)(fTmp+0.1);
 EnableExternalTriggerCruise = true;
@@ -587,11 +586,11 @@ if(iTmp != iOldVarioSwitch)
 } // PLXVF()
 
 
-bool DevLXV7::PLXVS(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLXV7::PLXVS(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 double Batt;
 double OAT;
-  if (ParToDouble(sentence, 0, &OAT))
+  if (sentence.ToDouble(0, &OAT))
   {
 	 info->OutsideAirTemperature = OAT;
 	 info->TemperatureAvailable  = TRUE;
@@ -599,7 +598,7 @@ double OAT;
 #ifdef SLOW_DET
 	  // Get STF switch
   double fTmp;
-  if (ParToDouble(sentence, 1, &fTmp))
+  if (sentence.ToDouble(1, &fTmp))
   {
     int  iTmp = (int)(fTmp+0.1);
     EnableExternalTriggerCruise = true;
@@ -622,7 +621,7 @@ double OAT;
   }
 #endif
 
-  if (ParToDouble(sentence, 2, &Batt))
+  if (sentence.ToDouble(2, &Batt))
 	 info->ExtBatt1_Voltage = Batt;
 
 
@@ -631,87 +630,77 @@ double OAT;
 
 
 
-bool DevLXV7::PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevLXV7::PLXV0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
-  char szTmp1[80], szTmp2[80];
+  char szTmp1[80];
 
 
 
 
-  NMEAParser::ExtractParameter(sentence,szTmp1,1);
+  sentence.Copy(1, szTmp1);
   if  (strcmp(szTmp1,"W")!=0)  // no write flag received
 	 return false;
 
-  NMEAParser::ExtractParameter(sentence,szTmp1,0);
+  sentence.Copy(0, szTmp1);
   if  (strcmp(szTmp1,"BRGPS")==0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	LXV7_iGPSBaudrate = Baudrate( (int)( (StrToDouble(szTmp2,NULL))+0.1 ) );
+	LXV7_iGPSBaudrate = Baudrate( (int)( (sentence.ToDouble(2))+0.1 ) );
 	return true;
   }
 
   if (strcmp(szTmp1, "BRPDA") == 0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	LXV7_iPDABaudrate = Baudrate( (int) StrToDouble(szTmp2,NULL));
+	LXV7_iPDABaudrate = Baudrate( (int) sentence.ToDouble(2));
 	return true;
   }
 
-  NMEAParser::ExtractParameter(sentence,szTmp1,0);
+  sentence.Copy(0, szTmp1);
   if  (strcmp(szTmp1, "QNH") == 0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	UpdateQNH((StrToDouble(szTmp2,NULL))/100.0);
+	UpdateQNH((sentence.ToDouble(2))/100.0);
 	return true;
   }
 #ifdef DEBUG_PARAMETERS
   if (strcmp(szTmp1, "MC") == 0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	iTmp =(int) StrToDouble(szTmp2,NULL);
+	iTmp =(int) sentence.ToDouble(2);
 	return true;
   }
 
   if (strcmp(szTmp1, "BAL") == 0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	iTmp = (int) StrToDouble(szTmp2,NULL);
+	iTmp = (int) sentence.ToDouble(2);
 	return true;
   }
 
   if (strcmp(szTmp1, "BUGS") == 0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	iTmp = (int) StrToDouble(szTmp2,NULL);
+	iTmp = (int) sentence.ToDouble(2);
 	return true;
   }
 
 
   if (strcmp(szTmp1, "VOL") == 0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	iTmp = (int) StrToDouble(szTmp2,NULL);
+	iTmp = (int) sentence.ToDouble(2);
 	return true;
   }
 
   if (strcmp(szTmp1, "POLAR") == 0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	iTmp = (int) StrToDouble(szTmp2,NULL);
+	iTmp = (int) sentence.ToDouble(2);
 	return true;
   }
 
   if (strcmp(szTmp1, "CONNECTION") == 0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	iTmp = (int) StrToDouble(szTmp2,NULL);
+	iTmp = (int) sentence.ToDouble(2);
 	return true;
   }
 
   if (strcmp(szTmp1, "NMEARATE") == 0)
   {
-	NMEAParser::ExtractParameter(sentence,szTmp2,2);
-	iTmp = (int) StrToDouble(szTmp2,NULL);
+	iTmp = (int) sentence.ToDouble(2);
 	return true;
   }
 #endif
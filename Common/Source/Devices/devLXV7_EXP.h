@@ -46,7 +46,7 @@ class DevLXV7_EXP : public DevBase
     static void Install(DeviceDescriptor_t* d);
 
     /// Parses LXWPn sentences.
-    static BOOL ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static BOOL ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     static BOOL LXV7_EXP_DirectLink(DeviceDescriptor_t* d, BOOL LinkStatus);
     /// Returns device name (max length is @c DEVNAMESIZE).
@@ -56,24 +56,24 @@ class DevLXV7_EXP : public DevBase
     }
 
     /// Parses PLXVF sentence.
-    static bool PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool PLXVF(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Parses PLXVS sentence.
-    static bool PLXVS(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool PLXVS(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Parses PLXV0 sentence.
-    static bool PLXV0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool PLXV0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
     /// Parses LXWP0 sentence.
-    static bool LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool LXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Parses LXWP1 sentence.
-    static bool LXWP1(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool LXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Parses LXWP2 sentence.
-    static bool LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool LXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Parses LXWP3 sentence.
-    static bool LXWP3(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+    static bool LXWP3(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
     /// Parses LXWP4 sentence.
     static bool LXWP4(DeviceDescriptor_t* d, const TCHAR* sentence, NMEA_INFO* info);
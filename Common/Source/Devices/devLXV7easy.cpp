@@ -14,28 +14,14 @@
 #include "utils/printf.h"
 #include "utils/charset_helper.h"
 
-static bool LXWP1(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+using std::string_view_literals::operator""sv;
 
-static bool PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
-static bool PLXVS(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+static bool LXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
-extern BOOL LXV7easyParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info);
+static bool PLXVF(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
+static bool PLXVS(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
-static 
-bool ParToDouble(const char* sentence, unsigned int parIdx, double* value) {
-  char  temp[80];
-  const char* stop;
-
-  NMEAParser::ExtractParameter(sentence, temp, parIdx);
-
-  stop = NULL;
-  *value = StrToDouble(temp, &stop);
-
-  if (stop == NULL || *stop != '\0')
-    return(false);
-
-  return(true);
-} 
+extern BOOL LXV7easyParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info);
 
 void LXV7easyInstall(DeviceDescriptor_t* d)
 {
@@ -45,53 +31,53 @@ void LXV7easyInstall(DeviceDescriptor_t* d)
 
 
 
-BOOL LXV7easyParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL LXV7easyParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 
-    if (!NMEAParser::NMEAChecksum(sentence) || (info == NULL)) {
+    if (!sentence.ChecksumValid() || (info == NULL)) {
         return FALSE;
     }
 
     //
     // We ignore the followings
     //
-    if (strncmp("$PLXV0", sentence, 6) == 0) {
+    if (sentence.Address() == "$PLXV0"sv) {
 	return TRUE;
     }
-    if (strncmp("$LXWP0", sentence, 6) == 0) {
+    if (sentence.Address() == "$LXWP0"sv) {
 	return TRUE;
     }
-    if (strncmp("$LXWP2", sentence, 6) == 0) {
+    if (sentence.Address() == "$LXWP2"sv) {
 	return TRUE;
     }
-    if (strncmp("$LXWP3", sentence, 6) == 0) {
+    if (sentence.Address() == "$LXWP3"sv) {
 	return TRUE;
     }
-    if (strncmp("$LXWP4", sentence, 6) == 0) {
+    if (sentence.Address() == "$LXWP4"sv) {
 	return TRUE;
     }
-    if (strncmp("$LXWP5", sentence, 6) == 0) {
+    if (sentence.Address() == "$LXWP5"sv) {
 	return TRUE;
     }
 
     //
     // We manage the followings
     //
-    if (strncmp("$PLXVF", sentence, 6) == 0)
-        return PLXVF(d, sentence + 7, info);
+    if (sentence.Address() == "$PLXVF"sv)
+        return PLXVF(d, sentence, info);
 
-    if (strncmp("$PLXVS", sentence, 6) == 0)
-        return PLXVS(d, sentence + 7, info);
+    if (sentence.Address() == "$PLXVS"sv)
+        return PLXVS(d, sentence, info);
 
-    if (strncmp("$LXWP1", sentence, 6) == 0)
-        return LXWP1(d, sentence + 7, info);
+    if (sentence.Address() == "$LXWP1"sv)
+        return LXWP1(d, sentence, info);
 
 
     return(FALSE);
 }
 
 
-bool LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
+bool LXWP1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* pGPS)
 {
     // $LXWP1,serial number,instrument ID, software version, hardware
     //   version,license string,NU*SC<CR><LF>
@@ -108,26 +94,23 @@ bool LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
     static int NoMsg=0;
     static int oldSerial=0;
 
-    if (strlen(String) >= 180) {
+    if (strlen(sentence.c_str()) >= 180) {
         return true;
     }
     if((( d->SerialNumber == 0)  || ( d->SerialNumber != oldSerial)) && (NoMsg < 5)) {
         NoMsg++ ;
-        NMEAParser::ExtractParameter(String, ctemp, 0);
+        sentence.Copy(0, ctemp);
         from_unknown_charset(ctemp, d->Name);
         StartupStore(_T(". %s"),d->Name);
 
-        NMEAParser::ExtractParameter(String, ctemp, 1);
-        d->SerialNumber = StrToDouble(ctemp, nullptr);
+        d->SerialNumber = sentence.ToDouble(1);
         oldSerial = d->SerialNumber;
         StartupStore(_T(". %s Serial Number %i"), d->Name, d->SerialNumber);
 
-        NMEAParser::ExtractParameter(String, ctemp, 2);
-        d->SoftwareVer = StrToDouble(ctemp, nullptr);
+        d->SoftwareVer = sentence.ToDouble(2);
         StartupStore(_T(". %s Software Vers.: %3.2f"), d->Name, d->SoftwareVer);
 
-        NMEAParser::ExtractParameter(String, ctemp, 3);
-        d->HardwareId = StrToDouble(ctemp,NULL) * 10;
+        d->HardwareId = sentence.ToDouble(3) * 10;
         StartupStore(_T(". %s Hardware Vers.: %3.2f"), d->Name, (double)(d->HardwareId)/10.0);
 
         TCHAR str[255];
@@ -142,17 +125,17 @@ bool LXWP1(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS)
 
 
 
-bool PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool PLXVF(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 
     double alt=0, airspeed=0;
 
-    if (ParToDouble(sentence, 5, &airspeed)) {
+    if (sentence.ToDouble(5, &airspeed)) {
         info->IndicatedAirspeed = airspeed;
         info->AirspeedAvailable = TRUE;
     }
 
-    if (ParToDouble(sentence, 6, &alt)) {
+    if (sentence.ToDouble(6, &alt)) {
 	    UpdateBaroSource(info, d, QNEAltitudeToQNHAltitude(alt));
         if (airspeed>0) {
             info->TrueAirspeed = TrueAirSpeed(airspeed, alt);
@@ -160,7 +143,7 @@ bool PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
     }
 
     double Vario = 0;
-    if (ParToDouble(sentence, 4, &Vario)) {
+    if (sentence.ToDouble(4, &Vario)) {
         UpdateVarioSource(*info, *d, Vario);
     }
 
@@ -169,18 +152,18 @@ bool PLXVF(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
 
 
 
-bool PLXVS(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info) {
+bool PLXVS(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info) {
 
     double Batt;
     double OAT;
 
-    if (ParToDouble(sentence, 0, &OAT)) {
+    if (sentence.ToDouble(0, &OAT)) {
 	 info->OutsideAirTemperature = OAT;
 	 info->TemperatureAvailable  = TRUE;
     }
 
 
-    if (ParToDouble(sentence, 2, &Batt)) {
+    if (sentence.ToDouble(2, &Batt)) {
 	 info->ExtBatt1_Voltage = Batt;
     }
 
@@ -44,6 +44,8 @@
 #include "Comm/UpdateQNH.h"
 #include "Comm/ExternalWind.h"
 
+using std::string_view_literals::operator""sv;
+
 unsigned int uiEOSDebugLevel = 1;
 
 BOOL DevLX_EOS_ERA::m_bShowValues = false;
@@ -182,7 +184,7 @@ bool SetEOSBinaryModeFlag(bool bBinMode) {
 
 
 
-BOOL DevLX_EOS_ERA::EOSParseStream(DeviceDescriptor_t* d, char *String, int len, NMEA_INFO *GPS_INFO) {
+BOOL DevLX_EOS_ERA::EOSParseStream(DeviceDescriptor_t* d, const char *String, int len, NMEA_INFO *GPS_INFO) {
   if ((!d) || (!String) || (!len)) {
     return FALSE;
   }
@@ -260,7 +262,7 @@ uint8_t EOSRecChar16(DeviceDescriptor_t* d, uint16_t *inchar, uint16_t Timeout)
 //static
 
 
-BOOL DevLX_EOS_ERA::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLX_EOS_ERA::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   if (Declare()) return false ;  // do not configure during declaration
   if( IsEOSInBinaryMode()) return false;
@@ -302,26 +304,26 @@ BOOL DevLX_EOS_ERA::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_
     }
   }
 
-  if ((info == nullptr) || !NMEAParser::NMEAChecksum(sentence)) {
+  if ((info == nullptr) || !sentence.ChecksumValid()) {
     return FALSE;
   }
-  if (strncmp("$LXDT", sentence, 5) == 0) {
-    return LXDT(d, sentence + 6, info);
+  if (sentence.Address() == "$LXDT"sv) {
+    return LXDT(d, sentence, info);
   }
-  if (strncmp("$LXBC", sentence, 5) == 0) {
-    return LXBC(d, sentence + 6, info);
+  if (sentence.Address() == "$LXBC"sv) {
+    return LXBC(d, sentence, info);
   }
-  if (strncmp("$LXWP2", sentence, 6) == 0) {
-    return LXWP2(d, sentence + 7, info);
+  if (sentence.Address() == "$LXWP2"sv) {
+    return LXWP2(d, sentence, info);
   }
-  if (strncmp("$LXWP0", sentence, 6) == 0) {
-    return LXWP0(d, sentence + 7, info);
+  if (sentence.Address() == "$LXWP0"sv) {
+    return LXWP0(d, sentence, info);
   }
-  if (strncmp("$GPRMB", sentence, 6) == 0) {
-    return GPRMB(d, sentence + 7, info);
+  if (sentence.Address() == "$GPRMB"sv) {
+    return GPRMB(d, sentence, info);
   }
-  if (strncmp("$LXWP1", sentence, 6) == 0) {
-    return LXWP1(d, sentence + 7, info);
+  if (sentence.Address() == "$LXWP1"sv) {
+    return LXWP1(d, sentence, info);
   }
   return false;
 } // ParseNMEA()
@@ -956,7 +958,7 @@ void DevLX_EOS_ERA::OnIGCDownloadClicked(WndButton* pWnd) {
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLX_EOS_ERA::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLX_EOS_ERA::LXWP0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   // $LXWP0,logger_stored, airspeed, airaltitude,
   //   v1[0],v1[1],v1[2],v1[3],v1[4],v1[5], hdg, windspeed*CS<CR><LF>
@@ -977,7 +979,7 @@ BOOL DevLX_EOS_ERA::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO
  // if( !devGetAdvancedMode(d))
   {
     double airspeed;
-    if( ParToDouble(sentence, 1, &airspeed))
+    if( sentence.ToDouble(1, &airspeed))
     {
 
       if(Values(d)) 
@@ -995,7 +997,7 @@ BOOL DevLX_EOS_ERA::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO
     }
 
     double altitude;
-    if (ParToDouble(sentence, 2, &altitude))
+    if (sentence.ToDouble(2, &altitude))
     {
       if(Values(d))
       { TCHAR szTmp[MAX_NMEA_LEN];
@@ -1012,7 +1014,7 @@ BOOL DevLX_EOS_ERA::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO
     }
 
     double vario;
-    if (ParToDouble(sentence, 3, &vario))
+    if (sentence.ToDouble(3, &vario))
     {
       if(Values(d))
       { TCHAR szTmp[MAX_NMEA_LEN];
@@ -1027,7 +1029,7 @@ BOOL DevLX_EOS_ERA::LXWP0(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO
   }
 
   double WindSpeed, WindDirection;
-  if (ParToDouble(sentence, 10, &WindDirection) && ParToDouble(sentence, 11, &WindSpeed)) {
+  if (sentence.ToDouble(10, &WindDirection) && sentence.ToDouble(11, &WindSpeed)) {
     if(Values(d)) {
       TCHAR szTmp[MAX_NMEA_LEN];
       _sntprintf(szTmp,MAX_NMEA_LEN, _T("%5.1fkm/h %3.0f° ($LXWP0)"),WindSpeed, WindDirection);
@@ -1169,7 +1171,7 @@ BOOL DevLX_EOS_ERA::EOSSetBUGS(DeviceDescriptor_t* d,float fTmp, const TCHAR *in
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLX_EOS_ERA::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*)
+BOOL DevLX_EOS_ERA::LXWP2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO*)
 {
   // $LXWP2,mccready,ballast,bugs,polar_a,polar_b,polar_c, audio volume
   //   *CS<CR><LF>
@@ -1187,19 +1189,19 @@ BOOL DevLX_EOS_ERA::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO
   double fTmp;
   if(!LX_EOS_ERA_bValid)
   {
-    if (ParToDouble(sentence, 0, &fTmp))
+    if (sentence.ToDouble(0, &fTmp))
       EOSSetMC  (d, fTmp,_T("($LXWP2)") );
 
-    if(ParToDouble(sentence, 1, &fTmp))
+    if(sentence.ToDouble(1, &fTmp))
       EOSSetBAL (d, fTmp,_T("($LXWP2)") );
 
-    if(ParToDouble(sentence, 2, &fTmp))
+    if(sentence.ToDouble(2, &fTmp))
       EOSSetBUGS(d, fTmp,_T("($LXWP2)") );
   }
   double fa,fb,fc;
-  if(ParToDouble(sentence, 3, &fa)) {
-    if(ParToDouble(sentence, 4, &fb)) {
-      if(ParToDouble(sentence, 5, &fc)) {
+  if(sentence.ToDouble(3, &fa)) {
+    if(sentence.ToDouble(4, &fb)) {
+      if(sentence.ToDouble(5, &fc)) {
         TCHAR szTmp[MAX_NMEA_LEN];
         if(Values(d))
         {
@@ -1227,7 +1229,7 @@ BOOL DevLX_EOS_ERA::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO
       }
     }
   }
-  if(ParToDouble(sentence, 6, &fTmp))
+  if(sentence.ToDouble(6, &fTmp))
   {
     // volume
   }
@@ -1245,10 +1247,10 @@ BOOL DevLX_EOS_ERA::LXWP2(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevLX_EOS_ERA::LXWP3(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLX_EOS_ERA::LXWP3(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   double fTmp;
-  if(ParToDouble(sentence, 1, &fTmp))  // SC mode
+  if(sentence.ToDouble(1, &fTmp))  // SC mode
   {
     int  iTmp = (int)(fTmp+0.1);
     if(Values(d))
@@ -1318,7 +1320,7 @@ BOOL DevLX_EOS_ERA::LXWP3(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO
 } // LXWP3()
 
 
-BOOL DevLX_EOS_ERA::LXDT(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLX_EOS_ERA::LXDT(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   char szTmp[MAX_NMEA_LEN];
 
@@ -1326,13 +1328,13 @@ BOOL DevLX_EOS_ERA::LXDT(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 
   devSetAdvancedMode(d,true);
   static int iNoFlights=0;
-  NMEAParser::ExtractParameter(sentence, szTmp, 0);
+  sentence.Copy(0, szTmp);
   if(strncmp(szTmp, "ANS", 3) != 0)  // really an Answer?
     return 0;
 
   const auto& PortIO = PortConfig[d->PortNumber].PortIO;
 
-  NMEAParser::ExtractParameter(sentence, szTmp, 1);  // Command?
+  sentence.Copy(1, szTmp);  // Command?
   if(strncmp(szTmp, "RADIO", 5) == 0)
   {
     d->IsRadio = true;
@@ -1340,31 +1342,31 @@ BOOL DevLX_EOS_ERA::LXDT(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
       RadioPara.Enabled = true;
     }
 
-    NMEAParser::ExtractParameter(sentence, szTmp, 2);  // Active frequency
+    sentence.Copy(2, szTmp);  // Active frequency
     RadioPara.ActiveKhz = ExtractFrequency(szTmp);
 
-    NMEAParser::ExtractParameter(sentence, szTmp, 3);  // Standby frequency
+    sentence.Copy(3, szTmp);  // Standby frequency
     RadioPara.PassiveKhz = ExtractFrequency(szTmp);
 
-    if(ParToDouble(sentence, 4, &fTmp)) {
+    if(sentence.ToDouble(4, &fTmp)) {
       RadioPara.Volume  = (int) fTmp;
     }
-    if(ParToDouble(sentence, 5, &fTmp)) {
+    if(sentence.ToDouble(5, &fTmp)) {
       RadioPara.Squelch = (int) fTmp;
     }
-    if(ParToDouble(sentence, 6, &fTmp)) {
+    if(sentence.ToDouble(6, &fTmp)) {
       RadioPara.Vox     = (int) fTmp;
     }
   }
   else if(strncmp(szTmp, "MC_BAL", 6) == 0)
   {
-    if(ParToDouble(sentence, 2, &fTmp)) {EOSSetMC(d, fTmp,_T("($LXDT)") );}
-    if(ParToDouble(sentence, 3, &fTmp)) {EOSSetBAL(d, fTmp,_T("($LXDT)") );}
-    if(ParToDouble(sentence, 4, &fTmp)) {EOSSetBUGS(d, fTmp,_T("($LXDT)") );}
-    if(ParToDouble(sentence, 5, &fTmp)) {}  // Screen brightness in percent
-    if(ParToDouble(sentence, 6, &fTmp)) {}  // Variometer volume in percent
-    if(ParToDouble(sentence, 7, &fTmp)) {}  // SC volume in percent
-    if(ParToDouble(sentence, 8, &fTmp))   // QNH in hPa (NEW)
+    if(sentence.ToDouble(2, &fTmp)) {EOSSetMC(d, fTmp,_T("($LXDT)") );}
+    if(sentence.ToDouble(3, &fTmp)) {EOSSetBAL(d, fTmp,_T("($LXDT)") );}
+    if(sentence.ToDouble(4, &fTmp)) {EOSSetBUGS(d, fTmp,_T("($LXDT)") );}
+    if(sentence.ToDouble(5, &fTmp)) {}  // Screen brightness in percent
+    if(sentence.ToDouble(6, &fTmp)) {}  // Variometer volume in percent
+    if(sentence.ToDouble(7, &fTmp)) {}  // SC volume in percent
+    if(sentence.ToDouble(8, &fTmp))   // QNH in hPa (NEW)
     {
       if(IsDirInput(PortIO.QNHDir))
       { 
@@ -1383,7 +1385,7 @@ BOOL DevLX_EOS_ERA::LXDT(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   }
   else if(strncmp(szTmp, "FLIGHTS_NO", 10) == 0)
   {
-    if(ParToDouble(sentence, 2, &fTmp)) iNoFlights =(int) (fTmp+0.05);
+    if(sentence.ToDouble(2, &fTmp)) iNoFlights =(int) (fTmp+0.05);
     if((iNoFlights > 0)
       && m_bTriggered)  // call next if triggerd from here only
     {
@@ -1396,19 +1398,19 @@ BOOL DevLX_EOS_ERA::LXDT(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   else if(strncmp(szTmp, "FLIGHT_INFO", 11) == 0)
   { 
     char FileName[50]= "FileName", Pilot[50]= "",Surname[50]= "", Takeoff[50]= "",Date[50]= "",Landing[50]= "",Type[50]= "", Reg[50]= "";
-    TestLog(TEXT("FLIGHT_INFO %s"), sentence);
-
-    NMEAParser::ExtractParameter(sentence, Date     ,2);int  iNo = (int) StrToDouble(Date,nullptr);
-    NMEAParser::ExtractParameter(sentence, FileName ,3);
-    NMEAParser::ExtractParameter(sentence, Date     ,4);
-    NMEAParser::ExtractParameter(sentence, Takeoff  ,5);
-    NMEAParser::ExtractParameter(sentence, Landing  ,6);
-    NMEAParser::ExtractParameter(sentence, Pilot    ,7);
-    NMEAParser::ExtractParameter(sentence, Surname  ,8);
-    NMEAParser::ExtractParameter(sentence, Type     ,9);
-    NMEAParser::ExtractParameter(sentence, Reg      ,10);
+    TestLog(TEXT("FLIGHT_INFO %s"), sentence.c_str());
+
+    sentence.Copy(2, Date);int  iNo = (int) StrToDouble(Date,nullptr);
+    sentence.Copy(3, FileName);
+    sentence.Copy(4, Date);
+    sentence.Copy(5, Takeoff);
+    sentence.Copy(6, Landing);
+    sentence.Copy(7, Pilot);
+    sentence.Copy(8, Surname);
+    sentence.Copy(9, Type);
+    sentence.Copy(10, Reg);
     uint32_t filesize  = 0;
-    if (ParToDouble(sentence, 15, &fTmp))
+    if (sentence.ToDouble(15, &fTmp))
        filesize = (uint32_t)fTmp;
     
     TCHAR Line[2][MAX_NMEA_LEN];
@@ -1433,7 +1435,7 @@ BOOL DevLX_EOS_ERA::LXDT(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
   }
   else if(strncmp(szTmp, "SC_VAR", 6) == 0)  // Vario / STF
   {
-    if(ParToDouble(sentence, 2, &fTmp)) {
+    if(sentence.ToDouble(2, &fTmp)) {
       EOSSetSTF(d, (int)fTmp,_T(" ($LXDT,SC_VAR)") );
     }
   }
@@ -1444,7 +1446,7 @@ BOOL DevLX_EOS_ERA::LXDT(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 
   if(strncmp(szTmp, "ERROR", 5) == 0)  // ERROR?
   {
-    NMEAParser::ExtractParameter(sentence, szTmp, 2);
+    sentence.Copy(2, szTmp);
     if(strncmp(szTmp, "Radio not enabled", 17) == 0)  
     {
       d->IsRadio = false;
@@ -1468,14 +1470,14 @@ BOOL DevLX_EOS_ERA::LXDT(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO*
 
 
 
-BOOL DevLX_EOS_ERA::SENS(DeviceDescriptor_t* d,  const char* sentence, NMEA_INFO* info, int ParNo)
+BOOL DevLX_EOS_ERA::SENS(DeviceDescriptor_t* d,  const NMEASentence& sentence, NMEA_INFO* info, int ParNo)
 { 
   TCHAR szTmp[MAX_NMEA_LEN];
   double fTmp;
 
   const auto& PortIO = PortConfig[d->PortNumber].PortIO;
 
-  if(ParToDouble(sentence, ParNo++, &fTmp)) { // Outside air temperature in °C. Left empty if OAT value not valid
+  if(sentence.ToDouble(ParNo++, &fTmp)) { // Outside air temperature in °C. Left empty if OAT value not valid
     _sntprintf(szTmp, MAX_NMEA_LEN, _T("%4.2f°C ($LXDT)"),fTmp);
     if(Values(d)) {
       SetDataText( d,_OAT,  szTmp);
@@ -1485,7 +1487,7 @@ BOOL DevLX_EOS_ERA::SENS(DeviceDescriptor_t* d,  const char* sentence, NMEA_INFO
       info->TemperatureAvailable  = TRUE;
     }
   }
-  if(ParToDouble(sentence, ParNo++, &fTmp)) { // main power supply voltage
+  if(sentence.ToDouble(ParNo++, &fTmp)) { // main power supply voltage
     _sntprintf(szTmp, MAX_NMEA_LEN, _T("%4.2fV ($LXDT)"),fTmp);
     if(Values(d)) {
       SetDataText( d,_BAT1,  szTmp);
@@ -1494,7 +1496,7 @@ BOOL DevLX_EOS_ERA::SENS(DeviceDescriptor_t* d,  const char* sentence, NMEA_INFO
       info->ExtBatt1_Voltage = fTmp;	
     }
   }
-  if(ParToDouble(sentence, ParNo++, &fTmp)) { // Backup battery voltage
+  if(sentence.ToDouble(ParNo++, &fTmp)) { // Backup battery voltage
     _sntprintf(szTmp, MAX_NMEA_LEN, _T("%4.2fV ($LXDT)"),fTmp);
     if(Values(d)) {
       SetDataText( d,_BAT2,  szTmp);
@@ -1504,45 +1506,45 @@ BOOL DevLX_EOS_ERA::SENS(DeviceDescriptor_t* d,  const char* sentence, NMEA_INFO
     }
   }
 /*  
-  NMEAParser::ExtractParameter(sentence, szTmp, ParNo++); 
+  sentence.Copy(ParNo++, szTmp); 
   {  // Current flap setting
   }
-  NMEAParser::ExtractParameter(sentence, szTmp, ParNo++);
+  sentence.Copy(ParNo++, szTmp);
   { // Recommended flap setting
   }
 */  
-  if(ParToDouble(sentence, ParNo++, &fTmp)) {  // Current landing gear position (0 = out, 1 = inside, left empty if gear input not configured)
+  if(sentence.ToDouble(ParNo++, &fTmp)) {  // Current landing gear position (0 = out, 1 = inside, left empty if gear input not configured)
   }
-  if(ParToDouble(sentence, ParNo++, &fTmp)) {  // SC/Vario mode (0 = Vario, 1 = SC)
+  if(sentence.ToDouble(ParNo++, &fTmp)) {  // SC/Vario mode (0 = Vario, 1 = SC)
     EOSSetSTF(d, (int)fTmp,_T(" ($LXDT,SENS)"));
   }
   return true;
 }
 
-BOOL DevLX_EOS_ERA::LXBC(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevLX_EOS_ERA::LXBC(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
   TCHAR szTmp[MAX_NMEA_LEN];
 
   devSetAdvancedMode(d,true);
-  if(strncmp(sentence, "SENS", 4) == 0) {  
+  if(sentence[0] == "SENS"sv) {  
     SENS(d,  sentence,  info,1);
   }
 
   const auto& PortIO = PortConfig[d->PortNumber].PortIO;
 
-  if(strncmp(sentence, "AHRS", 4) == 0)
+  if(sentence[0] == "AHRS"sv)
   {
     if(IsDirInput(PortIO.GFORCEDir)) { 
       double fX,fY,fZ, fPitch, fRoll, fYaw, fSlip;
       
-      bool bAHRS = ParToDouble(sentence, 1, &fPitch); // pitch
-      bAHRS = bAHRS && ParToDouble(sentence, 2, &fRoll); // Roll
-      bAHRS = bAHRS && ParToDouble(sentence, 3, &fYaw); // Yaw
-      bAHRS = bAHRS && ParToDouble(sentence, 4, &fSlip); // slip
-
-      if(ParToDouble(sentence, 5, &fX) &&
-        ParToDouble(sentence, 6, &fY) &&
-        ParToDouble(sentence, 7, &fZ))
+      bool bAHRS = sentence.ToDouble(1, &fPitch); // pitch
+      bAHRS = bAHRS && sentence.ToDouble(2, &fRoll); // Roll
+      bAHRS = bAHRS && sentence.ToDouble(3, &fYaw); // Yaw
+      bAHRS = bAHRS && sentence.ToDouble(4, &fSlip); // slip
+
+      if(sentence.ToDouble(5, &fX) &&
+        sentence.ToDouble(6, &fY) &&
+        sentence.ToDouble(7, &fZ))
       {
         if(Values(d))
         {
@@ -1715,7 +1717,7 @@ BOOL DevLX_EOS_ERA::PutTarget(DeviceDescriptor_t* d, const WAYPOINT& wpt)
 
 
 
-BOOL DevLX_EOS_ERA::GetTarget(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info) {
+BOOL DevLX_EOS_ERA::GetTarget(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info) {
   const auto& PortIO = PortConfig[d->PortNumber].PortIO;
 
   if (PortIO.R_TRGTDir != TP_VTARG) {    return false;
@@ -1723,17 +1725,17 @@ BOOL DevLX_EOS_ERA::GetTarget(DeviceDescriptor_t* d, const char* sentence, NMEA_
 
   double fLat, fLon, fAlt, fFlags;
 
-  ParToDouble(sentence, 4, &fLat);   // latitude
-  ParToDouble(sentence, 5, &fLon);   // longitude
-  if (!ParToDouble(sentence, 6, &fAlt)) {   // altitude (elevation)
+  sentence.ToDouble(4, &fLat);   // latitude
+  sentence.ToDouble(5, &fLon);   // longitude
+  if (!sentence.ToDouble(6, &fAlt)) {   // altitude (elevation)
     fAlt = RESWP_INVALIDNUMBER;
   }
-//ParToDouble(sentence, 7, &fTmp);   // distance (not needed)
-//ParToDouble(sentence, 8, &fTmp);   // bearing  (not needed)
-  ParToDouble(sentence, 9, &fFlags); // landable?
+//sentence.ToDouble(7, &fTmp);   // distance (not needed)
+//sentence.ToDouble(8, &fTmp);   // bearing  (not needed)
+  sentence.ToDouble(9, &fFlags); // landable?
 		
   char szTmp[MAX_NMEA_LEN];		
-  NMEAParser::ExtractParameter(sentence,szTmp,3);
+  sentence.Copy(3, szTmp);
     // detect and fix charset
   tstring tname = from_unknown_charset(szTmp);
 
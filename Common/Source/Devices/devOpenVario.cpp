@@ -12,6 +12,8 @@
 #include "Baro.h"
 #include "Calc/Vario.h"
 
+using std::string_view_literals::operator""sv;
+
 
 
 BOOL OpenVarioPutMacCready(DeviceDescriptor_t* d, double MacCready);
@@ -86,18 +88,18 @@ BOOL OpenVarioPutBugs(DeviceDescriptor_t* d, double Bugs) {
 /// @retval TRUE if the sentence has been parsed
 ///
 //static
-BOOL DevOpenVario::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info) {
+BOOL DevOpenVario::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info) {
 
 
-  if (!NMEAParser::NMEAChecksum(sentence) || (info == NULL)) {
+  if (!sentence.ChecksumValid() || (info == NULL)) {
     if (OV_DebugLevel > 0) {
       StartupStore(TEXT(" OpenVario Checksum Error"));
     }
     return FALSE;
   }
 
-  if (strncmp("$POV", sentence, 4) == 0) {
-    return POV(d, sentence + 5, info);
+  if (sentence.Address() == "$POV"sv) {
+    return POV(d, sentence, info);
   }
 
 
@@ -105,7 +107,7 @@ BOOL DevOpenVario::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_I
 } // ParseNMEA()
 
 
-BOOL DevOpenVario::POV(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info) {
+BOOL DevOpenVario::POV(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info) {
   char szTmp1[80];
 
 
@@ -122,12 +124,12 @@ BOOL DevOpenVario::POV(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* i
 
   int FieldIndex = 0;
   do {
-    NMEAParser::ExtractParameter(sentence, szTmp1, FieldIndex++);
+    sentence.Copy(FieldIndex++, szTmp1);
     if (strlen(szTmp1) != 1) {
       break; // we are on CRC field or sentence is invalid : stop parsing
     }
     double value = 0;
-    if (!ParToDouble(sentence, FieldIndex++, &value)) {
+    if (!sentence.ToDouble(FieldIndex++, &value)) {
       break; // Invalid Field : stop parsing
     }
 
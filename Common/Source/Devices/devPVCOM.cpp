@@ -15,6 +15,8 @@
 #include "utils/printf.h"
 #include "Radio.h"
 
+using std::string_view_literals::operator""sv;
+
 namespace {
 
 void ReplaceNMEAControlChars(TCHAR *String)
@@ -201,54 +203,37 @@ BOOL PVCOMRequestAllData(DeviceDescriptor_t* d) {
   return(TRUE);
 }
 
-bool ParToDouble(const char* sentence, unsigned int parIdx, double* value)
-{
-  char  temp[80];
-  const char* stop;
-  LKASSERT(value!=NULL);
-
-  NMEAParser::ExtractParameter(sentence, temp, parIdx);
-
-  stop = NULL;
-  *value = StrToDouble(temp, &stop);
-
-  if (stop == NULL || *stop != '\0')
-    return(false);
-
-  return(true);
-} // ParToDouble()
-
 static
-bool PVCOM_ProcessPEYI(DeviceDescriptor_t* d, const char *sentence, NMEA_INFO *info)
+bool PVCOM_ProcessPEYI(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *info)
 {
   TSpaceInfo data = {};
   unsigned fieldIdx = 0;
   bool status = true;
   double value;
 
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.eulerRoll = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.eulerPitch = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.rollRate = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.pitchRate = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.yawRate = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.accelX = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.accelY = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.accelZ = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.virosbandometer = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.trueHeading = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.magneticHeading = value;
-  if(status &= ParToDouble(sentence, fieldIdx++, &value))
+  if(status &= sentence.ToDouble(fieldIdx++, &value))
     data.localDeclination = value;
 
   if(status) {
@@ -290,29 +275,27 @@ static bool TRI_on = false;
 
 
 
-BOOL PVCOMParseString(DeviceDescriptor_t* d, const char *String, NMEA_INFO *info)
+BOOL PVCOMParseString(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *info)
 {
-char  device[250];
 char  cmd[220];
 char  dir[220];
 char  para1[250];
 char  para2[250];
 
 
-if (!NMEAParser::NMEAChecksum(String) )
+if (!sentence.ChecksumValid() )
 {
 //	  DoStatusMessage(_T("RADIO Checksum Error!") );
   return FALSE;
 }
 
-NMEAParser::ExtractParameter(String,device,0);
-    if(strncmp("$PEYI", device, 5) == 0)
-        return PVCOM_ProcessPEYI(d, String + 6, info);
+    if(sentence.Address() == "$PEYI"sv)
+        return PVCOM_ProcessPEYI(d, sentence, info);
 
-if ((strncmp("$PVCOM", device,5) == 0) )
+if (sentence.Address() == "$PVCOM"sv)
 {
 
-	NMEAParser::ExtractParameter(String,dir,1);
+	sentence.Copy(0, dir);
     if(strcmp("A", dir) == 0)
 	{
       RadioPara.Changed = TRUE;
@@ -325,51 +308,51 @@ if ((strncmp("$PVCOM", device,5) == 0) )
         RadioPara.Enabled = TRUE;
       }
 
-      NMEAParser::ExtractParameter(String,cmd,2);
+      sentence.Copy(1, cmd);
       if(strcmp("AF", cmd) == 0)
       {
-        NMEAParser::ExtractParameter(String,para1,3);
+        sentence.Copy(2, para1);
         RadioPara.ActiveKhz = ExtractFrequency(para1);
 
-        NMEAParser::ExtractParameter(String,para2,4);
+        sentence.Copy(3, para2);
         lk::snprintf(RadioPara.ActiveName, _T("%s"),para2);
       } else
       if(strcmp("PF", cmd) == 0)
       {
-        NMEAParser::ExtractParameter(String,para1,3);
+        sentence.Copy(2, para1);
         RadioPara.PassiveKhz = ExtractFrequency(para1);
 
-        NMEAParser::ExtractParameter(String,para2,4);
+        sentence.Copy(3, para2);
         lk::snprintf(RadioPara.PassiveName, _T("%s"),para2);
       }  else
       if(strcmp("VOL", cmd) == 0)
       {
-	NMEAParser::ExtractParameter(String,para1,3);
+	sentence.Copy(2, para1);
 	RadioPara.Volume = (int)StrToDouble(para1,NULL);
       }   else
 	  if(strcmp("SQL", cmd) == 0)
 	  {
-	     NMEAParser::ExtractParameter(String,para1,3);
+	     sentence.Copy(2, para1);
 	     RadioPara.Squelch = (int)StrToDouble(para1,NULL);
 	  }  else
 	  if(strcmp("CHG", cmd) == 0)
 	  {
-      NMEAParser::ExtractParameter(String,para1,3);
+      sentence.Copy(2, para1);
       RadioPara.ActiveKhz = ExtractFrequency(para1);
 
-      NMEAParser::ExtractParameter(String,para2,4);
+      sentence.Copy(3, para2);
       lk::snprintf(RadioPara.ActiveName, _T("%s"),para2);
 
-      NMEAParser::ExtractParameter(String,para1,5);
+      sentence.Copy(4, para1);
       RadioPara.PassiveKhz = ExtractFrequency(para1);
 
-      NMEAParser::ExtractParameter(String,para2,6);
+      sentence.Copy(5, para2);
       lk::snprintf(RadioPara.PassiveName,_T("%s"),para2);
 
 	  } else
       if(strcmp("STA", cmd) == 0)
       {
-	  NMEAParser::ExtractParameter(String,para1,3);
+	  sentence.Copy(2, para1);
 	  if(strncmp("DUAL_ON", para1, 7) == 0)
 	    RadioPara.Dual = TRUE;
 	  if(strncmp("DUAL_OFF", para1, 8) == 0)
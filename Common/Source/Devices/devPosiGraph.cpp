@@ -19,20 +19,22 @@
 #include "Baro.h"
 #include "devPosiGraph.h"
 
+using std::string_view_literals::operator""sv;
+
 static
-BOOL GPWIN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+BOOL GPWIN(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 
-BOOL PGParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+BOOL PGParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
 
   // $GPWIN ... Winpilot proprietary sentance includinh baro altitude
   // $GPWIN ,01900 , 0 , 5159 , 0 , 0 , 0 , 0 , 0 , 0 , 0 , 0 * 6 B , 0 7 * 6 0 E
-  if(strncmp("$GPWIN", String, 6)==0)
+  if(sentence.Address() == "$GPWIN"sv)
     {
-      return GPWIN(d, &String[7], pGPS);
+      return GPWIN(d, sentence, pGPS);
     }
 
   return FALSE;
@@ -54,11 +56,11 @@ void pgInstall(DeviceDescriptor_t* d){
 // *****************************************************************************
 // local stuff
 
-static BOOL GPWIN(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
+static BOOL GPWIN(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
   char ctemp[80];
 
-  NMEAParser::ExtractParameter(String, ctemp, 2);
+  sentence.Copy(2, ctemp);
 
   UpdateBaroSource(pGPS, d, QNEAltitudeToQNHAltitude(iround(StrToDouble(ctemp, NULL) / 10)));
 
@@ -18,6 +18,8 @@
 #include "Comm/wait_ack.h"
 #include "utils/printf.h"
 
+using std::string_view_literals::operator""sv;
+
 #define MAX_VAL_STR_LEN    60
 
 //____________________________________________________________class_definitions_
@@ -113,10 +115,10 @@ extern BOOL LX_EOS_ERA_bValid;
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevRCFenix::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info) {
+BOOL DevRCFenix::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info) {
 
   auto wait_ack = d->lock_wait_ack();
-  if (wait_ack && wait_ack->check(sentence)) {
+  if (wait_ack && wait_ack->check(sentence.c_str())) {
     return TRUE;
   }
 
@@ -124,26 +126,26 @@ BOOL DevRCFenix::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INF
     return FALSE;
   }
 
-  if (!NMEAParser::NMEAChecksum(sentence)){
+  if (!sentence.ChecksumValid()){
     return FALSE;
   }
-  if (strncmp("$RCDT", sentence, 5) == 0) {
-    return LXDT(d, sentence + 6, info);
+  if (sentence.Address() == "$RCDT"sv) {
+    return LXDT(d, sentence, info);
   }
-  if (strncmp("$LXBC", sentence, 5) == 0) {
-    return LXBC(d, sentence + 6, info);
+  if (sentence.Address() == "$LXBC"sv) {
+    return LXBC(d, sentence, info);
   }
-  if (strncmp("$LXWP2", sentence, 6) == 0) {
-    return LXWP2(d, sentence + 7, info);
+  if (sentence.Address() == "$LXWP2"sv) {
+    return LXWP2(d, sentence, info);
   }
-  if (strncmp("$LXWP0", sentence, 6) == 0) {
-    return LXWP0(d, sentence + 7, info);
+  if (sentence.Address() == "$LXWP0"sv) {
+    return LXWP0(d, sentence, info);
   }
-  if(strncmp("$GPRMB", sentence, 6) == 0) {
-    return GPRMB(d, sentence + 7, info);
+  if(sentence.Address() == "$GPRMB"sv) {
+    return GPRMB(d, sentence, info);
   }
-  if (strncmp("$LXWP1", sentence, 6) == 0) {
-    return LXWP1(d, sentence + 7, info);
+  if (sentence.Address() == "$LXWP1"sv) {
+    return LXWP1(d, sentence, info);
   }
 
   // do not configure during declaration
@@ -13,6 +13,8 @@
 #include "Calc/Vario.h"
 #include "Comm/ExternalWind.h"
 
+using std::string_view_literals::operator""sv;
+
 int iVaulter_RxUpdateTime=0;
 double oldVaulterMC = MACCREADY;
 int  VaulterBugsUpdateTimeout = 0;
@@ -113,21 +115,21 @@ BOOL VaulterPutBallast(DeviceDescriptor_t* d, double Ballast){
 /// @retval true if the sentence has been parsed
 ///
 //static
-BOOL DevVaulter::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+BOOL DevVaulter::ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 
 
-  if (!NMEAParser::NMEAChecksum(sentence) || (info == NULL)){
+  if (!sentence.ChecksumValid() || (info == NULL)){
     return FALSE;
   }
 
 
-  if (strncmp("$PITV3", sentence, 6) == 0)
-    return PITV3(d, sentence + 7, info);
-  else if (strncmp("$PITV4", sentence, 6) == 0)
-    return PITV4(d, sentence + 7, info);
-  else if (strncmp("$PITV5", sentence, 6) == 0)
-    return PITV5(d, sentence + 7, info);
+  if (sentence.Address() == "$PITV3"sv)
+    return PITV3(d, sentence, info);
+  else if (sentence.Address() == "$PITV4"sv)
+    return PITV4(d, sentence, info);
+  else if (sentence.Address() == "$PITV5"sv)
+    return PITV5(d, sentence, info);
 
 
   return(false);
@@ -144,7 +146,7 @@ BOOL DevVaulter::ParseNMEA(DeviceDescriptor_t* d, const char* sentence, NMEA_INF
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevVaulter::PITV3(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevVaulter::PITV3(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 //  $PITV3,20.0,-5.3,280.2,33.0,1.1*44
 //  Feld Beispiel Beschreibung
@@ -155,22 +157,22 @@ bool DevVaulter::PITV3(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* i
 //  5 1.1 Lastenvielfaches (g)
   double tmp=0;
 
-  if (ParToDouble(sentence, 0, &tmp))
+  if (sentence.ToDouble(0, &tmp))
   {
     info->Roll = tmp;
     info->GyroscopeAvailable = true;
   }
 
-  if (ParToDouble(sentence, 1, &tmp))
+  if (sentence.ToDouble(1, &tmp))
     info->Pitch = tmp;
 
-  if (ParToDouble(sentence, 2, &tmp))
+  if (sentence.ToDouble(2, &tmp))
   {
     info->MagneticHeading  = tmp;
     info->MagneticHeadingAvailable = true;
   }
 
-  if (ParToDouble(sentence, 3, &tmp))
+  if (sentence.ToDouble(3, &tmp))
   {
     bVaulterValid = true;
     info->IndicatedAirspeed = tmp;
@@ -201,7 +203,7 @@ bool DevVaulter::PITV3(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* i
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevVaulter::PITV4(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info)
+bool DevVaulter::PITV4(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info)
 {
 //  $PITV4,2.0,2.8,2.2,430.2,460.2,460.4*44
 //  Feld Beispiel Beschreibung
@@ -212,16 +214,16 @@ bool DevVaulter::PITV4(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* i
 //  5 460.2 Barometrische Energiehöhe (m)
 //  6 460.4 Inertiale Energiehöhe (m)
   double  tmp=0;
-  if (ParToDouble(sentence, 0, &tmp))
+  if (sentence.ToDouble(0, &tmp))
   {
     UpdateVarioSource(*info, *d, tmp);
   }
-  if (ParToDouble(sentence, 1, &tmp))
+  if (sentence.ToDouble(1, &tmp))
   {
     info->NettoVario = tmp;
     info->NettoVarioAvailable = true;
   }
-  if (ParToDouble(sentence, 3, &tmp))
+  if (sentence.ToDouble(3, &tmp))
   {
     UpdateBaroSource(info, d, tmp);
   }
@@ -242,7 +244,7 @@ bool DevVaulter::PITV4(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* i
 /// @retval true if the sentence has been parsed
 ///
 //static
-bool DevVaulter::PITV5(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* info )
+bool DevVaulter::PITV5(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* info )
 {
 //  $PITV5,5.0,30.0,0.950,0.15,0,2.30*44
 //  Feld Beispiel Beschreibung
@@ -257,12 +259,12 @@ bool DevVaulter::PITV5(DeviceDescriptor_t* d, const char* sentence, NMEA_INFO* i
 
 
   double WindSpeed, WindDirection;
-  if (ParToDouble(sentence, 0, &WindSpeed) && ParToDouble(sentence, 1, &WindDirection)) {
+  if (sentence.ToDouble(0, &WindSpeed) && sentence.ToDouble(1, &WindDirection)) {
     UpdateExternalWind(*info, *d, Units::From(Units_t::unMeterPerSecond, WindSpeed), WindDirection);
   }
 
   double fTmp;
-  if (ParToDouble(sentence, 5, &fTmp)) {
+  if (sentence.ToDouble(5, &fTmp)) {
     d->RecvMacCready(fTmp);
   }
   return (true);
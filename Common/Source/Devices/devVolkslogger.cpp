@@ -15,18 +15,20 @@
 #include "Volkslogger/vlapihlp.h"
 #include "utils/stringext.h"
 
+using std::string_view_literals::operator""sv;
+
 
 // RMN: Volkslogger
 // Source data:
 // $PGCS,1,0EC0,FFF9,0C6E,02*61
 // $PGCS,1,0EC0,FFFA,0C6E,03*18
-BOOL vl_PGCS1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
+BOOL vl_PGCS1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
 
   char ctemp[80];
   double InternalAltitude;
 
-  NMEAParser::ExtractParameter(String,ctemp,2);
+  sentence.Copy(2, ctemp);
   // four characers, hex, barometric altitude
   InternalAltitude = HexStrToDouble(ctemp,NULL);
   double fBaroAltitude =0;
@@ -56,14 +58,14 @@ BOOL vl_PGCS1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 }
 
 static
-BOOL VLParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+BOOL VLParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
 
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
-  if(strstr(String, "$PGCS,") == String){
-    return vl_PGCS1(d, &String[6], pGPS);
+  if(sentence.Address() == "$PGCS"sv){
+    return vl_PGCS1(d, sentence, pGPS);
   }
 
   return FALSE;
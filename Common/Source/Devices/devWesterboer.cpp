@@ -14,10 +14,12 @@
 #include "Calc/Vario.h"
 #include "Comm/UpdateQNH.h"
 
+using std::string_view_literals::operator""sv;
+
 #define VW_BIDIRECTIONAL
-static BOOL PWES0(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
-static BOOL PWES1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
-static BOOL PWES2(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS);
+static BOOL PWES0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
+static BOOL PWES1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
+static BOOL PWES2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS);
 BOOL devWesterboerPutMacCready(DeviceDescriptor_t* d, double Mc);
 BOOL devWesterboerPutBallast(DeviceDescriptor_t* d, double Ballast);
 BOOL devWesterboerPutBugs(DeviceDescriptor_t* d, double Bus);
@@ -82,11 +84,11 @@ else
 
 
 
-static BOOL WesterboerParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS){
+static BOOL WesterboerParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS){
 
   (void)d;
 
-  if (!NMEAParser::NMEAChecksum(String) || (pGPS == NULL)){
+  if (!sentence.ChecksumValid() || (pGPS == NULL)){
     return FALSE;
   }
 
@@ -95,7 +97,7 @@ static BOOL WesterboerParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_
 /* this is for auto MC calculation, because we do not get a notification on changed
  * MC while changed by auto calac                                                     */
 
-if(strncmp("$PWES0", String, 6) == 0)
+if(sentence.Address() == "$PWES0"sv)
 {
   if(iWEST_RxUpdateTime > 0)
   {
@@ -121,25 +123,25 @@ if(strncmp("$PWES0", String, 6) == 0)
 
 
 
-  if(strncmp("$PWES0", String, 6) == 0)
+  if(sentence.Address() == "$PWES0"sv)
     {
 	  RequestInfos(d);
-      return PWES0(d, &String[7], pGPS);
+      return PWES0(d, sentence, pGPS);
     }
   else
-    if(strncmp("$PWES1", String, 6) == 0)
+    if(sentence.Address() == "$PWES1"sv)
     {
 	  if( iReceiveSuppress > 0)
 	  {
 		iReceiveSuppress--;
 		return false;
 	  }
-      return PWES1(d, &String[7], pGPS);
+      return PWES1(d, sentence, pGPS);
     }
     else
-      if(strncmp("$PWES2", String, 6) == 0)
+      if(sentence.Address() == "$PWES2"sv)
       {
-	return PWES2(d, &String[7], pGPS);
+	return PWES2(d, sentence, pGPS);
       }
   return FALSE;
 
@@ -155,7 +157,7 @@ void WesterboerInstall(DeviceDescriptor_t* d) {
   d->PutBallast = devWesterboerPutBallast;
 }
 
-static BOOL PWES0(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
+static BOOL PWES0(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
 /*
 	Sent by Westerboer VW1150  combining data stream from Flarm and VW1020.
@@ -180,7 +182,6 @@ static BOOL PWES0(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 
 */
 
-  char ctemp[180];
   double vtas, vias;
   double altqne, altqnh;
   static bool initqnh=true;
@@ -190,11 +191,10 @@ static BOOL PWES0(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 
 
 
-  if (strlen(String) < 180) {
+  if (strlen(sentence.c_str()) < 180) {
     if (((d->SerialNumber == 0) || (oldSerial != SerialNumber)) && (NoMsg < 5)) {
       NoMsg++ ;
-      NMEAParser::ExtractParameter(String, ctemp, 0);
-      d->HardwareId = StrToDouble(ctemp, nullptr);
+      d->HardwareId = sentence.ToDouble(0);
       switch (d->HardwareId) {
         case 21:  _tcscpy(d->Name, TEXT("VW1010")); break;
         case 22:  _tcscpy(d->Name, TEXT("VW1020")); break;
@@ -211,24 +211,20 @@ static BOOL PWES0(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
   }
 #endif
   // instant vario
-  NMEAParser::ExtractParameter(String,ctemp,1);
-  double Vario = StrToDouble(ctemp,NULL)/10;
+  double Vario = sentence.ToDouble(1)/10;
   UpdateVarioSource(*pGPS, *d, Vario);
 
   // netto vario
-  NMEAParser::ExtractParameter(String,ctemp,3);
-  if (ctemp[0] != '\0') {
-	pGPS->NettoVario = StrToDouble(ctemp,NULL)/10;
+  if (!sentence[3].empty()) {
+	pGPS->NettoVario = sentence.ToDouble(3)/10;
 	pGPS->NettoVarioAvailable = TRUE;
   } else
 	pGPS->NettoVarioAvailable = FALSE;
 
 
   // Baro altitudes. To be verified, because I have no docs from Westerboer of any kind.
-  NMEAParser::ExtractParameter(String,ctemp,6);
-  altqne = StrToDouble(ctemp,NULL);
-  NMEAParser::ExtractParameter(String,ctemp,7);
-  altqnh = StrToDouble(ctemp,NULL);
+  altqne = sentence.ToDouble(6);
+  altqnh = sentence.ToDouble(7);
 
   // AutoQNH will take care of setting an average QNH if nobody does it for a while
   if (initqnh) {
@@ -248,10 +244,8 @@ static BOOL PWES0(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 
 
   // IAS and TAS
-  NMEAParser::ExtractParameter(String,ctemp,8);
-  vias = StrToDouble(ctemp,NULL)/36;
-  NMEAParser::ExtractParameter(String,ctemp,9);
-  vtas = StrToDouble(ctemp,NULL)/36;
+  vias = sentence.ToDouble(8)/36;
+  vtas = sentence.ToDouble(9)/36;
 
   if (vias >1) {
 	pGPS->TrueAirspeed = vtas;
@@ -261,12 +255,10 @@ static BOOL PWES0(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 	pGPS->AirspeedAvailable = FALSE;
 
   // external battery voltage
-  NMEAParser::ExtractParameter(String,ctemp,10);
-  pGPS->ExtBatt1_Voltage = StrToDouble(ctemp,NULL)/10;
+  pGPS->ExtBatt1_Voltage = sentence.ToDouble(10)/10;
 
   // OAT
-  NMEAParser::ExtractParameter(String,ctemp,11);
-  pGPS->OutsideAirTemperature = StrToDouble(ctemp,NULL)/10;
+  pGPS->OutsideAirTemperature = sentence.ToDouble(11)/10;
   pGPS->TemperatureAvailable=TRUE;
 
   return TRUE;
@@ -282,7 +274,7 @@ static BOOL PWES0(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 //GEXTERN double POLARV[POLARSIZE];
 //GEXTERN double POLARLD[POLARSIZE];
 
-static BOOL PWES1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
+static BOOL PWES1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
 /*
 	Sent by Westerboer VW1150  combining data stream from Flarm and VW1020.
@@ -304,18 +296,15 @@ static BOOL PWES1(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
 
 */
 
-  char ctemp[80];
   double fTemp;
 
   // Get MC Ready
-  NMEAParser::ExtractParameter(String,ctemp,1);
-  int iTmp = StrToDouble(ctemp,NULL);
+  int iTmp = sentence.ToDouble(1);
   fTemp = (double)iTmp/10.0f;
   d->RecvMacCready(fTemp);
 
   // Get STF switch
-  NMEAParser::ExtractParameter(String,ctemp,2);
-  iTmp = (int)StrToDouble(ctemp,NULL);
+  iTmp = (int)sentence.ToDouble(2);
 #ifdef STF_SWITCH
   EnableExternalTriggerCruise = true;
 static int  iOldVarioSwitch=0;
@@ -337,8 +326,7 @@ static int  iOldVarioSwitch=0;
 
 
 
-  NMEAParser::ExtractParameter(String,ctemp,6);
-  iTmp = (int)StrToDouble(ctemp,NULL);
+  iTmp = (int)sentence.ToDouble(6);
   fTemp = (double)iTmp/ 10.0f;
   if(fabs(fTemp-GlidePolar::WingLoading )> 0.05)
   {
@@ -346,8 +334,7 @@ static int  iOldVarioSwitch=0;
     iWEST_RxUpdateTime = 5;
   }
 
-  NMEAParser::ExtractParameter(String,ctemp,7);
-  iTmp = (int) StrToDouble(ctemp,NULL);
+  iTmp = (int) sentence.ToDouble(7);
   fTemp = (double)(100-iTmp)/100.0f;
   d->RecvBugs(fTemp);
   return TRUE;
@@ -404,7 +391,7 @@ iReceiveSuppress = 1;
 
 }
 
-static BOOL PWES2(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
+static BOOL PWES2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *pGPS)
 {
 //	$PWES2: Datenausgabe, Ger�teparameter
 //	$PWES2,DD,SSSS,YY,FFFF*CS<CR><LF>
@@ -423,11 +410,10 @@ static BOOL PWES2(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
   char ctemp[180];
   static int NoMsg=0;
 
-  if (strlen(String) < 180) {
+  if (strlen(sentence.c_str()) < 180) {
     if (((d->SerialNumber == 0) || (oldSerial	!= SerialNumber)) && (NoMsg < 5)) {
       NoMsg++;
-      NMEAParser::ExtractParameter(String, ctemp, 0);
-      d->HardwareId = StrToDouble(ctemp, nullptr);
+      d->HardwareId = sentence.ToDouble(0);
       switch (d->HardwareId) {
         case 21:  _tcscpy(d->Name, TEXT("VW1010")); break;
         case 22:  _tcscpy(d->Name, TEXT("VW1020")); break;
@@ -436,14 +422,12 @@ static BOOL PWES2(DeviceDescriptor_t* d, const char *String, NMEA_INFO *pGPS)
         default:  _tcscpy(d->Name, TEXT("Westerboer")); break;
       }
     }
-    NMEAParser::ExtractParameter(String, ctemp, 1);
-    d->SerialNumber = StrToDouble(ctemp, nullptr);
+    d->SerialNumber = sentence.ToDouble(1);
     SerialNumber = d->SerialNumber;
 
-    NMEAParser::ExtractParameter(String, ctemp, 2);
-    int Year = StrToDouble(ctemp, nullptr);
+    int Year = sentence.ToDouble(2);
 
-    NMEAParser::ExtractParameter(String, ctemp, 3);
+    sentence.Copy(3, ctemp);
     d->SoftwareVer = StrToDouble(ctemp, nullptr) / 100.0;
 
     TCHAR str[255];
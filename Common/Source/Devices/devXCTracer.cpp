@@ -221,11 +221,11 @@ bool LXWP0(DeviceDescriptor_t* d, char **params, size_t nparams, NMEA_INFO *pGPS
     return(true);
 } // LXWP0()
 
-static BOOL XCTracerParseNMEA(DeviceDescriptor_t* d, const char *String, NMEA_INFO *_INFO) {
+static BOOL XCTracerParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *_INFO) {
     char ctemp[MAX_NMEA_LEN];
     char * params[MAX_NMEA_PARAMS];
 
-    size_t n_params = NMEAParser::ValidateAndExtract(String, ctemp, params);
+    size_t n_params = NMEAParser::ValidateAndExtract(sentence.c_str(), ctemp, params);
     if (n_params>0) {
         if(strcmp(params[0], "$XCTRC") == 0) {
             return XTRC(d, params, n_params, _INFO);
@@ -154,14 +154,14 @@ BOOL XCV(DeviceDescriptor_t* d, const char* const* params, size_t nparams, NMEA_
   return TRUE;
 }
 
-BOOL ParseNMEA(DeviceDescriptor_t* d, const char* String, NMEA_INFO* pGPS) {
+BOOL ParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO* pGPS) {
   if (!pGPS) {
     return FALSE;
   }
   char ctemp[MAX_NMEA_LEN];
   char* params[MAX_NMEA_PARAMS];
 
-  size_t n_params = NMEAParser::ValidateAndExtract(String, ctemp, params);
+  size_t n_params = NMEAParser::ValidateAndExtract(sentence.c_str(), ctemp, params);
   if (n_params > 0) {
     if (params[0] == "$PXCV"sv) {
       return PXCV(d, params, n_params, pGPS);
@@ -12,34 +12,36 @@
 #include "devZander.h"
 #include "Comm/ExternalWind.h"
 
-static BOOL PZAN1(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS);
-static BOOL PZAN2(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS);
-static BOOL PZAN3(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS);
-static BOOL PZAN4(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS);
+using std::string_view_literals::operator""sv;
 
-static BOOL ZanderParseNMEA(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS){
+static BOOL PZAN1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *apGPS);
+static BOOL PZAN2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *apGPS);
+static BOOL PZAN3(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *apGPS);
+static BOOL PZAN4(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *apGPS);
+
+static BOOL ZanderParseNMEA(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *apGPS){
   (void)d;
 
-  if (!NMEAParser::NMEAChecksum(String) || (apGPS == NULL)){
+  if (!sentence.ChecksumValid() || (apGPS == NULL)){
     return FALSE;
   }
 
 
-  if(strncmp("$PZAN1", String, 6) == 0)
+  if(sentence.Address() == "$PZAN1"sv)
     {
-      return PZAN1(d, &String[7], apGPS);
+      return PZAN1(d, sentence, apGPS);
     }
-  if(strncmp("$PZAN2", String, 6) == 0)
+  if(sentence.Address() == "$PZAN2"sv)
     {
-      return PZAN2(d, &String[7], apGPS);
+      return PZAN2(d, sentence, apGPS);
     }
-  if(strncmp("$PZAN3", String, 6) == 0)
+  if(sentence.Address() == "$PZAN3"sv)
     {
-      return PZAN3(d, &String[7], apGPS);
+      return PZAN3(d, sentence, apGPS);
     }
-  if(strncmp("$PZAN4", String, 6) == 0)
+  if(sentence.Address() == "$PZAN4"sv)
     {
-      return PZAN4(d, &String[7], apGPS);
+      return PZAN4(d, sentence, apGPS);
     }
 
   return FALSE;
@@ -55,26 +57,20 @@ void zanderInstall(DeviceDescriptor_t* d) {
 // local stuff
 
 
-static BOOL PZAN1(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS)
+static BOOL PZAN1(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *apGPS)
 {
   double palt=0;
-  char ctemp[80];
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  palt=StrToDouble(ctemp,NULL);
+  palt=sentence.ToDouble(0);
   UpdateBaroSource(apGPS, d, QNEAltitudeToQNHAltitude(palt));
   return TRUE;
 }
 
 
-static BOOL PZAN2(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS)
+static BOOL PZAN2(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *apGPS)
 {
-  char ctemp[80];
+  double vtas = sentence.ToDouble(0)/3.6;
 
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  double vtas = StrToDouble(ctemp,NULL)/3.6;
-
-  NMEAParser::ExtractParameter(String,ctemp,1);
-  double wnet = (StrToDouble(ctemp,NULL)-10000)/100; // cm/s
+  double wnet = (sentence.ToDouble(1)-10000)/100; // cm/s
   UpdateVarioSource(*apGPS, *d, wnet);
 
   double qnh_altitude = (BaroAltitudeAvailable(*apGPS)) ? apGPS->BaroAltitude : apGPS->Altitude;
@@ -87,7 +83,7 @@ static BOOL PZAN2(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS)
   return TRUE;
 }
 
-static BOOL PZAN3(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS)
+static BOOL PZAN3(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *apGPS)
 {
   //$PZAN3,+,026,A,321,035,V*cc
   //Windkomponente (+=R�ckenwind, -=Gegenwind)
@@ -102,13 +98,11 @@ static BOOL PZAN3(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS)
   double wspeed, wfrom;
   char wind_usable;
 
-  NMEAParser::ExtractParameter(String,ctemp,3);
-  wfrom=StrToDouble(ctemp,NULL);
+  wfrom=sentence.ToDouble(3);
 
-  NMEAParser::ExtractParameter(String,ctemp,4);
-  wspeed=StrToDouble(ctemp,NULL);
+  wspeed=sentence.ToDouble(4);
 
-  NMEAParser::ExtractParameter(String,ctemp,5);
+  sentence.Copy(5, ctemp);
   wind_usable=ctemp[0];
 
 
@@ -119,7 +113,7 @@ static BOOL PZAN3(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS)
   return true;
 }
 
-static BOOL PZAN4(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS)
+static BOOL PZAN4(DeviceDescriptor_t* d, const NMEASentence& sentence, NMEA_INFO *apGPS)
 {
   //$PZAN4,1.5,+,20,39,45*cc
   //Einstellungen am ZS1:
@@ -128,10 +122,7 @@ static BOOL PZAN4(DeviceDescriptor_t* d, const char* String, NMEA_INFO *apGPS)
   //wing loading (kp/m2)
   //best glide ratio
 
-  char ctemp[80];
-
-  NMEAParser::ExtractParameter(String,ctemp,0);
-  d->RecvMacCready(StrToDouble(ctemp, nullptr));
+  d->RecvMacCready(sentence.ToDouble(0));
 
   return true;
 }
@@ -37,6 +37,7 @@
 #include "Tracking/Tracking.h"
 #include "Devices/DeviceRegister.h"
 #include "Library/TimeFunctions.h"
+#include "Waypoints/WaypointIndex.h"
 
 #ifdef ANDROID
 #include <jni.h>
@@ -991,6 +992,7 @@ static void OnWaypointEditClicked(WndButton* pWnd) {
 
 
     dlgWaypointEditShowModal(&WayPointList[res]);
+    WaypointIndex::Invalidate(); // position can be changed
     waypointneedsave = true;
   }
 }
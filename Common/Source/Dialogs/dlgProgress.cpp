@@ -16,6 +16,7 @@
 #include "LKObjects.h"
 #include "resource.h"
 #include "Draw/LoadSplash.h"
+#include "utils/task_graph.h"
 
 class dlgProgress final {
 public:
@@ -131,6 +132,13 @@ void CloseProgressDialog() {
 }
 
 void CreateProgressDialog(const TCHAR* text) {
+    if(task_graph::InWorker()) {
+        // startup loader thread : dialog is updated by main thread
+        task_graph::Post([message = tstring(text)]() {
+            CreateProgressDialog(message.c_str());
+        });
+        return;
+    }
     if(!pWndProgress) {
         pWndProgress = new dlgProgress();
     } 
@@ -20,6 +20,7 @@
 #include "Library/rapidxml/rapidxml.hpp"
 #include "Library/rapidxml/rapidxml_iterators.hpp"
 #include "Form/WndButtonImage.h"
+#include "utils/task_graph.h"
 
 #include <stdio.h>
 
@@ -68,6 +69,15 @@ static bool FormKeyDown(WndForm* pWnd, unsigned KeyCode){
 
 MsgReturn_t MessageBoxX(LPCTSTR lpText, LPCTSTR lpCaption, MsgType_t uType, bool wfullscreen){
 
+  if (task_graph::InWorker()) {
+    // startup loader thread : dialog must be run by main thread
+    MsgReturn_t result = IdOk;
+    task_graph::Invoke([&]() {
+      result = MessageBoxX(lpText, lpCaption, uType, wfullscreen);
+    });
+    return result;
+  }
+
   WndForm *wf=NULL;
   WndFrame *wText=NULL;
   int X, Y, Width, Height;
@@ -10,6 +10,7 @@
 #include "Multimap.h"
 #include "ScreenProjection.h"
 #include "Task/TaskRendererMgr.h"
+#include "Waypoints/WaypointIndex.h"
 #include <functional>
 using std::placeholders::_1;
 
@@ -190,9 +191,33 @@ ScreenProjection MapWindow::CalculateScreenPositions(const POINT& Orig, const RE
   LockTaskData();
 
   if (!WayPointList.empty()) {
-    /* Is needed ? */
-    for(auto& wpt : WayPointList) {
-        wpt.Visible = PointVisible(wpt.Longitude, wpt.Latitude);
+    // only waypoints inside screen bounds are tested, others were already reset by previous run.
+    static std::vector<unsigned> visible;
+    static std::vector<unsigned> candidates;
+    static unsigned generation = 0;
+
+    const unsigned current = WaypointIndex::Query(screenbounds_latlon, candidates);
+    if (current != generation) {
+      // index rebuilt, list has changed since last run
+      generation = current;
+      for(auto& wpt : WayPointList) {
+        wpt.Visible = false;
+      }
+    } else {
+      for (unsigned i : visible) {
+        if (i < WayPointList.size()) {
+          WayPointList[i].Visible = false;
+        }
+      }
+    }
+
+    visible.clear();
+    for (unsigned i : candidates) {
+      WAYPOINT& wpt = WayPointList[i];
+      wpt.Visible = PointVisible(wpt.Longitude, wpt.Latitude);
+      if (wpt.Visible) {
+        visible.push_back(i);
+      }
     }
   }
 
@@ -9,6 +9,7 @@
 #include "externs.h"
 #include "RGB.h"
 #include "NavFunctions.h"
+#include "Waypoints/WaypointIndex.h"
 
 
 
@@ -164,17 +165,33 @@ _normal_run:
   }
 
   // far visibility for waypoints
-/*
-    WAYPOINT& wv = WayPointList.front();
-    const WAYPOINT& we = WayPointList.back();
- */
-  for( std::vector<WAYPOINT>::iterator wv = WayPointList.begin(); wv != WayPointList.end(); ++wv) {
-    // TODO code: optimise waypoint visibility
-	// TODO 110203 make it happen in 3 steps, with MULTICALC approach
-      wv->FarVisible = ((wv->Longitude> bounds.minx) &&
-			(wv->Longitude< bounds.maxx) &&
-			(wv->Latitude> bounds.miny) &&
-			(wv->Latitude< bounds.maxy));
+  // only waypoints inside bounds are tested, others were already reset by previous scan.
+  static std::vector<unsigned> far_visible;
+  static std::vector<unsigned> candidates;
+  static unsigned generation = 0;
+
+  const unsigned current = WaypointIndex::Query(bounds, candidates);
+  if (current != generation) {
+    // index rebuilt, list has changed since last scan
+    generation = current;
+    for (auto& wv : WayPointList) {
+      wv.FarVisible = false;
+    }
+  } else {
+    for (unsigned i : far_visible) {
+      if (i < WayPointList.size()) {
+        WayPointList[i].FarVisible = false;
+      }
+    }
+  }
+
+  far_visible.clear();
+  for (unsigned i : candidates) {
+    WAYPOINT& wv = WayPointList[i];
+    wv.FarVisible = PointInRect(wv.Longitude, wv.Latitude, bounds);
+    if (wv.FarVisible) {
+      far_visible.push_back(i);
+    }
   }
 
   // far visibility for airspace
@@ -13,6 +13,7 @@
 #include "Multimap.h"
 #include "Sound/Sound.h"
 #include "ScreenProjection.h"
+#include "utils/profiler.h"
 
 extern bool FastZoom;
 extern bool TargetDialogOpen;
@@ -29,6 +30,8 @@ void MapWindow::RenderOverlayGauges(LKSurface& Surface, const RECT& rc) {
 
 void MapWindow::RenderMapWindowBg(LKSurface& Surface, const RECT& rc) {
 
+    profiler::scope timing(profiler::RenderMap);
+
     if ( (LKSurface::AlphaBlendSupported() && BarOpacity < 100) || mode.AnyPan() ) {
         RECT newRect = {0, 0, ScreenSizeX, ScreenSizeY};
         MapWindow::ChangeDrawRect(newRect);
@@ -148,8 +151,11 @@ QuickRedraw:
             goto QuickRedraw;
         }
 
-        if(DrawTerrain(Surface, DrawRect, _Proj, sunazimuth, sunelevation)) {
-            terrainpainted = true;
+        {
+            profiler::scope timing(profiler::DrawTerrain);
+            if(DrawTerrain(Surface, DrawRect, _Proj, sunazimuth, sunelevation)) {
+                terrainpainted = true;
+            }
         }
 
         if (DONTDRAWTHEMAP) {
@@ -181,12 +187,15 @@ QuickRedraw:
     }
 
 
-    if (IsMultimapTopology()) {
-        DrawTopology(Surface, DrawRect, _Proj);
-    } else {
-        // If no topology wanted, but terrain painted, we paint only water stuff
-        if (terrainpainted) {
-            DrawTopology(Surface, DrawRect, _Proj, true);
+    {
+        profiler::scope timing(profiler::DrawTopology);
+        if (IsMultimapTopology()) {
+            DrawTopology(Surface, DrawRect, _Proj);
+        } else {
+            // If no topology wanted, but terrain painted, we paint only water stuff
+            if (terrainpainted) {
+                DrawTopology(Surface, DrawRect, _Proj, true);
+            }
         }
     }
 
@@ -195,6 +204,7 @@ QuickRedraw:
     ResetLabelDeclutter();
 
     if ((Flags_DrawTask || TargetDialogOpen) && ValidTaskPoint(ActiveTaskPoint) && ValidTaskPoint(1)) {
+        profiler::scope timing(profiler::DrawTask);
         DrawTaskAAT(Surface, DrawRect);
     }
 
@@ -204,6 +214,7 @@ QuickRedraw:
     }
 
     if (IsMultimapAirspace()) {
+        profiler::scope timing(profiler::DrawAirspace);
         DrawAirSpace(Surface, rc, _Proj);
     }
 
@@ -231,16 +242,21 @@ QuickRedraw:
 _skip_stuff:
 
     if (IsMultimapAirspace() && AirspaceWarningMapLabels) {
-        DrawAirspaceLabels(Surface, DrawRect, _Proj, Orig_Aircraft);
+        {
+            profiler::scope timing(profiler::DrawAirspace);
+            DrawAirspaceLabels(Surface, DrawRect, _Proj, Orig_Aircraft);
+        }
         if (DONTDRAWTHEMAP) { // 100319
             goto QuickRedraw;
         }
     }
 
     if (IsMultimapWaypoints()) {
+        profiler::scope timing(profiler::DrawWaypoints);
         DrawWaypointsNew(Surface, DrawRect, _Proj);
     }
     if (TrailActive) {
+        profiler::scope timing(profiler::DrawTrail);
         LKDrawLongTrail(Surface, DrawRect, _Proj);
         LKDrawTrail(Surface, DrawRect, _Proj);
     }
@@ -249,6 +265,7 @@ _skip_stuff:
     }
 
     if ((Flags_DrawTask || TargetDialogOpen) && ValidTaskPoint(ActiveTaskPoint) && ValidTaskPoint(1)) {
+        profiler::scope timing(profiler::DrawTask);
         DrawTask(Surface, DrawRect, _Proj, Orig_Aircraft);
 
     }
@@ -293,16 +310,21 @@ _skip_stuff:
         goto QuickRedraw;
     }
 
-    // Draw traffic and other specifix LK gauges
-    LKDrawFLARMTraffic(Surface, DrawRect, _Proj, Orig_Aircraft);
+    {
+        profiler::scope timing(profiler::DrawTraffic);
 
-    // Draw FANET-Data on Map
-    LKDrawFanetData(Surface, DrawRect, _Proj, Orig_Aircraft);
+        // Draw traffic and other specifix LK gauges
+        LKDrawFLARMTraffic(Surface, DrawRect, _Proj, Orig_Aircraft);
+
+        // Draw FANET-Data on Map
+        LKDrawFanetData(Surface, DrawRect, _Proj, Orig_Aircraft);
+    }
 
     // ---------------------------------------------------
 _skip_2:
 
     if (NOTANYPAN) {
+        profiler::scope timing(profiler::DrawOverlays);
 
         if (IsMultimapOverlaysGauges()) {
             RenderOverlayGauges(Surface, rc);
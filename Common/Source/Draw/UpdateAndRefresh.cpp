@@ -52,9 +52,17 @@ void MapWindow::UpdateCaches(const ScreenProjection& _Proj, bool force) {
   // map was dirtied while we were drawing, so skip slow process
   // (unless we haven't done it for 2000 ms)
 
+  // predicted position (see PredictNextPosition) give direction of topology prefetch,
+  // nothing to prefetch while circling or panning.
+  const vectorObj track = {
+    DerivedDrawInfo.NextLongitude - DrawInfo.Longitude,
+    DerivedDrawInfo.NextLatitude - DrawInfo.Latitude
+  };
+  const bool prefetch = !DerivedDrawInfo.Circling && !mode.AnyPan();
+
   // have some time, do shape file cache update if necessary
   LockTerrainDataGraphics();
-  SetTopologyBounds(DrawRect, _Proj, force||MapWindow::ForceVisibilityScan);
+  SetTopologyBounds(DrawRect, _Proj, force||MapWindow::ForceVisibilityScan, prefetch ? &track : nullptr);
   UnlockTerrainDataGraphics();
   //
   // ForceVisibilityScan is checked and actively used only here, and in ScanVisibility since v6
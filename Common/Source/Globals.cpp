@@ -239,6 +239,7 @@ void Globals_Init(void) {
 
   HideUnits=false;
   CheckSum=true;
+  EnableNMEAQueue=false;
   OutlinedTp_Config=0;
   OutlinedTp=OutlinedTp_Config;
   OverColor=0;
@@ -591,6 +592,7 @@ void Globals_Init(void) {
 
   LockSettingsInFlight = false;
   LoggerShortName = false;
+  LoggerGRecordInterval = 5;
 
   /*
    * These tables are initialized by InitSineTable later than Globals here
@@ -669,6 +671,7 @@ void Globals_Init(void) {
   AutoContrast=true;
   SnailScale=MAXSNAILRESIZE;
   TerrainWhiteness=1;
+  TerrainCacheSize=16;
 
   EnableAudioVario = false;
 
@@ -19,6 +19,7 @@
 #include <Tracking/Tracking.h>
 #include "utils/printf.h"
 #include "utils/unique_file_ptr.h"
+#include "utils/tokenizer.h"
 
 #ifdef ANDROID
   #include "Android/BluetoothHelper.hpp"
@@ -209,6 +210,7 @@ void LKParseProfileString(const char *sname, const char *svalue) {
   }
 
   if (settings::read(sname, svalue, szRegistryCheckSum, CheckSum)) return;
+  if (settings::read(sname, svalue, szRegistryEnableNMEAQueue, EnableNMEAQueue)) return;
 
   if (!strcmp(szRegistryCircleZoom, sname)) {
     int ival = strtol(svalue, nullptr, 10);
@@ -377,6 +379,7 @@ void LKParseProfileString(const char *sname, const char *svalue) {
 
   if (settings::read(sname, svalue, szRegistryLockSettingsInFlight, LockSettingsInFlight)) return;
   if (settings::read(sname, svalue, szRegistryLoggerShort, LoggerShortName)) return;
+  if (settings::read(sname, svalue, szRegistryLoggerGRecordInterval, LoggerGRecordInterval)) return;
   if (settings::read(sname, svalue, szRegistryMapBox, MapBox)) return;
   if (settings::read(sname, svalue, szRegistryMapFile, szMapFile)) {
     RemoveFilePathPrefix(_T("%LOCAL_PATH%"), szMapFile);
@@ -485,60 +488,44 @@ void LKParseProfileString(const char *sname, const char *svalue) {
     if (settings::read(sname, svalue, szRegistryReplayRaw[n], Port.RawByteData)) return;
     if (settings::read(sname, svalue, szRegistryReplaySync[n], Port.ReplaySync)) return;
 
-    int i = 0;
-
     TCHAR szTmp[IO_PARAM_SIZE] = _T("");
-    TCHAR szItem[10];
 
     char szKey[20] = ("");
     sprintf(szKey, "%s%u", szRegistryIOValues, n + 1);
     if (settings::read(sname, svalue, szKey, szTmp) && (_tcslen(szTmp) > 0)) {
 //      StartupStore(TEXT(" Load : szRegistryIOValues[%u] (%s) %s  %s"), n, szKey, szTmp, NEWLINE);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.MCDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.BUGDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10); // (String, nullptr, 0)
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.BALDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.STFDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.WINDDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.BARODir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.VARIODir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.SPEEDDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.R_TRGTDir = (DataTP_Type) _tcstoul(szItem, nullptr, 10);
-
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.RADIODir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.TRAFDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.GYRODir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.GFORCEDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.OATDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.BAT1Dir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.BAT2Dir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp, szItem, i++);
-      Port.PortIO.POLARDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp,szItem,i++);
-      Port.PortIO.DirLink  = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp,szItem,i++);
-      Port.PortIO.T_TRGTDir = (DataTP_Type) _tcstoul(szItem, nullptr, 10);
-      NMEAParser::ExtractParameter(szTmp,szItem,i++);
-      Port.PortIO.QNHDir = (DataBiIoDir) _tcstoul(szItem, nullptr, 10);
+      // single pass over the value list, missing items are 0
+      lk::tokenizer<TCHAR> tok(szTmp);
+      auto next_item = [&]() -> unsigned long {
+        const TCHAR* item = tok.Next(_T(","));
+        return item ? _tcstoul(item, nullptr, 10) : 0;
+      };
+
+      Port.PortIO.MCDir = (DataBiIoDir) next_item();
+      Port.PortIO.BUGDir = (DataBiIoDir) next_item(); // (String, nullptr, 0)
+      Port.PortIO.BALDir = (DataBiIoDir) next_item();
+
+      Port.PortIO.STFDir = (DataBiIoDir) next_item();
+      Port.PortIO.WINDDir = (DataBiIoDir) next_item();
+      Port.PortIO.BARODir = (DataBiIoDir) next_item();
+
+      Port.PortIO.VARIODir = (DataBiIoDir) next_item();
+      Port.PortIO.SPEEDDir = (DataBiIoDir) next_item();
+      Port.PortIO.R_TRGTDir = (DataTP_Type) next_item();
+
+      Port.PortIO.RADIODir = (DataBiIoDir) next_item();
+      Port.PortIO.TRAFDir = (DataBiIoDir) next_item();
+      Port.PortIO.GYRODir = (DataBiIoDir) next_item();
+
+      Port.PortIO.GFORCEDir = (DataBiIoDir) next_item();
+      Port.PortIO.OATDir = (DataBiIoDir) next_item();
+      Port.PortIO.BAT1Dir = (DataBiIoDir) next_item();
+
+      Port.PortIO.BAT2Dir = (DataBiIoDir) next_item();
+      Port.PortIO.POLARDir = (DataBiIoDir) next_item();
+      Port.PortIO.DirLink  = (DataBiIoDir) next_item();
+      Port.PortIO.T_TRGTDir = (DataTP_Type) next_item();
+      Port.PortIO.QNHDir = (DataBiIoDir) next_item();
     }
   }
 
@@ -585,6 +572,7 @@ void LKParseProfileString(const char *sname, const char *svalue) {
   if (settings::read(sname, svalue, szRegistryStartRadius, StartRadius)) return;
   if (settings::read(sname, svalue, szRegistryTeamcodeRefWaypoint, TeamCodeRefWaypoint)) return;
   if (settings::read(sname, svalue, szRegistryTerrainBrightness, TerrainBrightness)) return;
+  if (settings::read(sname, svalue, szRegistryTerrainCacheSize, TerrainCacheSize)) return;
   if (settings::read(sname, svalue, szRegistryTerrainContrast, TerrainContrast)) return;
 
   if (settings::read(sname, svalue, szRegistryTerrainFile, szTerrainFile)) {
@@ -154,6 +154,7 @@ void LKProfileResetDefault() {
   gTaskType=TSK_DEFAULT;
 
   CheckSum = 1;
+  EnableNMEAQueue = false;
 
   ClimbZoom=5;
   CruiseZoom=14;
@@ -432,6 +433,7 @@ void LKProfileResetDefault() {
 
   LockSettingsInFlight = false;
   LoggerShortName = false;
+  LoggerGRecordInterval = 5;
 
   BUGS_Config=1; // 1=100%, 0.5 = 50% .. FLOATS!
 
@@ -485,6 +487,7 @@ void LKProfileResetDefault() {
 
   AutoContrast=true;
   TerrainWhiteness=1;
+  TerrainCacheSize=16;
 
   EnableAudioVario = false;
 
@@ -200,6 +200,7 @@ void LKProfileSave(const TCHAR *szFile) {
   write_settings(szRegistryLanguageCode, szLanguageCode);
   write_settings(szRegistryLockSettingsInFlight, LockSettingsInFlight);
   write_settings(szRegistryLoggerShort, LoggerShortName);
+  write_settings(szRegistryLoggerGRecordInterval, LoggerGRecordInterval);
   write_settings(szRegistryMapBox, MapBox);
   write_settings(szRegistryMapFile, szMapFile);
   write_settings(szRegistryMenuTimeout, MenuTimeout_Config);
@@ -246,6 +247,7 @@ void LKProfileSave(const TCHAR *szFile) {
   write_settings(szRegistryStartRadius, StartRadius);
   write_settings(szRegistryTeamcodeRefWaypoint, TeamCodeRefWaypoint);
   write_settings(szRegistryTerrainBrightness, TerrainBrightness);
+  write_settings(szRegistryTerrainCacheSize, TerrainCacheSize);
   write_settings(szRegistryTerrainContrast, TerrainContrast);
   write_settings(szRegistryTerrainFile, szTerrainFile);
   write_settings(szRegistryTerrainRamp, TerrainRamp_Config);
@@ -505,6 +507,7 @@ void LKDeviceSave(const TCHAR *szFile) {
   write_settings(szRegistryUseGeoidSeparation, UseGeoidSeparation);
   write_settings(szRegistryPollingMode, PollingMode);
   write_settings(szRegistryCheckSum, CheckSum);
+  write_settings(szRegistryEnableNMEAQueue, EnableNMEAQueue);
 
   ModelType::SaveSettings(write_settings);
 }
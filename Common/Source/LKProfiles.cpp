@@ -166,6 +166,7 @@ const char szRegistryBestWarning[] = "BestWarning";
 const char szRegistryBgMapColor[] = "BgMapColor";
 const char szRegistryBugs[] = "Bugs";
 const char szRegistryCheckSum[] = "CheckSum1";
+const char szRegistryEnableNMEAQueue[] = "EnableNMEAQueue";
 const char szRegistryCircleZoom[] = "CircleZoom";
 const char szRegistryClipAlt[] = "ClipAlt1";
 const char szRegistryCompetitionClass[] = "CompetitionClass1";
@@ -300,6 +301,7 @@ const char szRegistryLKVarioVal[] = "LKVarioVal";
 const char szRegistryLanguageCode[] = "LanguageCode";
 const char szRegistryLockSettingsInFlight[] = "LockSettingsInFlight";
 const char szRegistryLoggerShort[] = "LoggerShortName";
+const char szRegistryLoggerGRecordInterval[] = "LoggerGRecordInterval";
 const char szRegistryMapBox[] = "MapBox";
 const char szRegistryMapFile[] = "MapFile";
 const char szRegistryMenuTimeout[] = "MenuTimeout";
@@ -412,6 +414,7 @@ const char szRegistryStartMaxSpeed[] = "StartMaxSpeed";
 const char szRegistryStartRadius[] = "StartRadius";
 const char szRegistryTeamcodeRefWaypoint[] = "TeamcodeRefWaypoint1";
 const char szRegistryTerrainBrightness[] = "TerrainBrightness1";
+const char szRegistryTerrainCacheSize[] = "TerrainCacheSize";
 const char szRegistryTerrainContrast[] = "TerrainContrast1";
 const char szRegistryTerrainFile[] = "TerrainFile";
 const char szRegistryTerrainRamp[] = "TerrainRamp";
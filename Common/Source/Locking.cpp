@@ -8,10 +8,10 @@
 #include "externs.h"
 
 
-Mutex  CritSec_FlightData;
+profiler::timed_mutex<profiler::LockFlightData>  CritSec_FlightData;
 Mutex  CritSec_TerrainDataGraphics;
 Mutex  CritSec_TerrainDataCalculations;
-Mutex  CritSec_TaskData;
+profiler::timed_mutex<profiler::LockTaskData>  CritSec_TaskData;
 
 void LockTaskData() {
   CritSec_TaskData.lock();
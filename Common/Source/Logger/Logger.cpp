@@ -492,7 +492,7 @@ static void internal_StartLogger() {
     }
   }
 
-  igc_writer_ptr = std::make_unique<igc_file_writer>(szLoggerFilePath, LoggerGActive());
+  igc_writer_ptr = std::make_unique<igc_file_writer>(szLoggerFilePath, LoggerGActive(), LoggerGRecordInterval);
 
   LoggerHeader(first_point, asset_id);
   LoggerTask();
@@ -502,6 +502,8 @@ static void internal_StartLogger() {
   }
   LoggerBuffer = std::deque<LoggerBuffer_t>(); //used instead of clear to deallocate.
 
+  igc_writer_ptr->flush();
+
 #ifdef ANDROID
   // required to make file available to Android StorageManager without reboot device.
   AndroidFileUtils::UpdateMediaStore(szLoggerFilePath);
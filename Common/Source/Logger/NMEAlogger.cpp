@@ -9,63 +9,184 @@
 
 #include "externs.h"
 #include "utils/printf.h"
+#include "Thread/Thread.hpp"
+#include "Time/PeriodClock.hpp"
+#include "Poco/Event.h"
+#include <atomic>
+#include <memory>
 
 
 bool	EnableLogNMEA = false;
 
+namespace {
 
+/**
+ * Lock-free single producer / single consumer ring of NMEA records.
+ *
+ * Producer is the port Rx thread, consumer is the NMEA log writer thread.
+ * Each record is a header followed by the sentence, the sequence number is used
+ * by writer to keep sentences of all ports in receive order.
+ */
+template<size_t capacity>
+class NMEALogRing final {
+  static_assert(capacity && !(capacity & (capacity - 1)), "capacity must be power of 2");
 
-// New LogNMEA
-void LogNMEA(const char* text, int PortNum) {
+public:
+  struct Header {
+    uint32_t seq;
+    uint16_t size;
+  };
+
+  // producer side, @return false if there is not enough free space
+  bool Push(uint32_t seq, const char* text, size_t size) {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    const size_t free = capacity - (head - _tail.load(std::memory_order_acquire));
+    if ((sizeof(Header) + size) > free) {
+      return false;
+    }
+    const Header header = { seq, static_cast<uint16_t>(size) };
+    CopyIn(head, &header, sizeof(Header));
+    CopyIn(head + sizeof(Header), text, size);
+    _head.store(head + sizeof(Header) + size, std::memory_order_release);
+    return true;
+  }
 
-static FILE *logfpall = NULL;
-static FILE *logfsingle[NUMDEV]= {NULL,NULL,NULL,NULL,NULL,NULL};
+  // used bytes
+  size_t Size() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
 
-static int iLastPort =-1;
-static bool wasWriting=false;
+  // consumer side, @return false if ring is empty
+  bool Front(Header& header) const {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (_head.load(std::memory_order_acquire) == tail) {
+      return false;
+    }
+    CopyOut(tail, &header, sizeof(Header));
+    return true;
+  }
 
+  // consumer side, copy front record to <text> and release it
+  void Pop(const Header& header, char* text) {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    CopyOut(tail + sizeof(Header), text, header.size);
+    _tail.store(tail + sizeof(Header) + header.size, std::memory_order_release);
+  }
 
-  if (!EnableLogNMEA) {
-      if (wasWriting) { 
-          if(logfpall != NULL) {
-              fclose(logfpall) ;
-              logfpall = NULL;
-          }
-          for(int dev = 0; dev < NUMDEV; dev++)
-          {
-            if(logfsingle[dev] != NULL) {
-              fclose(logfsingle[dev]);
-              logfsingle[dev] = NULL;
-            }
-          }
+private:
+  void CopyIn(size_t pos, const void* data, size_t size) {
+    const size_t offset = pos & (capacity - 1);
+    const size_t first = std::min(size, capacity - offset);
+    memcpy(&_buffer[offset], data, first);
+    memcpy(&_buffer[0], static_cast<const uint8_t*>(data) + first, size - first);
+  }
+
+  void CopyOut(size_t pos, void* data, size_t size) const {
+    const size_t offset = pos & (capacity - 1);
+    const size_t first = std::min(size, capacity - offset);
+    memcpy(data, &_buffer[offset], first);
+    memcpy(static_cast<uint8_t*>(data) + first, &_buffer[0], size - first);
+  }
+
+  uint8_t _buffer[capacity];
+  std::atomic<size_t> _head = {0}; // written by producer
+  std::atomic<size_t> _tail = {0}; // written by consumer
+};
+
+// ~3s of data at 115200 baud
+constexpr size_t ring_size = 32 * 1024;
+// ring are drained at least every 250ms, or when half full
+constexpr unsigned write_period = 250;
+// files are flushed every second or when 16kB are waiting
+constexpr unsigned flush_period = 1000;
+constexpr size_t flush_threshold = 16 * 1024;
+
+struct PortLog {
+  NMEALogRing<ring_size> ring;
+  std::atomic<unsigned> dropped = {0}; // bytes
+};
+
+PortLog port_log[NUMDEV];
+std::atomic<uint32_t> sequence = {0};
+
+// static : Rx thread can signal it before writer is started or after it's stopped
+Poco::Event data_event;
+
+class NMEALogWriter final : public Thread {
+public:
+  NMEALogWriter() : Thread("NMEALogger") {}
+
+  void Stop() {
+    _stop = true;
+    data_event.set();
+    Join();
+  }
 
-          iLastPort =-1;
-          wasWriting=false;
+protected:
+  void Run() override {
+    PeriodClock flush_clock;
+    flush_clock.Update();
+    while (!_stop) {
+      data_event.tryWait(write_period);
+      Write();
+      if (unflushed >= flush_threshold || flush_clock.CheckUpdate(flush_period)) {
+        Flush();
       }
-      return;
-  }
-
-  if(logfpall == NULL)
-  {
-        TCHAR fpname[LKSIZEBUFFERPATH];
-        TCHAR buffer[LKSIZEBUFFERPATH];
-        LocalPath(buffer,TEXT(LKD_LOGS));
-        lk::snprintf(fpname, _T("%s%sNMEA_%04d-%02d-%02d-%02d-%02d-%02d.txt"), buffer, _T(DIRSEP), GPS_INFO.Year, GPS_INFO.Month, GPS_INFO.Day,
-        GPS_INFO.Hour, GPS_INFO.Minute, GPS_INFO.Second);
-        logfpall = _tfopen(fpname, _T("a"));
-        if (logfpall == NULL) {
-          DoStatusMessage(_T("CANNOT SAVE TO NMEA LOGFILE"));
-          EnableLogNMEA=false;
-          return;
+      if (!EnableLogNMEA) {
+        Close();
+      }
+    }
+    Write();
+    Close();
+  }
+
+private:
+  // write all pending sentences, in receive order.
+  void Write() {
+    for (;;) {
+      int port = -1;
+      NMEALogRing<ring_size>::Header header = {};
+      for (int i = 0; i < NUMDEV; ++i) {
+        NMEALogRing<ring_size>::Header front;
+        if (port_log[i].ring.Front(front)) {
+          if (port < 0 || static_cast<int32_t>(front.seq - header.seq) < 0) {
+            port = i;
+            header = front;
+          }
         }
-        wasWriting=true;
+      }
+      if (port < 0) {
+        return;
+      }
+
+      char snmea[LKSIZENMEA];
+      port_log[port].ring.Pop(header, snmea);
+      snmea[header.size] = '\0';
+      if (EnableLogNMEA) {
+        Write(snmea, port);
+      }
+    }
   }
 
-  if(iLastPort != -1)  /* already a port info ? */
-  {
-    if( iLastPort != PortNum) /* more than one port active (another than the previous) */
+  void Write(char* snmea, int PortNum) {
+    if(logfpall == NULL)
     {
-      if((PortNum >=0) && (PortNum < NUMDEV))
+          TCHAR fpname[LKSIZEBUFFERPATH];
+          TCHAR buffer[LKSIZEBUFFERPATH];
+          LocalPath(buffer,TEXT(LKD_LOGS));
+          lk::snprintf(fpname, _T("%s%sNMEA_%04d-%02d-%02d-%02d-%02d-%02d.txt"), buffer, _T(DIRSEP), GPS_INFO.Year, GPS_INFO.Month, GPS_INFO.Day,
+          GPS_INFO.Hour, GPS_INFO.Minute, GPS_INFO.Second);
+          logfpall = _tfopen(fpname, _T("a"));
+          if (logfpall == NULL) {
+            DoStatusMessage(_T("CANNOT SAVE TO NMEA LOGFILE"));
+            EnableLogNMEA=false;
+            return;
+          }
+    }
+
+    if(iLastPort != -1)  /* already a port info ? */
+    {
+      if( iLastPort != PortNum) /* more than one port active (another than the previous) */
       {
         if(logfsingle[PortNum] == NULL)
         {
@@ -76,41 +197,197 @@ static bool wasWriting=false;
           logfsingle[PortNum] = _tfopen(fpname, _T("a"));
           if (logfsingle[PortNum] == NULL) {
             DoStatusMessage(_T("CANNOT SAVE TO NMEA LOGFILE PORT A:"));
-            return; 
+            return;
           }
-          wasWriting=true;
         }
       }
     }
+
+    iLastPort = PortNum;
+
+    short l=strlen(snmea);
+    if ( snmea[l-3]==0x0d && snmea[l-2]==0x0d) {
+      snmea[l-2]=0x0a;
+      snmea[l-1]=0;
+    }
+    l=strlen(snmea); // surely >3
+    if ( snmea[l-1]==0x0a && snmea[l-2]==0x0a) {
+      snmea[l-1]=0;
+      --l;
+    }
+
+    if (logfpall) {
+      fwrite(snmea, 1, l, logfpall);
+      unflushed += l;
+    }
+
+    if(logfsingle[PortNum]) {
+      fwrite(snmea, 1, l, logfsingle[PortNum]);
+    }
   }
 
-  iLastPort = PortNum;
+  void Flush() {
+    if(logfpall != NULL) {
+      fflush(logfpall);
+    }
+    for (FILE* file : logfsingle) {
+      if (file != NULL) {
+        fflush(file);
+      }
+    }
+    unflushed = 0;
 
-  char snmea[LKSIZENMEA];
-  LKASSERT(strlen(text)<sizeof(snmea));
-  if (strlen(text)>=sizeof(snmea)) return;
+    unsigned total = 0;
+    for (const auto& log : port_log) {
+      total += log.dropped;
+    }
+    if (total != reported_dropped) {
+      StartupStore(_T("... NMEA log : %u bytes dropped, card is too slow"), total - reported_dropped);
+      reported_dropped = total;
+    }
+  }
 
-  strcpy(snmea,text);
+  void Close() {
+    Flush();
+    if(logfpall != NULL) {
+      fclose(logfpall) ;
+      logfpall = NULL;
+    }
+    for(FILE*& file : logfsingle) {
+      if(file != NULL) {
+        fclose(file);
+        file = NULL;
+      }
+    }
+    iLastPort =-1;
+  }
+
+  std::atomic<bool> _stop = {false};
+
+  FILE *logfpall = NULL;
+  FILE *logfsingle[NUMDEV]= {NULL,NULL,NULL,NULL,NULL,NULL};
+  int iLastPort =-1;
+  size_t unflushed = 0;
+  unsigned reported_dropped = 0;
+};
+
+Mutex writer_mutex;
+std::unique_ptr<NMEALogWriter> writer;
+std::atomic<bool> writer_started = {false};
+
+void StartNMEALogger() {
+  ScopeLock lock(writer_mutex);
+  if (!writer) {
+    writer = std::make_unique<NMEALogWriter>();
+    writer->Start();
+    writer_started = true;
+  }
+}
+
+} // namespace
+
+
+// New LogNMEA
+// Called from port Rx thread, sentence is only queued, files are written by NMEALogWriter thread.
+void LogNMEA(const char* text, int PortNum) {
 
-  short l=strlen(snmea);
+  if (!EnableLogNMEA) {
+    return;
+  }
+  if ((PortNum < 0) || (PortNum >= NUMDEV)) {
+    return;
+  }
+
+  const size_t l = strlen(text);
+  LKASSERT(l<LKSIZENMEA);
+  if (l>=LKSIZENMEA) return;
   if (l<6) return;
-  if ( snmea[l-3]==0x0d && snmea[l-2]==0x0d) {
-    snmea[l-2]=0x0a;
-    snmea[l-1]=0;
+
+  if (!writer_started) {
+    StartNMEALogger();
   }
-  l=strlen(snmea); // surely >3
-  if ( snmea[l-1]==0x0a && snmea[l-2]==0x0a) {
-    snmea[l-1]=0;
+
+  auto& log = port_log[PortNum];
+  if (!log.ring.Push(sequence++, text, l)) {
+    log.dropped += l;
+  } else if (log.ring.Size() > (ring_size / 2)) {
+    data_event.set(); // don't wait for write period
   }
+}
+
+void CloseNMEALogger() {
+  ScopeLock lock(writer_mutex);
+  if (writer) {
+    writer_started = false;
+    writer->Stop();
+    writer = nullptr;
+  }
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <string>
+#include <thread>
 
-  if (logfpall) {
-    fprintf(logfpall,"%s",snmea);
-    fflush(logfpall);
+TEST_CASE("nmea log ring") {
+
+  SUBCASE("wrap") {
+    auto ring = std::make_unique<NMEALogRing<64>>();
+    NMEALogRing<64>::Header header;
+    char text[64];
+    CHECK_FALSE(ring->Front(header));
+
+    // 8 byte header + 20 byte : 2 records fit, third doesn't
+    const std::string line(20, 'a');
+    CHECK(ring->Push(1, line.c_str(), line.size()));
+    CHECK(ring->Push(2, line.c_str(), line.size()));
+    CHECK_FALSE(ring->Push(3, line.c_str(), line.size()));
+
+    // each record wrap at a different offset
+    for (uint32_t seq = 1; seq < 20; ++seq) {
+      REQUIRE(ring->Front(header));
+      CHECK(header.seq == seq);
+      CHECK(header.size == line.size());
+      ring->Pop(header, text);
+      CHECK(std::string(text, header.size) == line);
+      CHECK(ring->Push(seq + 2, line.c_str(), line.size()));
+    }
   }
 
-  if(logfsingle[PortNum]) {
-    fprintf(logfsingle[PortNum],"%s",snmea);
-    fflush(logfsingle[PortNum]);
+  SUBCASE("threads") {
+    auto ring = std::make_unique<NMEALogRing<1024>>();
+    constexpr uint32_t count = 100000;
+
+    std::thread producer([&]() {
+      char buff[LKSIZENMEA];
+      for (uint32_t i = 0; i < count; ) {
+        const int size = sprintf(buff, "$GPTST,%u\r\n", i);
+        if (ring->Push(i, buff, size)) {
+          ++i;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+    unsigned errors = 0;
+    NMEALogRing<1024>::Header header;
+    char text[LKSIZENMEA];
+    for (uint32_t i = 0; i < count; ) {
+      if (ring->Front(header)) {
+        ring->Pop(header, text);
+        text[header.size] = '\0';
+        errors += (header.seq != i) || (strtoul(text + 7, nullptr, 10) != i);
+        ++i;
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    producer.join();
+
+    CHECK(errors == 0);
+    CHECK(ring->Size() == 0);
   }
 }
 
+#endif
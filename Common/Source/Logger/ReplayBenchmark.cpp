@@ -0,0 +1,296 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   ReplayBenchmark.cpp
+ *
+ * Headless fast forward replay of an IGC file through the calculation chain.
+ *
+ * Unlike ReplayLogger, fixes are not paced by real time and no window is needed,
+ * so it can be used as cpu benchmark of release build, from command line :
+ *
+ *   LK8000 -replay=flight.igc [-replaytask=task.lkt] [-profile=filename]
+ *
+ * In debug build, same replay is available from doctest runner :
+ *
+ *   LK8000 --test-case="replay benchmark" --no-skip
+ *
+ * environment :
+ *   LK_REPLAY_IGC      igc file to replay (default : synthetic flight)
+ *   LK_REPLAY_PROFILE  profile to load (default : _Configuration/DEFAULT_PROFILE.prf)
+ *   LK_REPLAY_TASK     task to load (.lkt, .cup, .gpx or .xctsk)
+ */
+
+#include "externs.h"
+#include "ReplayBenchmark.h"
+#include "Calculations.h"
+#include "McReady.h"
+#include "Baro.h"
+#include "Calc/Vario.h"
+#include "Waypointparser.h"
+#include "RasterTerrain.h"
+#include "CTaskFileHelper.h"
+#include "ContestMgr.h"
+#include "NavFunctions.h"
+#include "LKProfiles.h"
+#include "utils/profiler.h"
+#include "Time/PeriodClock.hpp"
+#include "utils/charset_helper.h"
+#include <vector>
+#include <memory>
+#include <sstream>
+
+namespace {
+
+  struct replay_fix {
+    unsigned time; // seconds since midnight UTC
+    double latitude;
+    double longitude;
+    double altitude;
+  };
+
+  struct replay_flight {
+    int year = 2024;
+    int month = 6;
+    int day = 15;
+    std::vector<replay_fix> fixes;
+  };
+
+  // B records and date of an IGC file, same format as ReplayLogger
+  replay_flight ReadIGC(const TCHAR* filename) {
+    replay_flight flight;
+    FILE* file = _tfopen(filename, _T("r"));
+    if (!file) {
+      return flight;
+    }
+    char line[200];
+    while (fgets(line, sizeof(line), file)) {
+      unsigned hour, minute, second, lat_deg, lat_min, lon_deg, lon_min;
+      unsigned day, month, year;
+      char lat_hemi, lon_hemi;
+      int baro_alt, gps_alt;
+      if (sscanf(line, "B%02u%02u%02u%02u%05u%c%03u%05u%cA%05d%05d",
+                 &hour, &minute, &second, &lat_deg, &lat_min, &lat_hemi,
+                 &lon_deg, &lon_min, &lon_hemi, &baro_alt, &gps_alt) == 11) {
+        double lat = lat_deg + lat_min / 60000.;
+        double lon = lon_deg + lon_min / 60000.;
+        flight.fixes.push_back({ hour * 3600 + minute * 60 + second,
+                                 (lat_hemi == 'S') ? -lat : lat,
+                                 (lon_hemi == 'W') ? -lon : lon,
+                                 static_cast<double>((gps_alt > 0) ? gps_alt : baro_alt) });
+      }
+      else if (sscanf(line, "HFDTE%02u%02u%02u", &day, &month, &year) == 3
+                || sscanf(line, "HFDTEDATE:%02u%02u%02u", &day, &month, &year) == 3) {
+        flight.day = day;
+        flight.month = month;
+        flight.year = 2000 + year;
+      }
+    }
+    fclose(file);
+    return flight;
+  }
+
+  // 1s fixes, straight glides between three turnpoints with a thermal every 3km
+  replay_flight SyntheticFlight() {
+    const double turnpoints[][2] = {{45.0, 10.0}, {45.35, 10.45}, {44.85, 10.6}};
+    replay_flight flight;
+    unsigned time = 36000;
+    double lat = turnpoints[0][0];
+    double lon = turnpoints[0][1];
+    double alt = 1500;
+    for (unsigned leg = 0; leg < 9; ++leg) {
+      const double* target = turnpoints[(leg + 1) % 3];
+      double dist, bearing;
+      DistanceBearing(lat, lon, target[0], target[1], &dist, &bearing);
+      for (double flown = 0; flown < dist; flown += 30) {
+        double next_lat, next_lon;
+        FindLatitudeLongitude(lat, lon, bearing, 30, &next_lat, &next_lon);
+        lat = next_lat;
+        lon = next_lon;
+        alt -= 1;
+        flight.fixes.push_back({ time++, lat, lon, alt });
+        if (static_cast<unsigned>(flown) % 3000 < 30) {
+          for (unsigned i = 0; i < 90; ++i) {
+            double circle_lat, circle_lon;
+            FindLatitudeLongitude(lat, lon, i * 12, 80, &circle_lat, &circle_lon);
+            alt += 1;
+            flight.fixes.push_back({ time++, circle_lat, circle_lon, alt });
+          }
+        }
+      }
+    }
+    return flight;
+  }
+
+  bool LoadTask(const TCHAR* path) {
+    const TCHAR* ext = _tcsrchr(path, _T('.'));
+    if (!ext) {
+      return false;
+    }
+    if (_tcsicmp(ext, _T(LKS_TSK)) == 0) {
+      CTaskFileHelper helper;
+      return helper.Load(path);
+    }
+    if (_tcsicmp(ext, _T(".cup")) == 0) {
+      return LoadCupTask(path);
+    }
+    if (_tcsicmp(ext, _T(".gpx")) == 0) {
+      return LoadGpxTask(path);
+    }
+    if (_tcsicmp(ext, _T(".xctsk")) == 0) {
+      return LoadXctrackTask(path);
+    }
+    return false;
+  }
+
+  // same as Startup(), without anything related to UI or devices
+  void LoadData(const TCHAR* profile, const TCHAR* task) {
+    TCHAR path[MAX_PATH];
+
+    // called before Startup() : from command line or doctest runner
+    InitSineTable();
+
+    LKProfileResetDefault();
+    LocalPath(path, _T(LKD_CONF), _T(LKAIRCRAFT));
+    LKProfileLoad(path);
+    LocalPath(path, _T(LKD_CONF), _T(LKPILOT));
+    LKProfileLoad(path);
+    if (profile) {
+      LKProfileLoad(profile);
+    } else {
+      LocalPath(path, _T(LKD_CONF), _T(LKPROFILE));
+      LKProfileLoad(path);
+    }
+    LKProfileInitRuntime();
+
+    memset(&Task, 0, sizeof(Task_t));
+    memset(&StartPoints, 0, sizeof(Start_t));
+    ClearTask();
+
+    ReadWinPilotPolar();
+    GlidePolar::SetBallast();
+
+    LockTerrainDataGraphics();
+    RasterTerrain::OpenTerrain();
+    UnlockTerrainDataGraphics();
+
+    ReadWayPoints();
+    InitLDRotary(&rotaryLD);
+    InitWindRotary(&rotaryWind);
+
+    CAirspaceManager::Instance().ReadAirspaces();
+    CAirspaceManager::Instance().SortAirspaces();
+
+    if (task && !LoadTask(task)) {
+      StartupStore(_T("... Replay benchmark : failed to load task <%s>"), task);
+    }
+  }
+
+  void UnloadData() {
+    ClearTask();
+    CAirspaceManager::Instance().CloseAirspaces();
+    LockTerrainDataGraphics();
+    RasterTerrain::CloseTerrain();
+    UnlockTerrainDataGraphics();
+  }
+
+} // namespace
+
+std::string ReplayBenchmark::Run(const TCHAR* igc, const TCHAR* profile, const TCHAR* task) {
+
+  const replay_flight flight = igc ? ReadIGC(igc) : SyntheticFlight();
+  if (flight.fixes.empty()) {
+    return {};
+  }
+
+  PeriodClock clock;
+  clock.Update();
+  LoadData(profile, task);
+  const unsigned load_ms = clock.Elapsed();
+
+  auto basic = std::make_unique<NMEA_INFO>();
+  auto calculated = std::make_unique<DERIVED_INFO>();
+  ResetBaroAvailable(*basic);
+  ResetVarioAvailable(*basic);
+  InitCalculations(basic.get(), calculated.get());
+
+  basic->Year = flight.year;
+  basic->Month = flight.month;
+  basic->Day = flight.day;
+  basic->SatellitesUsed = 8;
+
+  profiler::Reset();
+  profiler::Enable(true);
+
+  clock.Update();
+  const replay_fix* previous = nullptr;
+  for (const replay_fix& fix : flight.fixes) {
+    if (previous && fix.time > previous->time) {
+      double distance, bearing;
+      DistanceBearing(previous->latitude, previous->longitude,
+                      fix.latitude, fix.longitude, &distance, &bearing);
+      basic->Speed = distance / (fix.time - previous->time);
+      basic->TrackBearing = bearing;
+    }
+    basic->NAVWarning = false;
+    basic->Latitude = fix.latitude;
+    basic->Longitude = fix.longitude;
+    basic->Altitude = fix.altitude;
+    basic->BaroAltitude = QNEAltitudeToQNHAltitude(fix.altitude);
+    basic->Time = fix.time;
+    basic->Hour = fix.time / 3600;
+    basic->Minute = (fix.time / 60) % 60;
+    basic->Second = fix.time % 60;
+    previous = &fix;
+
+    // same sequence as CalculationThread, without pacing
+    LockFlightData();
+    GPS_INFO = *basic;
+    UnlockFlightData();
+
+    DoCalculationsVario(basic.get(), calculated.get());
+    if (DoCalculations(basic.get(), calculated.get())) {
+      DoCalculationsSlow(basic.get(), calculated.get());
+    }
+
+    LockFlightData();
+    CALCULATED_INFO = *calculated;
+    UnlockFlightData();
+  }
+  CContestMgr::Instance().WaitSolver();
+  const unsigned replay_ms = clock.Elapsed();
+
+  profiler::Enable(false);
+
+  UnloadData();
+
+  std::ostringstream report;
+  report << "replay " << flight.fixes.size() << " fixes : load " << load_ms << "ms, replay " << replay_ms << "ms\n"
+         << profiler::Report();
+  return report.str();
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+
+// not run by default, use '--test-case="replay benchmark" --no-skip'
+TEST_CASE("replay benchmark" * doctest::skip()) {
+
+  auto getenv_tstring = [](const char* name) {
+    const char* value = getenv(name);
+    return value ? from_utf8(value) : tstring();
+  };
+  const tstring igc = getenv_tstring("LK_REPLAY_IGC");
+  const tstring profile = getenv_tstring("LK_REPLAY_PROFILE");
+  const tstring task = getenv_tstring("LK_REPLAY_TASK");
+
+  auto c_str_or_null = [](const tstring& str) {
+    return str.empty() ? nullptr : str.c_str();
+  };
+  const std::string report = ReplayBenchmark::Run(c_str_or_null(igc), c_str_or_null(profile), c_str_or_null(task));
+  REQUIRE_FALSE(report.empty());
+  MESSAGE(report);
+}
+
+#endif
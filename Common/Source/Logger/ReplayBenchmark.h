@@ -0,0 +1,30 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   ReplayBenchmark.h
+ */
+
+#ifndef _LOGGER_REPLAYBENCHMARK_H_
+#define _LOGGER_REPLAYBENCHMARK_H_
+
+#include "tchar.h"
+#include <string>
+
+namespace ReplayBenchmark {
+
+  /**
+   * Headless fast forward replay of an IGC file through the calculation chain.
+   *
+   * Waypoints, airspaces and terrain are loaded according to profile, and unloaded at end.
+   *
+   * @igc : igc file to replay, nullptr for synthetic flight
+   * @profile : profile to load, nullptr for default profile
+   * @task : task to load (.lkt, .cup, .gpx or .xctsk), can be nullptr
+   * @return timing report, empty if igc file has no fix
+   */
+  std::string Run(const TCHAR* igc, const TCHAR* profile, const TCHAR* task);
+}
+
+#endif // _LOGGER_REPLAYBENCHMARK_H_
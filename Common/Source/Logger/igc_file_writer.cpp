@@ -12,6 +12,7 @@
 #include "igc_file_writer.h"
 #include <cstdio>
 #include <cassert>
+#include <algorithm>
 
 namespace {
   // return c if valid char for IGC files
@@ -25,10 +26,11 @@ namespace {
     return ' ';
   }
 
-  void write_g_record(FILE *stream, const MD5_Base &md5) {
-    // we made copy to allow to continue to update hash after Final call.
-    MD5 md5_tmp(md5);
-    std::string digest = md5_tmp.Final();
+  bool is_eol(char c) {
+    return c == 0x0D || c == 0x0A;
+  }
+
+  void write_g_record(FILE *stream, const std::string& digest) {
     if (digest.size() >= 32) {
       fwrite("G", 1, 1, stream);
       fwrite(digest.data(), 1, 16, stream);
@@ -39,48 +41,261 @@ namespace {
   }
 } // namespace
 
-igc_file_writer::igc_file_writer(const TCHAR *file, bool grecord)
-    : file_path(file), add_grecord(grecord) {
+igc_file_writer::igc_file_writer(const TCHAR *file, bool grecord, unsigned interval)
+    : file_path(file), add_grecord(grecord), grecord_interval(std::max(1U, interval)) {
 
 }
 
+igc_file_writer::~igc_file_writer() {
+  flush();
+}
 
 bool igc_file_writer::append(const char *data, size_t size) {
 
-  FILE *stream = _tfopen(file_path.c_str(), _T("rb+"));
+  const size_t first = pending.size();
+  for (; *(data) && size > 1; ++data, --size) {
+    if (!is_eol(*data)) {
+      pending.push_back(clean_igc_char(*data));
+    } else {
+      pending.push_back(*data);
+    }
+  }
+
+  if (add_grecord) {
+    // <CR><LF> are not part of G record, hash each part of record between them
+    auto it = std::next(pending.begin(), first);
+    while (it != pending.end()) {
+      auto next = std::find_if(it, pending.end(), is_eol);
+      const size_t count = std::distance(it, next);
+      md5.Update(&(*it), count);
+      it = std::find_if_not(next, pending.end(), is_eol);
+    }
+  }
+
+  if (++pending_records < grecord_interval) {
+    return true;
+  }
+  return flush();
+}
+
+bool igc_file_writer::flush() {
+  if (pending_records == 0) {
+    return true; // nothing appended since last flush
+  }
+
   if (!stream) {
-    stream = _tfopen(file_path.c_str(), _T("wb"));
+    stream.reset(_tfopen(file_path.c_str(), _T("rb+")));
+    if (!stream) {
+      stream.reset(_tfopen(file_path.c_str(), _T("wb")));
+    }
   }
   assert(stream); // invalid file path or missing right on target directory ?
-  if (stream) {
-    fseek(stream, next_record_position, SEEK_SET);
+  if (!stream) {
+    return false;
+  }
+
+  // overwrite previous G record
+  fseek(stream.get(), next_record_position, SEEK_SET);
+  fwrite(pending.data(), 1, pending.size(), stream.get());
+  next_record_position += pending.size();
+
+  pending.clear();
+  pending_records = 0;
+
+  if (add_grecord) {
+    // Final() don't change hash state, so we can continue to update it.
+    for (const auto& digest : md5.Final()) {
+      write_g_record(stream.get(), digest);
+    }
+  }
+  return (fflush(stream.get()) == 0) && !ferror(stream.get());
+}
 
-    for (; *(data) && size > 1; ++data, --size) {
-      if ((*data) != 0x0D && (*data) != 0x0A) {
-        char c = clean_igc_char(*data);
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <cstring>
+#include "utils/filesystem.h"
+#include "Time/PeriodClock.hpp"
+#include "md5.h"
+
+namespace {
+
+  constexpr size_t MAX_IGC_BUFF = 80;
+
+  void write_g_record(FILE *stream, const MD5_Base &md5) {
+    // we made copy to allow to continue to update hash after Final call.
+    MD5 md5_tmp(md5);
+    write_g_record(stream, md5_tmp.Final());
+  }
+
+  // previous implementation : reopen file and rewrite G record for each record
+  class legacy_igc_file_writer final {
+  public:
+    legacy_igc_file_writer(const TCHAR *file, bool grecord)
+        : file_path(file), add_grecord(grecord) {}
+
+    bool append(const char *data, size_t size) {
+      FILE *stream = _tfopen(file_path.c_str(), _T("rb+"));
+      if (!stream) {
+        stream = _tfopen(file_path.c_str(), _T("wb"));
+      }
+      if (stream) {
+        fseek(stream, next_record_position, SEEK_SET);
+
+        for (; *(data) && size > 1; ++data, --size) {
+          if ((*data) != 0x0D && (*data) != 0x0A) {
+            char c = clean_igc_char(*data);
+
+            if (add_grecord) {
+              md5_a.Update(c);
+              md5_b.Update(c);
+              md5_c.Update(c);
+              md5_d.Update(c);
+            }
+            fwrite(&c, 1, 1, stream);
+          } else {
+            fwrite(data, 1, 1, stream);
+          }
+        }
+
+        next_record_position = ftell(stream);
 
         if (add_grecord) {
-          md5_a.Update(c);
-          md5_b.Update(c);
-          md5_c.Update(c);
-          md5_d.Update(c);
+          write_g_record(stream, md5_a);
+          write_g_record(stream, md5_b);
+          write_g_record(stream, md5_c);
+          write_g_record(stream, md5_d);
         }
-        fwrite(&c, 1, 1, stream);
-      } else {
-        fwrite(data, 1, 1, stream);
+        fclose(stream);
+        return true;
       }
+      return false;
     }
 
-    next_record_position = ftell(stream);
+  private:
+    const tstring file_path;
+    const bool add_grecord;
+
+    long next_record_position = 0;
 
-    if (add_grecord) {
-      write_g_record(stream, md5_a);
-      write_g_record(stream, md5_b);
-      write_g_record(stream, md5_c);
-      write_g_record(stream, md5_d);
+    MD5_Base md5_a = {0x63e54c01, 0x25adab89, 0x44baecfe, 0x60f25476};
+    MD5_Base md5_b = {0x41e24d03, 0x23b8ebea, 0x4a4bfc9e, 0x640ed89a};
+    MD5_Base md5_c = {0x61e54e01, 0x22cdab89, 0x48b20cfe, 0x62125476};
+    MD5_Base md5_d = {0xc1e84fe8, 0x21d1c28a, 0x438e1a12, 0x6c250aee};
+  };
+
+  std::string read_file(const TCHAR* path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+
+  std::vector<std::string> igc_records(size_t fix_count) {
+    std::vector<std::string> records = {
+      "ALKT001\r\n",
+      "HFDTE150624\r\n",
+      "HFPLTPILOTINCHARGE:J$hn*Doe,~^!\\\r\n", // invalid char
+      "HFGTYGLIDERTYPE:\x01\x7F\xE9LS8\r\n",
+      "LPLTTASK\rCR\nONLY\r\n",
+      "I023638FXA3940SIU\r\n",
+    };
+    char record[64];
+    for (size_t i = 0; i < fix_count; ++i) {
+      sprintf(record, "B%02u%02u%02u4551%03uN00612%03uEA%05u%05u\r\n",
+              unsigned(10 + i / 3600), unsigned((i / 60) % 60), unsigned(i % 60),
+              unsigned(i % 1000), unsigned((i * 7) % 1000), unsigned(1000 + i % 500), unsigned(1100 + i % 500));
+      records.emplace_back(record);
     }
-    fclose(stream);
-    return true;
+    return records;
   }
-  return false;
+
+} // namespace
+
+TEST_CASE("igc file writer") {
+
+  const TCHAR* legacy_path = _T("igc_writer_test_legacy.igc");
+  const TCHAR* path = _T("igc_writer_test.igc");
+
+  const std::vector<std::string> records = igc_records(100);
+
+  for (bool grecord : { true, false }) {
+    for (unsigned interval : { 1U, 7U }) {
+      lk::filesystem::deleteFile(legacy_path);
+      lk::filesystem::deleteFile(path);
+
+      std::vector<std::string> legacy_content;
+      {
+        legacy_igc_file_writer legacy(legacy_path, grecord);
+        for (const auto& record : records) {
+          legacy.append(record.c_str(), record.size() + 1);
+          legacy_content.push_back(read_file(legacy_path));
+        }
+      }
+
+      {
+        igc_file_writer writer(path, grecord, interval);
+        for (size_t i = 0; i < records.size(); ++i) {
+          char record[MAX_IGC_BUFF];
+          strcpy(record, records[i].c_str());
+          CHECK(writer.append(record));
+          if (((i + 1) % interval) == 0) {
+            // file on disk is same as legacy after same number of records
+            CHECK(read_file(path) == legacy_content[i]);
+          } else if (i >= interval) {
+            // pending records are not yet written, file is still valid.
+            CHECK(read_file(path) == legacy_content[i - ((i + 1) % interval)]);
+          }
+        }
+      }
+      CHECK(read_file(path) == legacy_content.back());
+    }
+  }
+
+  lk::filesystem::deleteFile(legacy_path);
+  lk::filesystem::deleteFile(path);
+}
+
+// not run by default, use '--test-case="igc file writer benchmark" --no-skip'
+TEST_CASE("igc file writer benchmark" * doctest::skip()) {
+
+  const TCHAR* path = _T("igc_writer_benchmark.igc");
+  const std::vector<std::string> records = igc_records(3600); // 1 hour at 1s
+
+  PeriodClock clock;
+
+  lk::filesystem::deleteFile(path);
+  clock.Update();
+  {
+    legacy_igc_file_writer legacy(path, true);
+    for (const auto& record : records) {
+      legacy.append(record.c_str(), record.size() + 1);
+    }
+  }
+  const int legacy_ms = clock.Elapsed();
+  const std::string legacy_content = read_file(path);
+
+  int elapsed_ms[2];
+  unsigned intervals[2] = { 1, 5 };
+  for (unsigned i = 0; i < 2; ++i) {
+    lk::filesystem::deleteFile(path);
+    clock.Update();
+    {
+      igc_file_writer writer(path, true, intervals[i]);
+      for (const auto& record : records) {
+        char buff[MAX_IGC_BUFF];
+        strcpy(buff, record.c_str());
+        writer.append(buff);
+      }
+    }
+    elapsed_ms[i] = clock.Elapsed();
+    CHECK(read_file(path) == legacy_content);
+  }
+  lk::filesystem::deleteFile(path);
+
+  MESSAGE(records.size() << " records : legacy " << legacy_ms << "ms, persistent "
+          << elapsed_ms[0] << "ms, persistent + G record every 5 records " << elapsed_ms[1] << "ms");
 }
+
+#endif
@@ -15,7 +15,9 @@
 #include "Compiler.h"
 #include "tchar.h"
 #include "Util/tstring.hpp"
-#include "md5.h"
+#include "utils/md5x4.h"
+#include "utils/unique_file_ptr.h"
+#include <string>
 
 class igc_file_writer final {
 
@@ -28,7 +30,15 @@ class igc_file_writer final {
 
 public:
 
-  igc_file_writer(const TCHAR *file, bool grecord);
+  /**
+   * @param grecord_interval : number of records kept in memory before they are written to file
+   *    with updated G record. the file on disk always ends with G record matching its content,
+   *    but pending records are lost in case of crash.
+   */
+  igc_file_writer(const TCHAR *file, bool grecord, unsigned grecord_interval = 1);
+
+  // write pending records
+  ~igc_file_writer();
 
   template <size_t size> 
   bool append(const char (&data)[size]) {
@@ -36,18 +46,28 @@ public:
     return append(data, size);
   }
 
+  // write pending records and G record, file is kept open.
+  bool flush();
+
 private:
   bool append(const char *data, size_t size);
 
   const tstring file_path; /** full path of target igc file */
   const bool add_grecord; /** true if G record must be added to file */
+  const unsigned grecord_interval;
 
+  unique_file_ptr stream;
   long next_record_position = 0; /** position of G record */
 
-  MD5_Base md5_a = {0x63e54c01, 0x25adab89, 0x44baecfe, 0x60f25476};
-  MD5_Base md5_b = {0x41e24d03, 0x23b8ebea, 0x4a4bfc9e, 0x640ed89a};
-  MD5_Base md5_c = {0x61e54e01, 0x22cdab89, 0x48b20cfe, 0x62125476};
-  MD5_Base md5_d = {0xc1e84fe8, 0x21d1c28a, 0x438e1a12, 0x6c250aee};
+  std::string pending; /** cleaned records not yet written */
+  unsigned pending_records = 0;
+
+  MD5x4 md5 = MD5x4({{
+    {0x63e54c01, 0x25adab89, 0x44baecfe, 0x60f25476},
+    {0x41e24d03, 0x23b8ebea, 0x4a4bfc9e, 0x640ed89a},
+    {0x61e54e01, 0x22cdab89, 0x48b20cfe, 0x62125476},
+    {0xc1e84fe8, 0x21d1c28a, 0x438e1a12, 0x6c250aee}
+  }});
 };
 
 #endif //_LOGGER_IGC_FILE_WRITER_H_
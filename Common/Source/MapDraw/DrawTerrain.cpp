@@ -19,6 +19,7 @@
 #include "Kobo/Model.hpp"
 #include "Util/Clamp.hpp"
 #include "Asset.hpp"
+#include "SlopeShading.h"
 #include <utility>
 #include <type_traits>
 #include <memory>
@@ -168,6 +169,42 @@ inline T TerrainShading(const int16_t illum, const T& color) {
 //
 // Returning from constructor without setting terrain_ready will result in no draw terrain.
 //
+/**
+ * Map projection used to fill height buffer.
+ * x, y : screen coordinate relative to map origin.
+ */
+struct TerrainProjection {
+    double pan_latitude;
+    double pan_longitude;
+    double inv_draw_scale;
+    int cost;
+    int sint;
+    int x0; // screen position of height buffer pixel (0,0)
+    int y0;
+
+    bool SameScaleAndAngle(const TerrainProjection& other) const {
+        return inv_draw_scale == other.inv_draw_scale && cost == other.cost && sint == other.sint;
+    }
+
+    GeoPoint ToGeoPoint(double x, double y) const {
+        const double ac2 = sint * inv_draw_scale;
+        const double ac3 = cost * inv_draw_scale;
+        const double Y = pan_latitude - y * ac3 - x * ac2;
+        return { Y, pan_longitude + invfastcosine(Y) * ((x * ac3) - y * ac2) };
+    }
+
+    // inverse of ToGeoPoint()
+    void ToScreen(const GeoPoint& pt, double& x, double& y) const {
+        const double ac2 = sint * inv_draw_scale;
+        const double ac3 = cost * inv_draw_scale;
+        const double u = (pt.longitude - pan_longitude) / invfastcosine(pt.latitude);
+        const double v = pan_latitude - pt.latitude;
+        const double det = ac2 * ac2 + ac3 * ac3;
+        x = (u * ac3 + v * ac2) / det;
+        y = (v * ac3 - u * ac2) / det;
+    }
+};
+
 class TerrainRenderer {
     TerrainRenderer(const TerrainRenderer &) = delete; // disallowed
     TerrainRenderer &operator=(const TerrainRenderer &) = delete; // disallowed
@@ -215,6 +252,9 @@ public:
             const size_t iys = screen_buffer->GetHeight();
 
             height_buffer = std::make_unique<CSTHeightBuffer>(ixs, iys);
+#if !((defined(__ARM_NEON) || defined(__ARM_NEON__)) && !GCC_OLDER_THAN(5,0))
+            color_index = std::make_unique<uint16_t[]>(ixs * iys);
+#endif
 
             auto_brightness = 218;
 
@@ -227,6 +267,9 @@ public:
 
             screen_buffer = nullptr;
             height_buffer = nullptr;
+#if !((defined(__ARM_NEON) || defined(__ARM_NEON__)) && !GCC_OLDER_THAN(5,0))
+            color_index = nullptr;
+#endif
 
             const tstring error = to_tstring(e.what());
             StartupStore(_T("TerrainRenderer : %s"), error.c_str());
@@ -270,6 +313,12 @@ private:
     std::unique_ptr<int16_t[]> prev_iso_band;
     std::unique_ptr<int16_t[]> current_iso_band;
 
+#if !((defined(__ARM_NEON) || defined(__ARM_NEON__)) && !GCC_OLDER_THAN(5,0))
+    // color_table index computed by Slope_shading()
+    std::unique_ptr<uint16_t[]> color_index;
+    const SlopeShadingKernel slope_shading_kernel = GetSlopeShadingKernel();
+#endif
+
     BGRColor color_table[128][256] = {};
 
     const COLORRAMP (*color_ramp)[NUM_COLOR_RAMP_LEVELS] = {};
@@ -282,6 +331,12 @@ private:
     int16_t height_min; // lower height visible terrain
     int16_t height_max; // highter height visible terrain
 
+    // used to reuse height buffer content, see UpdateHeightBuffer()
+    TerrainSampler height_sampler;
+    TerrainProjection height_projection;
+    int shift_x = 0;
+    int shift_y = 0;
+
     short auto_brightness;
 
 public:
@@ -310,14 +365,6 @@ public:
     void Height(const RasterPoint& offset, const ScreenProjection& _Proj) {
         assert(height_buffer && height_buffer->GetBuffer());
 
-        ScopeLock Lock(RasterTerrain::mutex);
-
-        RasterMap* DisplayMap = RasterTerrain::TerrainMap.get();
-        assert(DisplayMap && DisplayMap->isMapLoaded());
-        if(!DisplayMap || !DisplayMap->isMapLoaded()) {
-            return;
-        }
-
         const int X0 = dtquant / 2;
         const int Y0 = dtquant / 2;
         const int X1 = X0 + dtquant * height_buffer->GetWidth();
@@ -337,78 +384,196 @@ public:
 
         pixelsize_d = GeoCenter.Distance(GeoNearby) / 2.0;
 
-        // set resolution
-        DisplayMap->SetFieldRounding(std::abs(GeoCenter.longitude - GeoNearby.longitude)/3,
-                                     std::abs(GeoCenter.latitude - GeoNearby.latitude)/3);
+        // set resolution, sampler is used without lock : calc thread can query terrain while we fill the buffer.
+        const TerrainSampler Sampler = RasterTerrain::GetSampler(
+                                            std::abs(GeoCenter.longitude - GeoNearby.longitude)/3,
+                                            std::abs(GeoCenter.latitude - GeoNearby.latitude)/3);
+        assert(Sampler.IsValid());
+        if(!Sampler.IsValid()) {
+            return;
+        }
 
-        epx = DisplayMap->GetEffectivePixelSize(&pixelsize_d, GeoCenter.latitude, GeoCenter.longitude);
+        epx = Sampler.GetMap()->GetEffectivePixelSize(&pixelsize_d, GeoCenter.latitude, GeoCenter.longitude);
         epx = std::max(4u, (epx / 4u ) * 4u); // "epx" must be divisible by 4 for compatibility with ARM NEON vectorized shadding algorithm
 
-        RasterPoint orig = RasterPoint(MapWindow::GetOrigScreen()) - offset;
+        const RasterPoint orig = RasterPoint(MapWindow::GetOrigScreen()) - offset;
+        const double DisplayAngle = MapWindow::GetDisplayAngle();
 
-        if(DisplayMap->interpolate()) {
+        const TerrainProjection proj = {
+            MapWindow::GetPanLatitude(),
+            MapWindow::GetPanLongitude(),
+            MapWindow::GetAlternateDrawScale() / 1024.0,
+            ifastcosine(DisplayAngle),
+            ifastsine(DisplayAngle),
+            X0 - orig.x,
+            Y0 - orig.y
+        };
 
-            FillHeightBuffer(X0 - orig.x, Y0 - orig.y, X1 - orig.x, Y1 - orig.y,
-                    [DisplayMap](const double &lat, const double &lon) {
-                        return DisplayMap->GetFieldInterpolate(lat,lon);
+        if(Sampler.interpolate()) {
+            UpdateHeightBuffer(proj, Sampler,
+                    [&Sampler](const double &lat, const double &lon) {
+                        return Sampler.GetFieldInterpolate(lat,lon);
                     });
         } else {
-
-            FillHeightBuffer(X0 - orig.x, Y0 - orig.y, X1 - orig.x, Y1 - orig.y,
-                    [DisplayMap](const double &lat, const double &lon) {
-                          return DisplayMap->GetFieldFine(lat,lon);
+            UpdateHeightBuffer(proj, Sampler,
+                    [&Sampler](const double &lat, const double &lon) {
+                          return Sampler.GetFieldFine(lat,lon);
                     });
         }
+        UpdateHeightRange();
     }
 
+private:
     /**
-     * Attention ! never call this without check if map is loaded.
+     * Height buffer content is always the terrain sampled on the grid of <height_projection>,
+     * buffer pixel (ix, iy) is grid pixel (ix + shift_x, iy + shift_y).
      *
-     * template avoid to test if interpolation is needed for each pixel.
+     * If scale and angle are unchanged, and all height buffer corners are less than
+     * half a pixel from a grid pixel, buffer is scrolled and only newly exposed
+     * strips are sampled, otherwise the grid is reset to current projection.
      */
     template<typename GetHeight_t>
-    void FillHeightBuffer(const int X0, const int Y0, const int X1, const int Y1, GetHeight_t GetHeight) {
-        // fill the buffer
-        assert(height_buffer && height_buffer->GetBuffer());
+    void UpdateHeightBuffer(const TerrainProjection& proj, const TerrainSampler& sampler, GetHeight_t GetHeight) {
+        const size_t col_count = height_buffer->GetWidth();
+        const size_t row_count = height_buffer->GetHeight();
 
-        const double PanLatitude = MapWindow::GetPanLatitude();
-        const double PanLongitude = MapWindow::GetPanLongitude();
-        const double InvDrawScale = MapWindow::GetAlternateDrawScale() / 1024.0;
-        const double DisplayAngle = MapWindow::GetDisplayAngle();
+        int dx, dy;
+        if (height_sampler.GetMap() == sampler.GetMap()
+                && height_sampler.interpolate() == sampler.interpolate()
+                && GetGridShift(proj, dx, dy)) {
+
+            const int scroll_x = dx - shift_x;
+            const int scroll_y = dy - shift_y;
+            shift_x = dx;
+            shift_y = dy;
+
+            if (static_cast<size_t>(std::abs(scroll_x)) < col_count && static_cast<size_t>(std::abs(scroll_y)) < row_count) {
+                ScrollHeightBuffer(scroll_x, scroll_y);
+
+                // newly exposed rows
+                const size_t first_row = (scroll_y < 0) ? -scroll_y : 0;
+                const size_t last_row = (scroll_y > 0) ? row_count - scroll_y : row_count;
+                FillHeightBuffer(0, col_count, 0, first_row, GetHeight);
+                FillHeightBuffer(0, col_count, last_row, row_count, GetHeight);
+
+                // newly exposed columns
+                if (scroll_x < 0) {
+                    FillHeightBuffer(0, -scroll_x, first_row, last_row, GetHeight);
+                } else if (scroll_x > 0) {
+                    FillHeightBuffer(col_count - scroll_x, col_count, first_row, last_row, GetHeight);
+                }
+                return;
+            }
+        } else {
+            height_projection = proj;
+            shift_x = 0;
+            shift_y = 0;
+        }
 
-        const int cost = ifastcosine(DisplayAngle);
-        const int sint = ifastsine(DisplayAngle);
+        height_sampler = sampler;
+        FillHeightBuffer(0, col_count, 0, row_count, GetHeight);
+    }
 
-        const double ac2 = sint*InvDrawScale;
-        const double ac3 = cost*InvDrawScale;
+    /**
+     * @return false if height buffer grid can't be reused for <proj>
+     */
+    bool GetGridShift(const TerrainProjection& proj, int& dx, int& dy) const {
+        if (!height_sampler.IsValid() || !proj.SameScaleAndAngle(height_projection)) {
+            return false;
+        }
 
-        height_scale = 0;
+        const double last_col = height_buffer->GetWidth() - 1;
+        const double last_row = height_buffer->GetHeight() - 1;
+        const std::pair<double, double> corners[] = {
+            { 0., 0. }, { last_col, 0. }, { 0., last_row }, { last_col, last_row }
+        };
 
-        // we need local variable for compatibility with all implementation of opemmp reduction
-        int16_t _height_min = std::numeric_limits<int16_t>::max();
-        int16_t _height_max = std::numeric_limits<int16_t>::min();
+        bool first = true;
+        for (const auto& corner : corners) {
+            const GeoPoint pt = proj.ToGeoPoint(proj.x0 + corner.first * dtquant,
+                                                proj.y0 + corner.second * dtquant);
+            double x, y;
+            height_projection.ToScreen(pt, x, y);
+
+            // distance in pixel between the corner and the same point on the grid
+            const double corner_dx = (x - height_projection.x0) / dtquant - corner.first;
+            const double corner_dy = (y - height_projection.y0) / dtquant - corner.second;
+            if (first) {
+                dx = iround(corner_dx);
+                dy = iround(corner_dy);
+                first = false;
+            }
+            if (std::abs(corner_dx - dx) > 0.5 || std::abs(corner_dy - dy) > 0.5) {
+                return false;
+            }
+        }
+        return true;
+    }
 
+    /**
+     * new pixel (ix, iy) = old pixel (ix + dx, iy + dy)
+     */
+    void ScrollHeightBuffer(int dx, int dy) {
         const size_t col_count = height_buffer->GetWidth();
         const size_t row_count = height_buffer->GetHeight();
 
+        const size_t copy_size = (col_count - std::abs(dx)) * sizeof(int16_t);
+        const size_t src_col = std::max(dx, 0);
+        const size_t dst_col = std::max(-dx, 0);
+
+        auto scroll_row = [&](size_t iy) {
+            memmove(height_buffer->GetRow(iy) + dst_col, height_buffer->GetRow(iy + dy) + src_col, copy_size);
+        };
+
+        if (dy > 0) {
+            for (size_t iy = 0; iy < row_count - dy; ++iy) {
+                scroll_row(iy);
+            }
+        } else {
+            for (size_t iy = row_count; iy-- > static_cast<size_t>(-dy); ) {
+                scroll_row(iy);
+            }
+        }
+    }
+
+    /**
+     * fill [col_begin, col_end[ x [row_begin, row_end[ rectangle of height buffer
+     *
+     * Attention ! never call this without check if map is loaded.
+     *
+     * template avoid to test if interpolation is needed for each pixel.
+     */
+    template<typename GetHeight_t>
+    void FillHeightBuffer(size_t col_begin, size_t col_end, size_t row_begin, size_t row_end, GetHeight_t GetHeight) {
+        // fill the buffer
+        assert(height_buffer && height_buffer->GetBuffer());
+
+        const TerrainProjection& proj = height_projection;
+        const double PanLatitude = proj.pan_latitude;
+        const double PanLongitude = proj.pan_longitude;
+
+        const double ac2 = proj.sint * proj.inv_draw_scale;
+        const double ac3 = proj.cost * proj.inv_draw_scale;
+
+        const int X0 = proj.x0 + shift_x * static_cast<int>(dtquant);
+        const int Y0 = proj.y0 + shift_y * static_cast<int>(dtquant);
 
 #if defined(_OPENMP)
-        #pragma omp parallel for reduction(max : _height_max) reduction(min : _height_min)
+        #pragma omp parallel for
 #endif
-        for (size_t iy = 0; iy < row_count; ++iy) {
+        for (size_t iy = row_begin; iy < row_end; ++iy) {
             const int y = Y0 + (iy*dtquant);
             const double ac1 = PanLatitude - y*ac3;
             const double cc1 = y * ac2;
 
             int16_t *height_row = height_buffer->GetRow(iy);
 
-            for (size_t ix = 0; ix < col_count; ++ix) {
+            const auto batch = height_sampler.Batch();
+            for (size_t ix = col_begin; ix < col_end; ++ix) {
                 const int x = X0 + (ix*dtquant);
                 const double Y = ac1 - x*ac2;
                 const double X = PanLongitude + (invfastcosine(Y) * ((x * ac3) - cc1));
 
-                int16_t& hDst = height_row[ix];
-
                 /*
                  * Terrain height can be negative.
                  * do not clip height to 0 here, otherwise all height below 0
@@ -416,11 +581,31 @@ public:
                  *
                  * all height will be sifted by #height_min in #TerrainRenderer::Slope method for ColorRamp lookup.
                  */
-                hDst = GetHeight(Y, X);
+                height_row[ix] = GetHeight(Y, X);
+            }
+        }
+    }
+
+    void UpdateHeightRange() {
+        height_scale = 0;
+
+        // we need local variable for compatibility with all implementation of opemmp reduction
+        int16_t _height_min = std::numeric_limits<int16_t>::max();
+        int16_t _height_max = std::numeric_limits<int16_t>::min();
 
-                if(hDst != TERRAIN_INVALID) {
-                  _height_min = std::min(_height_min, hDst);
-                  _height_max = std::max(_height_max, hDst);
+        const size_t col_count = height_buffer->GetWidth();
+        const size_t row_count = height_buffer->GetHeight();
+
+#if defined(_OPENMP)
+        #pragma omp parallel for reduction(max : _height_max) reduction(min : _height_min)
+#endif
+        for (size_t iy = 0; iy < row_count; ++iy) {
+            const int16_t *height_row = height_buffer->GetRow(iy);
+            for (size_t ix = 0; ix < col_count; ++ix) {
+                const int16_t h = height_row[ix];
+                if(h != TERRAIN_INVALID) {
+                  _height_min = std::min(_height_min, h);
+                  _height_max = std::max(_height_max, h);
                 }
             }
         }
@@ -450,6 +635,7 @@ public:
         }
     }
 
+public:
 
 #if (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !GCC_OLDER_THAN(5,0)
 
@@ -689,61 +875,39 @@ public:
     void Slope_shading(const int sx, const int sy, const int sz) {
         assert(height_buffer && height_buffer->GetBuffer());
         assert(screen_buffer && screen_buffer->GetBuffer());
-
-        const int hscale = std::max<int>(1, pixelsize_d);
+        assert(color_index);
 
         const size_t ixs = height_buffer->GetWidth();
         const size_t iys = height_buffer->GetHeight();
 
+        const SlopeShadingParams params = {
+            sx, sy, sz, epx, std::max<int>(1, pixelsize_d), height_min, height_scale
+        };
+
+        const BGRColor* colors = &color_table[0][0];
+
 #if defined(_OPENMP)
         #pragma omp parallel for
 #endif
         for(size_t y = 0; y < iys; y++) {
             BGRColor* screen_row = screen_buffer->GetRow(y);
+            uint16_t* index_row = color_index.get() + (y * ixs);
 
             const unsigned prev_row_index =  (y < epx) ? 0 : y - epx;
             const unsigned next_row_index =  (y + epx >= iys) ? iys - 1 : y + epx;
 
-            const int16_t* prev_row = height_buffer->GetRow(prev_row_index);
-            const int16_t* curr_row = height_buffer->GetRow(y);
-            const int16_t* next_row = height_buffer->GetRow(next_row_index);
+            const SlopeShadingRow row = {
+                height_buffer->GetRow(prev_row_index),
+                height_buffer->GetRow(y),
+                height_buffer->GetRow(next_row_index),
+                ixs,
+                static_cast<float>(next_row_index - prev_row_index)
+            };
 
-            const float p31 = next_row_index - prev_row_index;
-            const float p31s = p31 * hscale;
+            slope_shading_kernel(params, row, index_row);
 
             for (size_t x = 0; x < ixs; ++x) {
-                const size_t prev_col_index =  (x < epx) ? 0 : x - epx;
-                const size_t next_col_index =  (x + epx >= ixs) ? ixs - 1 : x + epx;
-
-                const int16_t& up =     prev_row[x];
-                const int16_t& bottom = next_row[x];
-                const int16_t& left =   curr_row[prev_col_index];
-                const int16_t& right =  curr_row[next_col_index];
-
-                const int32_t p20 = next_col_index - prev_col_index;
-                const int32_t p22 = right - left;
-                const int32_t p32 = bottom - up;
-
-                int32_t dd0 = p22 * p31;
-                int32_t dd1 = p20 * p32;
-                int32_t dd2 = p20 * p31s;
-
-                // prevent overflow of magnitude calculation
-                const int32_t scale = (dd2 / 512) + 1;
-                dd0 /= scale;
-                dd1 /= scale;
-                dd2 /= scale;
-
-                const uint32_t sqr_mag = (dd0 * dd0 + dd1 * dd1 + dd2 * dd2);
-                int32_t mag = (dd2 * sz + dd0 * sx + dd1 * sy) / (isqrt4(sqr_mag)|1);
-                mag = Clamp<int32_t>((mag - sz), -64, 63);
-
-                // when h is invalid, result is clamped to 255 so we have invalid terrain color
-                int16_t h =  *(curr_row + x);
-                h = ((h - height_min) >> height_scale);
-                h = Clamp<int16_t>(h, 0, 255);
-
-                screen_row[x] = GetColor(h, mag);
+                screen_row[x] = colors[index_row[x]];
             }
         }
     }
@@ -1206,6 +1370,37 @@ TEST_SUITE("Terrain renderer") {
             }
         }
     }
+
+    TEST_CASE("terrain projection") {
+        InitSineTable();
+
+        for (double angle : { 0., 35., 200. }) {
+            const TerrainProjection proj = {
+                45.5, 6.2, 0.00002, ifastcosine(angle), ifastsine(angle), -160, -120
+            };
+            for (int y = -120; y < 120; y += 7) {
+                for (int x = -160; x < 160; x += 11) {
+                    const GeoPoint pt = proj.ToGeoPoint(x, y);
+                    double sx, sy;
+                    proj.ToScreen(pt, sx, sy);
+                    CHECK_LT(std::abs(sx - x), 1e-6);
+                    CHECK_LT(std::abs(sy - y), 1e-6);
+                }
+            }
+        }
+
+        SUBCASE("north up pan") {
+            // pan 3 pixels to the north : same grid shifted by 3 rows
+            const TerrainProjection proj = { 45.5, 6.2, 0.00002, 1024, 0, -160, -120 };
+            TerrainProjection moved = proj;
+            moved.pan_latitude += 3 * 1024 * proj.inv_draw_scale;
+
+            double sx, sy;
+            proj.ToScreen(moved.ToGeoPoint(10, 20), sx, sy);
+            CHECK_LT(std::abs(sx - 10), 1e-6);
+            CHECK_LT(std::abs(sy - 17), 1e-6);
+        }
+    }
 }
 
 #endif
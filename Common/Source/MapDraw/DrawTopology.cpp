@@ -18,10 +18,11 @@ void DrawTopology(LKSurface& Surface, const RECT& rc, const ScreenProjection& _P
 {
   LockTerrainDataGraphics();
   static ShapeSpecialRenderer renderer;
-  for(const Topology* topo: TopoStore) {
+  for(Topology* topo: TopoStore) {
     if(!topo) {
       continue;
     }
+    topo->ApplyPendingCache();
     if(!wateronly || topo->scaleCategory == 5 || topo->scaleCategory == 10 || topo->scaleCategory == 20) {
       topo->Paint(renderer, Surface,rc, _Proj);
     }
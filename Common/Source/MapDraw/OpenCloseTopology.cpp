@@ -265,6 +265,9 @@ void OpenTopology() {
 
   UnlockTerrainDataGraphics();
 
+  if (numtopo > 0) {
+    TopologyLoader::Start();
+  }
 }
 
 
@@ -275,6 +278,8 @@ void CloseTopology() {
   StartupStore(TEXT(". CloseTopology%s"),NEWLINE);
   #endif
 
+  TopologyLoader::Stop();
+
   LockTerrainDataGraphics();
   std::for_each(std::begin(TopoStore), std::end(TopoStore), safe_delete());
   UnlockTerrainDataGraphics();
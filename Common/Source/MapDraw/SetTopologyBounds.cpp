@@ -32,7 +32,7 @@ bool RectangleIsInside(rectObj r_exterior, rectObj r_interior) {
 //
 // This is called FORCED when changing multimap
 //
-void SetTopologyBounds(const RECT& rcin, const ScreenProjection& _Proj, const bool force) {
+void SetTopologyBounds(const RECT& rcin, const ScreenProjection& _Proj, const bool force, const vectorObj* track) {
   static rectObj bounds_active;
   static double range_active = 1.0;
   bool unchanged=false;
@@ -133,6 +133,20 @@ void SetTopologyBounds(const RECT& rcin, const ScreenProjection& _Proj, const bo
     }
   }
 
+    // area ahead along track, shifted by half of active area.
+    // it's loaded in advance by TopologyLoader thread.
+    rectObj bounds_ahead = bounds_active;
+    const rectObj* prefetch = nullptr;
+    const double track_dist = track ? std::hypot(track->x, track->y) : 0;
+    if (track_dist > 0) {
+      const double shift = range_active / 2 / track_dist;
+      bounds_ahead.minx += track->x * shift;
+      bounds_ahead.maxx += track->x * shift;
+      bounds_ahead.miny += track->y * shift;
+      bounds_ahead.maxy += track->y * shift;
+      prefetch = &bounds_ahead;
+    }
+
     // check if any needs to have cache updates because wasnt
     // visible previously when bounds moved
     bool sneaked = false;
@@ -147,7 +161,7 @@ void SetTopologyBounds(const RECT& rcin, const ScreenProjection& _Proj, const bo
             if (TopoStore[z]->triggerUpdateCache) {
                 sneaked = true;
             }
-            TopoStore[z]->updateCache(bounds_active, !rta);
+            TopoStore[z]->updateCache(bounds_active, !rta, prefetch);
         }
     }
 }
@@ -0,0 +1,459 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   SlopeShading.cpp
+ */
+
+#include "externs.h"
+#include "SlopeShading.h"
+#include "Util/Clamp.hpp"
+#include <algorithm>
+
+#ifdef HAVE_SLOPE_SHADING_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * JMW: if zoomed right in (e.g. one unit is larger than terrain
+ * grid), then increase the step size to be equal to the terrain
+ * grid for purposes of calculating slope, to avoid shading problems
+ * (gridding of display) This is why epx is used instead of 1
+ * previously.  for large zoom levels, epx=1
+ */
+inline uint16_t ShadePixel(const SlopeShadingParams& params, const SlopeShadingRow& row, const float p31s, size_t x) {
+    const size_t prev_col_index =  (x < params.epx) ? 0 : x - params.epx;
+    const size_t next_col_index =  (x + params.epx >= row.width) ? row.width - 1 : x + params.epx;
+
+    const int16_t& up =     row.prev[x];
+    const int16_t& bottom = row.next[x];
+    const int16_t& left =   row.curr[prev_col_index];
+    const int16_t& right =  row.curr[next_col_index];
+
+    const int32_t p20 = next_col_index - prev_col_index;
+    const int32_t p22 = right - left;
+    const int32_t p32 = bottom - up;
+
+    int32_t dd0 = p22 * row.p31;
+    int32_t dd1 = p20 * p32;
+    int32_t dd2 = p20 * p31s;
+
+    // prevent overflow of magnitude calculation
+    const int32_t scale = (dd2 / 512) + 1;
+    dd0 /= scale;
+    dd1 /= scale;
+    dd2 /= scale;
+
+    // near invalid terrain, squares can overflow : use unsigned arithmetic to
+    // have well defined wrap around, same as vectorized kernels.
+    const uint32_t sqr_mag = (uint32_t(dd0) * dd0 + uint32_t(dd1) * dd1 + uint32_t(dd2) * dd2);
+    const uint32_t num = (uint32_t(dd2) * params.sz + uint32_t(dd0) * params.sx + uint32_t(dd1) * params.sy);
+    int32_t mag = num / (isqrt4(sqr_mag)|1);
+    mag = Clamp<int32_t>((mag - params.sz), -64, 63);
+
+    // when h is invalid, result is clamped to 255 so we have invalid terrain color
+    int16_t h =  row.curr[x];
+    h = ((h - params.height_min) >> params.height_scale);
+    h = Clamp<int16_t>(h, 0, 255);
+
+    return ((mag + 64) << 8) + h;
+}
+
+/**
+ * Vectorized kernels only process pixels with x in [epx, width - epx[,
+ * border pixels use ShadePixel().
+ *
+ * Integer divisions are done in double precision : for 32bit integer, quotient
+ * truncated to integer is exactly the same as integer division.
+ * uint32 -> float conversion is done in 2 parts of 16bit to get the same rounding
+ * as scalar conversion.
+ */
+
+#ifdef HAVE_SLOPE_SHADING_X86
+
+__attribute__((target("sse4.1")))
+inline __m128i Load4(const int16_t* src) {
+    return _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src)));
+}
+
+// signed a / b
+__attribute__((target("sse4.1")))
+inline __m128i DivEpi32(__m128i a, __m128d b) {
+    const __m128d lo = _mm_div_pd(_mm_cvtepi32_pd(a), b);
+    const __m128d hi = _mm_div_pd(_mm_cvtepi32_pd(_mm_unpackhi_epi64(a, a)), b);
+    return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+}
+
+__attribute__((target("sse4.1")))
+inline __m128d CvtEpu32Pd(__m128i a) {
+    const __m128d d = _mm_cvtepi32_pd(a);
+    const __m128d neg = _mm_cmplt_pd(d, _mm_setzero_pd());
+    return _mm_add_pd(d, _mm_and_pd(neg, _mm_set1_pd(4294967296.)));
+}
+
+// unsigned a / b
+__attribute__((target("sse4.1")))
+inline __m128i DivEpu32(__m128i a, __m128i b) {
+    const __m128d offset = _mm_set1_pd(2147483648.);
+    const __m128d lo = _mm_floor_pd(_mm_div_pd(CvtEpu32Pd(a), CvtEpu32Pd(b)));
+    const __m128d hi = _mm_floor_pd(_mm_div_pd(CvtEpu32Pd(_mm_unpackhi_epi64(a, a)),
+                                               CvtEpu32Pd(_mm_unpackhi_epi64(b, b))));
+    const __m128i q = _mm_unpacklo_epi64(_mm_cvttpd_epi32(_mm_sub_pd(lo, offset)),
+                                         _mm_cvttpd_epi32(_mm_sub_pd(hi, offset)));
+    return _mm_xor_si128(q, _mm_set1_epi32(0x80000000));
+}
+
+// (float)a for unsigned a
+__attribute__((target("sse4.1")))
+inline __m128 CvtEpu32Ps(__m128i a) {
+    const __m128 hi = _mm_cvtepi32_ps(_mm_srli_epi32(a, 16));
+    const __m128 lo = _mm_cvtepi32_ps(_mm_and_si128(a, _mm_set1_epi32(0xffff)));
+    return _mm_add_ps(_mm_mul_ps(hi, _mm_set1_ps(65536.f)), lo);
+}
+
+__attribute__((target("avx2")))
+inline __m256i Load8(const int16_t* src) {
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+
+__attribute__((target("avx2")))
+inline __m256i Combine(__m128i lo, __m128i hi) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+__attribute__((target("avx2")))
+inline __m256i DivEpi32(__m256i a, __m256d b) {
+    const __m256d lo = _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(a)), b);
+    const __m256d hi = _mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(a, 1)), b);
+    return Combine(_mm256_cvttpd_epi32(lo), _mm256_cvttpd_epi32(hi));
+}
+
+__attribute__((target("avx2")))
+inline __m256d Cvt4Epu32Pd(__m128i a) {
+    const __m256d d = _mm256_cvtepi32_pd(a);
+    const __m256d neg = _mm256_cmp_pd(d, _mm256_setzero_pd(), _CMP_LT_OQ);
+    return _mm256_add_pd(d, _mm256_and_pd(neg, _mm256_set1_pd(4294967296.)));
+}
+
+__attribute__((target("avx2")))
+inline __m256i DivEpu32(__m256i a, __m256i b) {
+    const __m256d offset = _mm256_set1_pd(2147483648.);
+    const __m256d lo = _mm256_floor_pd(_mm256_div_pd(Cvt4Epu32Pd(_mm256_castsi256_si128(a)),
+                                                     Cvt4Epu32Pd(_mm256_castsi256_si128(b))));
+    const __m256d hi = _mm256_floor_pd(_mm256_div_pd(Cvt4Epu32Pd(_mm256_extracti128_si256(a, 1)),
+                                                     Cvt4Epu32Pd(_mm256_extracti128_si256(b, 1))));
+    const __m256i q = Combine(_mm256_cvttpd_epi32(_mm256_sub_pd(lo, offset)),
+                              _mm256_cvttpd_epi32(_mm256_sub_pd(hi, offset)));
+    return _mm256_xor_si256(q, _mm256_set1_epi32(0x80000000));
+}
+
+__attribute__((target("avx2")))
+inline __m256 CvtEpu32Ps(__m256i a) {
+    const __m256 hi = _mm256_cvtepi32_ps(_mm256_srli_epi32(a, 16));
+    const __m256 lo = _mm256_cvtepi32_ps(_mm256_and_si256(a, _mm256_set1_epi32(0xffff)));
+    return _mm256_add_ps(_mm256_mul_ps(hi, _mm256_set1_ps(65536.f)), lo);
+}
+
+#endif // HAVE_SLOPE_SHADING_X86
+
+} // namespace
+
+void SlopeShadingScalar(const SlopeShadingParams& params, const SlopeShadingRow& row, uint16_t* index) {
+    const float p31s = row.p31 * params.hscale;
+    for (size_t x = 0; x < row.width; ++x) {
+        index[x] = ShadePixel(params, row, p31s, x);
+    }
+}
+
+#ifdef HAVE_SLOPE_SHADING_X86
+
+__attribute__((target("sse4.1")))
+void SlopeShadingSSE41(const SlopeShadingParams& params, const SlopeShadingRow& row, uint16_t* index) {
+    const float p31s = row.p31 * params.hscale;
+
+    const size_t first = std::min<size_t>(params.epx, row.width);
+    const size_t last = (row.width > params.epx) ? row.width - params.epx : 0;
+
+    size_t x = 0;
+    for (; x < first; ++x) {
+        index[x] = ShadePixel(params, row, p31s, x);
+    }
+
+    // p20, dd2 and scale are the same for all pixels far enough from the border
+    const int32_t p20 = params.epx + params.epx;
+    int32_t dd2 = p20 * p31s;
+    const int32_t scale = (dd2 / 512) + 1;
+    dd2 /= scale;
+
+    const __m128 v_p31 = _mm_set1_ps(row.p31);
+    const __m128i v_p20 = _mm_set1_epi32(p20);
+    const __m128d v_scale = _mm_set1_pd(scale);
+    const __m128i v_dd2_sqr = _mm_set1_epi32(dd2 * dd2);
+    const __m128i v_dd2_sz = _mm_set1_epi32(dd2 * params.sz);
+    const __m128i v_sx = _mm_set1_epi32(params.sx);
+    const __m128i v_sy = _mm_set1_epi32(params.sy);
+    const __m128i v_sz = _mm_set1_epi32(params.sz);
+    const __m128i v_one = _mm_set1_epi32(1);
+    const __m128i mag_min = _mm_set1_epi32(-64);
+    const __m128i mag_max = _mm_set1_epi32(63);
+    const __m128i mag_offset = _mm_set1_epi32(64);
+    const __m128i v_height_min = _mm_set1_epi32(params.height_min);
+    const __m128i v_height_scale = _mm_cvtsi32_si128(params.height_scale);
+    const __m128i height_max = _mm_set1_epi32(255);
+
+    for (; (x + 4) <= last; x += 4) {
+        const __m128i up = Load4(row.prev + x);
+        const __m128i bottom = Load4(row.next + x);
+        const __m128i left = Load4(row.curr + x - params.epx);
+        const __m128i right = Load4(row.curr + x + params.epx);
+
+        const __m128i p22 = _mm_sub_epi32(right, left);
+        const __m128i p32 = _mm_sub_epi32(bottom, up);
+
+        const __m128i dd0 = DivEpi32(_mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(p22), v_p31)), v_scale);
+        const __m128i dd1 = DivEpi32(_mm_mullo_epi32(v_p20, p32), v_scale);
+
+        const __m128i sqr_mag = _mm_add_epi32(_mm_add_epi32(_mm_mullo_epi32(dd0, dd0),
+                                                            _mm_mullo_epi32(dd1, dd1)), v_dd2_sqr);
+        const __m128i mag_div = _mm_or_si128(_mm_cvttps_epi32(_mm_sqrt_ps(CvtEpu32Ps(sqr_mag))), v_one);
+
+        const __m128i num = _mm_add_epi32(_mm_add_epi32(v_dd2_sz, _mm_mullo_epi32(dd0, v_sx)),
+                                          _mm_mullo_epi32(dd1, v_sy));
+        __m128i mag = _mm_sub_epi32(DivEpu32(num, mag_div), v_sz);
+        mag = _mm_min_epi32(_mm_max_epi32(mag, mag_min), mag_max);
+
+        __m128i h = _mm_sra_epi32(_mm_sub_epi32(Load4(row.curr + x), v_height_min), v_height_scale);
+        h = _mm_srai_epi32(_mm_slli_epi32(h, 16), 16); // int16_t conversion
+        h = _mm_min_epi32(_mm_max_epi32(h, _mm_setzero_si128()), height_max);
+
+        const __m128i result = _mm_add_epi32(_mm_slli_epi32(_mm_add_epi32(mag, mag_offset), 8), h);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(index + x), _mm_packus_epi32(result, result));
+    }
+
+    for (; x < row.width; ++x) {
+        index[x] = ShadePixel(params, row, p31s, x);
+    }
+}
+
+__attribute__((target("avx2")))
+void SlopeShadingAVX2(const SlopeShadingParams& params, const SlopeShadingRow& row, uint16_t* index) {
+    const float p31s = row.p31 * params.hscale;
+
+    const size_t first = std::min<size_t>(params.epx, row.width);
+    const size_t last = (row.width > params.epx) ? row.width - params.epx : 0;
+
+    size_t x = 0;
+    for (; x < first; ++x) {
+        index[x] = ShadePixel(params, row, p31s, x);
+    }
+
+    // p20, dd2 and scale are the same for all pixels far enough from the border
+    const int32_t p20 = params.epx + params.epx;
+    int32_t dd2 = p20 * p31s;
+    const int32_t scale = (dd2 / 512) + 1;
+    dd2 /= scale;
+
+    const __m256 v_p31 = _mm256_set1_ps(row.p31);
+    const __m256i v_p20 = _mm256_set1_epi32(p20);
+    const __m256d v_scale = _mm256_set1_pd(scale);
+    const __m256i v_dd2_sqr = _mm256_set1_epi32(dd2 * dd2);
+    const __m256i v_dd2_sz = _mm256_set1_epi32(dd2 * params.sz);
+    const __m256i v_sx = _mm256_set1_epi32(params.sx);
+    const __m256i v_sy = _mm256_set1_epi32(params.sy);
+    const __m256i v_sz = _mm256_set1_epi32(params.sz);
+    const __m256i v_one = _mm256_set1_epi32(1);
+    const __m256i mag_min = _mm256_set1_epi32(-64);
+    const __m256i mag_max = _mm256_set1_epi32(63);
+    const __m256i mag_offset = _mm256_set1_epi32(64);
+    const __m256i v_height_min = _mm256_set1_epi32(params.height_min);
+    const __m128i v_height_scale = _mm_cvtsi32_si128(params.height_scale);
+    const __m256i height_max = _mm256_set1_epi32(255);
+
+    for (; (x + 8) <= last; x += 8) {
+        const __m256i up = Load8(row.prev + x);
+        const __m256i bottom = Load8(row.next + x);
+        const __m256i left = Load8(row.curr + x - params.epx);
+        const __m256i right = Load8(row.curr + x + params.epx);
+
+        const __m256i p22 = _mm256_sub_epi32(right, left);
+        const __m256i p32 = _mm256_sub_epi32(bottom, up);
+
+        const __m256i dd0 = DivEpi32(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(p22), v_p31)), v_scale);
+        const __m256i dd1 = DivEpi32(_mm256_mullo_epi32(v_p20, p32), v_scale);
+
+        const __m256i sqr_mag = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(dd0, dd0),
+                                                                  _mm256_mullo_epi32(dd1, dd1)), v_dd2_sqr);
+        const __m256i mag_div = _mm256_or_si256(_mm256_cvttps_epi32(_mm256_sqrt_ps(CvtEpu32Ps(sqr_mag))), v_one);
+
+        const __m256i num = _mm256_add_epi32(_mm256_add_epi32(v_dd2_sz, _mm256_mullo_epi32(dd0, v_sx)),
+                                             _mm256_mullo_epi32(dd1, v_sy));
+        __m256i mag = _mm256_sub_epi32(DivEpu32(num, mag_div), v_sz);
+        mag = _mm256_min_epi32(_mm256_max_epi32(mag, mag_min), mag_max);
+
+        __m256i h = _mm256_sra_epi32(_mm256_sub_epi32(Load8(row.curr + x), v_height_min), v_height_scale);
+        h = _mm256_srai_epi32(_mm256_slli_epi32(h, 16), 16); // int16_t conversion
+        h = _mm256_min_epi32(_mm256_max_epi32(h, _mm256_setzero_si256()), height_max);
+
+        const __m256i result = _mm256_add_epi32(_mm256_slli_epi32(_mm256_add_epi32(mag, mag_offset), 8), h);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(index + x),
+                         _mm_packus_epi32(_mm256_castsi256_si128(result), _mm256_extracti128_si256(result, 1)));
+    }
+
+    for (; x < row.width; ++x) {
+        index[x] = ShadePixel(params, row, p31s, x);
+    }
+}
+
+#endif // HAVE_SLOPE_SHADING_X86
+
+SlopeShadingKernel GetSlopeShadingKernel() {
+#ifdef HAVE_SLOPE_SHADING_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SlopeShadingAVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SlopeShadingSSE41;
+    }
+#endif
+    return SlopeShadingScalar;
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <vector>
+#include <random>
+#include <cmath>
+#include "Time/PeriodClock.hpp"
+
+namespace {
+
+  struct NamedKernel {
+    const char* name;
+    SlopeShadingKernel kernel;
+  };
+
+  // vectorized kernels supported by current CPU
+  std::vector<NamedKernel> VectorKernels() {
+    std::vector<NamedKernel> kernels;
+#ifdef HAVE_SLOPE_SHADING_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.1")) {
+      kernels.push_back({ "sse4.1", SlopeShadingSSE41 });
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      kernels.push_back({ "avx2", SlopeShadingAVX2 });
+    }
+#endif
+    return kernels;
+  }
+
+  /**
+   * fixed DEM tile : smooth hills, a cliff, flat sea, invalid area and noise,
+   * width is not a multiple of vector size.
+   */
+  struct DemTile {
+    static constexpr size_t width = 333;
+    static constexpr size_t height = 127;
+    std::vector<int16_t> data;
+
+    DemTile() : data(width * height) {
+      std::mt19937 gen(42);
+      std::uniform_int_distribution<int> noise(-40, 40);
+      for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+          double h = 1500. + 1200. * std::sin(x / 17.) * std::cos(y / 11.) + noise(gen);
+          if (x > 200 && x < 210) {
+            h += 2500.; // cliff
+          }
+          if (x < 30 && y > 90) {
+            h = 0.; // sea
+          }
+          if (x > 300 && y < 20) {
+            h = TERRAIN_INVALID;
+          }
+          data[y * width + x] = static_cast<int16_t>(h);
+        }
+      }
+    }
+
+    const int16_t* Row(size_t y) const {
+      return data.data() + y * width;
+    }
+  };
+
+  // same row setup as TerrainRenderer::Slope_shading()
+  void ShadeTile(const DemTile& tile, const SlopeShadingParams& params, SlopeShadingKernel kernel, std::vector<uint16_t>& out) {
+    out.assign(tile.data.size(), 0);
+    for (size_t y = 0; y < tile.height; ++y) {
+      const unsigned prev_row_index =  (y < params.epx) ? 0 : y - params.epx;
+      const unsigned next_row_index =  (y + params.epx >= tile.height) ? tile.height - 1 : y + params.epx;
+      const SlopeShadingRow row = {
+        tile.Row(prev_row_index), tile.Row(y), tile.Row(next_row_index),
+        tile.width, static_cast<float>(next_row_index - prev_row_index)
+      };
+      kernel(params, row, out.data() + y * tile.width);
+    }
+  }
+
+} // namespace
+
+TEST_CASE("slope shading kernels") {
+  const DemTile tile;
+  const auto kernels = VectorKernels();
+  if (kernels.empty()) {
+    MESSAGE("no vectorized kernel supported");
+  }
+
+  std::vector<uint16_t> expected;
+  std::vector<uint16_t> result;
+
+  for (unsigned epx : { 4, 8, 12 }) {
+    for (int hscale : { 1, 30, 250, 2000 }) {
+      for (int azimuth : { 0, 135, 315 }) {
+        const double a = azimuth * DEG_TO_RAD;
+        const double e = 40. * DEG_TO_RAD;
+        const SlopeShadingParams params = {
+          static_cast<int>(255 * std::cos(e) * std::sin(a)),
+          static_cast<int>(255 * std::cos(e) * std::cos(a)),
+          static_cast<int>(255 * std::sin(e)),
+          epx, hscale, -100, 4
+        };
+        ShadeTile(tile, params, SlopeShadingScalar, expected);
+        for (const auto& k : kernels) {
+          ShadeTile(tile, params, k.kernel, result);
+          CHECK_MESSAGE(result == expected, k.name << " epx=" << epx << " hscale=" << hscale << " azimuth=" << azimuth);
+        }
+      }
+    }
+  }
+}
+
+// not run by default, use '--test-case="slope shading benchmark" --no-skip'
+TEST_CASE("slope shading benchmark" * doctest::skip()) {
+  const DemTile tile;
+  const SlopeShadingParams params = { 120, -140, 164, 4, 250, -100, 4 };
+  const unsigned loop = 200;
+  const double mpixels = double(tile.data.size()) * loop / 1e6;
+
+  std::vector<NamedKernel> kernels = { { "scalar", SlopeShadingScalar } };
+  for (const auto& k : VectorKernels()) {
+    kernels.push_back(k);
+  }
+
+  std::vector<uint16_t> out;
+  for (const auto& k : kernels) {
+    PeriodClock clock;
+    clock.Update();
+    for (unsigned i = 0; i < loop; ++i) {
+      ShadeTile(tile, params, k.kernel, out);
+    }
+    const double ms = std::max<double>(1, clock.Elapsed());
+    MESSAGE(k.name << " : " << (mpixels * 1000. / ms) << " Mpixels/s");
+  }
+}
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   SlopeShading.h
+ */
+
+#ifndef SLOPESHADING_H
+#define SLOPESHADING_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Compiler.h"
+
+/**
+ * Slope shading kernel used by TerrainRenderer when ARM NEON is not available.
+ *
+ * For each pixel of one row of height buffer, kernel compute the index in
+ * TerrainRenderer color table :
+ *   index = ((mag + 64) << 8) + h
+ *     mag : sunlight intensity in [-64, 63]
+ *     h : height scaled to [0, 255]
+ *
+ * All kernels return exactly the same result, vectorized one are only selected
+ * at runtime if the CPU support required instruction set.
+ */
+struct SlopeShadingParams {
+  int sx, sy, sz; // sunlight vector
+  unsigned epx; // step size used for slope calculations
+  int hscale;
+  int16_t height_min;
+  unsigned height_scale;
+};
+
+struct SlopeShadingRow {
+  const int16_t* prev; // row y - epx
+  const int16_t* curr; // row y
+  const int16_t* next; // row y + epx
+  size_t width;
+  float p31; // distance between prev and next row
+};
+
+using SlopeShadingKernel = void (*)(const SlopeShadingParams& params, const SlopeShadingRow& row, uint16_t* index);
+
+void SlopeShadingScalar(const SlopeShadingParams& params, const SlopeShadingRow& row, uint16_t* index);
+
+#if (defined(__x86_64__) || defined(__i386__)) && CLANG_OR_GCC_VERSION(5,0)
+#define HAVE_SLOPE_SHADING_X86
+void SlopeShadingSSE41(const SlopeShadingParams& params, const SlopeShadingRow& row, uint16_t* index);
+void SlopeShadingAVX2(const SlopeShadingParams& params, const SlopeShadingRow& row, uint16_t* index);
+#endif
+
+// fastest kernel supported by current CPU
+SlopeShadingKernel GetSlopeShadingKernel();
+
+#endif /* SLOPESHADING_H */
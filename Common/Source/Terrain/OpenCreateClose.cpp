@@ -11,8 +11,9 @@
 #include "Dialogs/dlgProgress.h"
 #include "Message.h"
 
-std::unique_ptr<RasterMap> RasterTerrain::TerrainMap;
-Mutex RasterTerrain::mutex;
+std::shared_ptr<RasterMap> RasterTerrain::TerrainMap;
+profiler::timed_mutex<profiler::LockTerrain> RasterTerrain::mutex;
+TerrainSampler RasterTerrain::Sampler;
 
 void RasterTerrain::OpenTerrain() {
   TestLog(_T(". Loading Terrain..."));
@@ -36,13 +37,14 @@ void RasterTerrain::OpenTerrain() {
 bool RasterTerrain::CreateTerrainMap(const TCHAR* zfilename) {
   ScopeLock lock(mutex);
   try {
-    TerrainMap = std::make_unique<RasterMap>();
+    TerrainMap = std::make_shared<RasterMap>();
     if (!TerrainMap->Open(zfilename)) {
       TerrainMap = nullptr;
     }
   } catch (std::exception&) {
     TerrainMap = nullptr;
   }
+  Sampler = TerrainSampler(TerrainMap, 0, 0);
   return static_cast<bool>(TerrainMap);
 }
 
@@ -52,5 +54,7 @@ void RasterTerrain::CloseTerrain() {
   TestLog(_T(". CloseTerrain"));
 
   ScopeLock lock(mutex);
+  Sampler = TerrainSampler();
+  // map is released when last sampler using it is destroyed.
   TerrainMap = nullptr;
 }
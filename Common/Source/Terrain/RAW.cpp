@@ -22,7 +22,18 @@ bool RasterMap::Open(const TCHAR* zfilename) {
   if (_tcslen(zfilename)<=0) {
     return false;
   }
-  
+
+  if (TerrainTiles::IsTiledFile(zfilename)) {
+    StartupStore(_T(". Terrain Open tiled RasterMap <%s>"),zfilename);
+    Tiles = TerrainTiles::Open(zfilename, TerrainInfo, TerrainCacheSize * 1024U * 1024U);
+    if (!Tiles) {
+      Close();
+      StartupStore(_T("... Terrain tiled RasterMap load failed"));
+      return false;
+    }
+    return true;
+  }
+
   StartupStore(_T(". Terrain Open RasterMapRaw <%s>"),zfilename);
   FILE* file = _tfopen(zfilename, _T("rb"));
   if(file) {
@@ -126,6 +137,7 @@ void RasterMap::Close(void) {
 
   TerrainMem = nullptr;
   pTerrainMem = nullptr;
+  Tiles = nullptr;
 
 #ifndef UNDER_CE  
   if(TerrainFile.is_open()) {
@@ -20,6 +20,14 @@ bool RasterMap::GetMapCenter(double *lat, double *lon) const {
   return true;
 }
 
+bool RasterMap::GetMapInfo(TERRAIN_INFO *info) const {
+  if(!isMapLoaded())
+    return false;
+
+  *info = TerrainInfo;
+  return true;
+}
+
 bool RasterMap::IsInside(double lat, double lon) const {
   double dlat = fabs( TerrainInfo.Top- TerrainInfo.Bottom) * 0.05f;
   double dlon = fabs( TerrainInfo.Right- TerrainInfo.Left) * 0.05f;
@@ -81,11 +89,18 @@ int RasterMap::GetEffectivePixelSize(double dist) const {
   return grounding;
 }
 
-void RasterMap::SetFieldRounding(double xr, double yr) {
-  if (!isMapLoaded()) {
+TerrainSampler::TerrainSampler(std::shared_ptr<const RasterMap> map, double xr, double yr)
+    : Map(std::move(map))
+{
+  if (!Map || !Map->isMapLoaded()) {
+    Map = nullptr;
     return;
   }
 
+  TerrainInfo = Map->TerrainInfo;
+  TerrainMem = Map->TerrainMem;
+  Tiles = Map->Tiles.get();
+
   assert(TerrainInfo.StepSize > 0);
 
   Xrounding = std::max(iround(xr/TerrainInfo.StepSize), 1);
@@ -100,6 +115,14 @@ void RasterMap::SetFieldRounding(double xr, double yr) {
   xlltop  = (int)(TerrainInfo.Top*fYroundingFine)-128;
 
   Interpolate = ((Xrounding==1)&&(Yrounding==1));
+
+  if (Tiles) {
+    // most decimated overview that don't skip any sample.
+    const int rounding = std::min(Xrounding, Yrounding);
+    while ((Level + 1) < Tiles->LevelCount() && (2 << Level) <= rounding) {
+      ++Level;
+    }
+  }
 }
 
 
@@ -115,19 +138,22 @@ void RasterTerrain::Unlock(void) {
   mutex.unlock();
 }
 
+TerrainSampler RasterTerrain::GetSampler(double xr, double yr) {
+  std::shared_ptr<const RasterMap> map;
+  {
+    ScopeLock lock(mutex);
+    map = TerrainMap;
+  }
+  return TerrainSampler(std::move(map), xr, yr);
+}
+
 short RasterTerrain::GetTerrainHeight(const double &Latitude,
                                       const double &Longitude) {
-  if (TerrainMap && TerrainMap->isMapLoaded()) {
-    return TerrainMap->GetField(Latitude, Longitude);
-  } else {
-    return TERRAIN_INVALID;
-  }
+  return Sampler.GetField(Latitude, Longitude);
 }
 
 void RasterTerrain::SetTerrainRounding(double x, double y) {
-  if (TerrainMap) {
-    TerrainMap->SetFieldRounding(x, y);
-  }
+  Sampler = TerrainSampler(TerrainMap, x, y);
 }
 
 bool RasterTerrain::WaypointIsInTerrainRange(double latitude, double longitude) {
@@ -146,3 +172,9 @@ bool RasterTerrain::GetTerrainCenter(double *latitude, double *longitude) {
 
   return TerrainMap && TerrainMap->GetMapCenter(latitude, longitude);
 }
+
+bool RasterTerrain::GetTerrainInfo(TERRAIN_INFO *info) {
+  ScopeLock lock(mutex);
+
+  return TerrainMap && TerrainMap->GetMapInfo(info);
+}
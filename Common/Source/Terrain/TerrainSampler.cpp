@@ -0,0 +1,349 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   TerrainSampler.cpp
+ */
+
+#include "externs.h"
+#include "RasterTerrain.h"
+#include <algorithm>
+
+#if !defined(_BILINEAR_INTERP)
+ #if defined(__SSE2__)
+  #include <emmintrin.h>
+  #define VECTORIZED_INTERPOLATE
+ #elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !GCC_OLDER_THAN(5,0)
+  #include <arm_neon.h>
+  #define VECTORIZED_INTERPOLATE
+ #endif
+#endif
+
+namespace {
+
+// points computed on stack by GetProfile() for each batch
+constexpr size_t profile_batch = 64;
+
+#if defined(__SSE2__)
+// SSE2 has no 32bit low multiply (_mm_mullo_epi32 is SSE4.1)
+inline __m128i mullo_epi32(__m128i a, __m128i b) {
+  const __m128i even = _mm_mul_epu32(a, b);
+  const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+  return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                            _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+#endif
+
+} // namespace
+
+#ifdef VECTORIZED_INTERPOLATE
+
+/**
+ * same as GetFieldInterpolate() for 4 points.
+ *
+ * @return false if one of the points is on right&bottom line or outside of the map,
+ *   in this case <Height> is unchanged.
+ */
+bool TerrainSampler::GetFieldInterpolate4(const double* Latitude, const double* Longitude, short* Height) const {
+    alignas(16) int32_t lx[4];
+    alignas(16) int32_t ly[4];
+
+#if defined(__SSE2__)
+    const __m128d fx = _mm_set1_pd(fXroundingFine);
+    const __m128d fy = _mm_set1_pd(fYroundingFine);
+
+    const __m128i x01 = _mm_cvttpd_epi32(_mm_mul_pd(_mm_loadu_pd(Longitude), fx));
+    const __m128i x23 = _mm_cvttpd_epi32(_mm_mul_pd(_mm_loadu_pd(Longitude + 2), fx));
+    const __m128i y01 = _mm_cvttpd_epi32(_mm_mul_pd(_mm_loadu_pd(Latitude), fy));
+    const __m128i y23 = _mm_cvttpd_epi32(_mm_mul_pd(_mm_loadu_pd(Latitude + 2), fy));
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(lx),
+                    _mm_sub_epi32(_mm_unpacklo_epi64(x01, x23), _mm_set1_epi32(xlleft)));
+    _mm_store_si128(reinterpret_cast<__m128i*>(ly),
+                    _mm_sub_epi32(_mm_set1_epi32(xlltop), _mm_unpacklo_epi64(y01, y23)));
+#else
+    // armv7 NEON has no double precision
+    for (unsigned i = 0; i < 4; ++i) {
+        lx[i] = (int)(Longitude[i] * fXroundingFine) - xlleft;
+        ly[i] = xlltop - (int)(Latitude[i] * fYroundingFine);
+    }
+#endif
+
+    // no gather instruction, load the 4 neighboring pixels of each point
+    alignas(16) int32_t h1[4]; // (x,y)
+    alignas(16) int32_t h2[4]; // (x+1,y)
+    alignas(16) int32_t h3[4]; // (x+1,y+1)
+    alignas(16) int32_t h4[4]; // (x,y+1)
+
+    for (unsigned i = 0; i < 4; ++i) {
+        const unsigned x = static_cast<unsigned>(lx[i]) >> 8;
+        const unsigned y = static_cast<unsigned>(ly[i]) >> 8;
+        if (gcc_unlikely((x + 1) >= TerrainInfo.Columns || (y + 1) >= TerrainInfo.Rows)) {
+            return false;
+        }
+        const short *tm = TerrainMem + y * TerrainInfo.Columns + x;
+        h1[i] = tm[0];
+        h2[i] = tm[1];
+        h3[i] = tm[TerrainInfo.Columns + 1];
+        h4[i] = tm[TerrainInfo.Columns];
+    }
+
+    /*
+     * piecewise linear interpolation, both triangles are computed and selected with ix > iy.
+     * only low 16 bits of result are kept, like the (short) cast of scalar version.
+     */
+#if defined(__SSE2__)
+    const __m128i mask = _mm_set1_epi32(0xff);
+    const __m128i ix = _mm_and_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(lx)), mask);
+    const __m128i iy = _mm_and_si128(_mm_load_si128(reinterpret_cast<const __m128i*>(ly)), mask);
+
+    const __m128i v1 = _mm_load_si128(reinterpret_cast<const __m128i*>(h1));
+    const __m128i v2 = _mm_load_si128(reinterpret_cast<const __m128i*>(h2));
+    const __m128i v3 = _mm_load_si128(reinterpret_cast<const __m128i*>(h3));
+    const __m128i v4 = _mm_load_si128(reinterpret_cast<const __m128i*>(h4));
+
+    const __m128i lower = _mm_add_epi32(v1, _mm_srai_epi32(_mm_sub_epi32(
+                                mullo_epi32(ix, _mm_sub_epi32(v2, v1)),
+                                mullo_epi32(iy, _mm_sub_epi32(v2, v3))), 8));
+    const __m128i upper = _mm_add_epi32(v1, _mm_srai_epi32(_mm_sub_epi32(
+                                mullo_epi32(iy, _mm_sub_epi32(v4, v1)),
+                                mullo_epi32(ix, _mm_sub_epi32(v4, v3))), 8));
+
+    const __m128i is_lower = _mm_cmpgt_epi32(ix, iy);
+    const __m128i h = _mm_or_si128(_mm_and_si128(is_lower, lower), _mm_andnot_si128(is_lower, upper));
+
+    // sign extend low 16 bits, so saturation of pack is a no-op.
+    const __m128i h16 = _mm_srai_epi32(_mm_slli_epi32(h, 16), 16);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(Height), _mm_packs_epi32(h16, h16));
+#else
+    const int32x4_t mask = vmovq_n_s32(0xff);
+    const int32x4_t ix = vandq_s32(vld1q_s32(lx), mask);
+    const int32x4_t iy = vandq_s32(vld1q_s32(ly), mask);
+
+    const int32x4_t v1 = vld1q_s32(h1);
+    const int32x4_t v2 = vld1q_s32(h2);
+    const int32x4_t v3 = vld1q_s32(h3);
+    const int32x4_t v4 = vld1q_s32(h4);
+
+    const int32x4_t lower = vaddq_s32(v1, vshrq_n_s32(vsubq_s32(
+                                vmulq_s32(ix, vsubq_s32(v2, v1)),
+                                vmulq_s32(iy, vsubq_s32(v2, v3))), 8));
+    const int32x4_t upper = vaddq_s32(v1, vshrq_n_s32(vsubq_s32(
+                                vmulq_s32(iy, vsubq_s32(v4, v1)),
+                                vmulq_s32(ix, vsubq_s32(v4, v3))), 8));
+
+    const int32x4_t h = vbslq_s32(vcgtq_s32(ix, iy), lower, upper);
+    vst1_s16(Height, vmovn_s32(h));
+#endif
+
+    return true;
+}
+
+#endif // VECTORIZED_INTERPOLATE
+
+/**
+ * same as GetFieldInterpolate() for tiled map, <lx>, <ly> are level 0 pixel.
+ */
+short TerrainSampler::GetFieldInterpolateTiled(unsigned lx, unsigned ly, unsigned ix, unsigned iy) const {
+    short h[4];
+    Tiles->GetQuad(lx, ly, h);
+
+    const int h1 = h[0]; // (x,y)
+    const int h2 = h[1]; // (x+1,y)
+    const int h3 = h[2]; // (x+1,y+1)
+    const int h4 = h[3]; // (x,y+1)
+
+#ifdef _BILINEAR_INTERP
+    const unsigned ix1 = 0x0ff - ix;
+    const unsigned iy1 = 0x0ff - iy;
+    return (h1 * ix1 * iy1 + h2 * ix * iy1 + h4 * ix1 * iy + h3 * ix * iy) >> 16;
+#else
+    if (ix > iy) {
+        // lower triangle
+        return (short) (h1 + ((ix * (h2 - h1) - iy * (h2 - h3)) >> 8));
+    } else {
+        // upper triangle
+        return (short) (h1 + ((iy * (h4 - h1) - ix * (h4 - h3)) >> 8));
+    }
+#endif
+}
+
+void TerrainSampler::GetFields(const double* Latitude, const double* Longitude, short* Height, size_t count) const {
+    if (!IsValid()) {
+        std::fill_n(Height, count, TERRAIN_INVALID);
+        return;
+    }
+
+    const auto batch = Batch();
+
+    if (!interpolate() || !TerrainMem) {
+        for (size_t i = 0; i < count; ++i) {
+            Height[i] = GetField(Latitude[i], Longitude[i]);
+        }
+        return;
+    }
+
+    size_t i = 0;
+#ifdef VECTORIZED_INTERPOLATE
+    for (; (i + 4) <= count; i += 4) {
+        if (gcc_unlikely(!GetFieldInterpolate4(Latitude + i, Longitude + i, Height + i))) {
+            // at least one point on map border.
+            for (size_t j = i; j < (i + 4); ++j) {
+                Height[j] = GetFieldInterpolate(Latitude[j], Longitude[j]);
+            }
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        Height[i] = GetFieldInterpolate(Latitude[i], Longitude[i]);
+    }
+}
+
+void TerrainSampler::GetProfile(double Latitude, double Longitude,
+                                double dLatitude, double dLongitude,
+                                short* Height, size_t count) const {
+    double lat[profile_batch];
+    double lon[profile_batch];
+
+    while (count > 0) {
+        const size_t size = std::min(count, profile_batch);
+        for (size_t i = 0; i < size; ++i) {
+            lat[i] = Latitude;
+            lon[i] = Longitude;
+            Latitude += dLatitude;
+            Longitude += dLongitude;
+        }
+        GetFields(lat, lon, Height, size);
+        Height += size;
+        count -= size;
+    }
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+#include "utils/filesystem.h"
+#include "Time/PeriodClock.hpp"
+
+namespace {
+
+  // write a small synthetic DEM file (header + row major heights)
+  bool WriteDemFile(const TCHAR* path, const TERRAIN_INFO& info, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<short> height(-200, 4800);
+
+    FILE* file = _tfopen(path, _T("wb"));
+    if (!file) {
+      return false;
+    }
+    fwrite(&info, sizeof(info), 1, file);
+    for (size_t i = 0; i < size_t(info.Rows) * info.Columns; ++i) {
+      const short h = height(gen);
+      fwrite(&h, sizeof(h), 1, file);
+    }
+    fclose(file);
+    return true;
+  }
+
+} // namespace
+
+TEST_CASE("terrain sampler") {
+  const TCHAR* path = _T("terrain_sampler_test.dem");
+  const TERRAIN_INFO info = { 6., 7., 46., 45., 1. / 120., 121, 121 };
+  REQUIRE(WriteDemFile(path, info, 7));
+
+  auto map = std::make_shared<RasterMap>();
+  const bool opened = map->Open(path);
+  lk::filesystem::deleteFile(path);
+  REQUIRE(opened);
+
+  // include points outside and on the border of the map
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> lat(44.9, 46.1);
+  std::uniform_real_distribution<double> lon(5.9, 7.1);
+  std::vector<double> lats(1003);
+  std::vector<double> lons(lats.size());
+  for (size_t i = 0; i < lats.size(); ++i) {
+    lats[i] = lat(gen);
+    lons[i] = lon(gen);
+  }
+
+  for (double rounding : { 0., 1. / 120., 1. / 30. }) {
+    const TerrainSampler sampler(map, rounding, rounding);
+    REQUIRE(sampler.IsValid());
+
+    std::vector<short> heights(lats.size());
+    sampler.GetFields(lats.data(), lons.data(), heights.data(), heights.size());
+    for (size_t i = 0; i < lats.size(); ++i) {
+      CHECK_EQ(heights[i], sampler.GetField(lats[i], lons[i]));
+    }
+
+    // profile from outside to the other side of the map
+    std::vector<short> profile(200);
+    sampler.GetProfile(44.95, 5.95, 0.0055, 0.0056, profile.data(), profile.size());
+    double y = 44.95, x = 5.95;
+    for (short h : profile) {
+      CHECK_EQ(h, sampler.GetField(y, x));
+      y += 0.0055;
+      x += 0.0056;
+    }
+  }
+
+  SUBCASE("invalid sampler") {
+    const TerrainSampler sampler;
+    short h = 0;
+    sampler.GetFields(lats.data(), lons.data(), &h, 1);
+    CHECK_EQ(h, TERRAIN_INVALID);
+  }
+}
+
+// not run by default, use '--test-case="terrain sampler benchmark" --no-skip'
+TEST_CASE("terrain sampler benchmark" * doctest::skip()) {
+  const TCHAR* path = _T("terrain_sampler_bench.dem");
+  const TERRAIN_INFO info = { 6., 8., 46., 44., 1. / 1000., 2001, 2001 };
+  REQUIRE(WriteDemFile(path, info, 7));
+
+  auto map = std::make_shared<RasterMap>();
+  const bool opened = map->Open(path);
+  lk::filesystem::deleteFile(path);
+  REQUIRE(opened);
+
+  const TerrainSampler sampler(map, 0, 0);
+
+  // glide footprint like queries : short profiles in all directions
+  const size_t count = 4000000;
+  std::vector<double> lats(count);
+  std::vector<double> lons(count);
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> lat(44.2, 45.8);
+  std::uniform_real_distribution<double> lon(6.2, 7.8);
+  std::uniform_real_distribution<double> step(-0.002, 0.002);
+  for (size_t i = 0; i < count; i += 32) {
+    double y = lat(gen), x = lon(gen);
+    const double dy = step(gen), dx = step(gen);
+    for (size_t j = i; j < std::min(count, i + 32); ++j) {
+      lats[j] = y;
+      lons[j] = x;
+      y += dy;
+      x += dx;
+    }
+  }
+
+  std::vector<short> heights(count);
+  std::vector<short> batch(count);
+
+  PeriodClock clock;
+  clock.Update();
+  for (size_t i = 0; i < count; ++i) {
+    heights[i] = sampler.GetField(lats[i], lons[i]);
+  }
+  MESSAGE("scalar : " << clock.ElapsedUpdate() << "ms");
+
+  sampler.GetFields(lats.data(), lons.data(), batch.data(), count);
+  MESSAGE("batch : " << clock.ElapsedUpdate() << "ms");
+
+  CHECK(heights == batch);
+}
+
+#endif
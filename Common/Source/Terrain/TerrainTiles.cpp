@@ -0,0 +1,693 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   TerrainTiles.cpp
+ */
+
+#include "externs.h"
+#include "RasterTerrain.h"
+#include "TerrainTiles.h"
+#include "OS/ByteOrder.hpp"
+#include <zlib.h>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+static_assert(IsLittleEndian(), "Big-Endian Arch is not supported");
+
+namespace {
+
+// NaN as double : never a valid TERRAIN_INFO::Left
+constexpr uint8_t tiled_magic[8] = { 'L', 'K', 'T', 'D', 'E', 'M', 0xF1, 0xFF };
+
+struct TILED_TERRAIN_HEADER {
+  uint8_t Magic[8];
+  TERRAIN_INFO Info;
+  uint32_t TileSize;
+  uint32_t LevelCount;
+};
+
+struct TILED_TERRAIN_ENTRY {
+  uint64_t Offset;
+  uint32_t Size;
+  uint32_t Reserved;
+};
+
+static_assert(sizeof(TILED_TERRAIN_HEADER) == 64, "invalid header size");
+static_assert(sizeof(TILED_TERRAIN_ENTRY) == 16, "invalid tile entry size");
+
+constexpr unsigned max_level_count = 8;
+
+bool IsPowerOfTwo(unsigned value) {
+  return value && !(value & (value - 1));
+}
+
+unsigned TileCount(unsigned pixels, unsigned tile_size) {
+  return (pixels + tile_size - 1) / tile_size;
+}
+
+/**
+ * each pixel is the mean of valid pixels in the 2x2 block of <src>
+ */
+std::vector<short> Overview(const std::vector<short>& src, unsigned rows, unsigned columns) {
+  const unsigned dst_rows = (rows + 1) / 2;
+  const unsigned dst_columns = (columns + 1) / 2;
+  std::vector<short> dst(size_t(dst_rows) * dst_columns);
+
+  for (unsigned y = 0; y < dst_rows; ++y) {
+    for (unsigned x = 0; x < dst_columns; ++x) {
+      int sum = 0;
+      int count = 0;
+      for (unsigned sy = 2 * y; sy < std::min(2 * y + 2, rows); ++sy) {
+        for (unsigned sx = 2 * x; sx < std::min(2 * x + 2, columns); ++sx) {
+          const short h = src[size_t(sy) * columns + sx];
+          if (h != TERRAIN_INVALID) {
+            sum += h;
+            ++count;
+          }
+        }
+      }
+      dst[size_t(y) * dst_columns + x] = count ? static_cast<short>(sum / count) : TERRAIN_INVALID;
+    }
+  }
+  return dst;
+}
+
+// tiles read by current thread inside a ReadScope, and reader slot of current thread.
+thread_local TerrainTiles::ReadScope::current_t current_reader = { nullptr, nullptr };
+
+// last reader slot used by current thread, so each thread use its own cache line.
+thread_local unsigned reader_hint = 0;
+
+} // namespace
+
+TerrainTiles::ReadScope::ReadScope(const TerrainTiles* tiles) : _tiles(tiles) {
+  if (_tiles && _tiles != current_reader.tiles) {
+    _slot = _tiles->Register();
+    _previous = current_reader;
+    current_reader = { _tiles, _slot };
+  }
+}
+
+TerrainTiles::ReadScope::~ReadScope() {
+  if (_slot) {
+    _tiles->Unregister(_slot);
+    current_reader = _previous;
+  }
+}
+
+std::atomic<uint64_t>* TerrainTiles::Register() const {
+  std::atomic<uint64_t>* slot = TryRegister();
+  if (gcc_unlikely(!slot)) {
+    // more than max_readers concurrent readers
+    ScopeLock lock(mutex);
+    ++waiters;
+    while (!(slot = TryRegister())) {
+      released.Wait(mutex);
+    }
+    --waiters;
+  }
+  return slot;
+}
+
+std::atomic<uint64_t>* TerrainTiles::TryRegister() const {
+  for (unsigned i = 0; i < max_readers; ++i) {
+    const unsigned index = (reader_hint + i) % max_readers;
+    uint64_t expected = 0;
+    // epoch can be incremented before slot is published : reader is older than it is, that only delay reclamation.
+    if (readers[index].epoch.compare_exchange_strong(expected, epoch.load())) {
+      reader_hint = index;
+      return &readers[index].epoch;
+    }
+  }
+  return nullptr;
+}
+
+void TerrainTiles::Unregister(std::atomic<uint64_t>* slot) const {
+  slot->store(0);
+  // waiter check its condition with <mutex> locked, so signal can't be lost.
+  if (gcc_unlikely(waiters.load())) {
+    ScopeLock lock(mutex);
+    released.Broadcast();
+  }
+}
+
+TerrainTiles::~TerrainTiles() {
+  if (file) {
+    fclose(file);
+  }
+}
+
+bool TerrainTiles::IsTiledFile(const TCHAR* filename) {
+  uint8_t magic[sizeof(tiled_magic)] = {};
+  FILE* fp = _tfopen(filename, _T("rb"));
+  if (!fp) {
+    return false;
+  }
+  const size_t read_size = fread(magic, 1, sizeof(magic), fp);
+  fclose(fp);
+  return (read_size == sizeof(magic)) && (memcmp(magic, tiled_magic, sizeof(magic)) == 0);
+}
+
+std::unique_ptr<TerrainTiles> TerrainTiles::Open(const TCHAR* filename, TERRAIN_INFO& info, size_t cache_size) {
+  std::unique_ptr<TerrainTiles> tiles(new TerrainTiles());
+  tiles->file = _tfopen(filename, _T("rb"));
+  if (!tiles->file) {
+    return nullptr;
+  }
+
+  TILED_TERRAIN_HEADER header;
+  if (fread(&header, sizeof(header), 1, tiles->file) != 1
+        || memcmp(header.Magic, tiled_magic, sizeof(tiled_magic)) != 0) {
+    StartupStore(_T("... ERROR Terrain : invalid tiled file header"));
+    return nullptr;
+  }
+  if (!(header.Info.StepSize > 0) || !header.Info.Rows || !header.Info.Columns
+        || !IsPowerOfTwo(header.TileSize) || !header.LevelCount || header.LevelCount > max_level_count) {
+    StartupStore(_T("... ERROR Terrain : invalid tiled file parameters"));
+    return nullptr;
+  }
+
+  tiles->tile_shift = __builtin_ctz(header.TileSize);
+  tiles->tile_mask = header.TileSize - 1;
+  tiles->tile_pixels = size_t(header.TileSize) * header.TileSize;
+
+  unsigned rows = header.Info.Rows;
+  unsigned columns = header.Info.Columns;
+  unsigned slot_count = 0;
+  for (unsigned i = 0; i < header.LevelCount; ++i) {
+    const Level level = {
+      rows, columns,
+      TileCount(columns, header.TileSize), TileCount(rows, header.TileSize),
+      slot_count
+    };
+    tiles->levels.push_back(level);
+    slot_count += level.tiles_x * level.tiles_y;
+    rows = (rows + 1) / 2;
+    columns = (columns + 1) / 2;
+  }
+
+  std::vector<TILED_TERRAIN_ENTRY> entries(slot_count);
+  if (fread(entries.data(), sizeof(TILED_TERRAIN_ENTRY), slot_count, tiles->file) != slot_count) {
+    StartupStore(_T("... ERROR Terrain : failed to read tiles index"));
+    return nullptr;
+  }
+  tiles->entries.reserve(slot_count);
+  for (const auto& entry : entries) {
+    // fseek() offset is a long, only 32 bits on some platforms (WinCE, 32 bits ARM).
+    if (entry.Size > LONG_MAX || entry.Offset > static_cast<uint64_t>(LONG_MAX) - entry.Size) {
+      StartupStore(_T("... ERROR Terrain : tiled file too large for this platform"));
+      return nullptr;
+    }
+    tiles->entries.push_back({ entry.Offset, entry.Size });
+  }
+
+  tiles->slots = std::make_unique<std::atomic<const Tile*>[]>(slot_count);
+  tiles->tiles.resize(slot_count);
+
+  const size_t tile_bytes = tiles->tile_pixels * sizeof(short);
+  tiles->max_tiles = std::max<size_t>(4, cache_size / tile_bytes);
+  tiles->max_retired = tiles->max_tiles / 4;
+  tiles->resident.reserve(tiles->max_tiles);
+
+  StartupStore(_T("... Terrain : tiled file, %u levels, %u tiles, cache %u tiles"),
+               header.LevelCount, slot_count, static_cast<unsigned>(tiles->max_tiles));
+
+  info = header.Info;
+  return tiles;
+}
+
+short TerrainTiles::GetHeight(unsigned level, unsigned x, unsigned y) const {
+  assert(level < levels.size());
+  const Level& l = levels[level];
+  if (gcc_unlikely(x >= l.columns || y >= l.rows)) {
+    return TERRAIN_INVALID;
+  }
+  const unsigned slot = Slot(l, x, y);
+  if (!entries[slot].size) {
+    return TERRAIN_INVALID;
+  }
+
+  const ReadScope scope(this);
+  const Tile* tile = Acquire(slot);
+  return tile ? Pixel(tile, x, y) : TERRAIN_INVALID;
+}
+
+void TerrainTiles::GetQuad(unsigned x, unsigned y, short (&h)[4]) const {
+  const Level& l = levels.front();
+  if ((x & tile_mask) == tile_mask || (y & tile_mask) == tile_mask || (x + 1) >= l.columns || (y + 1) >= l.rows) {
+    // across tiles
+    h[0] = GetHeight(0, x, y);
+    h[1] = GetHeight(0, x + 1, y);
+    h[2] = GetHeight(0, x + 1, y + 1);
+    h[3] = GetHeight(0, x, y + 1);
+    return;
+  }
+
+  const unsigned slot = Slot(l, x, y);
+  const Tile* tile = nullptr;
+  const ReadScope scope(this);
+  if (entries[slot].size) {
+    tile = Acquire(slot);
+  }
+  if (!tile) {
+    std::fill(std::begin(h), std::end(h), TERRAIN_INVALID);
+    return;
+  }
+  const short* tm = &tile->data[((y & tile_mask) << tile_shift) + (x & tile_mask)];
+  const size_t stride = tile_mask + 1;
+  h[0] = tm[0];
+  h[1] = tm[1];
+  h[2] = tm[stride + 1];
+  h[3] = tm[stride];
+}
+
+size_t TerrainTiles::ResidentSize() const {
+  ScopeLock lock(mutex);
+  return resident.size() * tile_pixels * sizeof(short);
+}
+
+size_t TerrainTiles::RetiredSize() const {
+  ScopeLock lock(mutex);
+  return retired.size() * tile_pixels * sizeof(short);
+}
+
+const TerrainTiles::Tile* TerrainTiles::Acquire(unsigned slot) const {
+  const Tile* tile = slots[slot].load();
+  if (gcc_unlikely(!tile)) {
+    return PageIn(slot);
+  }
+  if (!tile->referenced.load(std::memory_order_relaxed)) {
+    tile->referenced.store(true, std::memory_order_relaxed);
+  }
+  return tile;
+}
+
+const TerrainTiles::Tile* TerrainTiles::PageIn(unsigned slot) const {
+  assert(current_reader.tiles == this);
+
+  ScopeLock lock(mutex);
+
+  ++waiters; // before reading reader slots, see Unregister()
+  const Tile* tile;
+  for (;;) {
+    // another thread can have loaded this tile while we were waiting for lock.
+    tile = slots[slot].load();
+    if (tile) {
+      break;
+    }
+    /*
+     * caller don't hold any tile : register it again at current epoch,
+     * so a long batch of queries don't prevent deletion of tiles evicted since it started.
+     */
+    const uint64_t current = epoch.load();
+    if (current_reader.slot->exchange(current) != current && waiters.load() > 1) {
+      released.Broadcast(); // oldest reader can have changed
+    }
+    Reclaim();
+    if (retired.size() < max_retired) {
+      break;
+    }
+    // hard limit : wait for readers still registered before oldest eviction.
+    released.Wait(mutex);
+  }
+  --waiters;
+
+  if (tile) {
+    return tile;
+  }
+
+  std::unique_ptr<Tile> loaded = Load(slot);
+  if (!loaded) {
+    return nullptr;
+  }
+
+  // resident and retired tiles never use more than <max_tiles>
+  while (resident.size() >= (max_tiles - max_retired)) {
+    Evict();
+  }
+
+  tile = loaded.get();
+  tiles[slot] = std::move(loaded);
+  resident.push_back(slot);
+  slots[slot].store(tile);
+  return tile;
+}
+
+/**
+ * reader registered at epoch <e> can only use tiles evicted at epoch >= <e> :
+ * tiles evicted before the oldest registered reader are unreachable.
+ */
+void TerrainTiles::Reclaim() const {
+  uint64_t oldest = UINT64_MAX;
+  for (const auto& reader : readers) {
+    const uint64_t reader_epoch = reader.epoch.load();
+    if (reader_epoch) {
+      oldest = std::min(oldest, reader_epoch);
+    }
+  }
+  retired.erase(std::remove_if(retired.begin(), retired.end(), [&](const RetiredTile& item) {
+    return item.epoch < oldest;
+  }), retired.end());
+}
+
+void TerrainTiles::Evict() const {
+  assert(!resident.empty());
+  for (;;) {
+    if (clock_hand >= resident.size()) {
+      clock_hand = 0;
+    }
+    const unsigned slot = resident[clock_hand];
+    if (tiles[slot]->referenced.exchange(false)) {
+      // second chance
+      ++clock_hand;
+      continue;
+    }
+    slots[slot].store(nullptr);
+    // reader registered after this increment can't see the tile.
+    retired.push_back({ std::move(tiles[slot]), epoch.fetch_add(1) });
+    resident[clock_hand] = resident.back();
+    resident.pop_back();
+    return;
+  }
+}
+
+std::unique_ptr<TerrainTiles::Tile> TerrainTiles::Load(unsigned slot) const {
+  const Entry& entry = entries[slot];
+  const size_t tile_bytes = tile_pixels * sizeof(short);
+
+  try {
+    auto tile = std::make_unique<Tile>(tile_pixels);
+    if (fseek(file, static_cast<long>(entry.offset), SEEK_SET) != 0) {
+      return nullptr;
+    }
+    if (entry.size == tile_bytes) {
+      // not compressed
+      if (fread(tile->data.get(), 1, tile_bytes, file) != tile_bytes) {
+        return nullptr;
+      }
+    } else {
+      auto compressed = std::make_unique<Bytef[]>(entry.size);
+      if (fread(compressed.get(), 1, entry.size, file) != entry.size) {
+        return nullptr;
+      }
+      uLongf size = tile_bytes;
+      if (uncompress(reinterpret_cast<Bytef*>(tile->data.get()), &size, compressed.get(), entry.size) != Z_OK
+            || size != tile_bytes) {
+        return nullptr;
+      }
+    }
+    return tile;
+  } catch (std::bad_alloc&) {
+    return nullptr;
+  }
+}
+
+bool TerrainTiles::Convert(const TCHAR* src, const TCHAR* dst, unsigned level_count, unsigned tile_size) {
+  if (!IsPowerOfTwo(tile_size) || !level_count || level_count > max_level_count) {
+    return false;
+  }
+
+  TILED_TERRAIN_HEADER header = {};
+  std::copy(std::begin(tiled_magic), std::end(tiled_magic), header.Magic);
+  header.TileSize = tile_size;
+  header.LevelCount = level_count;
+
+  std::vector<std::vector<short>> data(level_count);
+  try {
+    FILE* in = _tfopen(src, _T("rb"));
+    if (!in) {
+      return false;
+    }
+    bool valid = (fread(&header.Info, sizeof(header.Info), 1, in) == 1)
+                    && (header.Info.StepSize > 0) && header.Info.Rows && header.Info.Columns;
+    if (valid) {
+      const size_t nsize = size_t(header.Info.Rows) * header.Info.Columns;
+      data[0].resize(nsize);
+      valid = (fread(data[0].data(), sizeof(short), nsize, in) == nsize);
+    }
+    fclose(in);
+    if (!valid) {
+      return false;
+    }
+
+    unsigned rows = header.Info.Rows;
+    unsigned columns = header.Info.Columns;
+    for (unsigned i = 1; i < level_count; ++i) {
+      data[i] = Overview(data[i - 1], rows, columns);
+      rows = (rows + 1) / 2;
+      columns = (columns + 1) / 2;
+    }
+  } catch (std::bad_alloc&) {
+    return false;
+  }
+
+  FILE* out = _tfopen(dst, _T("wb"));
+  if (!out) {
+    return false;
+  }
+
+  std::vector<TILED_TERRAIN_ENTRY> entries;
+  unsigned rows = header.Info.Rows;
+  unsigned columns = header.Info.Columns;
+  for (unsigned i = 0; i < level_count; ++i) {
+    entries.resize(entries.size() + TileCount(columns, tile_size) * TileCount(rows, tile_size));
+    rows = (rows + 1) / 2;
+    columns = (columns + 1) / 2;
+  }
+
+  bool success = (fwrite(&header, sizeof(header), 1, out) == 1)
+                    && (fwrite(entries.data(), sizeof(TILED_TERRAIN_ENTRY), entries.size(), out) == entries.size());
+
+  const size_t tile_pixels = size_t(tile_size) * tile_size;
+  const uLong tile_bytes = tile_pixels * sizeof(short);
+  std::vector<short> tile(tile_pixels);
+  std::vector<Bytef> compressed(compressBound(tile_bytes));
+
+  rows = header.Info.Rows;
+  columns = header.Info.Columns;
+  auto entry = entries.begin();
+  for (unsigned i = 0; success && i < level_count; ++i) {
+    for (unsigned ty = 0; success && ty < TileCount(rows, tile_size); ++ty) {
+      for (unsigned tx = 0; success && tx < TileCount(columns, tile_size); ++tx, ++entry) {
+        bool empty = true;
+        for (unsigned y = 0; y < tile_size; ++y) {
+          for (unsigned x = 0; x < tile_size; ++x) {
+            const unsigned px = tx * tile_size + x;
+            const unsigned py = ty * tile_size + y;
+            const short h = (px < columns && py < rows) ? data[i][size_t(py) * columns + px] : TERRAIN_INVALID;
+            tile[size_t(y) * tile_size + x] = h;
+            empty = empty && (h == TERRAIN_INVALID);
+          }
+        }
+        if (empty) {
+          continue;
+        }
+
+        const long offset = ftell(out);
+        if (offset < 0) {
+          // file larger than LONG_MAX
+          success = false;
+          continue;
+        }
+        entry->Offset = offset;
+        uLongf size = compressed.size();
+        if (compress2(compressed.data(), &size, reinterpret_cast<const Bytef*>(tile.data()), tile_bytes, Z_BEST_COMPRESSION) == Z_OK
+                && size < tile_bytes) {
+          entry->Size = size;
+          success = (fwrite(compressed.data(), 1, size, out) == size);
+        } else {
+          entry->Size = tile_bytes;
+          success = (fwrite(tile.data(), 1, tile_bytes, out) == tile_bytes);
+        }
+      }
+    }
+    rows = (rows + 1) / 2;
+    columns = (columns + 1) / 2;
+  }
+
+  success = success && (fseek(out, sizeof(header), SEEK_SET) == 0)
+                    && (fwrite(entries.data(), sizeof(TILED_TERRAIN_ENTRY), entries.size(), out) == entries.size());
+
+  return (fclose(out) == 0) && success;
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+#include <thread>
+#include <chrono>
+#include "utils/filesystem.h"
+
+namespace {
+
+  // random heights with large invalid area (empty tiles)
+  std::vector<short> WriteDemFile(const TCHAR* path, const TERRAIN_INFO& info) {
+    std::mt19937 gen(17);
+    std::uniform_int_distribution<short> height(-200, 4800);
+
+    std::vector<short> data(size_t(info.Rows) * info.Columns);
+    for (unsigned y = 0; y < info.Rows; ++y) {
+      for (unsigned x = 0; x < info.Columns; ++x) {
+        data[size_t(y) * info.Columns + x] = (x < 150 && y < 140) ? TERRAIN_INVALID : height(gen);
+      }
+    }
+
+    FILE* file = _tfopen(path, _T("wb"));
+    if (file) {
+      fwrite(&info, sizeof(info), 1, file);
+      fwrite(data.data(), sizeof(short), data.size(), file);
+      fclose(file);
+    }
+    return data;
+  }
+
+} // namespace
+
+TEST_CASE("terrain tiles") {
+  const TCHAR* dem_path = _T("terrain_tiles_test.dem");
+  const TCHAR* tiled_path = _T("terrain_tiles_test_tiled.dem");
+  const TERRAIN_INFO info = { 6., 8.5, 46., 44., 1. / 200., 401, 501 };
+  const std::vector<short> data = WriteDemFile(dem_path, info);
+
+  REQUIRE(TerrainTiles::Convert(dem_path, tiled_path, 3, 64));
+  CHECK_FALSE(TerrainTiles::IsTiledFile(dem_path));
+  CHECK(TerrainTiles::IsTiledFile(tiled_path));
+
+  auto flat = std::make_shared<RasterMap>();
+  auto tiled = std::make_shared<RasterMap>();
+  REQUIRE(flat->Open(dem_path));
+  REQUIRE(tiled->Open(tiled_path));
+
+  SUBCASE("sampler") {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> lat(43.9, 46.1);
+    std::uniform_real_distribution<double> lon(5.9, 8.6);
+
+    // full resolution : same result as row major file.
+    for (double rounding : { 0., 1. / 200. }) {
+      const TerrainSampler flat_sampler(flat, rounding, rounding);
+      const TerrainSampler tiled_sampler(tiled, rounding, rounding);
+      REQUIRE(tiled_sampler.IsValid());
+      for (int i = 0; i < 20000; ++i) {
+        const double y = lat(gen);
+        const double x = lon(gen);
+        CHECK_EQ(tiled_sampler.GetField(y, x), flat_sampler.GetField(y, x));
+      }
+    }
+
+    // rounding 4 : use level 2 overview
+    const std::vector<short> level1 = Overview(data, info.Rows, info.Columns);
+    const std::vector<short> level2 = Overview(level1, (info.Rows + 1) / 2, (info.Columns + 1) / 2);
+    const unsigned columns2 = (info.Columns + 3) / 4;
+
+    const TerrainSampler sampler(tiled, 4. / 200., 4. / 200.);
+    for (int i = 0; i < 20000; ++i) {
+      const double y = lat(gen);
+      const double x = lon(gen);
+      if (y > info.Top || x < info.Left) {
+        continue;
+      }
+      const unsigned lx = uround((x - info.Left) * 50.) * 4;
+      const unsigned ly = uround((info.Top - y) * 50.) * 4;
+      const short expected = (lx < info.Columns && ly < info.Rows)
+                                ? level2[size_t(ly / 4) * columns2 + (lx / 4)]
+                                : TERRAIN_INVALID;
+      CHECK_EQ(sampler.GetField(y, x), expected);
+    }
+  }
+
+  SUBCASE("eviction") {
+    TERRAIN_INFO tiles_info;
+    // room for 4 tiles
+    auto tiles = TerrainTiles::Open(tiled_path, tiles_info, 4 * 64 * 64 * sizeof(short));
+    REQUIRE(tiles);
+    CHECK_EQ(tiles->LevelCount(), 3);
+
+    for (unsigned y = 0; y < info.Rows; ++y) {
+      for (unsigned x = 0; x < info.Columns; ++x) {
+        REQUIRE_EQ(tiles->GetHeight(0, x, y), data[size_t(y) * info.Columns + x]);
+      }
+    }
+    CHECK_LE(tiles->ResidentSize(), 4 * 64 * 64 * sizeof(short));
+
+    // concurrent readers with cache much smaller than working set,
+    // at any time at least one reader is registered.
+    std::vector<std::thread> threads;
+    std::atomic<unsigned> errors = { 0 };
+    std::atomic<size_t> max_used = { 0 };
+    for (unsigned t = 0; t < 4; ++t) {
+      threads.emplace_back([&, t]() {
+        std::mt19937 gen(t);
+        std::uniform_int_distribution<unsigned> px(0, info.Columns - 2);
+        std::uniform_int_distribution<unsigned> py(0, info.Rows - 2);
+        for (int batch = 0; batch < 500; ++batch) {
+          // odd thread register once per batch, even thread once per query.
+          const TerrainTiles::ReadScope scope((t % 2) ? tiles.get() : nullptr);
+          for (int i = 0; i < 20; ++i) {
+            const unsigned x = px(gen);
+            const unsigned y = py(gen);
+            short h[4];
+            tiles->GetQuad(x, y, h);
+            if (h[0] != data[size_t(y) * info.Columns + x] || h[2] != data[size_t(y + 1) * info.Columns + x + 1]) {
+              ++errors;
+            }
+          }
+          const size_t used = tiles->ResidentSize() + tiles->RetiredSize();
+          size_t expected = max_used.load();
+          while (used > expected && !max_used.compare_exchange_weak(expected, used)) { }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    CHECK_EQ(errors.load(), 0);
+
+    // evicted tiles are deleted while other threads are reading, cache size is never exceeded.
+    CHECK_LE(max_used.load(), 4 * 64 * 64 * sizeof(short));
+  }
+
+  SUBCASE("more readers than slots") {
+    TERRAIN_INFO tiles_info;
+    auto tiles = TerrainTiles::Open(tiled_path, tiles_info, 4 * 64 * 64 * sizeof(short));
+    REQUIRE(tiles);
+
+    // 64 reader slots : extra readers wait until a scope is released.
+    std::vector<std::thread> threads;
+    std::atomic<unsigned> errors = { 0 };
+    std::atomic<unsigned> inside = { 0 };
+    std::atomic<unsigned> max_inside = { 0 };
+    for (unsigned t = 0; t < 80; ++t) {
+      threads.emplace_back([&, t]() {
+        const unsigned x = (t * 37) % (info.Columns - 1);
+        const unsigned y = (t * 53) % (info.Rows - 1);
+        for (int batch = 0; batch < 5; ++batch) {
+          const TerrainTiles::ReadScope scope(tiles.get());
+          const unsigned count = ++inside;
+          unsigned expected = max_inside.load();
+          while (count > expected && !max_inside.compare_exchange_weak(expected, count)) { }
+          std::this_thread::sleep_for(std::chrono::milliseconds(10));
+          if (tiles->GetHeight(0, x, y) != data[size_t(y) * info.Columns + x]) {
+            ++errors;
+          }
+          --inside;
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    CHECK_EQ(errors.load(), 0);
+    CHECK_LE(max_inside.load(), 64);
+  }
+
+  flat = nullptr;
+  tiled = nullptr;
+  lk::filesystem::deleteFile(dem_path);
+  lk::filesystem::deleteFile(tiled_path);
+}
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   TerrainTiles.h
+ */
+
+#ifndef TERRAINTILES_H
+#define TERRAINTILES_H
+
+#include <cstdint>
+#include <cstdio>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <tchar.h>
+#include "Thread/Mutex.hpp"
+#include "Thread/Cond.hpp"
+
+struct TERRAIN_INFO;
+
+/**
+ * Tiled terrain file, alternative storage of .dem file.
+ *
+ * File layout (little endian) :
+ *   TILED_TERRAIN_HEADER
+ *   TILED_TERRAIN_ENTRY[] : one entry for each tile of each level
+ *   tile data
+ *
+ * Level 0 is full resolution, level n is an overview of level n-1 where each
+ * pixel is the mean of 2x2 valid pixels. Each tile is TileSize x TileSize
+ * pixels row major, right and bottom tiles are padded with TERRAIN_INVALID.
+ * tile data is zlib compressed unless compressed size is not smaller than raw size.
+ * Tile with only invalid pixels have no data.
+ *
+ * Header start with magic bytes that are a NaN when read as TERRAIN_INFO::Left,
+ * so tiled file can't be confused with row major .dem file.
+ *
+ * Tiles are loaded on demand into a cache, reader never lock :
+ *  - resident tiles are published with atomic pointer.
+ *  - tiles are evicted using clock (second chance) algorithm when the cache is full.
+ *  - each reader publish in its own slot the epoch at which it started reading,
+ *    evicted tiles are deleted once all readers started after eviction (epoch based reclamation).
+ *  - loading wait for reclamation when retired tiles reach a quarter of the cache,
+ *    end of ReadScope wake it up.
+ */
+class TerrainTiles final {
+  TerrainTiles(const TerrainTiles&) = delete;
+  TerrainTiles& operator=(const TerrainTiles&) = delete;
+
+public:
+  ~TerrainTiles();
+
+  /**
+   * @return true if <filename> start with tiled terrain magic bytes
+   */
+  static bool IsTiledFile(const TCHAR* filename);
+
+  /**
+   * @info : filled with full resolution terrain info.
+   * @cache_size : max memory used by cached tiles in bytes.
+   * @return nullptr in case of failure.
+   */
+  static std::unique_ptr<TerrainTiles> Open(const TCHAR* filename, TERRAIN_INFO& info, size_t cache_size);
+
+  /**
+   * convert row major .dem file to tiled file.
+   * whole terrain and overviews are loaded in memory during conversion.
+   */
+  static bool Convert(const TCHAR* src, const TCHAR* dst,
+                      unsigned level_count = 4, unsigned tile_size = 256);
+
+  unsigned LevelCount() const {
+    return levels.size();
+  }
+
+  short GetHeight(unsigned level, unsigned x, unsigned y) const;
+
+  /**
+   * level 0 pixel (x,y), (x+1,y), (x+1,y+1), (x,y+1)
+   */
+  void GetQuad(unsigned x, unsigned y, short (&h)[4]) const;
+
+  // memory used by resident tiles in bytes
+  size_t ResidentSize() const;
+
+  // memory used by evicted tiles not yet deleted, in bytes
+  size_t RetiredSize() const;
+
+  /**
+   * register current thread as reader of <tiles> (can be nullptr) for a batch of queries,
+   * GetHeight() and GetQuad() called inside a scope don't need to register again.
+   * must be released quickly : tiles evicted since current thread last loaded a tile
+   * can't be deleted while it exists.
+   */
+  class ReadScope final {
+  public:
+    explicit ReadScope(const TerrainTiles* tiles);
+    ~ReadScope();
+
+    ReadScope(const ReadScope&) = delete;
+    ReadScope& operator=(const ReadScope&) = delete;
+
+    struct current_t {
+      const TerrainTiles* tiles;
+      std::atomic<uint64_t>* slot;
+    };
+
+  private:
+    const TerrainTiles* const _tiles;
+    current_t _previous = { nullptr, nullptr }; // restored at end of scope
+    std::atomic<uint64_t>* _slot = nullptr; // nullptr for nested scope
+  };
+
+private:
+  TerrainTiles() = default;
+
+  struct Tile {
+    explicit Tile(size_t size) : data(std::make_unique<short[]>(size)) {}
+
+    mutable std::atomic<bool> referenced = { true };
+    std::unique_ptr<short[]> data;
+  };
+
+  struct Level {
+    unsigned rows;
+    unsigned columns;
+    unsigned tiles_x;
+    unsigned tiles_y;
+    unsigned first_slot; // index of first tile of this level in <slots>
+  };
+
+  struct Entry {
+    uint64_t offset;
+    uint32_t size; // 0 : all pixels are invalid
+  };
+
+  static constexpr unsigned max_readers = 64;
+
+  struct alignas(64) ReaderSlot {
+    // epoch at which reader started, 0 if free
+    std::atomic<uint64_t> epoch = { 0 };
+  };
+
+  struct RetiredTile {
+    std::unique_ptr<Tile> tile;
+    uint64_t epoch; // epoch at which tile was evicted
+  };
+
+  std::atomic<uint64_t>* Register() const;
+  std::atomic<uint64_t>* TryRegister() const;
+  void Unregister(std::atomic<uint64_t>* slot) const;
+
+  unsigned Slot(const Level& level, unsigned x, unsigned y) const {
+    return level.first_slot + (y >> tile_shift) * level.tiles_x + (x >> tile_shift);
+  }
+
+  short Pixel(const Tile* tile, unsigned x, unsigned y) const {
+    return tile->data[((y & tile_mask) << tile_shift) + (x & tile_mask)];
+  }
+
+  /**
+   * @return resident tile, nullptr if tile is empty or can't be loaded.
+   *   caller must own a ReadScope
+   */
+  const Tile* Acquire(unsigned slot) const;
+  const Tile* PageIn(unsigned slot) const;
+  std::unique_ptr<Tile> Load(unsigned slot) const;
+  void Evict() const;
+  void Reclaim() const;
+
+  std::vector<Level> levels;
+  std::vector<Entry> entries;
+
+  unsigned tile_shift = 0;
+  unsigned tile_mask = 0;
+  size_t tile_pixels = 0;
+  size_t max_tiles = 0; // resident and retired tiles
+  size_t max_retired = 0;
+
+  std::unique_ptr<std::atomic<const Tile*>[]> slots;
+
+  mutable ReaderSlot readers[max_readers];
+  mutable std::atomic<uint64_t> epoch = { 1 };
+  mutable std::atomic<unsigned> waiters = { 0 }; // threads waiting for <released>
+
+  // protect all members below
+  mutable Mutex mutex;
+  mutable Cond released; // reader slot released or reader epoch updated
+  FILE* file = nullptr;
+  mutable std::vector<std::unique_ptr<Tile>> tiles; // owner of resident tiles, indexed by slot
+  mutable std::vector<unsigned> resident; // clock ring of resident slots
+  mutable size_t clock_hand = 0;
+  mutable std::vector<RetiredTile> retired; // evicted tiles that can still be read
+};
+
+#endif /* TERRAINTILES_H */
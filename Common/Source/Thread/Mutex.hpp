@@ -28,7 +28,16 @@ struct LockableMutex : BaseMutex {
 using Mutex = LockableMutex<Poco::Mutex>;
 using FastMutex = LockableMutex<Poco::FastMutex>;
 
-using ScopeLock = Poco::ScopedLock<Mutex>;
+// mutex type is deduced, so lock() of class derived from Mutex is used (see profiler::timed_mutex)
+template<typename _Mutex>
+class ScopeLock : public Poco::ScopedLock<_Mutex> {
+public:
+    using Poco::ScopedLock<_Mutex>::ScopedLock;
+};
+
+template<typename _Mutex>
+ScopeLock(_Mutex&) -> ScopeLock<_Mutex>;
+
 using ScopeUnlock = Poco::ScopedUnlock<Mutex>;
 
 /**
@@ -14,6 +14,8 @@
 #include "Calc/Vario.h"
 #include "LKInterface.h"
 #include "OS/Sleep.h"
+#include "Time/PeriodClock.hpp"
+#include "utils/profiler.h"
 
 #ifndef ENABLE_OPENGL
 extern bool OnFastPanning;
@@ -62,6 +64,7 @@ public:
 
         Sleep(1000); // 091213  BUGFIX need to syncronize !!! TOFIX02 TODO
 
+        profiler_clock.Update();
         while (!MapWindow::CLOSETHREAD) {
 
             if (dataTriggerEvent.tryWait(5000)) dataTriggerEvent.reset();
@@ -149,12 +152,21 @@ public:
 
             ExternalDeviceSendTarget();
             SendDataToExternalDevice(tmpGPS, tmpCALCULATED);
+
+            if (profiler::enabled && profiler_clock.CheckUpdate(60000)) {
+                profiler::Dump();
+            }
+        }
+
+        if (profiler::enabled) {
+            profiler::Dump();
         }
     }
 
 private:
     NMEA_INFO tmpGPS;
     DERIVED_INFO tmpCALCULATED;
+    PeriodClock profiler_clock;
 };
 
 CalculationThread _CalculationThread;
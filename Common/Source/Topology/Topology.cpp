@@ -23,7 +23,13 @@
 #include "Utils.h"
 
 #include "ShapePolygonRenderer.h"
+#include "TopologyStore.h"
 #include "shapelib/mapshape.h"
+#include "utils/filesystem.h"
+#include "Poco/Event.h"
+#include "utils/profiler.h"
+#include <atomic>
+#include <algorithm>
 
 //#define DEBUG_TFC
 
@@ -47,6 +53,38 @@ void XShape::load(shapefileObj* shpfile, int i) {
 }
 
 
+XShapeView::~XShapeView() {
+  clear();
+}
+
+
+void XShapeView::clear() {
+  // <shape> and <label> point to storage owned by this or by TopologyStore
+  msInitShape(&shape);
+  label = nullptr;
+}
+
+
+void XShapeView::Load(const TopologyStore& store, unsigned i) {
+  store.Decode(i, shape, lines, points);
+  hide = store.Hidden(i);
+
+  const char* utf8 = store.Label(i);
+  if (!utf8) {
+    label = nullptr;
+    return;
+  }
+#ifdef UNICODE
+  label_buffer.resize(from_utf8(utf8, static_cast<TCHAR*>(nullptr), 0) + 1);
+  from_utf8(utf8, label_buffer.data(), label_buffer.size());
+  label = label_buffer.data();
+#else
+  // never modified, XShapeLabel::clearLabel() is not used
+  label = const_cast<TCHAR*>(utf8);
+#endif
+}
+
+
 void Topology::loadBitmap(const int xx) {
   hBitmap.LoadFromResource(MAKEINTRESOURCE(xx));
 }
@@ -152,6 +190,7 @@ Topology::Topology(const TCHAR* shpname, int field1) {
   shps = NULL;
   cache_mode = 0;
   lastBounds.minx = lastBounds.miny = lastBounds.maxx = lastBounds.maxy = 0;
+  cache_generation = 0;
 
   in_scale = false;
 
@@ -290,9 +329,50 @@ void Topology::initCache() {
 }
 
 
+bool Topology::OpenStore() {
+  tstring shp_path = from_utf8(filename);
+  tstring store_path = shp_path;
+  const size_t ext = store_path.rfind(_T('.'));
+  if (ext != tstring::npos) {
+    store_path.resize(ext);
+  }
+  store_path += _T(LKS_TOPOLOGY_STORE);
+
+  if (!lk::filesystem::isFile(store_path.c_str())) {
+    return false;
+  }
+
+  std::unique_ptr<TopologyStore> topology_store = TopologyStore::Open(store_path.c_str());
+  if (!topology_store) {
+    return false;
+  }
+  if (topology_store->Field() != field) {
+    StartupStore(_T("------ Topology: label field mismatch, ignored <%s>"), store_path.c_str());
+    return false;
+  }
+  // store is out of date if shapefile was replaced after conversion
+  const size_t shp_size = lk::filesystem::getFileSize(shp_path.c_str());
+  if (shp_size && topology_store->SourceSize() && shp_size != topology_store->SourceSize()) {
+    StartupStore(_T("------ Topology: outdated, ignored <%s>"), store_path.c_str());
+    return false;
+  }
+
+  store = std::move(topology_store);
+  store_visible.clear();
+  in_scale_last = false;
+  return true;
+}
+
+
 void Topology::Open() {
   shapefileopen = false;
 
+  if (OpenStore()) {
+    scaleThreshold = 1000.0;
+    shapefileopen = true;
+    return;
+  }
+
   if (msShapefileOpen(&shpfile, "rb", filename, true) == -1) {
     StartupStore(_T("------ Topology: Open FAILED for <%s>"), from_utf8(filename).c_str());
     return;
@@ -310,6 +390,16 @@ void Topology::Open() {
 
 
 void Topology::Close() {
+  pending_update = nullptr;
+  prefetched.clear();
+
+  if (store) {
+    store = nullptr;
+    store_visible.clear();
+    shapefileopen = false;
+    return;
+  }
+
   if (shapefileopen) {
     if (shpCache) {
       flushCache();
@@ -355,6 +445,11 @@ void Topology::flushCache() {
   PeriodClock starttick;
   starttick.Update();
 #endif
+  if (store) {
+    store_visible.clear();
+    shapes_visible_count = 0;
+    return;
+  }
   switch (cache_mode) {
 	case 0:  // Original
 	case 1:  // Bounds array in memory
@@ -369,15 +464,16 @@ void Topology::flushCache() {
 		break;
   }//sw
   shapes_visible_count = 0;
+  ++cache_generation;
 #ifdef DEBUG_TFC
   StartupStore(TEXT("   flushCache() ends (%dms)%s"),starttick.Elapsed(),NEWLINE);
 #endif
 }
 
-void Topology::updateCache(rectObj thebounds, bool purgeonly) {
+void Topology::updateCache(rectObj thebounds, bool purgeonly, const rectObj* prefetch) {
   if (!triggerUpdateCache) return;
 
-  if (!shapefileopen || !shpCache) return;
+  if (!shapefileopen || (!store && !shpCache)) return;
 
   in_scale = CheckScale();
 
@@ -397,6 +493,15 @@ void Topology::updateCache(rectObj thebounds, bool purgeonly) {
 
   triggerUpdateCache = false;
 
+  if (store) {
+    // nothing to load : shapes are decoded from memory mapped file when drawn
+    store->WhichShapes(thebounds, store_visible);
+    shapes_visible_count = store_visible.size();
+    in_scale_last = in_scale;
+    lastBounds = thebounds;
+    return;
+  }
+
 #ifdef DEBUG_TFC
   StartupStore(TEXT("---UpdateCache() starts, mode%d%s"),cache_mode,NEWLINE);
   PeriodClock starttick;
@@ -411,6 +516,28 @@ void Topology::updateCache(rectObj thebounds, bool purgeonly) {
     return;
   }
 
+  if (cache_mode != 2) {
+    // install previous result first, so it's not loaded again
+    ApplyPendingCache();
+
+    cache_request request = {
+      thebounds,
+      prefetch ? *prefetch : thebounds,
+      prefetch != nullptr,
+      cache_generation,
+      std::vector<bool>(shpfile.numshapes)
+    };
+    for (int i = 0; i < shpfile.numshapes; i++) {
+      request.present[i] = (shpCache[i] != nullptr);
+    }
+    if (TopologyLoader::Post(this, std::move(request))) {
+      // shapes are loaded by TopologyLoader thread, draw previous cache until ready.
+      in_scale_last = in_scale;
+      lastBounds = thebounds;
+      return;
+    }
+  }
+
   bool smaller = false;
   bool bigger = false;
   bool in_scale_again = in_scale && !in_scale_last;
@@ -511,7 +638,59 @@ void Topology::updateCache(rectObj thebounds, bool purgeonly) {
 }
 
 
+std::vector<bool> Topology::whichShapes(const rectObj& bounds) {
+  std::vector<bool> result(shpfile.numshapes, false);
+  if (msRectOverlap(&shpfile.bounds, &bounds) != MS_TRUE) {
+    return result;
+  }
+  if (cache_mode == 1) {
+    for (int i = 0; i < shpfile.numshapes; i++) {
+      result[i] = (msRectOverlap(&shpBounds[i], &bounds) == MS_TRUE);
+    }
+  } else {
+    ScopeLock lock(file_mutex);
+    msShapefileWhichShapes(&shpfile, bounds, 0);
+    if (shpfile.status) {
+      for (int i = 0; i < shpfile.numshapes; i++) {
+        result[i] = msGetBit(shpfile.status, i);
+      }
+    }
+  }
+  return result;
+}
+
+Topology::cache_update::~cache_update() {
+  for (auto& item : shapes) {
+    delete item.second;
+  }
+}
+
+void Topology::ApplyPendingCache() {
+  std::unique_ptr<cache_update> update = WithLock(pending_mutex, [&]() {
+    return std::move(pending_update);
+  });
+  if (!update || update->generation != cache_generation) {
+    return; // nothing to do or cache was flushed after request.
+  }
+
+  for (auto& item : update->shapes) {
+    if (!shpCache[item.first]) {
+      shpCache[item.first] = std::exchange(item.second, nullptr);
+    }
+  }
+
+  shapes_visible_count = 0;
+  for (int i = 0; i < shpfile.numshapes; i++) {
+    if (!update->wanted[i]) {
+      removeShape(i);
+    } else if (shpCache[i]) {
+      ++shapes_visible_count;
+    }
+  }
+}
+
 XShape* Topology::addShape(const int i) {
+  ScopeLock lock(file_mutex);
   if(field < 0) {
     XShape* theshape = new(std::nothrow) XShape();
     if(theshape) {
@@ -631,11 +810,8 @@ void Topology::Paint(ShapeSpecialRenderer& renderer, LKSurface& Surface, const R
 
   static std::vector<ScreenPoint> points;
 
-  for (const XShape* cshape : make_array(shpCache, shpfile.numshapes)) {
-    if (!cshape || cshape->hide)
-        continue;
-
-    const shapeObj& shape = cshape->shape;
+  auto paint_shape = [&](const XShape& cshape) {
+    const shapeObj& shape = cshape.shape;
 
     switch (shape.type) {
       case MS_SHAPE_POINT:
@@ -644,7 +820,7 @@ void Topology::Paint(ShapeSpecialRenderer& renderer, LKSurface& Surface, const R
             for (const pointObj& point : make_array(line.point, line.numpoints)) {
               if (msPointInRect(&point, &screenRect)) {
                 const POINT sc = _Proj.ToRasterPoint(point.y, point.x);
-                if (cshape->renderSpecial(renderer, Surface, sc.x, sc.y, rc)) {
+                if (cshape.renderSpecial(renderer, Surface, sc.x, sc.y, rc)) {
                   MapWindow::DrawBitmapIn(Surface, sc, hBitmap);
                 }
               }
@@ -658,7 +834,7 @@ void Topology::Paint(ShapeSpecialRenderer& renderer, LKSurface& Surface, const R
           for (const lineObj& line : make_array(shape.line, shape.numlines)) {
             const ScreenPoint ptLabel = shape2Screen<ScreenPoint>(line, _Proj, points);
             Surface.Polyline(points.data(), points.size(), rc);
-            cshape->renderSpecial(renderer, Surface, ptLabel.x, ptLabel.y, rc);
+            cshape.renderSpecial(renderer, Surface, ptLabel.x, ptLabel.y, rc);
           }
         }
         break;
@@ -667,14 +843,37 @@ void Topology::Paint(ShapeSpecialRenderer& renderer, LKSurface& Surface, const R
         // if it's a water area (nolabels), print shape up to defaultShape, but print
         // labels only up to custom label levels
         if (checkVisible(shape, screenRect)) {
-          shape_renderer.renderPolygon(renderer, Surface, *cshape, hbBrush, _Proj);
+          shape_renderer.renderPolygon(renderer, Surface, cshape, hbBrush, _Proj);
         }
         break;
 
       default:
         break;
     }
+  };
+
+  if (store) {
+    static XShapeView shape_view;
+    for (unsigned i : store_visible) {
+      if (store->Hidden(i)) {
+        continue;
+      }
+      // don't decode shapes outside of screen
+      const rectObj bounds = store->ShapeBounds(i);
+      if (msRectOverlap(&bounds, &screenRect) != MS_TRUE) {
+        continue;
+      }
+      shape_view.Load(*store, i);
+      paint_shape(shape_view);
+    }
+  } else {
+    for (const XShape* cshape : make_array(shpCache, shpfile.numshapes)) {
+      if (cshape && !cshape->hide) {
+        paint_shape(*cshape);
+      }
+    }
   }
+
   if (hbOld) {
     Surface.SelectObject(hbOld);
   }
@@ -848,28 +1047,13 @@ void Topology::SearchNearest(const rectObj& bounds) {
 
   if (!shapefileopen) return;
 
-  if(msRectOverlap(&shpfile.bounds, &bounds) != MS_TRUE) {
-    return;
-  }
-
-  for (int ixshp = 0; ixshp < shpfile.numshapes; ixshp++) {
+  auto search_shape = [&](const XShape* cshape) {
 
-    std::unique_ptr<XShape> shape_tmp;
-    XShape *cshape = shpCache[ixshp];
-    if(!cshape) {
-      if((cache_mode == 1) && (msRectOverlap(&shpBounds[ixshp], &bounds) != MS_TRUE)) {
-          // if bounds is in cache and does not overlap no need to load shape;
-          continue;
-      }
-      shape_tmp.reset(addShape(ixshp));
-      cshape = shape_tmp.get();
-    }
-
-	if (!cshape || cshape->hide || !cshape->HasLabel()) continue;
+	if (!cshape || cshape->hide || !cshape->HasLabel()) return;
 	const shapeObj& shape = cshape->shape;
 
     if(msRectOverlap(&(cshape->shape.bounds), &bounds) != MS_TRUE) {
-        continue;
+        return;
     }
 
 	switch(shape.type) {
@@ -907,5 +1091,217 @@ void Topology::SearchNearest(const rectObj& bounds) {
 		break;
 
     } // switch type of shape
+  };
+
+  if (store) {
+    // called by WhereAmI thread, draw thread shape view and visible list can't be used
+    XShapeView shape_view;
+    std::vector<unsigned> candidates;
+    store->WhichShapes(bounds, candidates);
+    for (unsigned i : candidates) {
+      if (store->Label(i) && !store->Hidden(i)) {
+        shape_view.Load(*store, i);
+        search_shape(&shape_view);
+      }
+    }
+    return;
+  }
+
+  if(msRectOverlap(&shpfile.bounds, &bounds) != MS_TRUE) {
+    return;
+  }
+
+  for (int ixshp = 0; ixshp < shpfile.numshapes; ixshp++) {
+
+    std::unique_ptr<XShape> shape_tmp;
+    XShape *cshape = shpCache[ixshp];
+    if(!cshape) {
+      if((cache_mode == 1) && (msRectOverlap(&shpBounds[ixshp], &bounds) != MS_TRUE)) {
+          // if bounds is in cache and does not overlap no need to load shape;
+          continue;
+      }
+      shape_tmp.reset(addShape(ixshp));
+      cshape = shape_tmp.get();
+    }
+
+    search_shape(cshape);
   } // for all shapes in this category
 } // Topology SearchNearest
+
+namespace {
+
+  std::atomic<unsigned> stat_requests = {0};
+  std::atomic<unsigned> stat_loads = {0};
+  std::atomic<unsigned> stat_prefetch_hits = {0};
+  std::atomic<unsigned> stat_prefetch_loads = {0};
+
+} // namespace
+
+void Topology::LoadCache(const cache_request& request) {
+  profiler::scope timing(profiler::TopologyLoad);
+
+  const std::vector<bool> wanted = whichShapes(request.bounds);
+
+  auto update = std::make_unique<cache_update>();
+  update->generation = request.generation;
+  update->wanted = wanted;
+
+  for (int i = 0; i < shpfile.numshapes; i++) {
+    if (!wanted[i] || request.present[i]) {
+      continue;
+    }
+    XShape* shape = nullptr;
+    auto it = prefetched.find(i);
+    if (it != prefetched.end()) {
+      shape = it->second.release();
+      prefetched.erase(it);
+      ++stat_prefetch_hits;
+    } else {
+      shape = addShape(i);
+      ++stat_loads;
+    }
+    if (shape) {
+      update->shapes.emplace_back(i, shape);
+    }
+  }
+
+  // publish before prefetch, draw thread don't have to wait for it.
+  WithLock(pending_mutex, [&]() {
+    pending_update = std::move(update);
+  });
+  ++stat_requests;
+
+  if (!request.has_prefetch) {
+    return;
+  }
+
+  const std::vector<bool> ahead = whichShapes(request.prefetch);
+  // forget shapes no more ahead
+  for (auto it = prefetched.begin(); it != prefetched.end(); ) {
+    if (ahead[it->first]) {
+      ++it;
+    } else {
+      it = prefetched.erase(it);
+    }
+  }
+  for (int i = 0; i < shpfile.numshapes; i++) {
+    if (ahead[i] && !wanted[i] && !request.present[i] && !prefetched.count(i)) {
+      std::unique_ptr<XShape> shape(addShape(i));
+      if (shape) {
+        prefetched.emplace(i, std::move(shape));
+        ++stat_prefetch_loads;
+      }
+    }
+  }
+}
+
+namespace {
+
+  Mutex request_mutex;
+  std::vector<std::pair<Topology*, Topology::cache_request>> requests;
+
+  // static : can be signaled after loader thread is stopped
+  Poco::Event request_event;
+
+  class LoaderThread final : public Thread {
+  public:
+    LoaderThread() : Thread("TopologyLoader") {}
+
+    void Stop() {
+      _stop = true;
+      request_event.set();
+      Join();
+    }
+
+  protected:
+    void Run() override {
+      while (!_stop) {
+        request_event.wait();
+
+        std::vector<std::pair<Topology*, Topology::cache_request>> pending;
+        WithLock(request_mutex, [&]() {
+          pending.swap(requests);
+        });
+
+        for (auto& item : pending) {
+          if (_stop) {
+            break;
+          }
+          item.first->LoadCache(item.second);
+        }
+        if (!pending.empty()) {
+          MapWindow::RefreshMap();
+        }
+      }
+    }
+
+  private:
+    std::atomic<bool> _stop = {false};
+  };
+
+  std::unique_ptr<LoaderThread> loader_thread;
+  std::atomic<bool> loader_running = {false};
+
+} // namespace
+
+void TopologyLoader::Start() {
+  Stop();
+
+  stat_requests = 0;
+  stat_loads = 0;
+  stat_prefetch_hits = 0;
+  stat_prefetch_loads = 0;
+
+  loader_thread = std::make_unique<LoaderThread>();
+  if (loader_thread->Start()) {
+    loader_running = true;
+  } else {
+    loader_thread = nullptr;
+    StartupStore(_T("... Topology loader failed to start, cache is updated by draw thread"));
+  }
+}
+
+void TopologyLoader::Stop() {
+  if (!loader_thread) {
+    return;
+  }
+  loader_running = false;
+  loader_thread->Stop();
+  loader_thread = nullptr;
+
+  WithLock(request_mutex, []() {
+    requests.clear();
+  });
+
+  const Stats stats = GetStats();
+  StartupStore(_T(". Topology loader : %u updates, %u shapes loaded, %u prefetched (%u hits)"),
+               stats.requests, stats.loads, stats.prefetch_loads, stats.prefetch_hits);
+}
+
+bool TopologyLoader::Post(Topology* topology, Topology::cache_request&& request) {
+  if (!loader_running) {
+    return false;
+  }
+  WithLock(request_mutex, [&]() {
+    // only last request of each topology is useful
+    auto it = std::find_if(requests.begin(), requests.end(), [&](auto& item) {
+      return item.first == topology;
+    });
+    if (it != requests.end()) {
+      it->second = std::move(request);
+    } else {
+      requests.emplace_back(topology, std::move(request));
+    }
+  });
+  request_event.set();
+  return true;
+}
+
+TopologyLoader::Stats TopologyLoader::GetStats() {
+  return {
+    stat_requests,
+    stat_loads,
+    stat_prefetch_hits,
+    stat_prefetch_loads
+  };
+}
@@ -0,0 +1,1071 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   TopologyStore.cpp
+ */
+
+#include "externs.h"
+#include "Topology.h"
+#include "TopologyStore.h"
+#include "OS/ByteOrder.hpp"
+#include "utils/filesystem.h"
+#include "utils/zzip_stream.h"
+#include "utils/charset_helper.h"
+#include "shapelib/mapshape.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+
+static_assert(IsLittleEndian(), "Big-Endian Arch is not supported");
+
+struct TOPOLOGY_STORE_HEADER {
+  uint8_t Magic[8];
+  uint64_t SourceSize;
+  int32_t Field;
+  uint32_t ShapeCount;
+  uint32_t GridSize;
+  uint32_t IndexCount;
+  int32_t Bounds[4]; // minx, miny, maxx, maxy
+  uint32_t VertexSize;
+  uint32_t LabelSize;
+  uint32_t Reserved[2];
+};
+
+struct TOPOLOGY_STORE_SHAPE {
+  int32_t Bounds[4]; // minx, miny, maxx, maxy
+  uint32_t Vertex; // offset in vertex data
+  uint32_t Label; // offset in label data, no_label if none
+  uint8_t Type; // MS_SHAPE_*
+  uint8_t Hidden;
+  uint16_t Reserved;
+  uint32_t Reserved2;
+};
+
+static_assert(sizeof(TOPOLOGY_STORE_HEADER) == 64, "invalid header size");
+static_assert(sizeof(TOPOLOGY_STORE_SHAPE) == 32, "invalid shape entry size");
+
+namespace {
+
+constexpr uint8_t store_magic[8] = { 'L', 'K', 'T', 'O', 'P', 'O', 0x00, 0x01 };
+
+constexpr double store_scale = 1e7; // 1e-7 degree
+constexpr uint32_t no_label = UINT32_MAX;
+constexpr unsigned max_grid_size = 256;
+
+// <q> : coordinate in 1e-7 degree, already rounded
+int32_t Quantize(double q) {
+  if (q < INT32_MIN) {
+    return INT32_MIN;
+  }
+  if (q > INT32_MAX) {
+    return INT32_MAX;
+  }
+  return static_cast<int32_t>(q);
+}
+
+// rounded outward, so quantised bounds always contain original bounds
+void QuantizeBounds(const rectObj& rect, int32_t (&bounds)[4]) {
+  bounds[0] = Quantize(std::floor(rect.minx * store_scale));
+  bounds[1] = Quantize(std::floor(rect.miny * store_scale));
+  bounds[2] = Quantize(std::ceil(rect.maxx * store_scale));
+  bounds[3] = Quantize(std::ceil(rect.maxy * store_scale));
+}
+
+rectObj Dequantize(const int32_t (&bounds)[4]) {
+  return {
+    bounds[0] / store_scale,
+    bounds[1] / store_scale,
+    bounds[2] / store_scale,
+    bounds[3] / store_scale
+  };
+}
+
+bool Overlap(const int32_t (&a)[4], const int32_t (&b)[4]) {
+  return a[0] <= b[2] && a[2] >= b[0] && a[1] <= b[3] && a[3] >= b[1];
+}
+
+uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+void WriteVarint(std::vector<uint8_t>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+// return 0 if <p> reach <end>
+uint64_t ReadVarint(const uint8_t*& p, const uint8_t* end) {
+  uint64_t value = 0;
+  for (unsigned shift = 0; p < end && shift < 64; shift += 7) {
+    const uint8_t byte = *(p++);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      break;
+    }
+  }
+  return value;
+}
+
+unsigned Cell(int32_t value, int32_t min, int32_t max, unsigned grid_size) {
+  if (value <= min) {
+    return 0;
+  }
+  if (value >= max) {
+    return grid_size - 1;
+  }
+  return static_cast<unsigned>((int64_t(value) - min) * grid_size / (int64_t(max) - min + 1));
+}
+
+struct cell_range {
+  unsigned x0, y0, x1, y1;
+
+  unsigned Count() const {
+    return (x1 - x0 + 1) * (y1 - y0 + 1);
+  }
+};
+
+cell_range Cells(const TOPOLOGY_STORE_HEADER& header, const int32_t (&bounds)[4]) {
+  const unsigned grid = header.GridSize;
+  return {
+    Cell(bounds[0], header.Bounds[0], header.Bounds[2], grid),
+    Cell(bounds[1], header.Bounds[1], header.Bounds[3], grid),
+    Cell(bounds[2], header.Bounds[0], header.Bounds[2], grid),
+    Cell(bounds[3], header.Bounds[1], header.Bounds[3], grid)
+  };
+}
+
+} // namespace
+
+TopologyStore::~TopologyStore() {
+#ifndef UNDER_CE
+  if (file.is_open()) {
+    file.close();
+  }
+#endif
+}
+
+std::unique_ptr<TopologyStore> TopologyStore::Open(const TCHAR* filename) {
+  std::unique_ptr<TopologyStore> store(new TopologyStore());
+
+#ifndef UNDER_CE
+  store->file.open(filename, true);
+  if (!store->file.is_open() || !store->file.data()) {
+    return nullptr;
+  }
+  store->data = store->file.data();
+  store->size = store->file.mapped_size();
+#else
+  // memory mapped file require SEH exception handling, not implemented by Mingw32ce
+  FILE* fp = _tfopen(filename, _T("rb"));
+  if (!fp) {
+    return nullptr;
+  }
+  fseek(fp, 0, SEEK_END);
+  const long file_size = ftell(fp);
+  fseek(fp, 0, SEEK_SET);
+  if (file_size > 0) {
+    store->buffer.reset(new(std::nothrow) char[file_size]);
+    if (store->buffer && fread(store->buffer.get(), 1, file_size, fp) == static_cast<size_t>(file_size)) {
+      store->data = store->buffer.get();
+      store->size = file_size;
+    }
+  }
+  fclose(fp);
+#endif
+
+  if (!store->Init()) {
+    StartupStore(_T("------ Topology : invalid store file <%s>"), filename);
+    return nullptr;
+  }
+  return store;
+}
+
+bool TopologyStore::Init() {
+  if (!data || size < sizeof(TOPOLOGY_STORE_HEADER)) {
+    return false;
+  }
+  header = reinterpret_cast<const TOPOLOGY_STORE_HEADER*>(data);
+  if (memcmp(header->Magic, store_magic, sizeof(store_magic)) != 0) {
+    return false;
+  }
+  if (!header->GridSize || header->GridSize > max_grid_size) {
+    return false;
+  }
+
+  const uint64_t cell_count = uint64_t(header->GridSize) * header->GridSize + 2;
+  const uint64_t expected_size = sizeof(TOPOLOGY_STORE_HEADER)
+                               + uint64_t(header->ShapeCount) * sizeof(TOPOLOGY_STORE_SHAPE)
+                               + cell_count * sizeof(uint32_t)
+                               + uint64_t(header->IndexCount) * sizeof(uint32_t)
+                               + header->VertexSize
+                               + header->LabelSize;
+  if (expected_size != size) {
+    return false;
+  }
+
+  const char* p = data + sizeof(TOPOLOGY_STORE_HEADER);
+  shapes = reinterpret_cast<const TOPOLOGY_STORE_SHAPE*>(p);
+  p += header->ShapeCount * sizeof(TOPOLOGY_STORE_SHAPE);
+  cells = reinterpret_cast<const uint32_t*>(p);
+  p += cell_count * sizeof(uint32_t);
+  index = reinterpret_cast<const uint32_t*>(p);
+  p += header->IndexCount * sizeof(uint32_t);
+  vertex = reinterpret_cast<const uint8_t*>(p);
+  p += header->VertexSize;
+  labels = p;
+
+  if (cells[cell_count - 1] != header->IndexCount) {
+    return false;
+  }
+  if (header->LabelSize && labels[header->LabelSize - 1] != '\0') {
+    return false;
+  }
+
+  bounds = Dequantize(header->Bounds);
+  return true;
+}
+
+int TopologyStore::Field() const {
+  return header->Field;
+}
+
+uint64_t TopologyStore::SourceSize() const {
+  return header->SourceSize;
+}
+
+unsigned TopologyStore::ShapeCount() const {
+  return header->ShapeCount;
+}
+
+rectObj TopologyStore::ShapeBounds(unsigned i) const {
+  return Dequantize(shapes[i].Bounds);
+}
+
+bool TopologyStore::Hidden(unsigned i) const {
+  return shapes[i].Hidden;
+}
+
+const char* TopologyStore::Label(unsigned i) const {
+  const uint32_t offset = shapes[i].Label;
+  return (offset < header->LabelSize) ? labels + offset : nullptr;
+}
+
+void TopologyStore::WhichShapes(const rectObj& rect, std::vector<unsigned>& result) const {
+  result.clear();
+
+  int32_t query[4];
+  QuantizeBounds(rect, query);
+  if (!header->ShapeCount || !Overlap(query, header->Bounds)) {
+    return;
+  }
+
+  const unsigned grid = header->GridSize;
+  const cell_range range = Cells(*header, query);
+  for (unsigned y = range.y0; y <= range.y1; ++y) {
+    for (unsigned x = range.x0; x <= range.x1; ++x) {
+      const unsigned cell = y * grid + x;
+      for (uint32_t k = cells[cell]; k < cells[cell + 1] && k < header->IndexCount; ++k) {
+        const uint32_t i = index[k];
+        if (i >= header->ShapeCount || !Overlap(shapes[i].Bounds, query)) {
+          continue;
+        }
+        // shape registered in several cells is only reported by first cell overlapping query
+        const cell_range shape_range = Cells(*header, shapes[i].Bounds);
+        if (x == std::max(range.x0, shape_range.x0) && y == std::max(range.y0, shape_range.y0)) {
+          result.push_back(i);
+        }
+      }
+    }
+  }
+
+  // big shapes
+  for (uint32_t k = cells[grid * grid]; k < cells[grid * grid + 1] && k < header->IndexCount; ++k) {
+    const uint32_t i = index[k];
+    if (i < header->ShapeCount && Overlap(shapes[i].Bounds, query)) {
+      result.push_back(i);
+    }
+  }
+
+  // same drawing order as shapefile
+  std::sort(result.begin(), result.end());
+}
+
+void TopologyStore::Decode(unsigned i, shapeObj& shape, std::vector<lineObj>& lines, std::vector<pointObj>& points) const {
+  const TOPOLOGY_STORE_SHAPE& entry = shapes[i];
+
+  lines.clear();
+  points.clear();
+
+  if (entry.Vertex < header->VertexSize) {
+    const uint8_t* p = vertex + entry.Vertex;
+    const uint8_t* end = vertex + header->VertexSize;
+
+    int64_t x = entry.Bounds[0];
+    int64_t y = entry.Bounds[1];
+
+    const uint64_t line_count = ReadVarint(p, end);
+    for (uint64_t l = 0; l < line_count && p < end; ++l) {
+      // each point use at least 2 bytes
+      const uint64_t point_count = std::min<uint64_t>(ReadVarint(p, end), (end - p) / 2);
+      lines.push_back({ static_cast<int>(point_count), nullptr });
+      for (uint64_t k = 0; k < point_count; ++k) {
+        x += UnZigZag(ReadVarint(p, end));
+        y += UnZigZag(ReadVarint(p, end));
+        pointObj point = {};
+        point.x = x / store_scale;
+        point.y = y / store_scale;
+        points.push_back(point);
+      }
+    }
+  }
+
+  // <points> is not reallocated anymore
+  pointObj* point = points.data();
+  for (lineObj& line : lines) {
+    line.point = point;
+    point += line.numpoints;
+  }
+
+  shape.type = entry.Type;
+  shape.bounds = Dequantize(entry.Bounds);
+  shape.numlines = lines.size();
+  shape.line = lines.empty() ? nullptr : lines.data();
+}
+
+bool TopologyStore::Convert(const TCHAR* src, int field, const TCHAR* dst) {
+  char filename[MAX_PATH];
+  to_utf8(src, filename);
+
+  shapefileObj shpfile;
+  memset((void*)&shpfile, 0, sizeof(shpfile));
+  if (msShapefileOpen(&shpfile, "rb", filename, true) == -1) {
+    return false;
+  }
+
+  TOPOLOGY_STORE_HEADER header = {};
+  std::copy(std::begin(store_magic), std::end(store_magic), header.Magic);
+  header.SourceSize = lk::filesystem::getFileSize(src);
+  header.Field = field;
+  header.ShapeCount = std::max(shpfile.numshapes, 0);
+
+  std::vector<TOPOLOGY_STORE_SHAPE> shapes(header.ShapeCount);
+  std::vector<uint8_t> vertex;
+  std::vector<char> labels;
+
+  bool success = true;
+  for (unsigned i = 0; success && i < header.ShapeCount; ++i) {
+    // same label processing as Topology::addShape()
+    XShapeLabel shape;
+    shape.load(&shpfile, i);
+    if (field >= 0) {
+      shape.setLabel(msDBFReadStringAttribute(shpfile.hDBF, i, field));
+    }
+
+    TOPOLOGY_STORE_SHAPE& entry = shapes[i];
+    QuantizeBounds(shape.shape.bounds, entry.Bounds);
+    entry.Type = shape.shape.type;
+    entry.Hidden = shape.hide;
+    entry.Vertex = vertex.size();
+    entry.Label = no_label;
+
+    WriteVarint(vertex, shape.shape.numlines);
+    int64_t x = entry.Bounds[0];
+    int64_t y = entry.Bounds[1];
+    for (int l = 0; l < shape.shape.numlines; ++l) {
+      const lineObj& line = shape.shape.line[l];
+      WriteVarint(vertex, line.numpoints);
+      for (int k = 0; k < line.numpoints; ++k) {
+        const int64_t px = Quantize(std::round(line.point[k].x * store_scale));
+        const int64_t py = Quantize(std::round(line.point[k].y * store_scale));
+        WriteVarint(vertex, ZigZag(px - x));
+        WriteVarint(vertex, ZigZag(py - y));
+        x = px;
+        y = py;
+      }
+    }
+
+    if (shape.HasLabel()) {
+      const size_t offset = labels.size();
+      const size_t length = to_utf8(shape.getLabel(), nullptr, 0);
+      labels.resize(offset + length + 1);
+      to_utf8(shape.getLabel(), labels.data() + offset, length + 1);
+      entry.Label = offset;
+    }
+
+    success = (vertex.size() < UINT32_MAX) && (labels.size() < UINT32_MAX);
+  }
+  msShapefileClose(&shpfile);
+
+  if (!success) {
+    return false;
+  }
+
+  header.VertexSize = vertex.size();
+  header.LabelSize = labels.size();
+
+  // file bounds
+  if (header.ShapeCount) {
+    std::copy(std::begin(shapes[0].Bounds), std::end(shapes[0].Bounds), header.Bounds);
+    for (const TOPOLOGY_STORE_SHAPE& entry : shapes) {
+      header.Bounds[0] = std::min(header.Bounds[0], entry.Bounds[0]);
+      header.Bounds[1] = std::min(header.Bounds[1], entry.Bounds[1]);
+      header.Bounds[2] = std::max(header.Bounds[2], entry.Bounds[2]);
+      header.Bounds[3] = std::max(header.Bounds[3], entry.Bounds[3]);
+    }
+  }
+
+  // spatial index : about 2 shapes per cell, but cell not smaller than median shape size,
+  // otherwise most shapes are registered in lot of cells.
+  unsigned grid_size = std::sqrt(header.ShapeCount / 2.);
+  if (header.ShapeCount) {
+    std::vector<int64_t> shape_size;
+    shape_size.reserve(shapes.size());
+    for (const TOPOLOGY_STORE_SHAPE& entry : shapes) {
+      shape_size.push_back(std::max(int64_t(entry.Bounds[2]) - entry.Bounds[0],
+                                    int64_t(entry.Bounds[3]) - entry.Bounds[1]));
+    }
+    auto median = std::next(shape_size.begin(), shape_size.size() / 2);
+    std::nth_element(shape_size.begin(), median, shape_size.end());
+    const int64_t file_size = std::max(int64_t(header.Bounds[2]) - header.Bounds[0],
+                                       int64_t(header.Bounds[3]) - header.Bounds[1]);
+    if (*median > 0) {
+      grid_size = std::min<int64_t>(grid_size, file_size / *median);
+    }
+  }
+  header.GridSize = std::clamp<unsigned>(grid_size, 1, max_grid_size);
+  const unsigned grid = header.GridSize;
+  // shapes overlapping more cells are only registered in big shapes cell
+  const unsigned max_cells = std::max(4U, grid * grid / 16);
+
+  std::vector<std::vector<uint32_t>> buckets(grid * grid + 1);
+  for (unsigned i = 0; i < header.ShapeCount; ++i) {
+    const cell_range range = Cells(header, shapes[i].Bounds);
+    if (range.Count() > max_cells) {
+      buckets[grid * grid].push_back(i);
+      continue;
+    }
+    for (unsigned y = range.y0; y <= range.y1; ++y) {
+      for (unsigned x = range.x0; x <= range.x1; ++x) {
+        buckets[y * grid + x].push_back(i);
+      }
+    }
+  }
+
+  std::vector<uint32_t> cells;
+  std::vector<uint32_t> index;
+  cells.reserve(buckets.size() + 1);
+  for (const auto& bucket : buckets) {
+    cells.push_back(index.size());
+    index.insert(index.end(), bucket.begin(), bucket.end());
+  }
+  cells.push_back(index.size());
+  header.IndexCount = index.size();
+
+  FILE* out = _tfopen(dst, _T("wb"));
+  if (!out) {
+    return false;
+  }
+
+  success = (fwrite(&header, sizeof(header), 1, out) == 1)
+          && (fwrite(shapes.data(), sizeof(TOPOLOGY_STORE_SHAPE), shapes.size(), out) == shapes.size())
+          && (fwrite(cells.data(), sizeof(uint32_t), cells.size(), out) == cells.size())
+          && (fwrite(index.data(), sizeof(uint32_t), index.size(), out) == index.size())
+          && (fwrite(vertex.data(), 1, vertex.size(), out) == vertex.size())
+          && (fwrite(labels.data(), 1, labels.size(), out) == labels.size());
+
+  return (fclose(out) == 0) && success;
+}
+
+unsigned TopologyStore::ConvertMap(const TCHAR* directory) {
+  TCHAR szFile[MAX_PATH];
+  _sntprintf(szFile, MAX_PATH, _T("%s%stopology.tpl"), directory, _T(DIRSEP));
+  szFile[MAX_PATH - 1] = _T('\0');
+
+  zzip_stream stream(szFile, "rt");
+  if (!stream) {
+    return 0;
+  }
+
+  unsigned converted = 0;
+  TCHAR TempString[READLINE_LENGTH + 1];
+  while (stream.read_line(TempString)) {
+    if (TempString[0] == _T('\0') || TempString[0] == _T('*')) {
+      continue; // Skip empty line and comment
+    }
+
+    // same as OpenTopology() : filename,range,icon,field,...
+    TCHAR ShapeName[80];
+    PExtractParameter(TempString, ShapeName, 0);
+
+    TCHAR ctemp[80];
+    PExtractParameter(TempString, ctemp, 3);
+    const int field = _istalnum(ctemp[0]) ? _tcstol(ctemp, nullptr, 10) - 1 : -1;
+
+    TCHAR src[MAX_PATH];
+    TCHAR dst[MAX_PATH];
+    _sntprintf(src, MAX_PATH, _T("%s%s%s.shp"), directory, _T(DIRSEP), ShapeName);
+    src[MAX_PATH - 1] = _T('\0');
+    _sntprintf(dst, MAX_PATH, _T("%s%s%s%s"), directory, _T(DIRSEP), ShapeName, _T(LKS_TOPOLOGY_STORE));
+    dst[MAX_PATH - 1] = _T('\0');
+
+    if (Convert(src, field, dst)) {
+      ++converted;
+    } else {
+      StartupStore(_T("------ Topology : failed to convert <%s>"), src);
+    }
+  }
+  return converted;
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+#include <thread>
+#include <chrono>
+#include "Time/PeriodClock.hpp"
+#include "OS/Clock.hpp"
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace {
+
+  struct test_shape {
+    std::vector<std::vector<pointObj>> lines;
+    std::string label;
+  };
+
+  void PutBE32(std::vector<uint8_t>& out, uint32_t value) {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      out.push_back(static_cast<uint8_t>(value >> shift));
+    }
+  }
+
+  template<typename T>
+  void PutLE(std::vector<uint8_t>& out, T value) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), p, p + sizeof(T));
+  }
+
+  rectObj LineBounds(const std::vector<std::vector<pointObj>>& lines) {
+    rectObj bounds = { lines[0][0].x, lines[0][0].y, lines[0][0].x, lines[0][0].y };
+    for (const auto& line : lines) {
+      for (const pointObj& point : line) {
+        bounds.minx = std::min(bounds.minx, point.x);
+        bounds.miny = std::min(bounds.miny, point.y);
+        bounds.maxx = std::max(bounds.maxx, point.x);
+        bounds.maxy = std::max(bounds.maxy, point.y);
+      }
+    }
+    return bounds;
+  }
+
+  void ShapefileHeader(std::vector<uint8_t>& out, size_t file_size, const rectObj& bounds) {
+    PutBE32(out, 9994);
+    out.resize(out.size() + 20);
+    PutBE32(out, file_size / 2);
+    PutLE<int32_t>(out, 1000);
+    PutLE<int32_t>(out, 3); // polyline
+    for (double value : { bounds.minx, bounds.miny, bounds.maxx, bounds.maxy, 0., 0., 0., 0. }) {
+      PutLE<double>(out, value);
+    }
+  }
+
+  bool WriteFile(const std::string& path, const std::vector<uint8_t>& data) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (!file) {
+      return false;
+    }
+    const bool success = fwrite(data.data(), 1, data.size(), file) == data.size();
+    return (fclose(file) == 0) && success;
+  }
+
+  // polyline shapefile (.shp, .shx, .dbf) with one text field
+  bool WriteShapefile(const std::string& basename, const std::vector<test_shape>& shapes) {
+    std::vector<uint8_t> records;
+    std::vector<uint8_t> index;
+    rectObj bounds = LineBounds(shapes[0].lines);
+    for (size_t i = 0; i < shapes.size(); ++i) {
+      const rectObj shape_bounds = LineBounds(shapes[i].lines);
+      bounds.minx = std::min(bounds.minx, shape_bounds.minx);
+      bounds.miny = std::min(bounds.miny, shape_bounds.miny);
+      bounds.maxx = std::max(bounds.maxx, shape_bounds.maxx);
+      bounds.maxy = std::max(bounds.maxy, shape_bounds.maxy);
+
+      size_t point_count = 0;
+      for (const auto& line : shapes[i].lines) {
+        point_count += line.size();
+      }
+      const size_t content_size = 44 + 4 * shapes[i].lines.size() + 16 * point_count;
+
+      PutBE32(index, (100 + records.size()) / 2);
+      PutBE32(index, content_size / 2);
+
+      PutBE32(records, i + 1);
+      PutBE32(records, content_size / 2);
+      PutLE<int32_t>(records, 3);
+      for (double value : { shape_bounds.minx, shape_bounds.miny, shape_bounds.maxx, shape_bounds.maxy }) {
+        PutLE<double>(records, value);
+      }
+      PutLE<int32_t>(records, shapes[i].lines.size());
+      PutLE<int32_t>(records, point_count);
+      int32_t first = 0;
+      for (const auto& line : shapes[i].lines) {
+        PutLE<int32_t>(records, first);
+        first += line.size();
+      }
+      for (const auto& line : shapes[i].lines) {
+        for (const pointObj& point : line) {
+          PutLE<double>(records, point.x);
+          PutLE<double>(records, point.y);
+        }
+      }
+    }
+
+    std::vector<uint8_t> shp;
+    ShapefileHeader(shp, 100 + records.size(), bounds);
+    shp.insert(shp.end(), records.begin(), records.end());
+
+    std::vector<uint8_t> shx;
+    ShapefileHeader(shx, 100 + index.size(), bounds);
+    shx.insert(shx.end(), index.begin(), index.end());
+
+    constexpr uint8_t field_size = 32;
+    std::vector<uint8_t> dbf = { 0x03, 124, 1, 1 };
+    PutLE<uint32_t>(dbf, shapes.size());
+    PutLE<uint16_t>(dbf, 32 + 32 + 1);
+    PutLE<uint16_t>(dbf, 1 + field_size);
+    dbf.resize(32);
+    const char name[11] = "NAME";
+    dbf.insert(dbf.end(), std::begin(name), std::end(name));
+    dbf.push_back('C');
+    dbf.resize(dbf.size() + 4);
+    dbf.push_back(field_size);
+    dbf.resize(dbf.size() + 15);
+    dbf.push_back(0x0D);
+    for (const test_shape& shape : shapes) {
+      dbf.push_back(' ');
+      std::string value = shape.label.substr(0, field_size);
+      value.resize(field_size, ' ');
+      dbf.insert(dbf.end(), value.begin(), value.end());
+    }
+    dbf.push_back(0x1A);
+
+    return WriteFile(basename + ".shp", shp) && WriteFile(basename + ".shx", shx) && WriteFile(basename + ".dbf", dbf);
+  }
+
+  // random polylines over [6,8]x[44,46] and one line across the whole area
+  std::vector<test_shape> RandomShapes(unsigned count, unsigned max_points) {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> lon(6., 8.);
+    std::uniform_real_distribution<double> lat(44., 46.);
+    std::uniform_real_distribution<double> step(-0.01, 0.01);
+    std::uniform_int_distribution<unsigned> points(2, max_points);
+
+    const char* labels[] = { "CITY", "NULL", "RAILWAY STATION", "", "M\xFCnchen", "UNK", "Z\xC3\xBCrich" };
+
+    std::vector<test_shape> shapes(count);
+    for (unsigned i = 0; i < count; ++i) {
+      test_shape& shape = shapes[i];
+      shape.label = labels[i % std::size(labels)];
+      if (shape.label == "CITY") {
+        shape.label += std::to_string(i);
+      }
+      shape.lines.resize(1 + (i % 4 == 0));
+      for (auto& line : shape.lines) {
+        pointObj point = {};
+        point.x = lon(gen);
+        point.y = lat(gen);
+        for (unsigned k = points(gen); k; --k) {
+          line.push_back(point);
+          point.x += step(gen);
+          point.y += step(gen);
+        }
+      }
+    }
+    shapes[count / 2].lines = { { { 6., 44. }, { 8., 46. } } };
+    shapes[count / 2].label = "BIG";
+    return shapes;
+  }
+
+  // resident set size in bytes, 0 if unknown
+  size_t ResidentSize() {
+#ifdef __linux__
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (file) {
+      unsigned long size = 0, resident = 0;
+      const int count = fscanf(file, "%lu %lu", &size, &resident);
+      fclose(file);
+      if (count == 2) {
+        return resident * sysconf(_SC_PAGESIZE);
+      }
+    }
+#endif
+    return 0;
+  }
+
+} // namespace
+
+TEST_CASE("topology store") {
+  const std::string basename = "topology_store_test";
+  const std::vector<test_shape> shapes = RandomShapes(2000, 30);
+  REQUIRE(WriteShapefile(basename, shapes));
+
+  const tstring shp_path = from_utf8((basename + ".shp").c_str());
+  const tstring store_path = from_utf8((basename + LKS_TOPOLOGY_STORE).c_str());
+  REQUIRE(TopologyStore::Convert(shp_path.c_str(), 0, store_path.c_str()));
+
+  CHECK_FALSE(TopologyStore::Open(shp_path.c_str()));
+  auto store = TopologyStore::Open(store_path.c_str());
+  REQUIRE(store);
+  CHECK_EQ(store->Field(), 0);
+  CHECK_EQ(store->SourceSize(), lk::filesystem::getFileSize(shp_path.c_str()));
+  REQUIRE_EQ(store->ShapeCount(), shapes.size());
+
+  shapefileObj shpfile;
+  memset((void*)&shpfile, 0, sizeof(shpfile));
+  REQUIRE(msShapefileOpen(&shpfile, "rb", (basename + ".shp").c_str(), true) == 0);
+
+  SUBCASE("decode") {
+    XShapeView view;
+    unsigned labels = 0;
+    unsigned hidden = 0;
+    for (unsigned i = 0; i < store->ShapeCount(); ++i) {
+      // same as Topology::addShape()
+      XShapeLabel expected;
+      expected.load(&shpfile, i);
+      expected.setLabel(msDBFReadStringAttribute(shpfile.hDBF, i, 0));
+
+      view.Load(*store, i);
+      REQUIRE_EQ(view.shape.type, expected.shape.type);
+      REQUIRE_EQ(view.shape.numlines, expected.shape.numlines);
+      CHECK_EQ(view.hide, expected.hide);
+      CHECK_EQ(view.HasLabel(), expected.HasLabel());
+      if (expected.HasLabel()) {
+        CHECK_EQ(tstring(view.getLabel()), tstring(expected.getLabel()));
+        ++labels;
+      }
+      hidden += expected.hide;
+
+      CHECK_LE(view.shape.bounds.minx, expected.shape.bounds.minx);
+      CHECK_LE(view.shape.bounds.miny, expected.shape.bounds.miny);
+      CHECK_GE(view.shape.bounds.maxx, expected.shape.bounds.maxx);
+      CHECK_GE(view.shape.bounds.maxy, expected.shape.bounds.maxy);
+
+      for (int l = 0; l < expected.shape.numlines; ++l) {
+        const lineObj& line = view.shape.line[l];
+        const lineObj& expected_line = expected.shape.line[l];
+        REQUIRE_EQ(line.numpoints, expected_line.numpoints);
+        for (int k = 0; k < line.numpoints; ++k) {
+          REQUIRE(std::abs(line.point[k].x - expected_line.point[k].x) <= 0.51e-7);
+          REQUIRE(std::abs(line.point[k].y - expected_line.point[k].y) <= 0.51e-7);
+        }
+      }
+    }
+    CHECK_GT(labels, 0);
+    CHECK_GT(hidden, 0);
+  }
+
+  SUBCASE("which shapes") {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> lon(5.9, 8.1);
+    std::uniform_real_distribution<double> lat(43.9, 46.1);
+    std::uniform_real_distribution<double> size(0., 0.5);
+
+    std::vector<unsigned> result;
+    for (int n = 0; n < 500; ++n) {
+      rectObj rect;
+      rect.minx = lon(gen);
+      rect.miny = lat(gen);
+      rect.maxx = rect.minx + size(gen);
+      rect.maxy = rect.miny + size(gen);
+
+      int32_t query[4];
+      QuantizeBounds(rect, query);
+      std::vector<unsigned> expected;
+      for (unsigned i = 0; i < store->ShapeCount(); ++i) {
+        int32_t bounds[4];
+        QuantizeBounds(store->ShapeBounds(i), bounds);
+        if (Overlap(bounds, query)) {
+          expected.push_back(i);
+        }
+      }
+
+      store->WhichShapes(rect, result);
+      REQUIRE_EQ(result, expected);
+    }
+
+    // outside of file bounds
+    store->WhichShapes({ 10., 10., 11., 11. }, result);
+    CHECK(result.empty());
+  }
+
+  SUBCASE("truncated file") {
+    std::vector<uint8_t> data(store->FileSize() - 1);
+    store = nullptr;
+    FILE* file = _tfopen(store_path.c_str(), _T("rb"));
+    REQUIRE(file);
+    CHECK_EQ(fread(data.data(), 1, data.size(), file), data.size());
+    fclose(file);
+    REQUIRE(WriteFile(basename + LKS_TOPOLOGY_STORE, data));
+    CHECK_FALSE(TopologyStore::Open(store_path.c_str()));
+  }
+
+  msShapefileClose(&shpfile);
+  store = nullptr;
+
+  for (const char* ext : { ".shp", ".shx", ".dbf", LKS_TOPOLOGY_STORE }) {
+    lk::filesystem::deleteFile(from_utf8((basename + ext).c_str()).c_str());
+  }
+}
+
+class TopologyLoaderTest {
+public:
+  // cache mode 2 (all shapes in memory) don't use TopologyLoader
+  static void UseBoundsCache(Topology& topology) {
+    if (topology.cache_mode != 2) {
+      return;
+    }
+    topology.flushCache();
+    for (int i = 0; i < topology.shpfile.numshapes; i++) {
+      delete topology.shps[i];
+    }
+    free(topology.shps);
+    topology.shps = nullptr;
+    topology.initCache_1();
+  }
+};
+
+TEST_CASE("topology loader") {
+  const std::string basename = "topology_loader_test";
+  REQUIRE(WriteShapefile(basename, RandomShapes(2000, 10)));
+  const tstring shp_path = from_utf8((basename + ".shp").c_str());
+
+  auto make_topology = [&]() {
+    auto topology = std::make_unique<Topology>(shp_path.c_str(), 0);
+    topology->scaleCategory = 0;
+    topology->scaleThreshold = topology->scaleDefaultThreshold = 1e9;
+    TopologyLoaderTest::UseBoundsCache(*topology);
+    return topology;
+  };
+
+  auto update = [](Topology& topology, const rectObj& bounds, const rectObj* prefetch = nullptr) {
+    topology.triggerUpdateCache = true;
+    topology.updateCache(bounds, false, prefetch);
+  };
+
+  // index of shapes in cache
+  auto cached = [](const Topology& topology) {
+    std::vector<int> result;
+    for (int i = 0; i < 2000; ++i) {
+      if (topology.shpCache[i]) {
+        result.push_back(i);
+      }
+    }
+    return result;
+  };
+
+  // loader publish result asynchronously
+  auto wait_requests = [](unsigned count) {
+    PeriodClock clock;
+    clock.Update();
+    while (TopologyLoader::GetStats().requests < count && !clock.Check(10000)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return TopologyLoader::GetStats().requests >= count;
+  };
+
+  const rectObj viewport = { 6.5, 44.5, 7., 45. };
+  const rectObj ahead = { 6.8, 44.8, 7.3, 45.3 };
+  const rectObj outside = { 10., 10., 11., 11. };
+
+  // loader not running : cache is updated synchronously
+  auto reference = make_topology();
+  update(*reference, viewport);
+  const std::vector<int> expected = cached(*reference);
+  const int expected_count = reference->shapes_visible_count;
+  update(*reference, ahead);
+  const std::vector<int> expected_ahead = cached(*reference);
+  REQUIRE_FALSE(expected.empty());
+  REQUIRE(expected != expected_ahead);
+
+  TopologyLoader::Start();
+
+  SUBCASE("apply") {
+    auto topology = make_topology();
+    const auto stats = TopologyLoader::GetStats();
+
+    update(*topology, viewport, &ahead);
+    CHECK(cached(*topology).empty()); // draw thread don't load shapes
+    REQUIRE(wait_requests(stats.requests + 1));
+    topology->ApplyPendingCache();
+    CHECK_EQ(cached(*topology), expected);
+    CHECK_EQ(topology->shapes_visible_count, expected_count);
+
+    // moving ahead use shapes loaded in advance
+    update(*topology, ahead);
+    REQUIRE(wait_requests(stats.requests + 2));
+    topology->ApplyPendingCache();
+    CHECK_EQ(cached(*topology), expected_ahead);
+
+    const auto after = TopologyLoader::GetStats();
+    CHECK_GT(after.prefetch_loads, stats.prefetch_loads);
+    CHECK_EQ(after.prefetch_hits - stats.prefetch_hits, after.prefetch_loads - stats.prefetch_loads);
+  }
+
+  SUBCASE("flush discard pending update") {
+    auto topology = make_topology();
+    const auto stats = TopologyLoader::GetStats();
+
+    update(*topology, viewport);
+    REQUIRE(wait_requests(stats.requests + 1));
+    // cache is flushed after request was posted : result is outdated
+    update(*topology, outside);
+    topology->ApplyPendingCache();
+    CHECK(cached(*topology).empty());
+    CHECK_EQ(topology->shapes_visible_count, 0);
+  }
+
+  SUBCASE("stop with pending requests") {
+    std::vector<std::unique_ptr<Topology>> topologies;
+    for (int i = 0; i < 4; ++i) {
+      topologies.push_back(make_topology());
+    }
+    for (int n = 0; n < 20; ++n) {
+      const double offset = 0.05 * n;
+      const rectObj bounds = { 6. + offset, 44. + offset, 6.5 + offset, 44.5 + offset };
+      for (auto& topology : topologies) {
+        update(*topology, bounds, &ahead);
+      }
+    }
+    TopologyLoader::Stop();
+
+    // loader is stopped : cache is updated synchronously again
+    for (auto& topology : topologies) {
+      update(*topology, viewport);
+      CHECK_EQ(cached(*topology), expected);
+    }
+  }
+
+  TopologyLoader::Stop();
+  reference = nullptr;
+
+  for (const char* ext : { ".shp", ".shx", ".dbf" }) {
+    lk::filesystem::deleteFile(from_utf8((basename + ext).c_str()).c_str());
+  }
+}
+
+// not run by default, use '--test-case="topology store benchmark" --no-skip'
+TEST_CASE("topology store benchmark" * doctest::skip()) {
+  /*
+   * environment :
+   *   LK_TOPOLOGY_SHP    shapefile to use (default : synthetic polyline shapefile)
+   *   LK_TOPOLOGY_FIELD  label field of shapefile, same as topology.tpl (default : 1)
+   */
+  const char* shp_env = getenv("LK_TOPOLOGY_SHP");
+  const char* field_env = getenv("LK_TOPOLOGY_FIELD");
+  const int field = (field_env ? atoi(field_env) : 1) - 1;
+
+  std::string basename = "topology_store_benchmark";
+  if (shp_env) {
+    basename = shp_env;
+    basename.resize(basename.rfind('.'));
+  } else {
+    REQUIRE(WriteShapefile(basename, RandomShapes(100000, 40)));
+  }
+  const tstring shp_path = from_utf8((basename + ".shp").c_str());
+  const tstring store_path = from_utf8((basename + LKS_TOPOLOGY_STORE).c_str());
+  const tstring backup_path = store_path + _T(".bak");
+
+  // existing store is restored at end
+  const bool has_store = lk::filesystem::moveFile(store_path.c_str(), backup_path.c_str());
+
+  // 0.5 degree viewport panned by 0.02 degree steps along file diagonal
+  rectObj file_bounds;
+  {
+    shapefileObj shpfile;
+    memset((void*)&shpfile, 0, sizeof(shpfile));
+    REQUIRE(msShapefileOpen(&shpfile, "rb", (basename + ".shp").c_str(), true) == 0);
+    file_bounds = shpfile.bounds;
+    msShapefileClose(&shpfile);
+  }
+  std::vector<rectObj> viewports;
+  for (double t = 0; t <= 1.; t += 0.01) {
+    const double x = file_bounds.minx + t * (file_bounds.maxx - file_bounds.minx - 0.5);
+    const double y = file_bounds.miny + t * (file_bounds.maxy - file_bounds.miny - 0.5);
+    viewports.push_back({ x, y, x + 0.5, y + 0.5 });
+  }
+
+  auto run = [&](const char* name) {
+    const size_t rss = ResidentSize();
+    PeriodClock clock;
+    clock.Update();
+
+    auto topology = std::make_unique<Topology>(shp_path.c_str(), field);
+    topology->scaleCategory = 0;
+    topology->scaleThreshold = topology->scaleDefaultThreshold = 1e9;
+    const unsigned open_ms = clock.ElapsedUpdate();
+
+    uint64_t start = MonotonicClockUS();
+    topology->triggerUpdateCache = true;
+    topology->updateCache(viewports.front());
+    const uint64_t cold_us = MonotonicClockUS() - start;
+
+    start = MonotonicClockUS();
+    for (const rectObj& viewport : viewports) {
+      topology->triggerUpdateCache = true;
+      topology->updateCache(viewport);
+    }
+    const uint64_t warm_us = (MonotonicClockUS() - start) / viewports.size();
+
+    MESSAGE(name << " : open " << open_ms << "ms, cold rebuild " << cold_us << "us, warm rebuild " << warm_us
+            << "us, " << topology->shapes_visible_count << " visible, RSS +" << (ResidentSize() - rss) / 1024 << "kB");
+  };
+
+  run("shapefile");
+
+  PeriodClock clock;
+  clock.Update();
+  REQUIRE(TopologyStore::Convert(shp_path.c_str(), field, store_path.c_str()));
+  MESSAGE("conversion " << clock.Elapsed() << "ms, "
+          << lk::filesystem::getFileSize(shp_path.c_str()) / 1024 << "kB .shp -> "
+          << lk::filesystem::getFileSize(store_path.c_str()) / 1024 << "kB .xtp");
+
+  run("store");
+
+  // store cache update is only the spatial index query, shapes are decoded when drawn
+  {
+    auto store = TopologyStore::Open(store_path.c_str());
+    REQUIRE(store);
+    XShapeView view;
+    std::vector<unsigned> visible;
+    size_t decoded = 0;
+    const uint64_t start = MonotonicClockUS();
+    for (const rectObj& viewport : viewports) {
+      store->WhichShapes(viewport, visible);
+      for (unsigned i : visible) {
+        view.Load(*store, i);
+        decoded += view.shape.numlines;
+      }
+    }
+    MESSAGE("store decode of visible shapes " << (MonotonicClockUS() - start) / viewports.size()
+            << "us per viewport (" << decoded << " lines)");
+  }
+
+  lk::filesystem::deleteFile(store_path.c_str());
+  if (has_store) {
+    lk::filesystem::moveFile(backup_path.c_str(), store_path.c_str());
+  }
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   TopologyStore.h
+ */
+
+#ifndef TOPOLOGYSTORE_H
+#define TOPOLOGYSTORE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <tchar.h>
+#include "Library/cpp-mmf/memory_mapped_file.hpp"
+#include "Topology/shapelib/mapserver.h"
+
+struct TOPOLOGY_STORE_HEADER;
+struct TOPOLOGY_STORE_SHAPE;
+
+/**
+ * Compact topology file, alternative storage of .shp/.dbf shapefile.
+ *
+ * File layout (little endian) :
+ *   TOPOLOGY_STORE_HEADER
+ *   TOPOLOGY_STORE_SHAPE[] : quantised bounds, type and offset of vertex and label of each shape
+ *   uint32_t[] : first index entry of each grid cell, GridSize x GridSize cells over file bounds,
+ *                followed by one extra cell for shapes too big to be registered in each cell they overlap.
+ *   uint32_t[] : shape index of each cell
+ *   vertex data
+ *   label data : null terminated utf-8 strings, already converted from dbf charset
+ *
+ * Coordinates are int32 in 1e-7 degree. Vertex data of each shape is line count then, for each line,
+ * point count and points : first point relative to shape bounds min, next ones relative to previous point.
+ * All values are zigzag varint.
+ *
+ * The whole file is memory mapped (loaded in heap memory on WinCE) : finding visible shapes and decoding
+ * them never allocate memory per shape.
+ */
+class TopologyStore final {
+  TopologyStore(const TopologyStore&) = delete;
+  TopologyStore& operator=(const TopologyStore&) = delete;
+
+public:
+  ~TopologyStore();
+
+  /**
+   * @return nullptr in case of failure.
+   */
+  static std::unique_ptr<TopologyStore> Open(const TCHAR* filename);
+
+  /**
+   * convert shapefile <src> to store file <dst>.
+   * @field : dbf field used as label, -1 if none.
+   */
+  static bool Convert(const TCHAR* src, int field, const TCHAR* dst);
+
+  /**
+   * convert each shapefile listed in <directory>/topology.tpl to <directory>/<shape>.xtp
+   * @return number of converted files
+   */
+  static unsigned ConvertMap(const TCHAR* directory);
+
+  // dbf field used as label, -1 if none.
+  int Field() const;
+
+  // size of .shp file at conversion time.
+  uint64_t SourceSize() const;
+
+  unsigned ShapeCount() const;
+
+  const rectObj& Bounds() const {
+    return bounds;
+  }
+
+  rectObj ShapeBounds(unsigned i) const;
+
+  bool Hidden(unsigned i) const;
+
+  // utf-8 label, nullptr if none
+  const char* Label(unsigned i) const;
+
+  /**
+   * replace content of <result> by index of shapes overlapping <rect>, in ascending order.
+   */
+  void WhichShapes(const rectObj& rect, std::vector<unsigned>& result) const;
+
+  /**
+   * decode shape <i> into <shape>, lines and points are stored in <lines> and <points>.
+   */
+  void Decode(unsigned i, shapeObj& shape, std::vector<lineObj>& lines, std::vector<pointObj>& points) const;
+
+  // size of store file in bytes
+  size_t FileSize() const {
+    return size;
+  }
+
+private:
+  TopologyStore() = default;
+
+  bool Init();
+
+#ifndef UNDER_CE
+  memory_mapped_file::read_only_mmf file;
+#else
+  std::unique_ptr<char[]> buffer;
+#endif
+
+  const char* data = nullptr;
+  size_t size = 0;
+
+  const TOPOLOGY_STORE_HEADER* header = nullptr;
+  const TOPOLOGY_STORE_SHAPE* shapes = nullptr;
+  const uint32_t* cells = nullptr;
+  const uint32_t* index = nullptr;
+  const uint8_t* vertex = nullptr;
+  const char* labels = nullptr;
+
+  rectObj bounds = {};
+};
+
+#endif /* TOPOLOGYSTORE_H */
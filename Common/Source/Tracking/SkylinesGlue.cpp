@@ -12,9 +12,10 @@
 #include "Defines.h"
 #include "NavFunctions.h"
 #include "Util/TruncateString.hpp"
+#include "utils/profiler.h"
 
 extern NMEA_INFO GPS_INFO;
-extern Mutex CritSec_FlightData;
+extern profiler::timed_mutex<profiler::LockFlightData> CritSec_FlightData;
 extern double LastFlarmCommandTime;
 
 #ifdef HAVE_SKYLINES_TRACKING_HANDLER
@@ -9,6 +9,7 @@
 #include "externs.h"
 #include "Waypointparser.h"
 #include "Dialogs.h"
+#include "WaypointIndex.h"
 #include <exception>
 
 
@@ -20,6 +21,7 @@ bool AddWaypoint(WAYPOINT& Waypoint) {
         // ownership of this string is transfered to WayPointList
         // Reset all content by security
         Waypoint = {};
+        WaypointIndex::Invalidate();
 
     } catch (std::exception& e) {
         const tstring what = to_tstring(e.what());
@@ -13,11 +13,7 @@
 
 
 double AltitudeFromTerrain(double Lat, double Lon) {
-  double myalt = 0.;
-  RasterTerrain::Lock();
-  RasterTerrain::SetTerrainRounding(0.0,0.0);
-  myalt = RasterTerrain::GetTerrainHeight(Lat, Lon);
-  RasterTerrain::Unlock();
+  double myalt = RasterTerrain::GetSampler(0.0, 0.0).GetField(Lat, Lon);
 
   return (myalt==TERRAIN_INVALID)?0:myalt;
 }
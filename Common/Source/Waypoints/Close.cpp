@@ -7,6 +7,7 @@
 */
 
 #include "externs.h"
+#include "WaypointIndex.h"
 
 int WaypointOutOfTerrainRangeDontAskAgain = -1;
 
@@ -28,6 +29,7 @@ void CloseWayPoints() {
   // tips : this is same as clear() but force to free allocated memory...
   WayPointList = std::vector<WAYPOINT>();
   WayPointCalc = std::vector<WPCALC>();
+  WaypointIndex::Invalidate();
 
   WaypointOutOfTerrainRangeDontAskAgain = WaypointsOutOfRange;
 }
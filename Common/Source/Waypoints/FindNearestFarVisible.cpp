@@ -9,6 +9,7 @@
 #include "externs.h"
 #include "Waypointparser.h"
 #include "NavFunctions.h"
+#include "WaypointIndex.h"
 
 
 
@@ -26,8 +27,13 @@ int FindNearestFarVisibleWayPoint(double X, double Y, double maxRange, short wpT
   if(WayPointList.size() <= NUMRESWP ) return -1;
   nearestDistance = maxRange;
 
-  for(unsigned i=NUMRESWP; i<WayPointList.size(); ++i) {
+  // only waypoints near enough are tested, in same order as WayPointList.
+  std::vector<unsigned> candidates;
+  WaypointIndex::Query(Y, X, maxRange, candidates);
 
+  for(unsigned i : candidates) {
+
+	if (i<NUMRESWP) continue;
 	if (!WayPointList[i].FarVisible) continue;
 	if (wpType && (WayPointCalc[i].WpType != wpType)) continue;
 
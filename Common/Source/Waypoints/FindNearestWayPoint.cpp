@@ -10,6 +10,7 @@
 #include "Waypointparser.h"
 #include "LKStyle.h"
 #include "NavFunctions.h"
+#include "WaypointIndex.h"
 
 
 
@@ -21,7 +22,13 @@ int FindNearestWayPoint(double X, double Y, double MaxRange)
 
   NearestDistance = MaxRange;
 
-    for(unsigned i=RESWP_FIRST_MARKER;i<WayPointList.size(); ++i) {
+  // only waypoints near enough are tested, in same order as WayPointList.
+  std::vector<unsigned> candidates;
+  WaypointIndex::Query(Y, X, MaxRange, candidates);
+
+    for(unsigned i : candidates) {
+
+      if (i<RESWP_FIRST_MARKER) continue;
 
       // Consider only valid markers
       if ( (i<NUMRESWP)  &&  (WayPointCalc[i].WpType!=WPT_TURNPOINT) ) continue;
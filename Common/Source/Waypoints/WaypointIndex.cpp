@@ -0,0 +1,490 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   WaypointIndex.cpp
+ */
+
+#include "externs.h"
+#include "WaypointIndex.h"
+#include "Thread/Mutex.hpp"
+#include "Time/PeriodClock.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+constexpr unsigned max_grid_size = 1024;
+
+// minimum length of one degree of latitude or of longitude at equator, for sphere and WGS84.
+constexpr double min_degree_length = 110000.;
+
+bool IsWrapped(const rectObj& bounds) {
+  // also reject NaN.
+  return !(bounds.minx <= bounds.maxx && bounds.miny <= bounds.maxy);
+}
+
+bool IsValid(const WAYPOINT& wpt) {
+  // also reject NaN.
+  return (wpt.Latitude >= -90. && wpt.Latitude <= 90. && wpt.Longitude >= -180. && wpt.Longitude <= 180.);
+}
+
+unsigned GridSize(double extent, double cell_size) {
+  if (!(cell_size > 0)) {
+    return 1;
+  }
+  return std::clamp<double>(std::ceil(extent / cell_size), 1, max_grid_size);
+}
+
+unsigned Cell(double value, double origin, double cell_size, unsigned count) {
+  const double i = std::floor((value - origin) / cell_size);
+  return std::clamp<double>(i, 0, count - 1);
+}
+
+} // namespace
+
+void CWaypointIndex::Clear() {
+  _bounds = {};
+  _cell_width = 0;
+  _cell_height = 0;
+  _columns = 0;
+  _rows = 0;
+  _first = 0;
+  _size = 0;
+  _cells.clear();
+  _items.clear();
+  _unindexed.clear();
+}
+
+void CWaypointIndex::Build(const std::vector<WAYPOINT>& list, size_t first) {
+  Clear();
+
+  _size = list.size();
+  _first = std::min(first, list.size());
+
+  std::vector<unsigned> indexed;
+  indexed.reserve(_size - _first);
+  for (unsigned i = _first; i < _size; ++i) {
+    if (IsValid(list[i])) {
+      indexed.push_back(i);
+    } else {
+      _unindexed.push_back(i);
+    }
+  }
+  if (indexed.empty()) {
+    return;
+  }
+
+  _bounds = { list[indexed.front()].Longitude, list[indexed.front()].Latitude,
+              list[indexed.front()].Longitude, list[indexed.front()].Latitude };
+  for (unsigned i : indexed) {
+    _bounds.minx = std::min(_bounds.minx, list[i].Longitude);
+    _bounds.miny = std::min(_bounds.miny, list[i].Latitude);
+    _bounds.maxx = std::max(_bounds.maxx, list[i].Longitude);
+    _bounds.maxy = std::max(_bounds.maxy, list[i].Latitude);
+  }
+
+  // square cells, about 4 waypoints per cell
+  const double width = _bounds.maxx - _bounds.minx;
+  const double height = _bounds.maxy - _bounds.miny;
+  const double cell_count = std::max(1., indexed.size() / 4.);
+  double cell_size = std::sqrt(width * height / cell_count);
+  if (!(cell_size > 0)) {
+    // all waypoints on same meridian or same parallel
+    cell_size = std::max(width, height) / cell_count;
+  }
+  _columns = GridSize(width, cell_size);
+  _rows = GridSize(height, cell_size);
+  _cell_width = (width > 0) ? width / _columns : 1.;
+  _cell_height = (height > 0) ? height / _rows : 1.;
+
+  // counting sort by cell, index order is kept inside each cell.
+  std::vector<unsigned> item_cell;
+  item_cell.reserve(indexed.size());
+  _cells.assign(_columns * _rows + 1, 0);
+  for (unsigned i : indexed) {
+    const unsigned x = Cell(list[i].Longitude, _bounds.minx, _cell_width, _columns);
+    const unsigned y = Cell(list[i].Latitude, _bounds.miny, _cell_height, _rows);
+    item_cell.push_back(y * _columns + x);
+    ++_cells[item_cell.back() + 1];
+  }
+  std::partial_sum(_cells.begin(), _cells.end(), _cells.begin());
+
+  std::vector<unsigned> next(_cells.begin(), std::prev(_cells.end()));
+  _items.resize(indexed.size());
+  for (size_t n = 0; n < indexed.size(); ++n) {
+    _items[next[item_cell[n]]++] = indexed[n];
+  }
+}
+
+void CWaypointIndex::Query(const rectObj& bounds, std::vector<unsigned>& result) const {
+  result.resize(_first);
+  std::iota(result.begin(), result.end(), 0U);
+  result.insert(result.end(), _unindexed.begin(), _unindexed.end());
+
+  if (_columns == 0 || IsWrapped(bounds)) {
+    return;
+  }
+  if (bounds.minx > _bounds.maxx || bounds.maxx < _bounds.minx
+      || bounds.miny > _bounds.maxy || bounds.maxy < _bounds.miny) {
+    return;
+  }
+
+  const unsigned x0 = Cell(bounds.minx, _bounds.minx, _cell_width, _columns);
+  const unsigned x1 = Cell(bounds.maxx, _bounds.minx, _cell_width, _columns);
+  const unsigned y0 = Cell(bounds.miny, _bounds.miny, _cell_height, _rows);
+  const unsigned y1 = Cell(bounds.maxy, _bounds.miny, _cell_height, _rows);
+
+  for (unsigned y = y0; y <= y1; ++y) {
+    const unsigned row = y * _columns;
+    // cells of one row are contiguous in _items
+    result.insert(result.end(), std::next(_items.begin(), _cells[row + x0]),
+                                std::next(_items.begin(), _cells[row + x1 + 1]));
+  }
+
+  // reserved items [0, _first) are already first.
+  std::sort(std::next(result.begin(), _first), result.end());
+}
+
+bool CWaypointIndex::DistanceBounds(double lat, double lon, double distance, rectObj& bounds) {
+  if (!(distance >= 0) || !(std::abs(lat) <= 90.)) {
+    return false;
+  }
+  // 5% margin cover ellipsoid and spherical approximation below.
+  const double dlat = distance / min_degree_length * 1.05;
+  // limit search area size to where dlat / cos(lat) is a valid bound of longitude difference.
+  const double max_lat = std::abs(lat) + dlat;
+  if (dlat > 5. || max_lat > 75.) {
+    return false;
+  }
+  const double dlon = dlat / std::cos(max_lat * DEG_TO_RAD);
+  if (lon - dlon < -180. || lon + dlon > 180.) {
+    return false;
+  }
+  bounds = { lon - dlon, lat - dlat, lon + dlon, lat + dlat };
+  return true;
+}
+
+bool CWaypointIndex::FlatDistanceBounds(int scx, int scy, int range, rectObj& bounds) {
+  // LatLon2Flat() : scx = (int)(lon * fastcosine(lat) * 100), scy = (int)(lat * 100)
+  // approx distance <= range imply |dx| <= range and |dy| <= range,
+  // +1 for truncation toward zero.
+  const double miny = (scy - range - 1) / 100.;
+  const double maxy = (scy + range + 1) / 100.;
+  const double a = (scx - range - 1) / 100.;
+  const double b = (scx + range + 1) / 100.;
+
+  // range of cosine over latitude band, with margin for fastcosine() table step.
+  const double abs_max = std::max(std::abs(miny), std::abs(maxy));
+  const double abs_min = (miny <= 0 && maxy >= 0) ? 0. : std::min(std::abs(miny), std::abs(maxy));
+  const double cos_min = std::cos(std::min(abs_max, 90.) * DEG_TO_RAD) - 0.01;
+  const double cos_max = std::cos(std::min(abs_min, 90.) * DEG_TO_RAD) + 0.01;
+  if (cos_min < 0.05) {
+    return false;
+  }
+
+  // lon = x / cos : extrema are at the corners of [a, b] x [cos_min, cos_max]
+  bounds = {
+    std::min(a / cos_min, a / cos_max), miny,
+    std::max(b / cos_min, b / cos_max), maxy
+  };
+  return true;
+}
+
+namespace {
+
+  Mutex index_mutex;
+  CWaypointIndex waypoint_index;
+  bool index_valid = false;
+  size_t index_list_size = 0;
+  unsigned index_generation = 0;
+
+  // must be called with index_mutex locked
+  void UpdateIndex() {
+    // size check also catch list change without Invalidate()
+    if (index_valid && index_list_size == WayPointList.size()) {
+      return;
+    }
+
+    PeriodClock clock;
+    clock.Update();
+
+    waypoint_index.Build(WayPointList, NUMRESWP);
+    index_valid = true;
+    index_list_size = WayPointList.size();
+    ++index_generation;
+
+    StartupStore(_T(". Waypoint index built for %u waypoints, %ux%u cells (%dms)"),
+                 static_cast<unsigned>(waypoint_index.size()), waypoint_index.columns(), waypoint_index.rows(),
+                 clock.Elapsed());
+  }
+
+} // namespace
+
+void WaypointIndex::Invalidate() {
+  ScopeLock lock(index_mutex);
+  index_valid = false;
+}
+
+unsigned WaypointIndex::Query(const rectObj& bounds, std::vector<unsigned>& result) {
+  ScopeLock lock(index_mutex);
+  UpdateIndex();
+  waypoint_index.Query(bounds, result);
+  return index_generation;
+}
+
+void WaypointIndex::Query(double lat, double lon, double distance, std::vector<unsigned>& result) {
+  rectObj bounds;
+  if (CWaypointIndex::DistanceBounds(lat, lon, distance, bounds)) {
+    Query(bounds, result);
+  } else {
+    result.resize(WayPointList.size());
+    std::iota(result.begin(), result.end(), 0U);
+  }
+}
+
+void WaypointIndex::QueryFlat(int scx, int scy, int range, std::vector<unsigned>& result) {
+  rectObj bounds;
+  if (CWaypointIndex::FlatDistanceBounds(scx, scy, range, bounds)) {
+    Query(bounds, result);
+  } else {
+    result.resize(WayPointList.size());
+    std::iota(result.begin(), result.end(), 0U);
+  }
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <random>
+#include "NavFunctions.h"
+
+namespace {
+
+  constexpr size_t reserved = 10;
+
+  // random waypoints over europe, denser around a few cities like real files, and some invalid ones.
+  std::vector<WAYPOINT> RandomWaypoints(size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> lon(-10., 30.);
+    std::uniform_real_distribution<double> lat(36., 60.);
+    std::normal_distribution<double> cluster(0., 0.3);
+
+    std::vector<WAYPOINT> list(count);
+    for (size_t i = 0; i < count; ++i) {
+      if (i % 3) {
+        list[i].Longitude = lon(gen);
+        list[i].Latitude = lat(gen);
+      } else {
+        list[i].Longitude = 7. + cluster(gen);
+        list[i].Latitude = 45. + cluster(gen);
+      }
+    }
+    list[reserved + 1].Latitude = 100.;
+    list[reserved + 2].Latitude = std::nan("");
+    list[reserved + 3].Longitude = 200.;
+    return list;
+  }
+
+  std::vector<rectObj> RandomScreens(size_t count, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> lon(-12., 32.);
+    std::uniform_real_distribution<double> lat(34., 62.);
+    std::exponential_distribution<double> size(2.);
+
+    std::vector<rectObj> bounds;
+    for (size_t i = 0; i < count; ++i) {
+      const double x = lon(gen);
+      const double y = lat(gen);
+      const double w = size(gen);
+      bounds.push_back({x, y, x + w, y + w * 0.7});
+    }
+    return bounds;
+  }
+
+  // same test as MapWindow::PointVisible()
+  bool Inside(const WAYPOINT& wpt, const rectObj& bounds) {
+    return (wpt.Longitude > bounds.minx && wpt.Longitude < bounds.maxx
+            && wpt.Latitude > bounds.miny && wpt.Latitude < bounds.maxy);
+  }
+
+  // same as CalculateWaypointApproxDistance()
+  int ApproxDistance(int scx, int scy, const WAYPOINT& wpt) {
+    int sc_x, sc_y;
+    LatLon2Flat(wpt.Longitude, wpt.Latitude, &sc_x, &sc_y);
+    const int dx = scx - sc_x;
+    const int dy = scy - sc_y;
+    return isqrt4(dx * dx + dy * dy);
+  }
+
+  // same loop as FindNearestWayPoint()
+  template<typename Indexes>
+  int Nearest(const std::vector<WAYPOINT>& list, const Indexes& candidates, double lat, double lon, double range) {
+    int nearest = -1;
+    double nearest_distance = range;
+    for (unsigned i : candidates) {
+      double distance;
+      DistanceBearing(lat, lon, list[i].Latitude, list[i].Longitude, &distance, nullptr);
+      if (distance < nearest_distance) {
+        nearest = i;
+        nearest_distance = distance;
+      }
+    }
+    return nearest;
+  }
+
+  std::vector<unsigned> All(const std::vector<WAYPOINT>& list) {
+    std::vector<unsigned> result(list.size());
+    std::iota(result.begin(), result.end(), 0U);
+    return result;
+  }
+
+} // namespace
+
+TEST_CASE("waypoint index") {
+
+  const std::vector<WAYPOINT> list = RandomWaypoints(20000, 1);
+  CWaypointIndex index;
+  index.Build(list, reserved);
+  CHECK_EQ(index.size(), list.size());
+  CHECK_GT(index.columns() * index.rows(), 1000U);
+
+  SUBCASE("visibility") {
+    std::vector<unsigned> result;
+    for (const rectObj& screen : RandomScreens(500, 2)) {
+      index.Query(screen, result);
+      CHECK(std::is_sorted(result.begin(), result.end()));
+      CHECK(std::adjacent_find(result.begin(), result.end()) == result.end());
+
+      std::vector<unsigned> visible, linear;
+      std::copy_if(result.begin(), result.end(), std::back_inserter(visible), [&](unsigned i) {
+        return Inside(list[i], screen);
+      });
+      for (unsigned i = 0; i < list.size(); ++i) {
+        if (Inside(list[i], screen)) {
+          linear.push_back(i);
+        }
+      }
+      CHECK_EQ(visible, linear);
+    }
+
+    // reserved and invalid are always returned
+    index.Query({ 100., 10., 101., 11. }, result);
+    CHECK_EQ(result, std::vector<unsigned>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13 }));
+    index.Query({ 10., 45., 9., 46. }, result);
+    CHECK_EQ(result.size(), 13U);
+  }
+
+  SUBCASE("nearest") {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> lon(-10., 30.);
+    std::uniform_real_distribution<double> lat(36., 60.);
+    std::exponential_distribution<double> range(1. / 20000.);
+
+    const std::vector<unsigned> all = All(list);
+    std::vector<unsigned> result;
+    for (int n = 0; n < 300; ++n) {
+      const double y = (n % 2) ? lat(gen) : 45. + (lat(gen) - 48.) / 20.;
+      const double x = (n % 2) ? lon(gen) : 7. + (lon(gen) - 10.) / 20.;
+      const double r = 100. + range(gen);
+
+      rectObj bounds;
+      REQUIRE(CWaypointIndex::DistanceBounds(y, x, r, bounds));
+      index.Query(bounds, result);
+      CHECK_EQ(Nearest(list, result, y, x, r), Nearest(list, all, y, x, r));
+
+      // all waypoints in range are candidate
+      for (unsigned i = 0; i < list.size(); ++i) {
+        double distance;
+        DistanceBearing(y, x, list[i].Latitude, list[i].Longitude, &distance, nullptr);
+        if (distance < r) {
+          CHECK(std::binary_search(result.begin(), result.end(), i));
+        }
+      }
+    }
+
+    rectObj bounds;
+    CHECK_FALSE(CWaypointIndex::DistanceBounds(45., 179.9, 20000., bounds));
+    CHECK_FALSE(CWaypointIndex::DistanceBounds(80., 10., 20000., bounds));
+    CHECK_FALSE(CWaypointIndex::DistanceBounds(45., 10., 1000000., bounds));
+  }
+
+  SUBCASE("range list") {
+    InitSineTable();
+
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<double> lon(-10., 30.);
+    std::uniform_real_distribution<double> lat(36., 60.);
+    std::uniform_int_distribution<int> range(30, 150);
+
+    std::vector<unsigned> result;
+    for (int n = 0; n < 300; ++n) {
+      int scx, scy;
+      LatLon2Flat(lon(gen), lat(gen), &scx, &scy);
+      const int r = range(gen);
+
+      rectObj bounds;
+      REQUIRE(CWaypointIndex::FlatDistanceBounds(scx, scy, r, bounds));
+      index.Query(bounds, result);
+
+      std::vector<unsigned> in_range, linear;
+      std::copy_if(result.begin(), result.end(), std::back_inserter(in_range), [&](unsigned i) {
+        return ApproxDistance(scx, scy, list[i]) <= r;
+      });
+      for (unsigned i = 0; i < list.size(); ++i) {
+        if (ApproxDistance(scx, scy, list[i]) <= r) {
+          linear.push_back(i);
+        }
+      }
+      CHECK_EQ(in_range, linear);
+    }
+  }
+
+  SUBCASE("empty") {
+    CWaypointIndex empty;
+    empty.Build({}, reserved);
+    std::vector<unsigned> result = { 1, 2 };
+    empty.Query({ 0., 0., 1., 1. }, result);
+    CHECK(result.empty());
+
+    // only reserved
+    empty.Build(std::vector<WAYPOINT>(5), reserved);
+    empty.Query({ 0., 0., 1., 1. }, result);
+    CHECK_EQ(result, std::vector<unsigned>({ 0, 1, 2, 3, 4 }));
+  }
+}
+
+// not run by default, use '--test-case="waypoint index benchmark" --no-skip'
+TEST_CASE("waypoint index benchmark" * doctest::skip()) {
+  const std::vector<WAYPOINT> list = RandomWaypoints(40000, 1);
+  const std::vector<rectObj> screens = RandomScreens(2000, 2);
+
+  PeriodClock clock;
+  clock.Update();
+  CWaypointIndex index;
+  index.Build(list, reserved);
+  MESSAGE("build : " << clock.ElapsedUpdate() << "ms, " << index.columns() << "x" << index.rows() << " cells");
+
+  size_t count_linear = 0;
+  for (const rectObj& screen : screens) {
+    for (const WAYPOINT& wpt : list) {
+      count_linear += Inside(wpt, screen);
+    }
+  }
+  MESSAGE("linear : " << clock.ElapsedUpdate() << "ms");
+
+  size_t count_index = 0;
+  std::vector<unsigned> result;
+  for (const rectObj& screen : screens) {
+    index.Query(screen, result);
+    for (unsigned i : result) {
+      count_index += Inside(list[i], screen);
+    }
+  }
+  MESSAGE("index : " << clock.ElapsedUpdate() << "ms");
+
+  CHECK_EQ(count_linear, count_index);
+}
+
+#endif
@@ -0,0 +1,102 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   WaypointIndex.h
+ */
+
+#ifndef WAYPOINTINDEX_H
+#define WAYPOINTINDEX_H
+
+#include <cstddef>
+#include <vector>
+#include "Topology/shapelib/mapprimitive.h"
+
+struct WAYPOINT;
+
+/**
+ * Uniform grid over waypoint positions, about 4 waypoints per cell.
+ *
+ * Items are identified by their position in the list used to build the index,
+ * queries return these positions sorted, so caller keep original list order
+ * (range list overflow and nearest search tie are resolved by list order).
+ *
+ * Result of a query is a superset of waypoints inside bounds :
+ *  - items [0, first) are never indexed and always returned, virtual waypoints are moved at runtime.
+ *  - items with invalid position are always returned.
+ * Caller must still apply it's own test on each returned item.
+ */
+class CWaypointIndex final {
+public:
+  void Build(const std::vector<WAYPOINT>& list, size_t first);
+  void Clear();
+
+  /**
+   * @param bounds : area to search, nothing but unindexed items if bounds are wrapped (minx > maxx).
+   * @param result : position of all candidates, sorted ascending.
+   */
+  void Query(const rectObj& bounds, std::vector<unsigned>& result) const;
+
+  size_t size() const { return _size; }
+  unsigned columns() const { return _columns; }
+  unsigned rows() const { return _rows; }
+
+  /**
+   * bounds containing all points at less than <distance> meters of <lat, lon> (see DistanceBearing()).
+   * @return false if too close to pole or 180° meridian, or distance too large.
+   */
+  static bool DistanceBounds(double lat, double lon, double distance, rectObj& bounds);
+
+  /**
+   * bounds containing all waypoints for which CalculateWaypointApproxDistance() <= <range>.
+   * @scx, @scy : LatLon2Flat() coordinate of reference point.
+   * @return false if too close to pole.
+   */
+  static bool FlatDistanceBounds(int scx, int scy, int range, rectObj& bounds);
+
+private:
+  rectObj _bounds = {};
+  double _cell_width = 0;
+  double _cell_height = 0;
+  unsigned _columns = 0;
+  unsigned _rows = 0;
+  size_t _first = 0;
+  size_t _size = 0;
+
+  std::vector<unsigned> _cells; // first item of each cell in _items, _columns * _rows + 1 entries
+  std::vector<unsigned> _items; // indexed items, grouped by cell, ascending in each cell
+  std::vector<unsigned> _unindexed; // items with invalid position, always candidate.
+};
+
+/**
+ * Index of WayPointList, shared by draw thread, calculation thread and dialogs.
+ */
+namespace WaypointIndex {
+
+  /**
+   * must be called each time WayPointList is loaded, cleared or a waypoint position is changed,
+   * index is rebuilt by next query.
+   */
+  void Invalidate();
+
+  /**
+   * candidates inside <bounds> (same as CWaypointIndex::Query())
+   * @return generation of index used, changed each time index is rebuilt.
+   */
+  unsigned Query(const rectObj& bounds, std::vector<unsigned>& result);
+
+  /**
+   * candidates at less than <distance> meters of <lat, lon>,
+   * all waypoints if search area can't be bounded.
+   */
+  void Query(double lat, double lon, double distance, std::vector<unsigned>& result);
+
+  /**
+   * candidates for which CalculateWaypointApproxDistance() <= <range>.
+   */
+  void QueryFlat(int scx, int scy, int range, std::vector<unsigned>& result);
+
+} // namespace WaypointIndex
+
+#endif /* WAYPOINTINDEX_H */
@@ -103,6 +103,7 @@ void BeforeShutdown(void) {
   // Stop COM devices first to avoid mutex race condition...
   StartupStore(TEXT(". Stop COM devices%s"),NEWLINE);
   devCloseAll();
+  CloseNMEALogger();
 
   // 100526 this is creating problem in SIM mode when quit is called from X button, and we are in waypoint details
   // or probably in other menu related screens. However it cannot happen from real PNA or PDA because we don't have
@@ -112,6 +113,9 @@ void BeforeShutdown(void) {
   // Stop calculating too (wake up)
   dataTriggerEvent.set();
 
+  // Stop contest solver before waypoints are cleared
+  CContestMgr::Instance().Stop();
+
   // Clear data
   // LKTOKEN _@M1222_ "Shutdown, saving task..."
   CreateProgressDialog(MsgToken<1222>());
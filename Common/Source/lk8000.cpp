@@ -57,6 +57,7 @@
 #include "Waypoints/SetHome.h"
 #include "Baro.h"
 #include "OS/Sleep.h"
+#include "utils/task_graph.h"
 
 #ifdef __linux__
 #include <sys/utsname.h>
@@ -97,6 +98,53 @@ void DetectKeyboardModel() {
 }
 
 
+/**
+ * Load terrain, waypoints, airspaces, topology and FLARM database.
+ * Independent loaders are run concurrently, duration of each one is written to runtime log.
+ */
+static void LoadDatabases() {
+  task_graph loader;
+
+  const auto terrain = loader.Add(_T("Terrain"), []() {
+    LockTerrainDataGraphics();
+    RasterTerrain::OpenTerrain();
+    UnlockTerrainDataGraphics();
+  });
+
+  // waypoints without altitude get it from terrain
+  loader.Add(_T("Waypoints"), []() {
+    ReadWayPoints();
+  }, { terrain });
+
+  // airspaces out of terrain are excluded
+  loader.Add(_T("Airspaces"), []() {
+    CreateProgressDialog(MsgToken<399>());
+    CAirspaceManager::Instance().ReadAirspaces();
+    CAirspaceManager::Instance().SortAirspaces();
+  }, { terrain });
+
+  // topology bitmaps must be loaded by main thread,
+  // and topology is opened with TerrainDataGraphics lock held like terrain.
+  loader.AddMain(_T("Topology"), []() {
+    OpenTopology();
+  }, { terrain });
+
+  loader.Add(_T("FLARM"), []() {
+    CreateProgressDialog(MsgToken<1808>());	// Loading FLARMNET database
+    OpenFLARMDetails();
+  });
+
+  loader.Run(4);
+
+  unsigned total = 0;
+  for (const auto& stage : loader.Timings()) {
+    StartupStore(_T(". Startup %-9s : start %5ums, %5ums%s"), stage.name, stage.start_ms, stage.duration_ms,
+                 stage.main_thread ? _T(" (main thread)") : _T(""));
+    total += stage.duration_ms;
+  }
+  StartupStore(_T(". Startup databases loaded in %ums (%ums sequential)"), loader.Elapsed(), total);
+}
+
 bool Startup(const TCHAR* szCmdLine) {
 
   _tcscpy(LK8000_Version, _T(LKFORK " v" LKVERSION "." LKRELEASE " " __DATE__));
@@ -397,11 +445,11 @@ bool Startup(const TCHAR* szCmdLine) {
     CreateProgressDialog(MsgToken<1215>());
   }
 
-  LockTerrainDataGraphics();
-  RasterTerrain::OpenTerrain();
-  UnlockTerrainDataGraphics();
+  // loaders use language tokens, so it can't be reloaded while they are running.
+  LKLoadLanguageFile();
+
+  LoadDatabases();
 
-  ReadWayPoints();
   StartupStore(_T(". LOADED %d WAYPOINTS + %u virtuals%s"),(unsigned)WayPointList.size()-NUMRESWP,NUMRESWP,NEWLINE);
   InitLDRotary(&rotaryLD);
   InitWindRotary(&rotaryWind); // 100103
@@ -409,15 +457,6 @@ bool Startup(const TCHAR* szCmdLine) {
   InitLK8000();
   ReadAirfieldFile();
   SetHome(false);
-  LKLoadLanguageFile();
-
-  CreateProgressDialog(MsgToken<399>());
-  CAirspaceManager::Instance().ReadAirspaces();
-  CAirspaceManager::Instance().SortAirspaces();
-  OpenTopology();
-
-  CreateProgressDialog(MsgToken<1808>());	// Loading FLARMNET database
-  OpenFLARMDetails();
 
   // LKTOKEN _@M1217_ "Starting devices"
   CreateProgressDialog(MsgToken<1217>());
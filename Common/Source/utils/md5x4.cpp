@@ -0,0 +1,310 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   md5x4.cpp
+ */
+
+#include "md5x4.h"
+#include "OS/ByteOrder.hpp"
+#include <cstring>
+#include <algorithm>
+
+namespace {
+
+  // one MD5 word for each lane, compiled to SSE2 / NEON register when available,
+  // or to 4 scalar operations.
+  typedef uint32_t u32x4 __attribute__((vector_size(16)));
+
+  inline u32x4 load(const uint32_t (&lanes)[4]) {
+    u32x4 v;
+    memcpy(&v, lanes, sizeof(v));
+    return v;
+  }
+
+  inline void store(uint32_t (&lanes)[4], u32x4 v) {
+    memcpy(lanes, &v, sizeof(v));
+  }
+
+  inline u32x4 rotate_left(u32x4 x, unsigned s) {
+    return (x << s) | (x >> (32 - s));
+  }
+
+  // RFC 1321, 3.4
+  constexpr uint32_t T[64] = {
+    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+  };
+
+  constexpr unsigned S[4][4] = {
+    { 7, 12, 17, 22 },
+    { 5, 9, 14, 20 },
+    { 4, 11, 16, 23 },
+    { 6, 10, 15, 21 }
+  };
+
+  constexpr char Digit[] = {
+    '0', '1', '2', '3', '4', '5', '6', '7',
+    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+  };
+
+} // namespace
+
+MD5x4::MD5x4(const std::array<key_t, 4>& keys) {
+  for (unsigned lane = 0; lane < 4; ++lane) {
+    for (unsigned i = 0; i < 4; ++i) {
+      state[i][lane] = keys[lane][i];
+    }
+  }
+}
+
+void MD5x4::ProcessBlock(const uint8_t* block) {
+  uint32_t X[16];
+  for (unsigned i = 0; i < 16; ++i) {
+    X[i] = ReadUnalignedLE32(reinterpret_cast<const uint32_t*>(block + i * 4));
+  }
+
+  u32x4 A = load(state[0]);
+  u32x4 B = load(state[1]);
+  u32x4 C = load(state[2]);
+  u32x4 D = load(state[3]);
+  const u32x4 A0 = A, B0 = B, C0 = C, D0 = D;
+
+  auto step = [&](u32x4 f, unsigned i, unsigned k, unsigned s) {
+    const u32x4 tmp = D;
+    D = C;
+    C = B;
+    B = B + rotate_left(A + f + (X[k] + T[i]), s);
+    A = tmp;
+  };
+
+  for (unsigned i = 0; i < 16; ++i) {
+    step(D ^ (B & (C ^ D)), i, i, S[0][i % 4]);
+  }
+  for (unsigned i = 16; i < 32; ++i) {
+    step(C ^ (D & (B ^ C)), i, (5 * i + 1) % 16, S[1][i % 4]);
+  }
+  for (unsigned i = 32; i < 48; ++i) {
+    step(B ^ C ^ D, i, (3 * i + 5) % 16, S[2][i % 4]);
+  }
+  for (unsigned i = 48; i < 64; ++i) {
+    step(C ^ (B | ~D), i, (7 * i) % 16, S[3][i % 4]);
+  }
+
+  store(state[0], A + A0);
+  store(state[1], B + B0);
+  store(state[2], C + C0);
+  store(state[3], D + D0);
+}
+
+void MD5x4::Update(const void* input, size_t size) {
+  const uint8_t* data = static_cast<const uint8_t*>(input);
+  total += size;
+
+  if (buflen) {
+    const size_t n = std::min(size, sizeof(buffer) - buflen);
+    memcpy(&buffer[buflen], data, n);
+    buflen += n;
+    data += n;
+    size -= n;
+    if (buflen < sizeof(buffer)) {
+      return;
+    }
+    ProcessBlock(buffer);
+    buflen = 0;
+  }
+
+  for (; size >= sizeof(buffer); data += sizeof(buffer), size -= sizeof(buffer)) {
+    ProcessBlock(data);
+  }
+
+  memcpy(buffer, data, size);
+  buflen = size;
+}
+
+std::array<std::string, 4> MD5x4::Final() const {
+  MD5x4 tmp(*this);
+
+  // RFC 1321, 3.1 & 3.2 : padding and message length in bits
+  const uint64_t bits = total << 3;
+  static constexpr uint8_t fill[64] = { 0x80 };
+  tmp.Update(fill, (tmp.buflen < 56) ? (56 - tmp.buflen) : (120 - tmp.buflen));
+  uint8_t length[8];
+  for (unsigned i = 0; i < 8; ++i) {
+    length[i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+  tmp.Update(length, sizeof(length));
+
+  std::array<std::string, 4> out;
+  for (unsigned lane = 0; lane < 4; ++lane) {
+    out[lane].reserve(32);
+    for (unsigned i = 0; i < 4; ++i) {
+      const uint32_t word = tmp.state[i][lane];
+      for (unsigned b = 0; b < 4; ++b) {
+        const uint8_t c = static_cast<uint8_t>(word >> (8 * b));
+        out[lane].push_back(Digit[c >> 4]);
+        out[lane].push_back(Digit[c & 0x0F]);
+      }
+    }
+  }
+  return out;
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <fstream>
+#include <random>
+#include <vector>
+#include "md5.h"
+#include "Time/PeriodClock.hpp"
+
+namespace {
+
+  const std::array<MD5x4::key_t, 4> igc_keys = {{
+    {0x63e54c01, 0x25adab89, 0x44baecfe, 0x60f25476},
+    {0x41e24d03, 0x23b8ebea, 0x4a4bfc9e, 0x640ed89a},
+    {0x61e54e01, 0x22cdab89, 0x48b20cfe, 0x62125476},
+    {0xc1e84fe8, 0x21d1c28a, 0x438e1a12, 0x6c250aee}
+  }};
+
+  const MD5x4::key_t md5_init = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+
+  std::array<MD5_Base, 4> igc_scalar() {
+    std::array<MD5_Base, 4> md5;
+    for (unsigned lane = 0; lane < 4; ++lane) {
+      const auto& key = igc_keys[lane];
+      md5[lane].Init(key[0], key[1], key[2], key[3]);
+    }
+    return md5;
+  }
+
+} // namespace
+
+TEST_CASE("MD5x4 hash") {
+
+  SUBCASE("RFC 1321 test suite") {
+    const std::pair<const char*, const char*> suite[] = {
+      { "", "d41d8cd98f00b204e9800998ecf8427e" },
+      { "a", "0cc175b9c0f1b6a831c399e269772661" },
+      { "abc", "900150983cd24fb0d6963f7d28e17f72" },
+      { "message digest", "f96b697d7cb7938d525a2f31aaf161d0" },
+      { "abcdefghijklmnopqrstuvwxyz", "c3fcd3d76192e4007dfb496cca67e13b" },
+      { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", "d174ab98d277d9f5a5611c2c9f419d9f" },
+      { "12345678901234567890123456789012345678901234567890123456789012345678901234567890", "57edf4a22be3c955ac49da2e2107b67a" },
+    };
+    for (const auto& test : suite) {
+      MD5x4 md5(std::array<MD5x4::key_t, 4>{{ md5_init, md5_init, md5_init, md5_init }});
+      md5.Update(test.first, strlen(test.first));
+      for (const auto& digest : md5.Final()) {
+        CHECK_EQ(digest, test.second);
+      }
+    }
+  }
+
+  SUBCASE("same as scalar MD5") {
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<size_t> chunk(0, 150);
+
+    for (size_t size : { 0, 1, 55, 56, 63, 64, 65, 119, 120, 128, 1000, 4099 }) {
+      std::vector<uint8_t> data(size);
+      std::generate(data.begin(), data.end(), [&]() { return byte(gen); });
+
+      auto scalar = igc_scalar();
+      MD5x4 md5(igc_keys);
+
+      // random chunk size, to test internal buffer
+      for (size_t pos = 0; pos < size; ) {
+        const size_t n = std::min(chunk(gen), size - pos);
+        md5.Update(&data[pos], n);
+        for (auto& lane : scalar) {
+          lane.Update(&data[pos], n);
+        }
+        pos += n;
+      }
+
+      const auto digest = md5.Final();
+      for (unsigned lane = 0; lane < 4; ++lane) {
+        CHECK_EQ(digest[lane], MD5(scalar[lane]).Final());
+      }
+
+      // Final() don't change state
+      md5.Update("B", 1);
+      scalar[0].Update('B');
+      CHECK_EQ(md5.Final()[0], MD5(scalar[0]).Final());
+    }
+  }
+}
+
+// not run by default, use '--test-case="MD5x4 benchmark" --no-skip'
+// set LK_BENCHMARK_IGC to hash a recorded igc file instead of synthetic B records.
+TEST_CASE("MD5x4 benchmark" * doctest::skip()) {
+
+  std::vector<std::string> records;
+  const char* path = getenv("LK_BENCHMARK_IGC");
+  if (path) {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+      line.erase(std::remove_if(line.begin(), line.end(), [](char c) { return c == '\r' || c == '\n'; }), line.end());
+      records.push_back(line);
+    }
+  } else {
+    // 10 hours flight at 1s
+    char record[64];
+    for (unsigned i = 0; i < 36000; ++i) {
+      sprintf(record, "B%02u%02u%02u4551%03uN00612%03uEA%05u%05u",
+              10 + i / 3600, (i / 60) % 60, i % 60, i % 1000, (i * 7) % 1000, 1000 + i % 500, 1100 + i % 500);
+      records.emplace_back(record);
+    }
+  }
+  REQUIRE(!records.empty());
+
+  PeriodClock clock;
+
+  // igc_file_writer before multi lane : one char at a time in each lane
+  clock.Update();
+  auto bytewise = igc_scalar();
+  for (const auto& record : records) {
+    for (char c : record) {
+      for (auto& lane : bytewise) {
+        lane.Update(c);
+      }
+    }
+  }
+  const int bytewise_ms = clock.Elapsed();
+
+  clock.Update();
+  auto scalar = igc_scalar();
+  for (const auto& record : records) {
+    for (auto& lane : scalar) {
+      lane.Update(record.data(), record.size());
+    }
+  }
+  const int scalar_ms = clock.Elapsed();
+
+  clock.Update();
+  MD5x4 md5(igc_keys);
+  for (const auto& record : records) {
+    md5.Update(record.data(), record.size());
+  }
+  const int multi_lane_ms = clock.Elapsed();
+
+  const auto digest = md5.Final();
+  for (unsigned lane = 0; lane < 4; ++lane) {
+    CHECK_EQ(digest[lane], MD5(bytewise[lane]).Final());
+    CHECK_EQ(digest[lane], MD5(scalar[lane]).Final());
+  }
+
+  MESSAGE(records.size() << " records : 4 x MD5 per char " << bytewise_ms << "ms, 4 x MD5 per record "
+          << scalar_ms << "ms, MD5x4 " << multi_lane_ms << "ms");
+}
+
+#endif
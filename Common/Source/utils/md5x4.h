@@ -0,0 +1,47 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   md5x4.h
+ */
+
+#ifndef _UTILS_MD5X4_H_
+#define _UTILS_MD5X4_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <string>
+
+/**
+ * Four MD5 hash of the same data with different initial state.
+ *
+ * This is what is used by IGC G record : each 64 bytes block is processed once
+ * for 4 lanes, using SIMD vector (SSE2 / NEON) when available.
+ * Result is the same as 4 MD5_Base initialized with same keys.
+ */
+class MD5x4 final {
+public:
+  using key_t = std::array<uint32_t, 4>;
+
+  explicit MD5x4(const std::array<key_t, 4>& keys);
+
+  void Update(const void* input, size_t size);
+
+  /**
+   * @return digest of each lane, as 32 lowercase hex digits.
+   *   hash state is not modified, so Update can be called after.
+   */
+  std::array<std::string, 4> Final() const;
+
+private:
+  void ProcessBlock(const uint8_t* block);
+
+  uint32_t state[4][4]; // [A, B, C, D][lane]
+  uint64_t total = 0; // bytes
+  uint8_t buffer[64];
+  size_t buflen = 0;
+};
+
+#endif // _UTILS_MD5X4_H_
@@ -0,0 +1,257 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   profiler.cpp
+ */
+
+#include "externs.h"
+#include "profiler.h"
+#include "utils/unique_file_ptr.h"
+#include <cstdio>
+#include <iterator>
+#include <algorithm>
+
+namespace profiler {
+
+namespace {
+
+  histogram stages[STAGE_COUNT];
+
+  const char* const stage_names[] = {
+    "DoCalculationsVario",
+    "DoCalculations",
+    "DoCalculationsSlow",
+    "AirspaceWarning",
+    "TerrainFootprint",
+    "RangeWaypointList",
+    "BestAlternate",
+    "ContestSolver",
+    "RenderMap",
+    "DrawTerrain",
+    "DrawTopology",
+    "DrawAirspace",
+    "AirspaceScreenPosition",
+    "DrawTask",
+    "DrawTrail",
+    "DrawWaypoints",
+    "DrawTraffic",
+    "DrawOverlays",
+    "TopologyLoad",
+    "LockFlightData",
+    "LockTaskData",
+    "LockTerrain",
+  };
+  static_assert(std::size(stage_names) == STAGE_COUNT, "invalid stage_names size");
+
+  unsigned bucket_index(uint64_t us) {
+    unsigned i = 0;
+    while ((us >>= 1) && i < (histogram::bucket_count - 1)) {
+      ++i;
+    }
+    return i;
+  }
+
+} // namespace
+
+std::atomic<bool> enabled = {false};
+
+void histogram::Add(uint64_t us) {
+  // lock wait can be added by any thread
+  buckets[bucket_index(us)].fetch_add(1, std::memory_order_relaxed);
+  count.fetch_add(1, std::memory_order_relaxed);
+  total.fetch_add(us, std::memory_order_relaxed);
+
+  uint64_t value = min.load(std::memory_order_relaxed);
+  while (us < value && !min.compare_exchange_weak(value, us, std::memory_order_relaxed)) { }
+
+  value = max.load(std::memory_order_relaxed);
+  while (us > value && !max.compare_exchange_weak(value, us, std::memory_order_relaxed)) { }
+}
+
+void histogram::Reset() {
+  for (auto& bucket : buckets) {
+    bucket = 0;
+  }
+  count = 0;
+  total = 0;
+  min = UINT64_MAX;
+  max = 0;
+}
+
+uint64_t histogram::Percentile(unsigned p) const {
+  const uint64_t n = Count();
+  if (n == 0) {
+    return 0;
+  }
+  const uint64_t rank = (n * p + 99) / 100;
+  uint64_t sum = 0;
+  for (unsigned i = 0; i < bucket_count; ++i) {
+    sum += Bucket(i);
+    if (sum >= std::max<uint64_t>(rank, 1)) {
+      return std::min(uint64_t(2) << i, Max());
+    }
+  }
+  return Max();
+}
+
+void Enable(bool enable) {
+  enabled = enable;
+}
+
+void Reset() {
+  for (auto& stage : stages) {
+    stage.Reset();
+  }
+}
+
+const histogram& Get(stage_t stage) {
+  return stages[stage];
+}
+
+const char* Name(stage_t stage) {
+  return (stage < STAGE_COUNT) ? stage_names[stage] : "";
+}
+
+void Add(stage_t stage, uint64_t us) {
+  if (stage < STAGE_COUNT) {
+    stages[stage].Add(us);
+  }
+}
+
+std::string Report() {
+  std::string out;
+  char line[256];
+  snprintf(line, std::size(line), "%-20s %8s %10s %8s %8s %8s %8s %8s  histogram (us, log2)\n",
+           "stage", "count", "total ms", "min us", "avg us", "p50 us", "p95 us", "max us");
+  out += line;
+
+  for (unsigned s = 0; s < STAGE_COUNT; ++s) {
+    const histogram& h = stages[s];
+    const unsigned count = h.Count();
+    if (count == 0) {
+      continue;
+    }
+    snprintf(line, std::size(line), "%-20s %8u %10.1f %8u %8.1f %8u %8u %8u ",
+             stage_names[s], count, h.Total() / 1000., unsigned(h.Min()), double(h.Total()) / count,
+             unsigned(h.Percentile(50)), unsigned(h.Percentile(95)), unsigned(h.Max()));
+    out += line;
+
+    for (unsigned i = 0; i < histogram::bucket_count; ++i) {
+      if (h.Bucket(i)) {
+        snprintf(line, std::size(line), " <%u:%u", 2U << i, h.Bucket(i));
+        out += line;
+      }
+    }
+    out += "\n";
+  }
+  return out;
+}
+
+void Dump() {
+  TCHAR path[MAX_PATH];
+  LocalPath(path, _T(LKD_LOGS), _T("PROFILER.TXT"));
+
+  unique_file_ptr file(_tfopen(path, _T("ab")));
+  if (file) {
+    fprintf(file.get(), "---- %04d-%02d-%02d %02d:%02d:%02d UTC\n",
+            GPS_INFO.Year, GPS_INFO.Month, GPS_INFO.Day,
+            GPS_INFO.Hour, GPS_INFO.Minute, GPS_INFO.Second);
+    const std::string report = Report();
+    fwrite(report.data(), 1, report.size(), file.get());
+  }
+  Reset();
+}
+
+} // namespace profiler
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <thread>
+
+TEST_CASE("profiler histogram") {
+  profiler::histogram h;
+  CHECK(h.Count() == 0);
+  CHECK(h.Percentile(95) == 0);
+
+  for (unsigned i = 0; i < 90; ++i) {
+    h.Add(3); // bucket [2, 4[
+  }
+  for (unsigned i = 0; i < 10; ++i) {
+    h.Add(1000); // bucket [512, 1024[
+  }
+  CHECK(h.Count() == 100);
+  CHECK(h.Total() == 90 * 3 + 10 * 1000);
+  CHECK(h.Min() == 3);
+  CHECK(h.Max() == 1000);
+  CHECK(h.Bucket(1) == 90);
+  CHECK(h.Bucket(9) == 10);
+  CHECK(h.Percentile(50) == 4);
+  CHECK(h.Percentile(90) == 4);
+  CHECK(h.Percentile(95) == 1000); // bucket upper bound is limited by max
+  CHECK(h.Percentile(100) == 1000);
+
+  h.Add(0);
+  CHECK(h.Bucket(0) == 1);
+  CHECK(h.Min() == 0);
+
+  h.Reset();
+  CHECK(h.Count() == 0);
+  CHECK(h.Min() == 0);
+  CHECK(h.Max() == 0);
+}
+
+TEST_CASE("profiler scope") {
+  const bool was_enabled = profiler::enabled;
+  profiler::Reset();
+
+  profiler::Enable(false);
+  {
+    profiler::scope timer(profiler::BestAlternate);
+  }
+  CHECK(profiler::Get(profiler::BestAlternate).Count() == 0);
+
+  profiler::Enable(true);
+  {
+    profiler::scope timer(profiler::BestAlternate);
+  }
+  CHECK(profiler::Get(profiler::BestAlternate).Count() == 1);
+  CHECK(profiler::Report().find("BestAlternate") != std::string::npos);
+  CHECK(profiler::Report().find("DrawTerrain") == std::string::npos); // no sample
+
+  profiler::Reset();
+  profiler::Enable(was_enabled);
+}
+
+TEST_CASE("profiler timed mutex") {
+  const bool was_enabled = profiler::enabled;
+  profiler::Reset();
+  profiler::Enable(true);
+
+  profiler::timed_mutex<profiler::LockTaskData> mutex;
+  {
+    ScopeLock lock(mutex); // not contended
+  }
+  CHECK(profiler::Get(profiler::LockTaskData).Count() == 0);
+
+  std::atomic<bool> locked = {false};
+  std::thread owner([&]() {
+    ScopeLock lock(mutex);
+    locked = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  });
+  while (!locked) {
+    std::this_thread::yield();
+  }
+  WithLock(mutex, []() {});
+  owner.join();
+
+  CHECK(profiler::Get(profiler::LockTaskData).Count() == 1);
+  CHECK(profiler::Get(profiler::LockTaskData).Max() >= 10000);
+
+  profiler::Reset();
+  profiler::Enable(was_enabled);
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   profiler.h
+ */
+
+#ifndef _UTILS_PROFILER_H_
+#define _UTILS_PROFILER_H_
+
+#include <cstdint>
+#include <atomic>
+#include <string>
+#include "OS/Clock.hpp"
+#include "Thread/Mutex.hpp"
+
+/**
+ * Execution time histogram of calculation steps, map render stages and lock wait.
+ *
+ * Always compiled, disabled by default : a disabled timer cost only one relaxed atomic load.
+ * Enabled by replay benchmark or by "-profiler" command line option, in this case
+ * statistics are appended to _Logger/PROFILER.TXT every minute and reset.
+ */
+namespace profiler {
+
+  enum stage_t : unsigned {
+    // calculation thread
+    DoCalculationsVario,
+    DoCalculations,
+    DoCalculationsSlow,
+    AirspaceWarning,
+    TerrainFootprint,
+    RangeWaypointList,
+    BestAlternate,
+    ContestSolver,
+
+    // draw thread
+    RenderMap,
+    DrawTerrain,
+    DrawTopology,
+    DrawAirspace,
+    AirspaceScreenPosition,
+    DrawTask,
+    DrawTrail,
+    DrawWaypoints,
+    DrawTraffic,
+    DrawOverlays,
+
+    // topology loader thread
+    TopologyLoad,
+
+    // lock wait, only contended lock are counted
+    LockFlightData,
+    LockTaskData,
+    LockTerrain,
+
+    STAGE_COUNT
+  };
+
+  /**
+   * log2 histogram of duration in microseconds : bucket <i> count duration in [2^i, 2^(i+1)[
+   */
+  class histogram final {
+  public:
+    static constexpr unsigned bucket_count = 32;
+
+    void Add(uint64_t us);
+    void Reset();
+
+    unsigned Count() const {
+      return count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t Total() const {
+      return total.load(std::memory_order_relaxed);
+    }
+
+    uint64_t Min() const {
+      return Count() ? min.load(std::memory_order_relaxed) : 0;
+    }
+
+    uint64_t Max() const {
+      return max.load(std::memory_order_relaxed);
+    }
+
+    unsigned Bucket(unsigned i) const {
+      return buckets[i].load(std::memory_order_relaxed);
+    }
+
+    // upper bound of bucket containing percentile <p> [0-100]
+    uint64_t Percentile(unsigned p) const;
+
+  private:
+    std::atomic<unsigned> buckets[bucket_count] = {};
+    std::atomic<unsigned> count = {0};
+    std::atomic<uint64_t> total = {0};
+    std::atomic<uint64_t> min = {UINT64_MAX};
+    std::atomic<uint64_t> max = {0};
+  };
+
+  extern std::atomic<bool> enabled;
+
+  void Enable(bool enable);
+  void Reset();
+
+  const histogram& Get(stage_t stage);
+  const char* Name(stage_t stage);
+
+  // one line per stage : count, total, min, avg, p50, p95, max and histogram
+  std::string Report();
+
+  /**
+   * append Report() to _Logger/PROFILER.TXT then Reset(),
+   * so each dump give statistics since previous one.
+   */
+  void Dump();
+
+  void Add(stage_t stage, uint64_t us);
+
+  class scope final {
+  public:
+    explicit scope(stage_t stage)
+        : _stage(stage), _start(enabled.load(std::memory_order_relaxed) ? MonotonicClockUS() : 0) {}
+
+    ~scope() {
+      if (_start) {
+        Add(_stage, MonotonicClockUS() - _start);
+      }
+    }
+
+    scope(const scope&) = delete;
+    scope& operator=(const scope&) = delete;
+
+  private:
+    const stage_t _stage;
+    const uint64_t _start;
+  };
+
+  /**
+   * Mutex measuring time spent waiting for lock.
+   * ScopeLock deduce mutex type, so this lock() is also used by ScopeLock and WithLock.
+   */
+  template<stage_t stage>
+  class timed_mutex final : public ::Mutex {
+  public:
+    void lock() {
+      if (!::Mutex::try_lock()) {
+        scope wait(stage);
+        ::Mutex::lock();
+      }
+    }
+  };
+
+} // namespace profiler
+
+#endif // _UTILS_PROFILER_H_
@@ -0,0 +1,320 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   task_graph.cpp
+ */
+
+#include "externs.h"
+#include "task_graph.h"
+#include "Thread/Thread.hpp"
+#include "OS/Clock.hpp"
+#include <algorithm>
+#include <memory>
+#include <cassert>
+
+namespace {
+
+  // graph run by current thread, only defined in worker thread.
+  thread_local task_graph* worker_graph = nullptr;
+
+} // namespace
+
+class task_graph::worker final : public Thread {
+public:
+  explicit worker(task_graph& graph) : Thread("TaskGraph"), _graph(graph) {}
+
+protected:
+  void Run() override {
+    worker_graph = &_graph;
+    _graph.WorkerRun();
+    worker_graph = nullptr;
+  }
+
+private:
+  task_graph& _graph;
+};
+
+task_graph::id_t task_graph::Add(const TCHAR* name, std::function<void()> fn, std::initializer_list<id_t> depends) {
+  return AddTask(name, std::move(fn), depends, false);
+}
+
+task_graph::id_t task_graph::AddMain(const TCHAR* name, std::function<void()> fn, std::initializer_list<id_t> depends) {
+  return AddTask(name, std::move(fn), depends, true);
+}
+
+task_graph::id_t task_graph::AddTask(const TCHAR* name, std::function<void()>&& fn,
+                                     std::initializer_list<id_t> depends, bool main_thread) {
+  // dependencies must be added first, so graph can't have cycle.
+  assert(std::all_of(depends.begin(), depends.end(), [&](id_t id) { return id < tasks.size(); }));
+
+  tasks.push_back({name, std::move(fn), depends, main_thread, state_t::waiting, 0, 0});
+  return tasks.size() - 1;
+}
+
+task_graph::task_t* task_graph::NextTask(bool main_thread) {
+  for (auto& task : tasks) {
+    if (task.state != state_t::waiting) {
+      continue;
+    }
+    // without worker thread, all tasks are run by main thread.
+    if (task.main_thread != main_thread && worker_count > 0) {
+      continue;
+    }
+    bool ready = std::all_of(task.depends.begin(), task.depends.end(), [&](id_t id) {
+      return tasks[id].state == state_t::done;
+    });
+    if (ready) {
+      return &task;
+    }
+  }
+  return nullptr;
+}
+
+void task_graph::Execute(task_t& task) {
+  task.state = state_t::running;
+  task.start_us = MonotonicClockUS();
+  {
+    ScopeUnlock unlock(mutex);
+    try {
+      task.fn();
+    } catch (...) {
+      // task is done anyway, otherwise all depending tasks would wait forever.
+      StartupStore(_T("... Startup task <%s> failed"), task.name);
+    }
+  }
+  task.duration_us = MonotonicClockUS() - task.start_us;
+  task.state = state_t::done;
+  ++done_count;
+  cond.Broadcast();
+}
+
+void task_graph::WorkerRun() {
+  ScopeLock lock(mutex);
+  while (!Done()) {
+    task_t* task = NextTask(false);
+    if (task) {
+      Execute(*task);
+    } else {
+      cond.Wait(mutex);
+    }
+  }
+}
+
+void task_graph::Run(unsigned max_workers) {
+  start_us = MonotonicClockUS();
+
+  WithLock(mutex, [&]() {
+    for (auto& task : tasks) {
+      task.state = state_t::waiting;
+    }
+    done_count = 0;
+    worker_count = 0;
+  });
+
+  const size_t worker_tasks = std::count_if(tasks.begin(), tasks.end(), [](const task_t& task) {
+    return !task.main_thread;
+  });
+
+  std::vector<std::unique_ptr<worker>> workers;
+  while (workers.size() < std::min<size_t>(max_workers, worker_tasks)) {
+    auto thread = std::make_unique<worker>(*this);
+    if (!thread->Start()) {
+      break;
+    }
+    workers.push_back(std::move(thread));
+    WithLock(mutex, [&]() {
+      ++worker_count;
+    });
+  }
+
+  {
+    ScopeLock lock(mutex);
+    while (!Done() || !main_calls.empty()) {
+      if (!main_calls.empty()) {
+        std::function<void()> fn = std::move(main_calls.front());
+        main_calls.pop_front();
+
+        ScopeUnlock unlock(mutex);
+        fn();
+        continue;
+      }
+      task_t* task = NextTask(true);
+      if (task) {
+        Execute(*task);
+      } else {
+        cond.Wait(mutex);
+      }
+    }
+  }
+
+  for (auto& thread : workers) {
+    thread->Join();
+  }
+  workers.clear();
+
+  elapsed_ms = (MonotonicClockUS() - start_us) / 1000;
+}
+
+std::vector<task_graph::timing> task_graph::Timings() const {
+  std::vector<timing> result;
+  result.reserve(tasks.size());
+  for (auto& task : tasks) {
+    result.push_back({
+      task.name,
+      task.main_thread,
+      static_cast<unsigned>((task.start_us - start_us) / 1000),
+      static_cast<unsigned>(task.duration_us / 1000)
+    });
+  }
+  return result;
+}
+
+bool task_graph::InWorker() {
+  return worker_graph != nullptr;
+}
+
+void task_graph::Post(std::function<void()> fn) {
+  task_graph* graph = worker_graph;
+  if (!graph) {
+    fn();
+    return;
+  }
+  ScopeLock lock(graph->mutex);
+  graph->main_calls.push_back(std::move(fn));
+  graph->cond.Broadcast();
+}
+
+void task_graph::Invoke(const std::function<void()>& fn) {
+  task_graph* graph = worker_graph;
+  if (!graph) {
+    fn();
+    return;
+  }
+  bool done = false;
+  ScopeLock lock(graph->mutex);
+  graph->main_calls.push_back([&]() {
+    fn();
+    WithLock(graph->mutex, [&]() {
+      done = true;
+      graph->cond.Broadcast();
+    });
+  });
+  graph->cond.Broadcast();
+  while (!done) {
+    graph->cond.Wait(graph->mutex);
+  }
+}
+
+#ifndef DOCTEST_CONFIG_DISABLE
+#include <doctest/doctest.h>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+TEST_CASE("task graph") {
+
+  SUBCASE("dependencies") {
+    task_graph graph;
+    std::atomic<int> order = {0};
+    int a = -1, b = -1, c = -1, d = -1;
+
+    auto ta = graph.Add(_T("a"), [&]() { a = order++; });
+    auto tb = graph.Add(_T("b"), [&]() { b = order++; }, { ta });
+    auto tc = graph.AddMain(_T("c"), [&]() { c = order++; }, { tb });
+    graph.Add(_T("d"), [&]() { d = order++; }, { ta, tc });
+
+    graph.Run(4);
+    CHECK(a == 0);
+    CHECK(b == 1);
+    CHECK(c == 2);
+    CHECK(d == 3);
+
+    // graph can be run again
+    order = 0;
+    graph.Run(4);
+    CHECK(d == 3);
+  }
+
+  SUBCASE("concurrency") {
+    task_graph graph;
+
+    // each task wait for the other one : only done if both are running at the same time.
+    std::atomic<unsigned> arrived = {0};
+    auto rendezvous = [&]() {
+      ++arrived;
+      const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (arrived < 2 && std::chrono::steady_clock::now() < timeout) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    };
+
+    const auto main_id = std::this_thread::get_id();
+    std::thread::id worker_id, main_task_id;
+
+    graph.Add(_T("a"), rendezvous);
+    graph.Add(_T("b"), [&]() {
+      worker_id = std::this_thread::get_id();
+      rendezvous();
+    });
+    graph.AddMain(_T("main"), [&]() {
+      main_task_id = std::this_thread::get_id();
+    });
+
+    graph.Run(2);
+    CHECK(arrived == 2);
+    CHECK(worker_id != main_id);
+    CHECK(main_task_id == main_id);
+
+    auto timings = graph.Timings();
+    REQUIRE(timings.size() == 3);
+    CHECK_FALSE(timings[0].main_thread);
+    CHECK(timings[2].main_thread);
+    CHECK(graph.Elapsed() < 5000);
+  }
+
+  SUBCASE("without worker") {
+    task_graph graph;
+    const auto main_id = std::this_thread::get_id();
+    unsigned in_main = 0;
+    for (unsigned i = 0; i < 3; ++i) {
+      graph.Add(_T("task"), [&]() {
+        in_main += (std::this_thread::get_id() == main_id);
+        CHECK_FALSE(task_graph::InWorker());
+      });
+    }
+    graph.Run(0);
+    CHECK(in_main == 3);
+  }
+
+  SUBCASE("main thread calls") {
+    task_graph graph;
+    const auto main_id = std::this_thread::get_id();
+    std::thread::id invoke_id, post_id;
+    bool in_worker = false;
+    unsigned posted = 0;
+
+    graph.Add(_T("worker"), [&]() {
+      in_worker = task_graph::InWorker();
+      task_graph::Invoke([&]() {
+        invoke_id = std::this_thread::get_id();
+      });
+      for (unsigned i = 0; i < 10; ++i) {
+        task_graph::Post([&]() {
+          post_id = std::this_thread::get_id();
+          ++posted;
+        });
+      }
+    });
+
+    graph.Run(1);
+    CHECK(in_worker);
+    CHECK(invoke_id == main_id);
+    CHECK(post_id == main_id);
+    CHECK(posted == 10); // all posted calls are done before Run() return
+    CHECK_FALSE(task_graph::InWorker());
+  }
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * LK8000 Tactical Flight Computer -  WWW.LK8000.IT
+ * Released under GNU/GPL License v.2 or later
+ * See CREDITS.TXT file for authors and copyrights
+ *
+ * File:   task_graph.h
+ */
+
+#ifndef _UTILS_TASK_GRAPH_H_
+#define _UTILS_TASK_GRAPH_H_
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+#include <tchar.h>
+#include "Thread/Mutex.hpp"
+#include "Thread/Cond.hpp"
+
+/**
+ * Run a set of tasks with dependencies, independent tasks are run concurrently.
+ *
+ * Used at startup for loading terrain, waypoints, airspaces, topology and FLARM database.
+ * Tasks added with AddMain() are run by the thread calling Run(), others by worker threads.
+ * Each task start once all its dependencies are done.
+ *
+ * Worker tasks must not use the user interface : Post() and Invoke() forward calls to the
+ * thread running the graph (progress dialog and message box already do that).
+ */
+class task_graph final {
+public:
+  using id_t = unsigned;
+
+  struct timing {
+    const TCHAR* name;
+    bool main_thread;
+    unsigned start_ms;     // relative to Run() start
+    unsigned duration_ms;
+  };
+
+  task_graph() = default;
+  task_graph(const task_graph&) = delete;
+  task_graph& operator=(const task_graph&) = delete;
+
+  /**
+   * add task run by worker thread
+   * @depends : tasks that must be done before this one is started.
+   */
+  id_t Add(const TCHAR* name, std::function<void()> fn, std::initializer_list<id_t> depends = {});
+
+  /**
+   * add task run by thread calling Run()
+   */
+  id_t AddMain(const TCHAR* name, std::function<void()> fn, std::initializer_list<id_t> depends = {});
+
+  /**
+   * run all tasks using up to <max_workers> threads, return when all tasks are done.
+   * if no worker thread can be started, all tasks are run by calling thread.
+   */
+  void Run(unsigned max_workers);
+
+  // duration of each task, in order of Add()
+  std::vector<timing> Timings() const;
+
+  // duration of last Run()
+  unsigned Elapsed() const {
+    return elapsed_ms;
+  }
+
+  // @return true if called from worker thread of a running graph.
+  static bool InWorker();
+
+  /**
+   * called from worker thread : <fn> is queued and run later by the thread running the graph.
+   * otherwise <fn> is run immediately.
+   */
+  static void Post(std::function<void()> fn);
+
+  /**
+   * same as Post() but wait until <fn> is done.
+   */
+  static void Invoke(const std::function<void()>& fn);
+
+private:
+  class worker;
+
+  enum class state_t {
+    waiting,
+    running,
+    done
+  };
+
+  struct task_t {
+    const TCHAR* name;
+    std::function<void()> fn;
+    std::vector<id_t> depends;
+    bool main_thread;
+    state_t state;
+    uint64_t start_us;
+    uint64_t duration_us;
+  };
+
+  id_t AddTask(const TCHAR* name, std::function<void()>&& fn, std::initializer_list<id_t> depends, bool main_thread);
+
+  // must be called with <mutex> locked, nullptr if no task is ready
+  task_t* NextTask(bool main_thread);
+
+  // must be called with <mutex> locked, unlocked while task is running.
+  void Execute(task_t& task);
+
+  void WorkerRun();
+
+  bool Done() const {
+    return done_count == tasks.size();
+  }
+
+  Mutex mutex;
+  Cond cond;
+
+  std::vector<task_t> tasks;
+  size_t done_count = 0;
+  unsigned worker_count = 0;
+
+  // calls forwarded by Post() and Invoke()
+  std::deque<std::function<void()>> main_calls;
+
+  uint64_t start_us = 0;
+  unsigned elapsed_ms = 0;
+};
+
+#endif // _UTILS_TASK_GRAPH_H_